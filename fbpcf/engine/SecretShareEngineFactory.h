@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -92,6 +93,8 @@ getEngineFactoryWithTupleGeneratorFactory(
       numberOfParty);
 }
 
+const size_t kTupleGeneratorBufferSize = 1600000;
+
 template <class T>
 inline std::unique_ptr<SecretShareEngineFactory>
 getSecureEngineFactoryWithRcotFactory(
@@ -100,9 +103,8 @@ getSecureEngineFactoryWithRcotFactory(
     communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
     std::unique_ptr<tuple_generator::oblivious_transfer::
                         IRandomCorrelatedObliviousTransferFactory>
-        rcotFactory) {
-  size_t bufferSize = 1600000;
-
+        rcotFactory,
+    size_t bufferSize = kTupleGeneratorBufferSize) {
   std::unique_ptr<tuple_generator::ITupleGeneratorFactory>
       tupleGeneratorFactory;
 
@@ -158,6 +160,34 @@ getSecureEngineFactoryWithFERRET(
       tuple_generator::oblivious_transfer::createFerretRcotFactory());
 }
 
+/**
+ * create a secure engine that utilizes FERRET protocol, sized for a job that
+ * is expected to consume about expectedTupleCount tuples. A small job gets a
+ * tuple buffer no larger than it needs, so its first gates don't wait for
+ * millions of tuples. Going beyond the hint is fine, it only costs more
+ * refills.
+ * this function must be called by all parties at the same time since it
+ * contains inter-party communication
+ */
+template <class T>
+inline std::unique_ptr<SecretShareEngineFactory>
+getSecureEngineFactoryWithFERRETForExpectedTuples(
+    int myId,
+    int numberOfParty,
+    communication::IPartyCommunicationAgentFactory& communicationAgentFactory,
+    uint64_t expectedTupleCount) {
+  size_t bufferSize = std::min<uint64_t>(
+      kTupleGeneratorBufferSize,
+      std::max<uint64_t>(
+          expectedTupleCount, tuple_generator::kDefaultBufferSize));
+  return getSecureEngineFactoryWithRcotFactory<T>(
+      myId,
+      numberOfParty,
+      communicationAgentFactory,
+      tuple_generator::oblivious_transfer::createFerretRcotFactory(),
+      bufferSize);
+}
+
 /**
  * create a secure engine that utilizes classic OT protocol
  * this function must be called by all parties at the same time since it
@@ -25,6 +25,9 @@ class EmpNetworkAdapter;
 
 namespace fbpcf::engine::communication {
 
+class NetworkEmulatingPartyCommunicationAgent;
+class StripedPartyCommunicationAgent;
+
 /**
  * This object is a metric recorder
  */
@@ -152,6 +155,8 @@ class IPartyCommunicationAgent {
 
  private:
   friend class util::EmpNetworkAdapter;
+  friend class NetworkEmulatingPartyCommunicationAgent;
+  friend class StripedPartyCommunicationAgent;
 
   // convert a vector of bits into a vector of bytes
   static std::vector<unsigned char> compressToBytes(
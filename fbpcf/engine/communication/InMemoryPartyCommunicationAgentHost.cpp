@@ -7,30 +7,54 @@
 
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentHost.h"
 
+#include <new>
+#include <stdexcept>
+
 namespace fbpcf::engine::communication {
 
 void InMemoryPartyCommunicationAgent::sendImpl(const void* data, int nBytes) {
-  std::vector<unsigned char> buffer(nBytes);
-  memcpy(buffer.data(), data, nBytes);
-  host_.send(myId_, buffer);
+  host_.send(myId_, data, nBytes);
   sentData_ += nBytes;
 }
 
 void InMemoryPartyCommunicationAgent::recvImpl(void* data, int nBytes) {
-  auto result = host_.receive(myId_, nBytes);
+  host_.receive(myId_, data, nBytes);
+  receivedData_ += nBytes;
+}
 
-  if (result.size() != nBytes) {
-    throw std::runtime_error("unexpected message size!");
+InMemoryPartyCommunicationAgentHost::RingSegment::RingSegment(size_t capacity)
+    : memory(
+          static_cast<unsigned char*>(std::aligned_alloc(
+              64,
+              (SpscRingBuffer::getRequiredMemorySize(capacity) + 63) &
+                  ~static_cast<size_t>(63))),
+          &std::free),
+      next(nullptr) {
+  if (!memory) {
+    throw std::bad_alloc();
   }
-  memcpy(data, result.data(), nBytes);
-  receivedData_ += nBytes;
+  SpscRingBuffer::initialize(memory.get(), capacity);
+  ring = std::make_unique<SpscRingBuffer>(memory.get(), false);
 }
 
-InMemoryPartyCommunicationAgentHost::InMemoryPartyCommunicationAgentHost() {
+InMemoryPartyCommunicationAgentHost::InMemoryPartyCommunicationAgentHost(
+    size_t initialBufferSize) {
+  for (int i = 0; i < 2; i++) {
+    readSegments_[i] = std::make_unique<RingSegment>(initialBufferSize);
+    writeSegments_[i] = readSegments_[i].get();
+  }
   agents_[0] = std::make_unique<InMemoryPartyCommunicationAgent>(*this, 0);
   agents_[1] = std::make_unique<InMemoryPartyCommunicationAgent>(*this, 1);
 }
 
+InMemoryPartyCommunicationAgentHost::~InMemoryPartyCommunicationAgentHost() {
+  for (auto& segment : readSegments_) {
+    while (segment) {
+      segment.reset(segment->next.load());
+    }
+  }
+}
+
 std::unique_ptr<InMemoryPartyCommunicationAgent>
 InMemoryPartyCommunicationAgentHost::getAgent(int Id) {
   if (agents_[Id]) {
@@ -42,34 +66,47 @@ InMemoryPartyCommunicationAgentHost::getAgent(int Id) {
 
 void InMemoryPartyCommunicationAgentHost::send(
     int myId,
-    const std::vector<unsigned char>& data) {
-  std::unique_lock<std::mutex> lock(bufferLock_[myId]);
-  buffers_[myId].push(std::make_unique<std::vector<unsigned char>>(data));
-  bufferEmptyVariable_[myId].notify_one();
+    const void* data,
+    size_t size) {
+  auto src = static_cast<const unsigned char*>(data);
+  while (size > 0) {
+    auto& segment = *writeSegments_[myId];
+    auto written = segment.ring->tryWrite(src, size);
+    src += written;
+    size -= written;
+    if (size > 0) {
+      // the ring is full, continue in a larger one.
+      auto capacity = segment.ring->getCapacity();
+      if (capacity < kMaxBufferSize) {
+        capacity <<= 1;
+      }
+      while (capacity < size && capacity < kMaxBufferSize) {
+        capacity <<= 1;
+      }
+      auto next = new RingSegment(capacity);
+      segment.next.store(next, std::memory_order_release);
+      segment.ring->seal();
+      writeSegments_[myId] = next;
+    }
+  }
 }
 
-std::vector<unsigned char> InMemoryPartyCommunicationAgentHost::receive(
+void InMemoryPartyCommunicationAgentHost::receive(
     int myId,
+    void* data,
     size_t size) {
-  std::vector<unsigned char> result;
-
-  while (result.size() < size) {
-    std::unique_lock<std::mutex> lock(bufferLock_[1 - myId]);
-    while (buffers_[1 - myId].empty()) {
-      bufferEmptyVariable_[1 - myId].wait(
-          lock, [&]() { return !buffers_[1 - myId].empty(); });
-    }
-    auto& buf = *buffers_[1 - myId].front();
-    if (size - result.size() >= buf.size()) {
-      result.insert(result.end(), buf.begin(), buf.end());
-      buffers_[1 - myId].pop();
-    } else {
-      result.insert(
-          result.end(), buf.begin(), buf.begin() + size - result.size());
-      buf.erase(buf.begin(), buf.begin() + size - result.size());
+  auto dst = static_cast<unsigned char*>(data);
+  auto& segment = readSegments_[1 - myId];
+  while (size > 0) {
+    auto received = segment->ring->readSome(dst, size);
+    if (received == 0) {
+      // this ring is sealed and drained, the producer moved on to the next.
+      segment.reset(segment->next.load(std::memory_order_acquire));
+      continue;
     }
+    dst += received;
+    size -= received;
   }
-  return result;
 }
 
 } // namespace fbpcf::engine::communication
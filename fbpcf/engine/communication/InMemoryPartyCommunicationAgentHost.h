@@ -6,13 +6,13 @@
  */
 
 #pragma once
-#include <condition_variable>
-#include <mutex>
-#include <queue>
-#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
 #include <vector>
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/communication/SpscRingBuffer.h"
 
 namespace fbpcf::engine::communication {
 
@@ -52,10 +52,24 @@ class InMemoryPartyCommunicationAgent final : public IPartyCommunicationAgent {
  * This object can creates two in memory party communication agent objects that
  * can be used to send/receive messages between two threads. This object is
  * obviously thread-safe.
+ * Each direction is a chain of preallocated lock-free single-producer/
+ * single-consumer rings. A sender never blocks: when the current ring is full
+ * it links a larger one and carries on, the receiver drains the rings in
+ * order and frees the ones it is done with.
  */
 class InMemoryPartyCommunicationAgentHost {
  public:
-  InMemoryPartyCommunicationAgentHost();
+  static const size_t kDefaultInitialBufferSize = 1 << 20;
+  static const size_t kMaxBufferSize = 1 << 28;
+
+  /**
+   * @param initialBufferSize the capacity of the first ring in each
+   * direction, must be a power of 2.
+   */
+  explicit InMemoryPartyCommunicationAgentHost(
+      size_t initialBufferSize = kDefaultInitialBufferSize);
+
+  ~InMemoryPartyCommunicationAgentHost();
 
   /**
    * Get the communication agent hosted
@@ -65,25 +79,35 @@ class InMemoryPartyCommunicationAgentHost {
   std::unique_ptr<InMemoryPartyCommunicationAgent> getAgent(int Id);
 
  private:
+  /**
+   * A ring together with the memory it lives in.
+   */
+  struct RingSegment {
+    explicit RingSegment(size_t capacity);
+
+    std::unique_ptr<unsigned char, decltype(&std::free)> memory;
+    std::unique_ptr<SpscRingBuffer> ring;
+    // set by the producer right before it seals this ring.
+    std::atomic<RingSegment*> next;
+  };
+
   /**
    * Allow an in memory communication agent send data to the other.
    */
-  void send(int myId, const std::vector<unsigned char>&);
+  void send(int myId, const void* data, size_t size);
 
   /**
    * Allow an in memory communication agent receive data from the other.
    */
-  std::vector<unsigned char> receive(int myId, size_t size);
+  void receive(int myId, void* data, size_t size);
 
   std::unique_ptr<InMemoryPartyCommunicationAgent> agents_[2];
 
-  // this variable stores all the messages sent. The first is for data sent by
-  // party0, the second is for party 1.
-  std::queue<std::unique_ptr<std::vector<unsigned char>>> buffers_[2];
-
-  // mutex lock for the two buffers
-  std::mutex bufferLock_[2];
-  std::condition_variable bufferEmptyVariable_[2];
+  // The rings carrying the messages sent. The first is for data sent by
+  // party0, the second is for party 1. The producer only touches the last
+  // segment of a chain, the consumer owns the first one.
+  RingSegment* writeSegments_[2];
+  std::unique_ptr<RingSegment> readSegments_[2];
 
   friend class InMemoryPartyCommunicationAgent;
 };
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/communication/NetworkEmulatingPartyCommunicationAgent.h"
+
+#include <string.h>
+#include <algorithm>
+
+namespace fbpcf::engine::communication {
+
+NetworkEmulatingPartyCommunicationAgent::
+    NetworkEmulatingPartyCommunicationAgent(
+        std::unique_ptr<IPartyCommunicationAgent> agent,
+        NetworkProfile profile)
+    : agent_(std::move(agent)),
+      profile_(profile),
+      sentData_(0),
+      receivedData_(0),
+      tokens_(profile.burstInBytes),
+      lastRefill_(Clock::now()),
+      lastDelivery_(lastRefill_),
+      jitterGenerator_(std::random_device()()),
+      stopping_(false) {
+  deliveryThread_ = std::thread([this]() { deliverMessages(); });
+}
+
+NetworkEmulatingPartyCommunicationAgent::
+    ~NetworkEmulatingPartyCommunicationAgent() {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    stopping_ = true;
+  }
+  queueVariable_.notify_one();
+  // messages already sent are still delivered.
+  deliveryThread_.join();
+}
+
+void NetworkEmulatingPartyCommunicationAgent::sendImpl(
+    const void* data,
+    int nBytes) {
+  DelayedMessage message{
+      scheduleDelivery(Clock::now(), nBytes),
+      std::vector<unsigned char>(nBytes)};
+  memcpy(message.data.data(), data, nBytes);
+  {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (deliveryException_) {
+      std::rethrow_exception(deliveryException_);
+    }
+    queue_.push(std::move(message));
+  }
+  queueVariable_.notify_one();
+  sentData_ += nBytes;
+}
+
+void NetworkEmulatingPartyCommunicationAgent::recvImpl(void* data, int nBytes) {
+  agent_->recvImpl(data, nBytes);
+  receivedData_ += nBytes;
+}
+
+NetworkEmulatingPartyCommunicationAgent::Clock::time_point
+NetworkEmulatingPartyCommunicationAgent::scheduleDelivery(
+    Clock::time_point now,
+    int nBytes) {
+  auto departure = now;
+  if (profile_.bandwidthInBytesPerSecond > 0) {
+    auto bytesPerMicrosecond = profile_.bandwidthInBytesPerSecond / 1e6;
+    auto idle =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - lastRefill_)
+            .count();
+    tokens_ = std::min<double>(
+        profile_.burstInBytes, tokens_ + idle * bytesPerMicrosecond);
+    lastRefill_ = now;
+    // a negative balance is the backlog still waiting to be serialized
+    // onto the link, this message leaves once it is paid off.
+    tokens_ -= nBytes;
+    if (tokens_ < 0) {
+      departure += std::chrono::microseconds(
+          static_cast<int64_t>(-tokens_ / bytesPerMicrosecond));
+    }
+  }
+
+  auto delivery = departure + profile_.latency;
+  if (profile_.jitter.count() > 0) {
+    std::uniform_int_distribution<int64_t> distribution(
+        0, profile_.jitter.count());
+    delivery += std::chrono::microseconds(distribution(jitterGenerator_));
+  }
+  // a message can't overtake the previous one.
+  lastDelivery_ = std::max(delivery, lastDelivery_);
+  return lastDelivery_;
+}
+
+void NetworkEmulatingPartyCommunicationAgent::deliverMessages() {
+  while (true) {
+    DelayedMessage message;
+    {
+      std::unique_lock<std::mutex> lock(queueMutex_);
+      queueVariable_.wait(
+          lock, [this]() { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      message = std::move(queue_.front());
+      queue_.pop();
+    }
+    std::this_thread::sleep_until(message.deliveryTime);
+    try {
+      agent_->sendImpl(message.data.data(), message.data.size());
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(queueMutex_);
+      deliveryException_ = std::current_exception();
+      return;
+    }
+  }
+}
+
+} // namespace fbpcf::engine::communication
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+
+namespace fbpcf::engine::communication {
+
+/**
+ * The characteristics of an emulated network link, in one direction.
+ */
+struct NetworkProfile {
+  // the time between a byte leaving the sender and it reaching the receiver.
+  std::chrono::microseconds latency;
+  // a random extra delay of up to this much is added to each message.
+  std::chrono::microseconds jitter;
+  // 0 means unlimited.
+  uint64_t bandwidthInBytesPerSecond;
+  // the amount of data that can leave at once after the link has been idle.
+  uint64_t burstInBytes;
+
+  /**
+   * Two hosts in the same data center.
+   */
+  static NetworkProfile lan() {
+    return {
+        std::chrono::microseconds(100),
+        std::chrono::microseconds(10),
+        1250000000, // 10 Gbps
+        1 << 20};
+  }
+
+  /**
+   * Two data centers in the same cloud region.
+   */
+  static NetworkProfile sameRegion() {
+    return {
+        std::chrono::microseconds(1000),
+        std::chrono::microseconds(100),
+        625000000, // 5 Gbps
+        1 << 20};
+  }
+
+  /**
+   * Two data centers in different regions, or two different clouds.
+   */
+  static NetworkProfile crossRegion() {
+    return {
+        std::chrono::microseconds(35000),
+        std::chrono::microseconds(2000),
+        125000000, // 1 Gbps
+        1 << 20};
+  }
+};
+
+/**
+ * This object wraps another communication agent and delays outgoing messages
+ * as if they went through a link with the given latency, jitter and
+ * bandwidth. Bandwidth is enforced with a token bucket; messages then wait in
+ * a delay queue and are handed to the wrapped agent by a background thread
+ * once they would have arrived. Message order is preserved. Incoming
+ * messages are delayed by the peer's agent, so both parties should be
+ * wrapped.
+ */
+class NetworkEmulatingPartyCommunicationAgent final
+    : public IPartyCommunicationAgent {
+ public:
+  NetworkEmulatingPartyCommunicationAgent(
+      std::unique_ptr<IPartyCommunicationAgent> agent,
+      NetworkProfile profile);
+
+  ~NetworkEmulatingPartyCommunicationAgent() override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return {sentData_, receivedData_};
+  }
+
+  void recvImpl(void* data, int nBytes) override;
+
+  void sendImpl(const void* data, int nBytes) override;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct DelayedMessage {
+    Clock::time_point deliveryTime;
+    std::vector<unsigned char> data;
+  };
+
+  /**
+   * Decide when a message of this size reaches the other side.
+   */
+  Clock::time_point scheduleDelivery(Clock::time_point now, int nBytes);
+
+  void deliverMessages();
+
+  std::unique_ptr<IPartyCommunicationAgent> agent_;
+  NetworkProfile profile_;
+
+  // counted here since the wrapped agent only sees a message once it is
+  // delivered, in a different thread.
+  uint64_t sentData_;
+  uint64_t receivedData_;
+
+  // token bucket state, only touched by the sending thread.
+  double tokens_;
+  Clock::time_point lastRefill_;
+  Clock::time_point lastDelivery_;
+  std::mt19937_64 jitterGenerator_;
+
+  std::mutex queueMutex_;
+  std::condition_variable queueVariable_;
+  std::queue<DelayedMessage> queue_;
+  bool stopping_;
+  std::exception_ptr deliveryException_;
+
+  std::thread deliveryThread_;
+};
+
+} // namespace fbpcf::engine::communication
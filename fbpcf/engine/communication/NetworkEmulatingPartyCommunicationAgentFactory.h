@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/NetworkEmulatingPartyCommunicationAgent.h"
+
+namespace fbpcf::engine::communication {
+
+/**
+ * A communication factory that wraps the agents of another factory in
+ * network emulating agents. This is meant for benchmarks: it lets local runs
+ * see the latency and bandwidth of a real link.
+ */
+class NetworkEmulatingPartyCommunicationAgentFactory final
+    : public IPartyCommunicationAgentFactory {
+ public:
+  NetworkEmulatingPartyCommunicationAgentFactory(
+      std::unique_ptr<IPartyCommunicationAgentFactory> factory,
+      NetworkProfile profile,
+      std::string myname)
+      : IPartyCommunicationAgentFactory(myname),
+        factory_(std::move(factory)),
+        profile_(profile) {
+    // the wrapped agents keep reporting traffic to the wrapped factory.
+    metricCollector_ = factory_->getMetricsCollector();
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::unique_ptr<IPartyCommunicationAgent> create(int id, std::string name)
+      override {
+    return std::make_unique<NetworkEmulatingPartyCommunicationAgent>(
+        factory_->create(id, name), profile_);
+  }
+
+ private:
+  std::unique_ptr<IPartyCommunicationAgentFactory> factory_;
+  NetworkProfile profile_;
+};
+
+} // namespace fbpcf::engine::communication
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/communication/ResumableSocketPartyCommunicationAgent.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <thread>
+
+#include <folly/String.h>
+#include "folly/logging/xlog.h"
+
+namespace fbpcf::engine::communication {
+
+namespace {
+
+// the kernel doubles these, so at most 4x this much can be in flight.
+const int kSocketBufferSize = 1 << 22;
+
+// a dead peer is noticed after about 10 + 3 * 5 seconds of silence.
+const int kKeepAliveIdleInSeconds = 10;
+const int kKeepAliveIntervalInSeconds = 5;
+const int kKeepAliveCount = 3;
+
+const auto kReconnectRetryInterval = std::chrono::milliseconds(100);
+
+void setSocketOptions(int sockfd) {
+  int enable = 1;
+  int bufferSize = kSocketBufferSize;
+  int idle = kKeepAliveIdleInSeconds;
+  int interval = kKeepAliveIntervalInSeconds;
+  int count = kKeepAliveCount;
+  if (setsockopt(sockfd, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(int)) <
+          0 ||
+      setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(int)) <
+          0) {
+    // without the cap, in-flight data could exceed the replay buffer.
+    throw std::runtime_error("error setting socket buffer size");
+  }
+  if (setsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(int)) < 0 ||
+      setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(int)) < 0 ||
+      setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(int)) <
+          0 ||
+      setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(int)) < 0) {
+    XLOG(INFO) << "setsockopt(SO_KEEPALIVE) failed";
+  }
+}
+
+} // namespace
+
+ResumableSocketPartyCommunicationAgent::ResumableSocketPartyCommunicationAgent(
+    int sockFd,
+    int portNo,
+    std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+    size_t replayBufferSize,
+    int reconnectTimeoutInSeconds)
+    : isServer_(true),
+      listeningFd_(sockFd),
+      portNo_(portNo),
+      connectionFd_(-1),
+      reconnectTimeout_(reconnectTimeoutInSeconds),
+      sentBytes_(0),
+      receivedBytes_(0),
+      replayBuffer_(replayBufferSize),
+      pendingReadPosition_(0),
+      resumeCount_(0),
+      recorder_(recorder) {
+  if (replayBufferSize < 4 * kSocketBufferSize) {
+    throw std::invalid_argument("Replay buffer is too small.");
+  }
+  // accepted connections inherit these.
+  setSocketOptions(listeningFd_);
+  connect(Clock::time_point::max());
+  XLOG(INFO) << "connected as resumable server at port " << portNo;
+}
+
+ResumableSocketPartyCommunicationAgent::ResumableSocketPartyCommunicationAgent(
+    const std::string& serverAddress,
+    int portNo,
+    std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+    size_t replayBufferSize,
+    int reconnectTimeoutInSeconds)
+    : isServer_(false),
+      listeningFd_(-1),
+      serverAddress_(serverAddress),
+      portNo_(portNo),
+      connectionFd_(-1),
+      reconnectTimeout_(reconnectTimeoutInSeconds),
+      sentBytes_(0),
+      receivedBytes_(0),
+      replayBuffer_(replayBufferSize),
+      pendingReadPosition_(0),
+      resumeCount_(0),
+      recorder_(recorder) {
+  if (replayBufferSize < 4 * kSocketBufferSize) {
+    throw std::invalid_argument("Replay buffer is too small.");
+  }
+  XLOGF(
+      INFO,
+      "try to connect as resumable client to {} at port {}",
+      serverAddress,
+      portNo);
+  if (!connect(Clock::time_point::max())) {
+    throw std::runtime_error(
+        "Can't connect to " + serverAddress + " " + std::to_string(portNo));
+  }
+  XLOGF(INFO, "connected as client to {} at port {}", serverAddress, portNo);
+}
+
+ResumableSocketPartyCommunicationAgent::
+    ~ResumableSocketPartyCommunicationAgent() {
+  closeConnection();
+  if (listeningFd_ >= 0) {
+    close(listeningFd_);
+  }
+}
+
+void ResumableSocketPartyCommunicationAgent::sendImpl(
+    const void* data,
+    int nBytes) {
+  auto src = static_cast<const unsigned char*>(data);
+  size_t remaining = nBytes;
+  while (remaining > 0) {
+    auto written = writeSome(src, remaining);
+    if (written < 0) {
+      resume();
+      continue;
+    }
+    recordSentData(src, written);
+    src += written;
+    remaining -= written;
+  }
+  recorder_->addSentData(nBytes);
+}
+
+void ResumableSocketPartyCommunicationAgent::recvImpl(void* data, int nBytes) {
+  auto dst = static_cast<unsigned char*>(data);
+  size_t remaining = nBytes;
+  while (remaining > 0) {
+    // what arrived during a resume comes first.
+    if (pendingReadPosition_ < pendingData_.size()) {
+      auto chunk =
+          std::min(remaining, pendingData_.size() - pendingReadPosition_);
+      memcpy(dst, pendingData_.data() + pendingReadPosition_, chunk);
+      pendingReadPosition_ += chunk;
+      if (pendingReadPosition_ == pendingData_.size()) {
+        pendingData_.clear();
+        pendingReadPosition_ = 0;
+      }
+      dst += chunk;
+      remaining -= chunk;
+      continue;
+    }
+    auto received = readSome(dst, remaining);
+    if (received < 0) {
+      resume();
+      continue;
+    }
+    receivedBytes_ += received;
+    dst += received;
+    remaining -= received;
+  }
+  recorder_->addReceivedData(nBytes);
+}
+
+void ResumableSocketPartyCommunicationAgent::recordSentData(
+    const unsigned char* data,
+    size_t size) {
+  auto capacity = replayBuffer_.size();
+  // only the last capacity bytes are kept.
+  if (size > capacity) {
+    sentBytes_ += size - capacity;
+    data += size - capacity;
+    size = capacity;
+  }
+  while (size > 0) {
+    auto offset = sentBytes_ % capacity;
+    auto chunk = capacity - offset;
+    if (chunk > size) {
+      chunk = size;
+    }
+    memcpy(replayBuffer_.data() + offset, data, chunk);
+    sentBytes_ += chunk;
+    data += chunk;
+    size -= chunk;
+  }
+}
+
+void ResumableSocketPartyCommunicationAgent::resume() {
+  XLOG(INFO) << "connection at port " << portNo_ << " lost, resuming";
+  auto deadline = Clock::now() + reconnectTimeout_;
+  while (true) {
+    closeConnection();
+    if (Clock::now() > deadline) {
+      throw std::runtime_error(
+          "Failed to resume the connection at port " +
+          std::to_string(portNo_));
+    }
+    if (!connect(deadline)) {
+      continue;
+    }
+
+    // tell each other how much was sent and arrived; both messages fit in
+    // the socket buffers so there is no deadlock.
+    uint64_t offsets[2] = {sentBytes_, receivedBytes_};
+    uint64_t peerOffsets[2];
+    if (!writeAll(
+            reinterpret_cast<const unsigned char*>(offsets), sizeof(offsets)) ||
+        !readAll(
+            reinterpret_cast<unsigned char*>(peerOffsets),
+            sizeof(peerOffsets))) {
+      continue;
+    }
+    auto peerSentBytes = peerOffsets[0];
+    auto peerReceivedBytes = peerOffsets[1];
+    if (peerReceivedBytes > sentBytes_ ||
+        sentBytes_ - peerReceivedBytes > replayBuffer_.size() ||
+        peerSentBytes < receivedBytes_) {
+      throw std::runtime_error(
+          "Can't resume the connection at port " + std::to_string(portNo_) +
+          ", the data the other party missed is gone.");
+    }
+
+    // one side replays while the other one only reads, then they swap.
+    auto replayed = isServer_
+        ? replay(peerReceivedBytes) && drainReplay(peerSentBytes)
+        : drainReplay(peerSentBytes) && replay(peerReceivedBytes);
+    if (!replayed) {
+      continue;
+    }
+    resumeCount_++;
+    XLOGF(
+        INFO,
+        "connection at port {} resumed, replayed {} bytes",
+        portNo_,
+        sentBytes_ - peerReceivedBytes);
+    return;
+  }
+}
+
+bool ResumableSocketPartyCommunicationAgent::replay(
+    uint64_t peerReceivedBytes) {
+  auto capacity = replayBuffer_.size();
+  auto offset = peerReceivedBytes;
+  while (offset < sentBytes_) {
+    auto position = offset % capacity;
+    auto chunk = std::min(capacity - position, sentBytes_ - offset);
+    if (!writeAll(replayBuffer_.data() + position, chunk)) {
+      return false;
+    }
+    offset += chunk;
+  }
+  return true;
+}
+
+bool ResumableSocketPartyCommunicationAgent::drainReplay(
+    uint64_t peerSentBytes) {
+  if (pendingReadPosition_ > 0) {
+    pendingData_.erase(
+        pendingData_.begin(), pendingData_.begin() + pendingReadPosition_);
+    pendingReadPosition_ = 0;
+  }
+  while (receivedBytes_ < peerSentBytes) {
+    auto size = pendingData_.size();
+    pendingData_.resize(size + (peerSentBytes - receivedBytes_));
+    auto received =
+        readSome(pendingData_.data() + size, pendingData_.size() - size);
+    pendingData_.resize(size + std::max<ssize_t>(received, 0));
+    if (received < 0) {
+      return false;
+    }
+    receivedBytes_ += received;
+  }
+  return true;
+}
+
+bool ResumableSocketPartyCommunicationAgent::connect(
+    Clock::time_point deadline) {
+  if (isServer_) {
+    while (true) {
+      auto timeout = -1;
+      if (deadline != Clock::time_point::max()) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - Clock::now())
+                        .count();
+        if (left <= 0) {
+          return false;
+        }
+        timeout = static_cast<int>(left);
+      }
+      struct pollfd listening = {listeningFd_, POLLIN, 0};
+      auto ready = poll(&listening, 1, timeout);
+      if (ready < 0 && errno != EINTR) {
+        throw std::runtime_error("error waiting for connections");
+      }
+      if (ready <= 0) {
+        continue;
+      }
+      connectionFd_ = accept(listeningFd_, nullptr, nullptr);
+      if (connectionFd_ >= 0) {
+        return true;
+      }
+      XLOG(INFO) << "accept() failed: " << folly::errnoStr(errno);
+    }
+  }
+
+  auto portString = std::to_string(portNo_);
+  struct addrinfo hints = {};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
+  while (Clock::now() < deadline) {
+    struct addrinfo* addrs = nullptr;
+    if (getaddrinfo(
+            serverAddress_.data(), portString.data(), &hints, &addrs) != 0 ||
+        addrs == nullptr) {
+      std::this_thread::sleep_for(kReconnectRetryInterval);
+      continue;
+    }
+    auto sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (sockfd < 0) {
+      freeaddrinfo(addrs);
+      throw std::runtime_error("error opening socket");
+    }
+    // must be set before connecting for the window to be sized accordingly.
+    setSocketOptions(sockfd);
+    auto status = ::connect(sockfd, addrs->ai_addr, addrs->ai_addrlen);
+    freeaddrinfo(addrs);
+    if (status == 0) {
+      connectionFd_ = sockfd;
+      return true;
+    }
+    close(sockfd);
+    std::this_thread::sleep_for(kReconnectRetryInterval);
+  }
+  return false;
+}
+
+void ResumableSocketPartyCommunicationAgent::closeConnection() {
+  if (connectionFd_ >= 0) {
+    close(connectionFd_);
+    connectionFd_ = -1;
+  }
+}
+
+bool ResumableSocketPartyCommunicationAgent::waitForConnection(short event) {
+  // a server also watches its listening socket: the other party only
+  // reconnects after its side of the connection failed, so this one is
+  // stale even if it doesn't know yet.
+  struct pollfd fds[2] = {
+      {connectionFd_, event, 0}, {isServer_ ? listeningFd_ : -1, POLLIN, 0}};
+  while (true) {
+    auto ready = poll(fds, 2, -1);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (fds[1].revents != 0) {
+      return false;
+    }
+    // errors and hang-ups are reported by the following send() or recv().
+    return true;
+  }
+}
+
+ssize_t ResumableSocketPartyCommunicationAgent::writeSome(
+    const unsigned char* data,
+    size_t size) {
+  while (waitForConnection(POLLOUT)) {
+    auto written = ::send(connectionFd_, data, size, MSG_NOSIGNAL);
+    if (written > 0) {
+      return written;
+    }
+    if (written < 0 && (errno == EINTR || errno == EAGAIN)) {
+      continue;
+    }
+    XLOG(INFO) << "send() failed: " << folly::errnoStr(errno);
+    break;
+  }
+  return -1;
+}
+
+ssize_t ResumableSocketPartyCommunicationAgent::readSome(
+    unsigned char* data,
+    size_t size) {
+  while (waitForConnection(POLLIN)) {
+    auto received = ::recv(connectionFd_, data, size, 0);
+    if (received > 0) {
+      return received;
+    }
+    if (received < 0 && (errno == EINTR || errno == EAGAIN)) {
+      continue;
+    }
+    // 0 means the other side closed the connection, which it only does when
+    // it gives up on it.
+    XLOG(INFO) << "recv() failed: "
+               << (received == 0 ? "connection closed"
+                                 : folly::errnoStr(errno));
+    break;
+  }
+  return -1;
+}
+
+bool ResumableSocketPartyCommunicationAgent::writeAll(
+    const unsigned char* data,
+    size_t size) {
+  while (size > 0) {
+    auto written = writeSome(data, size);
+    if (written < 0) {
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool ResumableSocketPartyCommunicationAgent::readAll(
+    unsigned char* data,
+    size_t size) {
+  while (size > 0) {
+    auto received = readSome(data, size);
+    if (received < 0) {
+      return false;
+    }
+    data += received;
+    size -= received;
+  }
+  return true;
+}
+
+} // namespace fbpcf::engine::communication
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+
+namespace fbpcf::engine::communication {
+
+/**
+ * This object connects two parties via a plain socket, like
+ * SocketPartyCommunicationAgent, but survives transient connection failures.
+ * Both sides count the bytes they sent and received; these stream offsets
+ * act as sequence numbers. The last bytes sent are kept in a bounded replay
+ * buffer. When the connection breaks, the client reconnects to the server's
+ * port (which the server keeps listening on), both sides exchange how much
+ * they have sent and received, and whatever the peer missed is replayed from
+ * the buffer. The server replays first while the client reads the replayed
+ * data into a pending buffer, then they swap, so the replays never wait on
+ * each other however large they are. Nothing is lost or duplicated, and
+ * callers don't notice.
+ *
+ * The socket buffers are capped so that the data in flight always fits in
+ * the replay buffer.
+ */
+class ResumableSocketPartyCommunicationAgent final
+    : public IPartyCommunicationAgent {
+ public:
+  static const size_t kDefaultReplayBufferSize = 1 << 26;
+  static const int kDefaultReconnectTimeoutInSeconds = 300;
+
+  /**
+   * Create as socket server. The listening socket stays open to accept
+   * reconnections.
+   */
+  ResumableSocketPartyCommunicationAgent(
+      int sockFd,
+      int portNo,
+      std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+      size_t replayBufferSize = kDefaultReplayBufferSize,
+      int reconnectTimeoutInSeconds = kDefaultReconnectTimeoutInSeconds);
+
+  /**
+   * Create as socket client.
+   */
+  ResumableSocketPartyCommunicationAgent(
+      const std::string& serverAddress,
+      int portNo,
+      std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+      size_t replayBufferSize = kDefaultReplayBufferSize,
+      int reconnectTimeoutInSeconds = kDefaultReconnectTimeoutInSeconds);
+
+  ~ResumableSocketPartyCommunicationAgent() override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return recorder_->getTrafficStatistics();
+  }
+
+  void recvImpl(void* data, int nBytes) override;
+
+  void sendImpl(const void* data, int nBytes) override;
+
+  /**
+   * @return how many times the connection was re-established.
+   */
+  uint64_t getResumeCount() const {
+    return resumeCount_;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Establish a new connection, giving up at the deadline.
+   * @return whether a connection was established.
+   */
+  bool connect(Clock::time_point deadline);
+
+  void closeConnection();
+
+  /**
+   * Re-establish the connection and replay what the peer missed. Throws if
+   * that isn't possible before the reconnect timeout.
+   */
+  void resume();
+
+  /**
+   * Send/receive some bytes on the current connection.
+   * @return the number of bytes transferred, or -1 if the connection failed.
+   */
+  ssize_t writeSome(const unsigned char* data, size_t size);
+  ssize_t readSome(unsigned char* data, size_t size);
+
+  /**
+   * Send/receive all the bytes on the current connection, without trying to
+   * resume. Used during the resume handshake.
+   * @return false if the connection failed.
+   */
+  bool writeAll(const unsigned char* data, size_t size);
+  bool readAll(unsigned char* data, size_t size);
+
+  /**
+   * Replay what the peer missed, from the given stream offset on.
+   * @return false if the connection failed.
+   */
+  bool replay(uint64_t peerReceivedBytes);
+
+  /**
+   * Receive the peer's replay into the pending buffer, up to the given
+   * stream offset.
+   * @return false if the connection failed.
+   */
+  bool drainReplay(uint64_t peerSentBytes);
+
+  /**
+   * Wait until the connection is ready for the given poll event.
+   * @return false if the connection should be considered broken.
+   */
+  bool waitForConnection(short event);
+
+  void recordSentData(const unsigned char* data, size_t size);
+
+  bool isServer_;
+  int listeningFd_;
+  std::string serverAddress_;
+  int portNo_;
+  int connectionFd_;
+  std::chrono::seconds reconnectTimeout_;
+
+  // stream offsets, in bytes.
+  uint64_t sentBytes_;
+  uint64_t receivedBytes_;
+
+  // the last bytes sent; the byte at offset i is at i % size.
+  std::vector<unsigned char> replayBuffer_;
+
+  // bytes received during a resume that the caller hasn't read yet, from
+  // pendingReadPosition_ on. They count in receivedBytes_.
+  std::vector<unsigned char> pendingData_;
+  size_t pendingReadPosition_;
+
+  uint64_t resumeCount_;
+
+  std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder_;
+};
+
+} // namespace fbpcf::engine::communication
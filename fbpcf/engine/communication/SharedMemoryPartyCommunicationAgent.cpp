@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/communication/SharedMemoryPartyCommunicationAgent.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include "folly/logging/xlog.h"
+
+namespace fbpcf::engine::communication {
+
+struct SharedMemoryPartyCommunicationAgent::SegmentHeader {
+  alignas(64) std::atomic<uint64_t> magic;
+  std::atomic<uint32_t> attached;
+  std::atomic<uint32_t> acknowledged;
+  uint64_t ringCapacity;
+};
+
+namespace {
+
+const uint64_t kSegmentMagic = 0x6662706366736d32; // "fbpcfsm2"
+
+const size_t kSegmentHeaderSize = 64;
+
+size_t getRingMemorySize(size_t ringCapacity) {
+  return (SpscRingBuffer::getRequiredMemorySize(ringCapacity) + 63) &
+      ~static_cast<size_t>(63);
+}
+
+// Layout: header | ring written by the creator | ring written by the opener.
+size_t getSegmentSize(size_t ringCapacity) {
+  return kSegmentHeaderSize + 2 * getRingMemorySize(ringCapacity);
+}
+
+// whether path currently names the file with the given inode.
+bool isSameFile(const std::string& path, const struct stat& fileStat) {
+  struct stat pathStat;
+  return stat(path.c_str(), &pathStat) == 0 &&
+      pathStat.st_dev == fileStat.st_dev && pathStat.st_ino == fileStat.st_ino;
+}
+
+} // namespace
+
+SharedMemoryPartyCommunicationAgent::SharedMemoryPartyCommunicationAgent(
+    const std::string& path,
+    bool isCreator,
+    size_t ringCapacity,
+    std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+    int connectTimeoutInSeconds)
+    : segment_(nullptr), segmentSize_(0), recorder_(recorder) {
+  static_assert(
+      sizeof(SegmentHeader) <= kSegmentHeaderSize,
+      "Segment header doesn't fit into its slot.");
+  auto deadline = Clock::now() + std::chrono::seconds(connectTimeoutInSeconds);
+  if (isCreator) {
+    createSegment(path, ringCapacity, deadline);
+  } else {
+    openSegment(path, deadline);
+  }
+  attachRings(isCreator);
+}
+
+SharedMemoryPartyCommunicationAgent::~SharedMemoryPartyCommunicationAgent() {
+  // let a peer blocked in recvImpl fail instead of waiting forever.
+  outgoingRing_->seal();
+  munmap(segment_, segmentSize_);
+}
+
+void SharedMemoryPartyCommunicationAgent::sendImpl(
+    const void* data,
+    int nBytes) {
+  outgoingRing_->write(data, nBytes);
+  recorder_->addSentData(nBytes);
+}
+
+void SharedMemoryPartyCommunicationAgent::recvImpl(void* data, int nBytes) {
+  incomingRing_->read(data, nBytes);
+  recorder_->addReceivedData(nBytes);
+}
+
+void SharedMemoryPartyCommunicationAgent::createSegment(
+    const std::string& path,
+    size_t ringCapacity,
+    Clock::time_point deadline) {
+  XLOG(INFO) << "try to create shared memory segment " << path;
+
+  // The segment is built under a name of its own and renamed into place once
+  // initialized, so the peer never sees a partial segment, and a leftover
+  // from an earlier run is replaced in one step.
+  auto tmpPath = path + ".tmp_" + std::to_string(getpid()) + "_" +
+      std::to_string(folly::Random::rand64());
+  auto fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    XLOG(INFO) << folly::errnoStr(errno);
+    throw std::runtime_error("error on creating shared memory file " + tmpPath);
+  }
+  struct stat fileStat;
+  auto segmentSize = getSegmentSize(ringCapacity);
+  if (fstat(fd, &fileStat) != 0 || ftruncate(fd, segmentSize) != 0) {
+    XLOG(INFO) << folly::errnoStr(errno);
+    close(fd);
+    unlink(tmpPath.c_str());
+    throw std::runtime_error("error on resizing shared memory file " + tmpPath);
+  }
+  auto memory =
+      mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    XLOG(INFO) << folly::errnoStr(errno);
+    unlink(tmpPath.c_str());
+    throw std::runtime_error("error on mapping shared memory file " + tmpPath);
+  }
+  segment_ = memory;
+  segmentSize_ = segmentSize;
+
+  auto header = new (segment_) SegmentHeader();
+  header->attached.store(0);
+  header->acknowledged.store(0);
+  header->ringCapacity = ringCapacity;
+  auto rings = static_cast<unsigned char*>(segment_) + kSegmentHeaderSize;
+  SpscRingBuffer::initialize(rings, ringCapacity);
+  SpscRingBuffer::initialize(
+      rings + getRingMemorySize(ringCapacity), ringCapacity);
+  header->magic.store(kSegmentMagic, std::memory_order_release);
+
+  if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+    XLOG(INFO) << folly::errnoStr(errno);
+    unlink(tmpPath.c_str());
+    munmap(segment_, segmentSize_);
+    throw std::runtime_error("error on publishing shared memory file " + path);
+  }
+
+  while (header->attached.load(std::memory_order_acquire) == 0) {
+    if (Clock::now() > deadline) {
+      // take the file down unless a newer creator has replaced it already.
+      if (isSameFile(path, fileStat)) {
+        unlink(path.c_str());
+      }
+      munmap(segment_, segmentSize_);
+      throw std::runtime_error(
+          "Timed out waiting for the peer on shared memory file " + path);
+    }
+    usleep(1000);
+  }
+  // tell the peer that it attached to a live segment.
+  header->acknowledged.store(1, std::memory_order_release);
+  // both parties have mapped the segment, the name is no longer needed.
+  unlink(path.c_str());
+
+  XLOG(INFO) << "connected through shared memory segment " << path;
+}
+
+void SharedMemoryPartyCommunicationAgent::openSegment(
+    const std::string& path,
+    Clock::time_point deadline) {
+  XLOG(INFO) << "try to open shared memory segment " << path;
+
+  while (true) {
+    if (Clock::now() > deadline) {
+      throw std::runtime_error(
+          "Timed out waiting for the peer on shared memory file " + path);
+    }
+    auto fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+      // the creator hasn't created the file yet.
+      usleep(1000);
+      continue;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 ||
+        static_cast<size_t>(fileStat.st_size) < kSegmentHeaderSize) {
+      close(fd);
+      usleep(1000);
+      continue;
+    }
+    size_t segmentSize = fileStat.st_size;
+    auto memory =
+        mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+      XLOG(INFO) << folly::errnoStr(errno);
+      throw std::runtime_error("error on mapping shared memory file " + path);
+    }
+
+    // Only take a segment that nobody attached to yet, then wait for its
+    // creator to acknowledge. A file left by a crashed run never gets the
+    // acknowledgement; it is given up on once a new creator renames its own
+    // segment over it.
+    auto header = static_cast<SegmentHeader*>(memory);
+    uint32_t notAttached = 0;
+    if (header->magic.load(std::memory_order_acquire) == kSegmentMagic &&
+        getSegmentSize(header->ringCapacity) == segmentSize &&
+        header->attached.compare_exchange_strong(notAttached, 1)) {
+      while (Clock::now() <= deadline) {
+        // the creator acknowledges before it unlinks the file, so a file that
+        // is gone or replaced is stale only if there is no acknowledgement
+        // after seeing that.
+        bool isReplaced = !isSameFile(path, fileStat);
+        if (header->acknowledged.load(std::memory_order_acquire) == 1) {
+          segment_ = memory;
+          segmentSize_ = segmentSize;
+          XLOG(INFO) << "connected through shared memory segment " << path;
+          return;
+        }
+        if (isReplaced) {
+          XLOG(INFO) << "dropping stale shared memory segment " << path;
+          break;
+        }
+        usleep(1000);
+      }
+    }
+    munmap(memory, segmentSize);
+    usleep(1000);
+  }
+}
+
+void SharedMemoryPartyCommunicationAgent::attachRings(bool isCreator) {
+  auto header = static_cast<SegmentHeader*>(segment_);
+  auto rings = static_cast<unsigned char*>(segment_) + kSegmentHeaderSize;
+  auto creatorRing = std::make_unique<SpscRingBuffer>(rings, true);
+  auto openerRing = std::make_unique<SpscRingBuffer>(
+      rings + getRingMemorySize(header->ringCapacity), true);
+  if (isCreator) {
+    outgoingRing_ = std::move(creatorRing);
+    incomingRing_ = std::move(openerRing);
+  } else {
+    outgoingRing_ = std::move(openerRing);
+    incomingRing_ = std::move(creatorRing);
+  }
+}
+
+} // namespace fbpcf::engine::communication
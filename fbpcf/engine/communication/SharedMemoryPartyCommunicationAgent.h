@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/communication/SpscRingBuffer.h"
+
+namespace fbpcf::engine::communication {
+
+/**
+ * This object connects two parties running on the same host, possibly in
+ * different processes or containers, through a memory mapped file (e.g. on
+ * /dev/shm or any other tmpfs both parties can see). The file holds one
+ * single-producer/single-consumer ring per direction, so no data goes through
+ * the network stack. Like the socket agent, a sender blocks once the peer
+ * stops draining its ring.
+ */
+class SharedMemoryPartyCommunicationAgent final
+    : public IPartyCommunicationAgent {
+ public:
+  static const size_t kDefaultRingCapacity = 1 << 24;
+  static const int kDefaultConnectTimeoutInSeconds = 300;
+
+  /**
+   * @param path the file backing the shared memory. It is created by the
+   * party that passes isCreator = true and opened by the other one. The file
+   * is unlinked as soon as both parties have mapped it.
+   * @param isCreator whether this party creates the file.
+   * @param ringCapacity the size of each ring, must be a power of 2. Only
+   * the creator's value is used.
+   * @param connectTimeoutInSeconds how long to wait for the peer before
+   * throwing.
+   */
+  SharedMemoryPartyCommunicationAgent(
+      const std::string& path,
+      bool isCreator,
+      size_t ringCapacity,
+      std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+      int connectTimeoutInSeconds = kDefaultConnectTimeoutInSeconds);
+
+  ~SharedMemoryPartyCommunicationAgent() override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return recorder_->getTrafficStatistics();
+  }
+
+  void recvImpl(void* data, int nBytes) override;
+
+  void sendImpl(const void* data, int nBytes) override;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct SegmentHeader;
+
+  void createSegment(
+      const std::string& path,
+      size_t ringCapacity,
+      Clock::time_point deadline);
+  void openSegment(const std::string& path, Clock::time_point deadline);
+  void attachRings(bool isCreator);
+
+  void* segment_;
+  size_t segmentSize_;
+
+  std::unique_ptr<SpscRingBuffer> outgoingRing_;
+  std::unique_ptr<SpscRingBuffer> incomingRing_;
+
+  std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder_;
+};
+
+} // namespace fbpcf::engine::communication
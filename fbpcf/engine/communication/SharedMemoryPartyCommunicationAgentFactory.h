@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/SharedMemoryPartyCommunicationAgent.h"
+
+namespace fbpcf::engine::communication {
+
+/**
+ * A communication factory for parties running on the same host. Parties may
+ * live in different processes or containers as long as they all see the same
+ * shared directory (e.g. /dev/shm or a shared tmpfs mount).
+ */
+class SharedMemoryPartyCommunicationAgentFactory final
+    : public IPartyCommunicationAgentFactory {
+ public:
+  /**
+   * @param sharedDirectory the directory holding the shared memory files,
+   * it should be backed by tmpfs.
+   * @param sessionName a name that all parties of one computation agree on.
+   * It must differ across computations running concurrently on the same host.
+   * @param ringCapacity the size of the ring in each direction of each agent,
+   * must be a power of 2.
+   */
+  SharedMemoryPartyCommunicationAgentFactory(
+      int myId,
+      std::string sharedDirectory,
+      std::string sessionName,
+      std::string myname,
+      size_t ringCapacity =
+          SharedMemoryPartyCommunicationAgent::kDefaultRingCapacity)
+      : IPartyCommunicationAgentFactory(myname),
+        myId_(myId),
+        sharedDirectory_(sharedDirectory),
+        sessionName_(sessionName),
+        ringCapacity_(ringCapacity) {}
+
+  /**
+   * @inherit doc
+   */
+  std::unique_ptr<IPartyCommunicationAgent> create(int id, std::string name)
+      override {
+    if (id == myId_) {
+      throw std::runtime_error("No need to talk to myself!");
+    }
+    // both parties create their agents in the same order, so the n-th agent
+    // on either side maps the same file.
+    int index = createdAgentCount_[id]++;
+    auto path = sharedDirectory_ + "/" + sessionName_ + "_" +
+        std::to_string(std::min(myId_, id)) + "_" +
+        std::to_string(std::max(myId_, id)) + "_" + std::to_string(index);
+
+    auto recorder = std::make_shared<PartyCommunicationAgentTrafficRecorder>();
+    metricCollector_->addNewRecorder(name, recorder);
+    return std::make_unique<SharedMemoryPartyCommunicationAgent>(
+        path, myId_ < id, ringCapacity_, recorder);
+  }
+
+ private:
+  int myId_;
+  std::string sharedDirectory_;
+  std::string sessionName_;
+  size_t ringCapacity_;
+  std::map<int, int> createdAgentCount_;
+};
+
+} // namespace fbpcf::engine::communication
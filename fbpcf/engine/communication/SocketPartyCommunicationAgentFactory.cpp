@@ -25,20 +25,50 @@ SocketPartyCommunicationAgentFactory::create(int id, std::string name) {
     auto recorder = std::make_shared<PartyCommunicationAgentTrafficRecorder>();
     metricCollector_->addNewRecorder(name, recorder);
 
-    if (id > myId_) {
-      // We first try to bind on the assigned port number (and its nexts). If
-      // that failed, we will try to bind to a free port instead. In either
-      // case, we will tell the client which port to use.
-      auto assignedPortNo = ++iter->second.first.portNo;
-      auto [socket, portNo] = createSocketFromMaybeFreePort(assignedPortNo);
-      iter->second.second->sendSingleT<int>(portNo);
-      return std::make_unique<SocketPartyCommunicationAgent>(
-          socket, portNo, useTls_, tlsDir_, recorder);
-    } else {
-      auto portNo = iter->second.second->receiveSingleT<int>();
-      return std::make_unique<SocketPartyCommunicationAgent>(
-          iter->second.first.address, portNo, useTls_, tlsDir_, recorder);
+    // the striped agent records the payload itself, its lanes report to a
+    // private recorder so that the frame headers don't count.
+    auto laneRecorder = numberOfStripes_ == 1
+        ? recorder
+        : std::make_shared<PartyCommunicationAgentTrafficRecorder>();
+    std::vector<std::unique_ptr<IPartyCommunicationAgent>> lanes;
+    for (int i = 0; i < numberOfStripes_; i++) {
+      if (id > myId_) {
+        // We first try to bind on the assigned port number (and its nexts).
+        // If that failed, we will try to bind to a free port instead. In
+        // either case, we will tell the client which port to use.
+        auto assignedPortNo = ++iter->second.first.portNo;
+        auto [socket, portNo] =
+            createSocketFromMaybeFreePort(assignedPortNo);
+        iter->second.second->sendSingleT<int>(portNo);
+        if (resumable_) {
+          lanes.push_back(
+              std::make_unique<ResumableSocketPartyCommunicationAgent>(
+                  socket, portNo, laneRecorder));
+        } else {
+          lanes.push_back(std::make_unique<SocketPartyCommunicationAgent>(
+              socket, portNo, useTls_, tlsDir_, laneRecorder));
+        }
+      } else {
+        auto portNo = iter->second.second->receiveSingleT<int>();
+        if (resumable_) {
+          lanes.push_back(
+              std::make_unique<ResumableSocketPartyCommunicationAgent>(
+                  iter->second.first.address, portNo, laneRecorder));
+        } else {
+          lanes.push_back(std::make_unique<SocketPartyCommunicationAgent>(
+              iter->second.first.address,
+              portNo,
+              useTls_,
+              tlsDir_,
+              laneRecorder));
+        }
+      }
     }
+    if (numberOfStripes_ == 1) {
+      return std::move(lanes.at(0));
+    }
+    return std::make_unique<StripedPartyCommunicationAgent>(
+        std::move(lanes), recorder);
   }
 }
 
@@ -20,7 +20,9 @@
 
 #include <fbpcf/util/MetricCollector.h>
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/ResumableSocketPartyCommunicationAgent.h"
 #include "fbpcf/engine/communication/SocketPartyCommunicationAgent.h"
+#include "fbpcf/engine/communication/StripedPartyCommunicationAgent.h"
 
 namespace fbpcf::engine::communication {
 
@@ -42,6 +44,16 @@ class SocketPartyCommunicationAgentFactory final
     std::string passphrasePath;
   };
 
+  struct ConnectionOptions {
+    // the number of parallel connections behind each agent. Large messages
+    // are split across all of them, which helps when a single TCP flow can't
+    // saturate the link.
+    int numberOfStripes;
+    // whether the agents survive transient connection failures, see
+    // ResumableSocketPartyCommunicationAgent.
+    bool resumable;
+  };
+
   /** it's OK if a party with a smaller id doesn't know a party with larger id's
   * ip address, since the party with smaller id will always be the server.
   *@param partyInfos This is a map that contains connection information for all
@@ -59,7 +71,9 @@ establishing multiple connections (>3) between each party pair.
       : IPartyCommunicationAgentFactory(myname),
         myId_(myId),
         useTls_(false),
-        tlsDir_("") {
+        tlsDir_(""),
+        numberOfStripes_(1),
+        resumable_(false) {
     setupInitialConnection(partyInfos);
   }
 
@@ -72,18 +86,38 @@ establishing multiple connections (>3) between each party pair.
       : IPartyCommunicationAgentFactory(myname),
         myId_(myId),
         useTls_(useTls),
-        tlsDir_(tlsDir) {
+        tlsDir_(tlsDir),
+        numberOfStripes_(1),
+        resumable_(false) {
     setupInitialConnection(partyInfos);
   }
 
+  /**
+   * The socket agents don't take the certificate paths of tlsInfo yet, so it
+   * fails if tlsInfo asks for TLS rather than connecting in plaintext.
+   * @param connectionOptions how the connections behind each agent created
+   * are set up, both parties must use the same options.
+   */
   SocketPartyCommunicationAgentFactory(
       int myId,
       std::map<int, PartyInfo> partyInfos,
       TlsInfo tlsInfo,
-      std::string myname)
+      std::string myname,
+      ConnectionOptions connectionOptions = {1, false})
       : IPartyCommunicationAgentFactory(myname),
         myId_(myId),
+        useTls_(false),
+        tlsDir_(""),
+        numberOfStripes_(connectionOptions.numberOfStripes),
+        resumable_(connectionOptions.resumable),
         tlsInfo_(tlsInfo) {
+    if (tlsInfo_.useTls) {
+      throw std::invalid_argument(
+          "TLS is only supported through the tlsDir constructor.");
+    }
+    if (numberOfStripes_ < 1) {
+      throw std::invalid_argument("Need at least one stripe.");
+    }
     setupInitialConnection(partyInfos);
   }
 
@@ -117,6 +151,9 @@ establishing multiple connections (>3) between each party pair.
   bool useTls_;
   std::string tlsDir_;
 
+  int numberOfStripes_;
+  bool resumable_;
+
   TlsInfo tlsInfo_;
 };
 
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/communication/SpscRingBuffer.h"
+
+#include <emmintrin.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace fbpcf::engine::communication {
+
+namespace {
+
+const size_t kControlBlockSize =
+    (sizeof(SpscRingBuffer::ControlBlock) + 63) & ~static_cast<size_t>(63);
+
+// A sleeping side re-checks its condition at least this often. Wake-ups
+// can't be lost (the futex compares the sequence word), the timeout only
+// bounds the cost of a bug or of a peer process that died.
+const long kFutexTimeoutNanoseconds = 100000000;
+
+void futexWait(
+    std::atomic<uint32_t>& word,
+    uint32_t expected,
+    bool processShared) {
+  struct timespec timeout = {0, kFutexTimeoutNanoseconds};
+  syscall(
+      SYS_futex,
+      reinterpret_cast<uint32_t*>(&word),
+      processShared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE,
+      expected,
+      &timeout,
+      nullptr,
+      0);
+}
+
+void futexWake(std::atomic<uint32_t>& word, bool processShared) {
+  syscall(
+      SYS_futex,
+      reinterpret_cast<uint32_t*>(&word),
+      processShared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE,
+      1,
+      nullptr,
+      nullptr,
+      0);
+}
+
+} // namespace
+
+size_t SpscRingBuffer::getRequiredMemorySize(size_t capacity) {
+  return kControlBlockSize + capacity;
+}
+
+void SpscRingBuffer::initialize(void* memory, size_t capacity) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    throw std::invalid_argument("Ring capacity must be a power of 2.");
+  }
+  auto control = new (memory) ControlBlock();
+  control->writeIndex.store(0);
+  control->writeSequence.store(0);
+  control->readerWaiting.store(0);
+  control->sealed.store(0);
+  control->readIndex.store(0);
+  control->readSequence.store(0);
+  control->writerWaiting.store(0);
+  control->capacity = capacity;
+}
+
+SpscRingBuffer::SpscRingBuffer(
+    void* memory,
+    bool processShared,
+    uint32_t spinCount)
+    : control_(static_cast<ControlBlock*>(memory)),
+      data_(static_cast<unsigned char*>(memory) + kControlBlockSize),
+      capacity_(control_->capacity),
+      mask_(capacity_ - 1),
+      processShared_(processShared),
+      spinCount_(spinCount) {}
+
+size_t SpscRingBuffer::tryWrite(const void* data, size_t size) {
+  auto writeIndex = control_->writeIndex.load(std::memory_order_relaxed);
+  auto readIndex = control_->readIndex.load(std::memory_order_acquire);
+  auto writeSize = std::min(size, capacity_ - (writeIndex - readIndex));
+  if (writeSize == 0) {
+    return 0;
+  }
+  auto offset = writeIndex & mask_;
+  auto firstPart = std::min(writeSize, capacity_ - offset);
+  memcpy(data_ + offset, data, firstPart);
+  memcpy(
+      data_,
+      static_cast<const unsigned char*>(data) + firstPart,
+      writeSize - firstPart);
+  control_->writeIndex.store(
+      writeIndex + writeSize, std::memory_order_release);
+  notify(control_->writeSequence, control_->readerWaiting);
+  return writeSize;
+}
+
+size_t SpscRingBuffer::tryRead(void* data, size_t size) {
+  auto readIndex = control_->readIndex.load(std::memory_order_relaxed);
+  auto writeIndex = control_->writeIndex.load(std::memory_order_acquire);
+  auto readSize = std::min(size, static_cast<size_t>(writeIndex - readIndex));
+  if (readSize == 0) {
+    return 0;
+  }
+  auto offset = readIndex & mask_;
+  auto firstPart = std::min(readSize, capacity_ - offset);
+  memcpy(data, data_ + offset, firstPart);
+  memcpy(
+      static_cast<unsigned char*>(data) + firstPart,
+      data_,
+      readSize - firstPart);
+  control_->readIndex.store(readIndex + readSize, std::memory_order_release);
+  notify(control_->readSequence, control_->writerWaiting);
+  return readSize;
+}
+
+void SpscRingBuffer::write(const void* data, size_t size) {
+  auto src = static_cast<const unsigned char*>(data);
+  while (size > 0) {
+    auto written = tryWrite(src, size);
+    if (written == 0) {
+      waitFor(control_->readSequence, control_->writerWaiting, [this]() {
+        return control_->writeIndex.load(std::memory_order_relaxed) -
+            control_->readIndex.load(std::memory_order_acquire) <
+            capacity_;
+      });
+    }
+    src += written;
+    size -= written;
+  }
+}
+
+void SpscRingBuffer::read(void* data, size_t size) {
+  auto dst = static_cast<unsigned char*>(data);
+  while (size > 0) {
+    auto received = readSome(dst, size);
+    if (received == 0) {
+      throw std::runtime_error("The ring was sealed by the producer.");
+    }
+    dst += received;
+    size -= received;
+  }
+}
+
+size_t SpscRingBuffer::readSome(void* data, size_t size) {
+  auto received = tryRead(data, size);
+  if (received > 0 || size == 0) {
+    return received;
+  }
+  waitFor(control_->writeSequence, control_->readerWaiting, [this]() {
+    return control_->writeIndex.load(std::memory_order_acquire) !=
+        control_->readIndex.load(std::memory_order_relaxed) ||
+        isSealed();
+  });
+  // data written before sealing is still delivered.
+  return tryRead(data, size);
+}
+
+void SpscRingBuffer::seal() {
+  control_->sealed.store(1, std::memory_order_release);
+  notify(control_->writeSequence, control_->readerWaiting);
+}
+
+template <typename Predicate>
+void SpscRingBuffer::waitFor(
+    std::atomic<uint32_t>& sequence,
+    std::atomic<uint32_t>& waiting,
+    Predicate&& ready) const {
+  for (uint32_t i = 0; i < spinCount_; i++) {
+    if (ready()) {
+      return;
+    }
+    _mm_pause();
+  }
+  while (!ready()) {
+    // Reading the sequence before re-checking the condition guarantees that
+    // any progress made after the check changes the futex word, so the wait
+    // below returns immediately instead of missing the wake-up.
+    auto expected = sequence.load();
+    waiting.store(1);
+    if (ready()) {
+      break;
+    }
+    futexWait(sequence, expected, processShared_);
+  }
+  waiting.store(0);
+}
+
+void SpscRingBuffer::notify(
+    std::atomic<uint32_t>& sequence,
+    std::atomic<uint32_t>& waiting) const {
+  sequence.fetch_add(1);
+  if (waiting.load()) {
+    futexWake(sequence, processShared_);
+  }
+}
+
+} // namespace fbpcf::engine::communication
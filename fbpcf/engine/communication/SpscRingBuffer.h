@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace fbpcf::engine::communication {
+
+/**
+ * A lock-free single-producer/single-consumer byte ring. The ring doesn't own
+ * its memory: the control block and the data area live in a region provided
+ * by the caller, so the same ring can sit on the heap or in a file mapped by
+ * two processes. A blocked reader/writer spins for a while and then sleeps on
+ * a futex until the other side makes progress.
+ */
+class SpscRingBuffer {
+ public:
+  static const uint32_t kDefaultSpinCount = 4096;
+
+  /**
+   * The control block stored at the beginning of the memory region. Fields
+   * updated by the producer and by the consumer live on separate cache lines.
+   */
+  struct ControlBlock {
+    alignas(64) std::atomic<uint64_t> writeIndex;
+    std::atomic<uint32_t> writeSequence;
+    std::atomic<uint32_t> readerWaiting;
+    std::atomic<uint32_t> sealed;
+
+    alignas(64) std::atomic<uint64_t> readIndex;
+    std::atomic<uint32_t> readSequence;
+    std::atomic<uint32_t> writerWaiting;
+
+    alignas(64) uint64_t capacity;
+  };
+
+  /**
+   * @return the size of the memory region needed by a ring of this capacity.
+   */
+  static size_t getRequiredMemorySize(size_t capacity);
+
+  /**
+   * Set up an empty ring in a fresh memory region. This must happen exactly
+   * once, before any side attaches to the region.
+   * @param capacity the number of bytes the ring can hold, must be a power of 2
+   */
+  static void initialize(void* memory, size_t capacity);
+
+  /**
+   * Attach to a ring that was set up with initialize().
+   * @param processShared whether the region is mapped by more than one
+   * process, this decides which futex flavor is used.
+   * @param spinCount how many times to poll before sleeping on the futex.
+   */
+  SpscRingBuffer(
+      void* memory,
+      bool processShared,
+      uint32_t spinCount = kDefaultSpinCount);
+
+  /**
+   * Copy as many bytes as currently fit into the ring without blocking.
+   * @return the number of bytes written.
+   */
+  size_t tryWrite(const void* data, size_t size);
+
+  /**
+   * Copy as many bytes as are currently available out of the ring without
+   * blocking.
+   * @return the number of bytes read.
+   */
+  size_t tryRead(void* data, size_t size);
+
+  /**
+   * Write all the bytes, waiting for the consumer to free space when needed.
+   */
+  void write(const void* data, size_t size);
+
+  /**
+   * Read exactly size bytes, waiting for the producer when needed.
+   * Throws if the ring is sealed before enough data arrived.
+   */
+  void read(void* data, size_t size);
+
+  /**
+   * Wait until the ring is not empty and read up to size bytes.
+   * @return the number of bytes read. 0 means the ring is sealed and drained.
+   */
+  size_t readSome(void* data, size_t size);
+
+  /**
+   * Tell the consumer that nothing will be written into this ring anymore.
+   */
+  void seal();
+
+  bool isSealed() const {
+    return control_->sealed.load(std::memory_order_acquire) != 0;
+  }
+
+  size_t getCapacity() const {
+    return capacity_;
+  }
+
+ private:
+  template <typename Predicate>
+  void waitFor(
+      std::atomic<uint32_t>& sequence,
+      std::atomic<uint32_t>& waiting,
+      Predicate&& ready) const;
+
+  void notify(std::atomic<uint32_t>& sequence, std::atomic<uint32_t>& waiting)
+      const;
+
+  ControlBlock* control_;
+  unsigned char* data_;
+  size_t capacity_;
+  size_t mask_;
+  bool processShared_;
+  uint32_t spinCount_;
+};
+
+} // namespace fbpcf::engine::communication
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/communication/StripedPartyCommunicationAgent.h"
+
+#include <string.h>
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+namespace fbpcf::engine::communication {
+
+StripedPartyCommunicationAgent::StripedPartyCommunicationAgent(
+    std::vector<std::unique_ptr<IPartyCommunicationAgent>>&& lanes,
+    std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+    int minStripedMessageSize)
+    : lanes_(std::move(lanes)),
+      recorder_(recorder),
+      minStripedMessageSize_(minStripedMessageSize),
+      pendingOffset_(0) {
+  if (lanes_.empty()) {
+    throw std::invalid_argument("Need at least one lane.");
+  }
+}
+
+void StripedPartyCommunicationAgent::sendImpl(const void* data, int nBytes) {
+  auto src = static_cast<const unsigned char*>(data);
+  FrameHeader header{
+      static_cast<uint32_t>(nBytes),
+      lanes_.size() > 1 && nBytes >= minStripedMessageSize_};
+
+  recorder_->addSentData(nBytes);
+
+  if (!header.isStriped && nBytes <= kMaxCoalescedMessageSize) {
+    // one write for header and payload.
+    sendBuffer_.resize(sizeof(FrameHeader) + nBytes);
+    memcpy(sendBuffer_.data(), &header, sizeof(FrameHeader));
+    memcpy(sendBuffer_.data() + sizeof(FrameHeader), src, nBytes);
+    lanes_.at(0)->sendImpl(sendBuffer_.data(), sendBuffer_.size());
+    return;
+  }
+
+  lanes_.at(0)->sendImpl(&header, sizeof(FrameHeader));
+  if (!header.isStriped) {
+    lanes_.at(0)->sendImpl(src, nBytes);
+    return;
+  }
+  forEachStripe(nBytes, [this, src](size_t lane, size_t offset, size_t size) {
+    lanes_.at(lane)->sendImpl(src + offset, size);
+  });
+}
+
+void StripedPartyCommunicationAgent::recvImpl(void* data, int nBytes) {
+  recorder_->addReceivedData(nBytes);
+  auto dst = static_cast<unsigned char*>(data);
+  size_t remaining = nBytes;
+  while (remaining > 0) {
+    if (pendingOffset_ < pendingData_.size()) {
+      auto size = std::min(remaining, pendingData_.size() - pendingOffset_);
+      memcpy(dst, pendingData_.data() + pendingOffset_, size);
+      pendingOffset_ += size;
+      dst += size;
+      remaining -= size;
+      continue;
+    }
+
+    FrameHeader header;
+    lanes_.at(0)->recvImpl(&header, sizeof(FrameHeader));
+    if (header.size <= remaining) {
+      // the whole message is wanted, receive it in place.
+      receiveMessage(header, dst);
+      dst += header.size;
+      remaining -= header.size;
+    } else {
+      pendingData_.resize(header.size);
+      pendingOffset_ = 0;
+      receiveMessage(header, pendingData_.data());
+    }
+  }
+}
+
+void StripedPartyCommunicationAgent::receiveMessage(
+    const FrameHeader& header,
+    unsigned char* data) {
+  if (!header.isStriped) {
+    lanes_.at(0)->recvImpl(data, header.size);
+    return;
+  }
+  forEachStripe(
+      header.size, [this, data](size_t lane, size_t offset, size_t size) {
+        lanes_.at(lane)->recvImpl(data + offset, size);
+      });
+}
+
+void StripedPartyCommunicationAgent::forEachStripe(
+    int nBytes,
+    const std::function<void(size_t, size_t, size_t)>& f) {
+  auto stripeSize = (nBytes + lanes_.size() - 1) / lanes_.size();
+  auto getStripe = [stripeSize, nBytes](size_t lane) {
+    auto offset = std::min<size_t>(lane * stripeSize, nBytes);
+    auto size = std::min<size_t>(stripeSize, nBytes - offset);
+    return std::make_pair(offset, size);
+  };
+
+  std::vector<std::future<void>> stripes;
+  for (size_t lane = 1; lane < lanes_.size(); lane++) {
+    auto [offset, size] = getStripe(lane);
+    if (size > 0) {
+      stripes.push_back(std::async(
+          std::launch::async, [&f, lane, offset = offset, size = size]() {
+            f(lane, offset, size);
+          }));
+    }
+  }
+  auto [offset, size] = getStripe(0);
+  f(0, offset, size);
+  for (auto& stripe : stripes) {
+    stripe.get();
+  }
+}
+
+} // namespace fbpcf::engine::communication
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+
+namespace fbpcf::engine::communication {
+
+/**
+ * This object spreads one logical channel over several connections ("lanes")
+ * to the same party. A single TCP flow is often limited by its congestion
+ * window long before the link is saturated; splitting large messages across
+ * parallel flows works around that. Each message is framed on the first
+ * lane: small messages travel there in one piece, large ones are cut into
+ * one contiguous stripe per lane, sent concurrently and reassembled in order
+ * by the receiver. Both parties must use the same number of lanes.
+ *
+ * The lanes shouldn't report to the recorder of this agent: it only records
+ * the payload, not the frame headers, like the other agents do.
+ */
+class StripedPartyCommunicationAgent final : public IPartyCommunicationAgent {
+ public:
+  static const int kDefaultMinStripedMessageSize = 1 << 20;
+  // messages up to this size are sent in one write with their header, larger
+  // ones aren't worth the copy.
+  static const int kMaxCoalescedMessageSize = 1 << 12;
+
+  /**
+   * @param lanes the connections to the other party, in the same order on
+   * both sides.
+   * @param recorder the recorder of the payload sent and received.
+   * @param minStripedMessageSize messages of at least this many bytes are
+   * striped, smaller ones go down the first lane.
+   */
+  StripedPartyCommunicationAgent(
+      std::vector<std::unique_ptr<IPartyCommunicationAgent>>&& lanes,
+      std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder,
+      int minStripedMessageSize = kDefaultMinStripedMessageSize);
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return recorder_->getTrafficStatistics();
+  }
+
+  void recvImpl(void* data, int nBytes) override;
+
+  void sendImpl(const void* data, int nBytes) override;
+
+ private:
+  struct FrameHeader {
+    uint32_t size;
+    uint32_t isStriped;
+  };
+
+  /**
+   * Run the function on every stripe of a message of the given size, one
+   * thread per lane.
+   * @param f takes the lane index, the offset and the size of the stripe.
+   */
+  void forEachStripe(
+      int nBytes,
+      const std::function<void(size_t, size_t, size_t)>& f);
+
+  void receiveMessage(const FrameHeader& header, unsigned char* data);
+
+  std::vector<std::unique_ptr<IPartyCommunicationAgent>> lanes_;
+  std::shared_ptr<PartyCommunicationAgentTrafficRecorder> recorder_;
+  int minStripedMessageSize_;
+
+  // reused to send a small message together with its header.
+  std::vector<unsigned char> sendBuffer_;
+
+  // the part of a received message the caller hasn't asked for yet.
+  std::vector<unsigned char> pendingData_;
+  size_t pendingOffset_;
+};
+
+} // namespace fbpcf::engine::communication
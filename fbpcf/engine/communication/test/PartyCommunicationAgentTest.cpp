@@ -8,6 +8,8 @@
 #include <emmintrin.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <poll.h>
+#include <chrono>
 #include <filesystem>
 #include <future>
 #include <memory>
@@ -17,9 +19,13 @@
 #include <thread>
 #include <vector>
 
+#include <folly/Random.h>
 #include <folly/dynamic.h>
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentHost.h"
+#include "fbpcf/engine/communication/NetworkEmulatingPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/ResumableSocketPartyCommunicationAgent.h"
+#include "fbpcf/engine/communication/SharedMemoryPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/SocketPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
 #include "fbpcf/engine/communication/test/SocketInTestHelper.h"
@@ -100,6 +106,236 @@ TEST(InMemoryPartyCommunicationAgentTest, testSendAndReceive) {
   thread0.join();
 }
 
+TEST(InMemoryPartyCommunicationAgentTest, testMessageLargerThanBuffer) {
+  // the messages outgrow the initial ring and are received with reads that
+  // don't line up with the message boundaries.
+  InMemoryPartyCommunicationAgentHost host(256);
+  auto agent0 = host.getAgent(0);
+  auto agent1 = host.getAgent(1);
+
+  int size = 100003;
+  std::vector<unsigned char> data(size);
+  for (int i = 0; i < size; i++) {
+    data[i] = folly::Random::rand32() & 0xFF;
+  }
+
+  // sending never blocks, even if nobody is receiving yet.
+  for (int t = 0; t < 3; t++) {
+    agent0->send(data);
+  }
+
+  auto receiverTask = std::async([&agent1, size]() {
+    std::vector<unsigned char> received;
+    int chunk = 777;
+    while (received.size() < 3 * size) {
+      auto readSize = std::min<int>(chunk, 3 * size - received.size());
+      auto part = agent1->receive(readSize);
+      received.insert(received.end(), part.begin(), part.end());
+    }
+    return received;
+  });
+  // keep writing into the chain while the receiver is draining it.
+  agent0->send(data);
+
+  auto received = receiverTask.get();
+  for (int t = 0; t < 3; t++) {
+    EXPECT_EQ(
+        std::vector<unsigned char>(
+            received.begin() + t * size, received.begin() + (t + 1) * size),
+        data);
+  }
+  EXPECT_EQ(agent1->receive(size), data);
+  EXPECT_EQ(agent0->getTrafficStatistics().first, 4 * size);
+  EXPECT_EQ(agent1->getTrafficStatistics().second, 4 * size);
+}
+
+TEST(NetworkEmulatingPartyCommunicationAgentTest, testSendAndReceive) {
+  auto factories = getInMemoryAgentFactory(2);
+  auto profile = NetworkProfile::sameRegion();
+
+  int size = 1024;
+  auto thread0 = std::thread(
+      testAgentFactory,
+      0,
+      2,
+      size,
+      std::make_unique<NetworkEmulatingPartyCommunicationAgentFactory>(
+          std::move(factories[0]), profile, "Party_0"),
+      "");
+  auto thread1 = std::thread(
+      testAgentFactory,
+      1,
+      2,
+      size,
+      std::make_unique<NetworkEmulatingPartyCommunicationAgentFactory>(
+          std::move(factories[1]), profile, "Party_1"),
+      "");
+
+  thread1.join();
+  thread0.join();
+}
+
+TEST(NetworkEmulatingPartyCommunicationAgentTest, testLatencyAndBandwidth) {
+  auto factories = getInMemoryAgentFactory(2);
+  NetworkProfile profile{
+      std::chrono::milliseconds(20),
+      std::chrono::microseconds(0),
+      10000000, // 10 MB/s
+      1000};
+  NetworkEmulatingPartyCommunicationAgentFactory factory0(
+      std::move(factories[0]), profile, "Party_0");
+  NetworkEmulatingPartyCommunicationAgentFactory factory1(
+      std::move(factories[1]), profile, "Party_1");
+  auto agent0 = factory0.create(1, "traffic_to_party_1");
+  auto agent1 = factory1.create(0, "traffic_to_party_0");
+
+  // a ping-pong of small messages costs one round trip each.
+  auto start = std::chrono::steady_clock::now();
+  auto echo = std::async([&agent1]() {
+    for (int i = 0; i < 3; i++) {
+      agent1->sendSingleT<int>(agent1->receiveSingleT<int>());
+    }
+  });
+  for (int i = 0; i < 3; i++) {
+    agent0->sendSingleT<int>(i);
+    EXPECT_EQ(agent0->receiveSingleT<int>(), i);
+  }
+  echo.get();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, 6 * profile.latency);
+
+  // 1 MB at 10 MB/s needs about 100 ms on the link.
+  std::vector<unsigned char> data(1000000, 0xAB);
+  start = std::chrono::steady_clock::now();
+  agent0->send(data);
+  EXPECT_EQ(agent1->receive(data.size()), data);
+  elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(99) + profile.latency);
+}
+
+TEST(SharedMemoryPartyCommunicationAgentTest, testSendAndReceive) {
+  auto directory = std::filesystem::temp_directory_path().string();
+  auto sessionName =
+      "shared_memory_test_" + std::to_string(folly::Random::rand32());
+
+  std::vector<std::unique_ptr<IPartyCommunicationAgentFactory>> factories;
+  for (int i = 0; i < 3; i++) {
+    factories.push_back(
+        std::make_unique<SharedMemoryPartyCommunicationAgentFactory>(
+            i, directory, sessionName, "Party_" + std::to_string(i)));
+  }
+
+  int size = 1048576; // 1024 ^ 2
+  auto thread0 =
+      std::thread(testAgentFactory, 0, 3, size, std::move(factories[0]), "");
+  auto thread1 =
+      std::thread(testAgentFactory, 1, 3, size, std::move(factories[1]), "");
+  auto thread2 =
+      std::thread(testAgentFactory, 2, 3, size, std::move(factories[2]), "");
+
+  thread2.join();
+  thread1.join();
+  thread0.join();
+}
+
+TEST(SharedMemoryPartyCommunicationAgentTest, testMessageLargerThanRing) {
+  auto directory = std::filesystem::temp_directory_path().string();
+  auto sessionName =
+      "shared_memory_test_" + std::to_string(folly::Random::rand32());
+  size_t ringCapacity = 4096;
+
+  // the message wraps around the ring many times and is received with reads
+  // that don't line up with the ring boundaries.
+  int size = 1000003;
+  std::vector<unsigned char> data(size);
+  for (int i = 0; i < size; i++) {
+    data[i] = folly::Random::rand32() & 0xFF;
+  }
+
+  auto receiverTask = std::async([&]() {
+    SharedMemoryPartyCommunicationAgentFactory factory(
+        1, directory, sessionName, "Party_1", ringCapacity);
+    auto agent = factory.create(0, "traffic_to_party_0");
+    std::vector<unsigned char> received;
+    int chunk = 777;
+    while (received.size() < size) {
+      auto readSize = std::min<int>(chunk, size - received.size());
+      auto part = agent->receive(readSize);
+      received.insert(received.end(), part.begin(), part.end());
+    }
+    EXPECT_EQ(agent->getTrafficStatistics().second, size);
+    return received;
+  });
+
+  SharedMemoryPartyCommunicationAgentFactory factory(
+      0, directory, sessionName, "Party_0", ringCapacity);
+  auto agent = factory.create(1, "traffic_to_party_1");
+  agent->send(data);
+  EXPECT_EQ(agent->getTrafficStatistics().first, size);
+
+  EXPECT_EQ(receiverTask.get(), data);
+}
+
+TEST(SharedMemoryPartyCommunicationAgentTest, testCreatorTimeout) {
+  auto path = std::filesystem::temp_directory_path().string() +
+      "/shared_memory_test_" + std::to_string(folly::Random::rand32());
+  EXPECT_THROW(
+      SharedMemoryPartyCommunicationAgent(
+          path,
+          true,
+          4096,
+          std::make_shared<PartyCommunicationAgentTrafficRecorder>(),
+          1),
+      std::runtime_error);
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(SharedMemoryPartyCommunicationAgentTest, testStaleSegment) {
+  auto path = std::filesystem::temp_directory_path().string() +
+      "/shared_memory_test_" + std::to_string(folly::Random::rand32());
+  auto stalePath = path + "_stale";
+
+  // a creator that gives up leaves a fully initialized segment behind, just
+  // like one that crashed before the peer attached.
+  auto abandonedCreator = std::async([&]() {
+    EXPECT_THROW(
+        SharedMemoryPartyCommunicationAgent(
+            path,
+            true,
+            4096,
+            std::make_shared<PartyCommunicationAgentTrafficRecorder>(),
+            1),
+        std::runtime_error);
+  });
+  while (!std::filesystem::exists(path)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::filesystem::copy_file(path, stalePath);
+  abandonedCreator.get();
+  std::filesystem::rename(stalePath, path);
+
+  // the opener comes first and attaches to the stale segment.
+  auto opener = std::async([&]() {
+    SharedMemoryPartyCommunicationAgent agent(
+        path,
+        false,
+        4096,
+        std::make_shared<PartyCommunicationAgentTrafficRecorder>());
+    return agent.receive(100);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  SharedMemoryPartyCommunicationAgent creator(
+      path,
+      true,
+      4096,
+      std::make_shared<PartyCommunicationAgentTrafficRecorder>(),
+      10);
+  std::vector<unsigned char> data(100, 42);
+  creator.send(data);
+  EXPECT_EQ(opener.get(), data);
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
 TEST(SocketPartyCommunicationAgentTest, testSendAndReceiveWithTls) {
   auto createdDir = setUpTlsFiles();
 
@@ -256,4 +492,293 @@ TEST(SocketPartyCommunicationAgentTest, testSendAndReceiveWithJammedPort) {
   thread0.join();
 }
 
+TEST(SocketPartyCommunicationAgentTest, testSendAndReceiveWithStripes) {
+  auto port = SocketInTestHelper::findNextOpenPort(5000);
+  std::map<int, SocketPartyCommunicationAgentFactory::PartyInfo> partyInfo0 = {
+      {1, {"127.0.0.1", port}}};
+  std::map<int, SocketPartyCommunicationAgentFactory::PartyInfo> partyInfo1 = {
+      {0, {"127.0.0.1", port}}};
+  int numberOfStripes = 4;
+
+  SocketPartyCommunicationAgentFactory::TlsInfo tlsInfo{false, "", "", ""};
+  SocketPartyCommunicationAgentFactory::ConnectionOptions options{
+      numberOfStripes, false};
+
+  auto factory1 = std::async([&partyInfo1, &tlsInfo, &options]() {
+    return std::make_unique<SocketPartyCommunicationAgentFactory>(
+        1, partyInfo1, tlsInfo, "Party_1", options);
+  });
+  auto factory0 = std::make_unique<SocketPartyCommunicationAgentFactory>(
+      0, partyInfo0, tlsInfo, "Party_0", options);
+
+  // two messages below and two above the striping threshold: the first one
+  // is sent in one write with its header, the last one doesn't divide evenly
+  // by the number of stripes.
+  std::vector<std::vector<unsigned char>> messages;
+  for (auto size : {100, 100000, 1 << 20, (1 << 22) + 3}) {
+    std::vector<unsigned char> message(size);
+    for (auto& byte : message) {
+      byte = folly::Random::rand32() & 0xFF;
+    }
+    messages.push_back(std::move(message));
+  }
+
+  auto receiverTask = std::async([&factory1, &messages]() {
+    auto agent = factory1.get()->create(0, "traffic_to_party_0");
+    for (auto& message : messages) {
+      EXPECT_EQ(agent->receive(message.size()), message);
+    }
+    // receive a striped message in pieces.
+    auto& message = messages.back();
+    std::vector<unsigned char> received;
+    while (received.size() < message.size()) {
+      auto part = agent->receive(
+          std::min<size_t>(100000, message.size() - received.size()));
+      received.insert(received.end(), part.begin(), part.end());
+    }
+    EXPECT_EQ(received, message);
+    agent->sendSingleT<int>(1);
+  });
+
+  auto agent = factory0->create(1, "traffic_to_party_1");
+  uint64_t sentBytes = 0;
+  for (auto& message : messages) {
+    agent->send(message);
+    sentBytes += message.size();
+  }
+  agent->send(messages.back());
+  sentBytes += messages.back().size();
+  EXPECT_EQ(agent->receiveSingleT<int>(), 1);
+  receiverTask.get();
+
+  // the frame headers don't count as traffic.
+  auto [sent, received] = agent->getTrafficStatistics();
+  EXPECT_EQ(sent, sentBytes);
+  EXPECT_EQ(received, sizeof(int));
+}
+
+TEST(SocketPartyCommunicationAgentTest, testSendAndReceiveWithResumable) {
+  auto port01 = SocketInTestHelper::findNextOpenPort(5000);
+  auto port02 = port01 + 4;
+  auto port12 = port01 + 8;
+
+  std::map<int, SocketPartyCommunicationAgentFactory::PartyInfo> partyInfo0 = {
+      {1, {"127.0.0.1", port01}}, {2, {"127.0.0.1", port02}}};
+  std::map<int, SocketPartyCommunicationAgentFactory::PartyInfo> partyInfo1 = {
+      {0, {"127.0.0.1", port01}}, {2, {"127.0.0.1", port12}}};
+  std::map<int, SocketPartyCommunicationAgentFactory::PartyInfo> partyInfo2 = {
+      {0, {"127.0.0.1", port02}}, {1, {"127.0.0.1", port12}}};
+
+  SocketPartyCommunicationAgentFactory::TlsInfo tlsInfo{false, "", "", ""};
+  SocketPartyCommunicationAgentFactory::ConnectionOptions options{1, true};
+
+  auto factory1 = std::async([&partyInfo1, &tlsInfo, &options]() {
+    return std::make_unique<SocketPartyCommunicationAgentFactory>(
+        1, partyInfo1, tlsInfo, "Party_1", options);
+  });
+
+  auto factory2 = std::async([&partyInfo2, &tlsInfo, &options]() {
+    return std::make_unique<SocketPartyCommunicationAgentFactory>(
+        2, partyInfo2, tlsInfo, "Party_2", options);
+  });
+
+  auto factory0 = std::make_unique<SocketPartyCommunicationAgentFactory>(
+      0, partyInfo0, tlsInfo, "Party_0", options);
+
+  int size = 1048576; // 1024 ^ 2
+
+  auto thread0 =
+      std::thread(testAgentFactory, 0, 3, size, std::move(factory0), "Party_0");
+  auto thread1 =
+      std::thread(testAgentFactory, 1, 3, size, factory1.get(), "Party_1");
+  auto thread2 =
+      std::thread(testAgentFactory, 2, 3, size, factory2.get(), "Party_2");
+
+  thread2.join();
+  thread1.join();
+  thread0.join();
+}
+
+int listenOnPort(int port) {
+  auto sockfd = socket(AF_INET, SOCK_STREAM, 0);
+  int enable = 1;
+  setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  struct sockaddr_in servAddr = {};
+  servAddr.sin_family = AF_INET;
+  servAddr.sin_addr.s_addr = INADDR_ANY;
+  servAddr.sin_port = htons(port);
+  if (::bind(sockfd, (struct sockaddr*)&servAddr, sizeof(servAddr)) < 0) {
+    throw std::runtime_error("error on binding");
+  }
+  listen(sockfd, 1);
+  return sockfd;
+}
+
+/**
+ * Forward connections from the proxy port to the server port, resetting each
+ * of the first numberOfCuts connections once bytesBeforeCut bytes went
+ * through. The bytes the proxy read but didn't forward yet are lost, just
+ * like the ones a real connection drops. With dropBeforeCut, the connections
+ * that get cut lose everything, so the bytes count both directions.
+ */
+void runFlakyProxy(
+    int proxyFd,
+    int serverPort,
+    int bytesBeforeCut,
+    int numberOfCuts,
+    bool dropBeforeCut) {
+  struct sockaddr_in serverAddr = {};
+  serverAddr.sin_family = AF_INET;
+  serverAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  serverAddr.sin_port = htons(serverPort);
+
+  for (int cut = 0; cut <= numberOfCuts; cut++) {
+    auto client = accept(proxyFd, nullptr, nullptr);
+    auto server = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(client, 0);
+    ASSERT_EQ(
+        connect(server, (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+
+    std::vector<char> buffer(1 << 16);
+    int forwarded = 0;
+    bool open = true;
+    while (open && (cut == numberOfCuts || forwarded < bytesBeforeCut)) {
+      struct pollfd fds[2] = {{client, POLLIN, 0}, {server, POLLIN, 0}};
+      poll(fds, 2, -1);
+      for (int i = 0; i < 2 && open; i++) {
+        if (fds[i].revents == 0) {
+          continue;
+        }
+        auto from = fds[i].fd;
+        auto to = from == client ? server : client;
+        auto size = read(from, buffer.data(), buffer.size());
+        if (size <= 0) {
+          open = false;
+          break;
+        }
+        if (cut < numberOfCuts) {
+          size = std::min<ssize_t>(size, bytesBeforeCut - forwarded);
+        }
+        if (cut < numberOfCuts && dropBeforeCut) {
+          forwarded += size;
+          continue;
+        }
+        for (ssize_t written = 0; written < size;) {
+          written += write(to, buffer.data() + written, size - written);
+        }
+        forwarded += size;
+      }
+    }
+    if (cut < numberOfCuts) {
+      // reset rather than close gracefully.
+      struct linger reset = {1, 0};
+      setsockopt(client, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+      setsockopt(server, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    }
+    close(client);
+    close(server);
+  }
+  close(proxyFd);
+}
+
+TEST(
+    ResumableSocketPartyCommunicationAgentTest,
+    testResumeAfterConnectionLoss) {
+  auto serverPort = SocketInTestHelper::findNextOpenPort(5000);
+  auto proxyPort = SocketInTestHelper::findNextOpenPort(serverPort + 1);
+  auto serverFd = listenOnPort(serverPort);
+  auto proxyFd = listenOnPort(proxyPort);
+  int numberOfCuts = 3;
+  auto proxy = std::thread(
+      runFlakyProxy, proxyFd, serverPort, 1 << 20, numberOfCuts, false);
+
+  std::vector<std::vector<unsigned char>> messages;
+  for (int i = 0; i < 20; i++) {
+    std::vector<unsigned char> message(folly::Random::rand32(1, 1 << 19));
+    for (auto& byte : message) {
+      byte = folly::Random::rand32() & 0xFF;
+    }
+    messages.push_back(std::move(message));
+  }
+
+  // messages go back and forth so that only one direction is busy at a time,
+  // which the proxy needs to avoid blocking.
+  auto serverTask = std::async([serverFd, serverPort, &messages]() {
+    auto recorder = std::make_shared<PartyCommunicationAgentTrafficRecorder>();
+    auto agent = std::make_unique<ResumableSocketPartyCommunicationAgent>(
+        serverFd, serverPort, recorder);
+    for (auto& message : messages) {
+      auto received = agent->receive(message.size());
+      EXPECT_EQ(received, message);
+      agent->send(received);
+    }
+    return agent->getResumeCount();
+  });
+
+  auto recorder = std::make_shared<PartyCommunicationAgentTrafficRecorder>();
+  auto agent = std::make_unique<ResumableSocketPartyCommunicationAgent>(
+      "127.0.0.1", proxyPort, recorder);
+  uint64_t size = 0;
+  for (auto& message : messages) {
+    agent->send(message);
+    EXPECT_EQ(agent->receive(message.size()), message);
+    size += message.size();
+  }
+  // the replayed bytes aren't counted.
+  EXPECT_EQ(agent->getTrafficStatistics(), std::make_pair(size, size));
+
+  EXPECT_GT(serverTask.get(), 0);
+  EXPECT_GT(agent->getResumeCount(), 0);
+  agent = nullptr;
+  proxy.join();
+}
+
+TEST(ResumableSocketPartyCommunicationAgentTest, testResumeWithLargeReplays) {
+  auto serverPort = SocketInTestHelper::findNextOpenPort(5000);
+  auto proxyPort = SocketInTestHelper::findNextOpenPort(serverPort + 1);
+  auto serverFd = listenOnPort(serverPort);
+  auto proxyFd = listenOnPort(proxyPort);
+  // both parties send a message far larger than the socket buffers, which
+  // the first connection drops, so both have to replay all of it.
+  int size = 1 << 25;
+  auto proxy =
+      std::thread(runFlakyProxy, proxyFd, serverPort, 2 * size, 1, true);
+
+  auto getRandomMessage = [size]() {
+    std::vector<unsigned char> rst(size);
+    for (auto& byte : rst) {
+      byte = folly::Random::rand32() & 0xFF;
+    }
+    return rst;
+  };
+  auto serverMessage = getRandomMessage();
+  auto clientMessage = getRandomMessage();
+
+  auto serverTask = std::async([&]() {
+    auto recorder = std::make_shared<PartyCommunicationAgentTrafficRecorder>();
+    auto agent = std::make_unique<ResumableSocketPartyCommunicationAgent>(
+        serverFd, serverPort, recorder);
+    agent->send(serverMessage);
+    // EXPECT_EQ would print the whole vectors on a mismatch.
+    EXPECT_TRUE(agent->receive(size) == clientMessage);
+    // one more round trip on the resumed connection.
+    agent->sendSingleT<int>(1);
+    EXPECT_EQ(agent->receiveSingleT<int>(), 2);
+    return agent->getResumeCount();
+  });
+
+  auto recorder = std::make_shared<PartyCommunicationAgentTrafficRecorder>();
+  auto agent = std::make_unique<ResumableSocketPartyCommunicationAgent>(
+      "127.0.0.1", proxyPort, recorder);
+  agent->send(clientMessage);
+  EXPECT_TRUE(agent->receive(size) == serverMessage);
+  EXPECT_EQ(agent->receiveSingleT<int>(), 1);
+  agent->sendSingleT<int>(2);
+
+  EXPECT_EQ(serverTask.get(), 1);
+  EXPECT_EQ(agent->getResumeCount(), 1);
+  agent = nullptr;
+  proxy.join();
+}
+
 } // namespace fbpcf::engine::communication
@@ -70,6 +70,10 @@ class DummyTupleGenerator final : public ITupleGenerator {
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
     return {0, 0};
   }
+
+  std::pair<uint64_t, uint64_t> getStallStatistics() const override {
+    return {0, 0};
+  }
 };
 
 } // namespace fbpcf::engine::tuple_generator::insecure
@@ -162,6 +162,13 @@ class ITupleGenerator {
    * @return a pair of (sent, received) data in bytes.
    */
   virtual std::pair<uint64_t, uint64_t> getTrafficStatistics() const = 0;
+
+  /**
+   * Get how often, and for how long in total, the caller had to wait for
+   * tuples that were not generated yet.
+   * @return a pair of (number of stalls, stall time in microseconds).
+   */
+  virtual std::pair<uint64_t, uint64_t> getStallStatistics() const = 0;
 };
 
 } // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <folly/logging/xlog.h>
+
+#include "fbpcf/engine/tuple_generator/PersistedTupleGenerator.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+namespace {
+
+// how many tuples to draw from the generator and append at a time.
+const uint32_t kOfflineChunkSize = 1 << 20;
+
+bool isSameFileId(__m128i a, __m128i b) {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+}
+
+} // namespace
+
+PersistedTupleGenerator::PersistedTupleGenerator(
+    std::unique_ptr<TupleFile> file,
+    std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+    uint64_t reservationSize)
+    : file_(std::move(file)),
+      agent_(std::move(agent)),
+      reservationSize_(std::max<uint64_t>(reservationSize, 1)) {
+  agent_->sendSingleT<__m128i>(file_->getFileId());
+  agent_->sendInt64({file_->getTupleCount(), file_->getConsumedOffset()});
+  auto otherFileId = agent_->receiveSingleT<__m128i>();
+  auto otherCounts = agent_->receiveInt64(2);
+
+  if (!isSameFileId(file_->getFileId(), otherFileId)) {
+    throw std::runtime_error(
+        "The tuple files of the two parties were not generated together.");
+  }
+  // a party that crashed may have reserved more than the other one recorded,
+  // neither party can use any of those tuples again.
+  offset_ = std::max(file_->getConsumedOffset(), otherCounts.at(1));
+  endOffset_ = std::min(file_->getTupleCount(), otherCounts.at(0));
+  offset_ = std::min(offset_, endOffset_);
+  reservedOffset_ = offset_;
+}
+
+PersistedTupleGenerator::~PersistedTupleGenerator() {
+  try {
+    // both parties handed out the same tuples, so the part of the
+    // reservation that was never used can be released.
+    file_->setConsumedOffset(offset_);
+  } catch (const std::exception& e) {
+    XLOG(ERR) << "Failed to release the reserved tuples: " << e.what();
+  }
+}
+
+std::vector<ITupleGenerator::BooleanTuple>
+PersistedTupleGenerator::getBooleanTuple(uint32_t size) {
+  if (size > endOffset_ - offset_) {
+    throw std::runtime_error(
+        "Not enough tuples left in the tuple file: requested " +
+        std::to_string(size) + ", remaining " +
+        std::to_string(endOffset_ - offset_));
+  }
+  if (offset_ + size > reservedOffset_) {
+    reservedOffset_ = std::min(
+        std::max(offset_ + size, reservedOffset_ + reservationSize_),
+        endOffset_);
+    file_->setConsumedOffset(reservedOffset_);
+  }
+  auto rst = file_->read(offset_, size);
+  offset_ += size;
+  return rst;
+}
+
+std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>
+PersistedTupleGenerator::getCompositeTuple(
+    const std::map<size_t, uint32_t>& /*tupleSizes*/) {
+  throw std::runtime_error(
+      "Composite tuples are not supported by the persisted tuple generator.");
+}
+
+std::pair<
+    std::vector<ITupleGenerator::BooleanTuple>,
+    std::map<size_t, std::vector<ITupleGenerator::CompositeBooleanTuple>>>
+PersistedTupleGenerator::getNormalAndCompositeBooleanTuples(
+    uint32_t tupleSize,
+    const std::map<size_t, uint32_t>& compositeTupleSizes) {
+  if (!compositeTupleSizes.empty()) {
+    getCompositeTuple(compositeTupleSizes);
+  }
+  return {getBooleanTuple(tupleSize), {}};
+}
+
+void PersistedTupleGenerator::generateOffline(
+    ITupleGenerator& generator,
+    communication::IPartyCommunicationAgent& agent,
+    int myId,
+    const std::string& path,
+    __m128i key,
+    uint64_t tupleCount) {
+  unsigned char fileExists = access(path.c_str(), F_OK) == 0;
+  agent.sendSingleT<unsigned char>(fileExists);
+  if (agent.receiveSingleT<unsigned char>() != fileExists) {
+    throw std::runtime_error(
+        "Only one of the two parties has a tuple file to extend.");
+  }
+
+  std::unique_ptr<TupleFile> file;
+  if (fileExists) {
+    file = TupleFile::open(path, key);
+    agent.sendSingleT<__m128i>(file->getFileId());
+    agent.sendInt64({file->getTupleCount()});
+    auto otherFileId = agent.receiveSingleT<__m128i>();
+    auto otherTupleCount = agent.receiveInt64(1).at(0);
+    if (!isSameFileId(file->getFileId(), otherFileId) ||
+        file->getTupleCount() != otherTupleCount) {
+      throw std::runtime_error(
+          "The tuple files of the two parties are out of sync.");
+    }
+  } else {
+    __m128i fileId;
+    if (myId == 0) {
+      fileId = util::getRandomM128iFromSystemNoise();
+      agent.sendSingleT<__m128i>(fileId);
+    } else {
+      fileId = agent.receiveSingleT<__m128i>();
+    }
+    file = TupleFile::create(path, key, fileId);
+  }
+
+  for (uint64_t generated = 0; generated < tupleCount;) {
+    auto size = static_cast<uint32_t>(
+        std::min<uint64_t>(tupleCount - generated, kOfflineChunkSize));
+    file->append(generator.getBooleanTuple(size));
+    generated += size;
+  }
+}
+
+} // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <memory>
+#include <string>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/TupleFile.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ * This object serves the online phase of a two party computation from the
+ * boolean tuples a previous offline run stored in a TupleFile, see
+ * generateOffline(). No tuple is generated online, only a few bytes are
+ * exchanged at construction to agree with the other party on where to resume.
+ *
+ * The consumption is reserved on disk in chunks ahead of use, so that a crash
+ * never leads to a tuple being handed out twice; the unused part of the last
+ * reservation is released on destruction.
+ */
+class PersistedTupleGenerator final : public ITupleGenerator {
+ public:
+  static const uint64_t kDefaultReservationSize = 1 << 20;
+
+  /**
+   * @param file this party's tuple file.
+   * @param agent the channel to the party holding the matching file.
+   * @param reservationSize how many tuples to mark as consumed at a time.
+   */
+  PersistedTupleGenerator(
+      std::unique_ptr<TupleFile> file,
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+      uint64_t reservationSize = kDefaultReservationSize);
+
+  ~PersistedTupleGenerator() override;
+
+  /**
+   * Draw tupleCount boolean tuples from generator and append them to the tuple
+   * file at path, creating it if it doesn't exist yet. Both parties must call
+   * this with the same tupleCount, on files that were always extended
+   * together.
+   * @param myId this party's id, the party with id 0 picks the file id of new
+   * files.
+   * @param key the key encrypting this party's file; each party has its own.
+   */
+  static void generateOffline(
+      ITupleGenerator& generator,
+      communication::IPartyCommunicationAgent& agent,
+      int myId,
+      const std::string& path,
+      __m128i key,
+      uint64_t tupleCount);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<BooleanTuple> getBooleanTuple(uint32_t size) override;
+
+  /**
+   * Composite tuples are not persisted, this always throws.
+   */
+  std::map<size_t, std::vector<CompositeBooleanTuple>> getCompositeTuple(
+      const std::map<size_t, uint32_t>& tupleSizes) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<
+      std::vector<BooleanTuple>,
+      std::map<size_t, std::vector<CompositeBooleanTuple>>>
+  getNormalAndCompositeBooleanTuples(
+      uint32_t tupleSize,
+      const std::map<size_t, uint32_t>& compositeTupleSizes) override;
+
+  bool supportsCompositeTupleGeneration() override {
+    return false;
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return agent_->getTrafficStatistics();
+  }
+
+  /**
+   * Tuples are always ready, this never stalls.
+   */
+  std::pair<uint64_t, uint64_t> getStallStatistics() const override {
+    return {0, 0};
+  }
+
+  /**
+   * How many tuples are left in the file.
+   */
+  uint64_t getRemainingTupleCount() const {
+    return endOffset_ - offset_;
+  }
+
+ private:
+  std::unique_ptr<TupleFile> file_;
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
+  uint64_t reservationSize_;
+
+  // the next tuple to hand out
+  uint64_t offset_;
+  // the end of the persisted reservation
+  uint64_t reservedOffset_;
+  // the end of the tuples both parties have
+  uint64_t endOffset_;
+};
+
+} // namespace fbpcf::engine::tuple_generator
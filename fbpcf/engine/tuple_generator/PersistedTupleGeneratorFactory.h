@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <memory>
+#include <string>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/tuple_generator/ITupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/PersistedTupleGenerator.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+class PersistedTupleGeneratorFactory final : public ITupleGeneratorFactory {
+ public:
+  /**
+   * @param path this party's tuple file, filled by
+   * PersistedTupleGenerator::generateOffline().
+   * @param key the key the file was encrypted with.
+   */
+  PersistedTupleGeneratorFactory(
+      const std::string& path,
+      __m128i key,
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId,
+      uint64_t reservationSize =
+          PersistedTupleGenerator::kDefaultReservationSize)
+      : path_(path),
+        key_(key),
+        agentFactory_(agentFactory),
+        myId_(myId),
+        reservationSize_(reservationSize) {}
+
+  /**
+   * Create a tuple generator reading from the tuple file.
+   */
+  std::unique_ptr<ITupleGenerator> create() override {
+    return std::make_unique<PersistedTupleGenerator>(
+        TupleFile::open(path_, key_),
+        agentFactory_.create(1 - myId_, "persisted_tuple_generator_traffic"),
+        reservationSize_);
+  }
+
+ private:
+  std::string path_;
+  __m128i key_;
+  communication::IPartyCommunicationAgentFactory& agentFactory_;
+  int myId_;
+  uint64_t reservationSize_;
+};
+
+} // namespace fbpcf::engine::tuple_generator
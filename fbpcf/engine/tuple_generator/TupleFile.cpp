@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <folly/String.h>
+
+#include "fbpcf/engine/tuple_generator/TupleFile.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+namespace {
+
+const char kMagic[8] = {'F', 'B', 'P', 'C', 'F', 'T', 'U', 'P'};
+const uint32_t kVersion = 3;
+
+// header fields
+const uint64_t kVersionOffset = 8;
+const uint64_t kFileIdOffset = 16;
+const uint64_t kTupleCountOffset = 32;
+const uint64_t kConsumedOffsetOffset = 40;
+const uint64_t kKeyCheckOffset = 48;
+const uint64_t kAppendCountOffset = 64;
+
+// The tuples are stored in groups of 128, as three 128-bit planes holding the
+// a, b and c bits of the group, followed by the number of the append that
+// encrypted the group. The j-th plane of the g-th group, written by the n-th
+// append, is encrypted with the key stream block of counter (n, 3g + j).
+// Appending to a partly filled group encrypts it again under the new append
+// number, so that no counter is ever used twice.
+const uint64_t kGroupSize = 128;
+const uint64_t kPlanes = 3;
+const uint64_t kGroupBytes = (kPlanes + 1) * sizeof(__m128i);
+const uint64_t kWordsPerGroup = kGroupBytes / sizeof(uint64_t);
+const uint64_t kPlaneWords = kPlanes * sizeof(__m128i) / sizeof(uint64_t);
+
+// how many groups to process at a time.
+const uint64_t kGroupBatchSize = 1024;
+
+uint64_t getGroupCount(uint64_t tupleCount) {
+  return (tupleCount + kGroupSize - 1) / kGroupSize;
+}
+
+void writeFully(int fd, const void* data, uint64_t size, uint64_t position) {
+  auto bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    auto written = pwrite(fd, bytes, size, position);
+    if (written < 0) {
+      throw std::runtime_error(
+          "Failed to write tuple file: " + folly::errnoStr(errno));
+    }
+    bytes += written;
+    size -= written;
+    position += written;
+  }
+}
+
+void sync(int fd) {
+  if (fdatasync(fd) != 0) {
+    throw std::runtime_error(
+        "Failed to sync tuple file: " + folly::errnoStr(errno));
+  }
+}
+
+bool equal(__m128i a, __m128i b) {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+}
+
+} // namespace
+
+TupleFile::TupleFile(int fd, __m128i key)
+    : fd_(fd),
+      cipher_(key),
+      fileId_(_mm_setzero_si128()),
+      tupleCount_(0),
+      consumedOffset_(0),
+      appendCount_(0),
+      mapping_(nullptr),
+      mappingSize_(0) {}
+
+std::unique_ptr<TupleFile>
+TupleFile::create(const std::string& path, __m128i key, __m128i fileId) {
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    throw std::runtime_error(
+        "Failed to create tuple file " + path + ": " + folly::errnoStr(errno));
+  }
+  std::unique_ptr<TupleFile> file(new TupleFile(fd, key));
+  file->fileId_ = fileId;
+  file->writeHeader();
+  return file;
+}
+
+std::unique_ptr<TupleFile> TupleFile::open(
+    const std::string& path,
+    __m128i key) {
+  int fd = ::open(path.c_str(), O_RDWR);
+  if (fd < 0) {
+    throw std::runtime_error(
+        "Failed to open tuple file " + path + ": " + folly::errnoStr(errno));
+  }
+  std::unique_ptr<TupleFile> file(new TupleFile(fd, key));
+  file->readHeader();
+  return file;
+}
+
+TupleFile::~TupleFile() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mappingSize_);
+  }
+  close(fd_);
+}
+
+void TupleFile::readHeader() {
+  unsigned char header[kHeaderSize];
+  if (pread(fd_, header, kHeaderSize, 0) !=
+          static_cast<ssize_t>(kHeaderSize) ||
+      std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("Not a tuple file.");
+  }
+  uint32_t version;
+  std::memcpy(&version, header + kVersionOffset, sizeof(version));
+  if (version != kVersion) {
+    throw std::runtime_error(
+        "Unsupported tuple file version: " + std::to_string(version));
+  }
+  std::memcpy(&fileId_, header + kFileIdOffset, sizeof(fileId_));
+  std::memcpy(&tupleCount_, header + kTupleCountOffset, sizeof(tupleCount_));
+  std::memcpy(
+      &consumedOffset_,
+      header + kConsumedOffsetOffset,
+      sizeof(consumedOffset_));
+  std::memcpy(&appendCount_, header + kAppendCountOffset, sizeof(appendCount_));
+
+  __m128i keyCheck;
+  std::memcpy(&keyCheck, header + kKeyCheckOffset, sizeof(keyCheck));
+  // the append number in the upper half of the key stream counters never
+  // reaches 2^64 - 1, so this block never shows up in the key stream.
+  std::vector<__m128i> expected = {
+      _mm_xor_si128(fileId_, _mm_set_epi64x(-1, 0))};
+  cipher_.encryptInPlace(expected);
+  if (!equal(keyCheck, expected[0])) {
+    throw std::runtime_error("The key doesn't match the tuple file.");
+  }
+}
+
+void TupleFile::writeHeader() {
+  unsigned char header[kHeaderSize] = {0};
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  std::memcpy(header + kVersionOffset, &kVersion, sizeof(kVersion));
+  std::memcpy(header + kFileIdOffset, &fileId_, sizeof(fileId_));
+  std::memcpy(header + kTupleCountOffset, &tupleCount_, sizeof(tupleCount_));
+  std::memcpy(
+      header + kConsumedOffsetOffset,
+      &consumedOffset_,
+      sizeof(consumedOffset_));
+  std::vector<__m128i> keyCheck = {
+      _mm_xor_si128(fileId_, _mm_set_epi64x(-1, 0))};
+  cipher_.encryptInPlace(keyCheck);
+  std::memcpy(header + kKeyCheckOffset, keyCheck.data(), sizeof(__m128i));
+  std::memcpy(header + kAppendCountOffset, &appendCount_, sizeof(appendCount_));
+
+  writeFully(fd_, header, kHeaderSize, 0);
+  sync(fd_);
+}
+
+std::vector<__m128i> TupleFile::getKeyStream(
+    uint64_t firstGroup,
+    const std::vector<uint64_t>& appendNumbers) const {
+  std::vector<__m128i> keyStream(kPlanes * appendNumbers.size());
+  for (uint64_t i = 0; i < appendNumbers.size(); i++) {
+    for (uint64_t j = 0; j < kPlanes; j++) {
+      keyStream[kPlanes * i + j] = _mm_xor_si128(
+          fileId_,
+          _mm_set_epi64x(appendNumbers[i], kPlanes * (firstGroup + i) + j));
+    }
+  }
+  cipher_.encryptInPlace(keyStream);
+  return keyStream;
+}
+
+void TupleFile::append(
+    const std::vector<ITupleGenerator::BooleanTuple>& tuples) {
+  if (tuples.empty()) {
+    return;
+  }
+  // the append number must be on disk before any counter made from it is
+  // used, so that an append that doesn't complete never has its counters
+  // reused.
+  auto appendNumber = ++appendCount_;
+  writeFully(fd_, &appendCount_, sizeof(appendCount_), kAppendCountOffset);
+  sync(fd_);
+
+  auto endCount = tupleCount_ + tuples.size();
+  auto firstGroup = tupleCount_ / kGroupSize;
+  auto groupCount = getGroupCount(endCount) - firstGroup;
+  std::vector<uint64_t> buffer;
+  for (uint64_t start = 0; start < groupCount; start += kGroupBatchSize) {
+    auto batchSize = std::min<uint64_t>(groupCount - start, kGroupBatchSize);
+    auto group = firstGroup + start;
+    auto position = kHeaderSize + group * kGroupBytes;
+    buffer.assign(batchSize * kWordsPerGroup, 0);
+
+    // A group that is partly filled already keeps its tuples, they are
+    // decrypted under the append number they were written with.
+    auto usedBits = tupleCount_ % kGroupSize;
+    if (start == 0 && usedBits != 0) {
+      if (pread(fd_, buffer.data(), kGroupBytes, position) !=
+          static_cast<ssize_t>(kGroupBytes)) {
+        throw std::runtime_error(
+            "Failed to read tuple file: " + folly::errnoStr(errno));
+      }
+      auto keyStream = getKeyStream(group, {buffer[kPlaneWords]});
+      auto keyStreamWords = reinterpret_cast<const uint64_t*>(keyStream.data());
+      for (uint64_t i = 0; i < kPlaneWords; i++) {
+        buffer[i] ^= keyStreamWords[i];
+        // an append that didn't complete may have left tuples past the end.
+        auto bitsInWord = std::min<uint64_t>(
+            64, usedBits - std::min<uint64_t>(usedBits, (i % 2) * 64));
+        buffer[i] &= bitsInWord == 64 ? ~0ULL : (1ULL << bitsInWord) - 1;
+      }
+    }
+
+    auto firstTuple = std::max(tupleCount_, group * kGroupSize);
+    auto lastTuple = std::min(endCount, (group + batchSize) * kGroupSize);
+    for (auto i = firstTuple; i < lastTuple; i++) {
+      auto& tuple = tuples[i - tupleCount_];
+      auto index = i - group * kGroupSize;
+      auto word = index / kGroupSize * kWordsPerGroup + (index / 64) % 2;
+      auto shift = index % 64;
+      buffer[word] |= static_cast<uint64_t>(tuple.getA()) << shift;
+      buffer[word + 2] |= static_cast<uint64_t>(tuple.getB()) << shift;
+      buffer[word + 4] |= static_cast<uint64_t>(tuple.getC()) << shift;
+    }
+    auto keyStream =
+        getKeyStream(group, std::vector<uint64_t>(batchSize, appendNumber));
+    auto keyStreamWords = reinterpret_cast<const uint64_t*>(keyStream.data());
+    for (uint64_t g = 0; g < batchSize; g++) {
+      auto groupWords = buffer.data() + g * kWordsPerGroup;
+      for (uint64_t i = 0; i < kPlaneWords; i++) {
+        groupWords[i] ^= keyStreamWords[g * kPlaneWords + i];
+      }
+      groupWords[kPlaneWords] = appendNumber;
+      groupWords[kPlaneWords + 1] = 0;
+    }
+    writeFully(fd_, buffer.data(), buffer.size() * sizeof(uint64_t), position);
+  }
+  // the tuples must be on disk before the header says they are there.
+  sync(fd_);
+  tupleCount_ = endCount;
+  writeFully(fd_, &tupleCount_, sizeof(tupleCount_), kTupleCountOffset);
+  sync(fd_);
+}
+
+void TupleFile::remap() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mappingSize_);
+    mapping_ = nullptr;
+  }
+  mappingSize_ = kHeaderSize + getGroupCount(tupleCount_) * kGroupBytes;
+  auto mapping =
+      mmap(nullptr, mappingSize_, PROT_READ, MAP_SHARED, fd_, /*offset=*/0);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error(
+        "Failed to map tuple file: " + folly::errnoStr(errno));
+  }
+  mapping_ = static_cast<unsigned char*>(mapping);
+  madvise(mapping_, mappingSize_, MADV_SEQUENTIAL);
+}
+
+std::vector<ITupleGenerator::BooleanTuple> TupleFile::read(
+    uint64_t offset,
+    uint64_t size) {
+  if (offset + size > tupleCount_) {
+    throw std::out_of_range(
+        "Reading tuples [" + std::to_string(offset) + ", " +
+        std::to_string(offset + size) + ") but the file only has " +
+        std::to_string(tupleCount_));
+  }
+  std::vector<ITupleGenerator::BooleanTuple> rst(size);
+  if (size == 0) {
+    return rst;
+  }
+  auto firstGroup = offset / kGroupSize;
+  auto groupCount = getGroupCount(offset + size) - firstGroup;
+  if (mappingSize_ < kHeaderSize + (firstGroup + groupCount) * kGroupBytes) {
+    remap();
+  }
+
+  for (uint64_t start = 0; start < groupCount; start += kGroupBatchSize) {
+    auto batchSize = std::min<uint64_t>(groupCount - start, kGroupBatchSize);
+    auto group = firstGroup + start;
+    auto data = reinterpret_cast<const uint64_t*>(
+        mapping_ + kHeaderSize + group * kGroupBytes);
+    std::vector<uint64_t> appendNumbers(batchSize);
+    for (uint64_t g = 0; g < batchSize; g++) {
+      appendNumbers[g] = data[g * kWordsPerGroup + kPlaneWords];
+    }
+    auto keyStream = getKeyStream(group, appendNumbers);
+    auto keyStreamWords = reinterpret_cast<const uint64_t*>(keyStream.data());
+
+    auto firstTuple = std::max(offset, group * kGroupSize);
+    auto lastTuple = std::min(offset + size, (group + batchSize) * kGroupSize);
+    for (auto i = firstTuple; i < lastTuple;) {
+      auto index = i - group * kGroupSize;
+      auto word = index / kGroupSize * kWordsPerGroup + (index / 64) % 2;
+      auto keyWord = index / kGroupSize * kPlaneWords + (index / 64) % 2;
+      auto a = data[word] ^ keyStreamWords[keyWord];
+      auto b = data[word + 2] ^ keyStreamWords[keyWord + 2];
+      auto c = data[word + 4] ^ keyStreamWords[keyWord + 4];
+      // decrypt one word per plane, then take all its tuples.
+      auto wordEnd = std::min(lastTuple, i - index % 64 + 64);
+      for (; i < wordEnd; i++) {
+        auto shift = (i - group * kGroupSize) % 64;
+        rst[i - offset] = ITupleGenerator::BooleanTuple(
+            (a >> shift) & 1, (b >> shift) & 1, (c >> shift) & 1);
+      }
+    }
+  }
+  return rst;
+}
+
+void TupleFile::setConsumedOffset(uint64_t offset) {
+  if (offset > tupleCount_) {
+    throw std::invalid_argument(
+        "The consumed offset is beyond the end of the tuple file.");
+  }
+  consumedOffset_ = offset;
+  writeFully(
+      fd_, &consumedOffset_, sizeof(consumedOffset_), kConsumedOffsetOffset);
+  sync(fd_);
+}
+
+} // namespace fbpcf::engine::tuple_generator
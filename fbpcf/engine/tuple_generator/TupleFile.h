@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
+#include "fbpcf/engine/util/aes.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+/**
+ * An append-only file of one party's boolean tuples, for generating tuples
+ * ahead of time and using them in a later run. The tuples are encrypted with
+ * AES in counter mode under a key only that party knows, as the shares must
+ * stay secret at rest. The file is read through a memory mapping: reading
+ * decrypts straight from the mapped pages, without any intermediate buffer.
+ *
+ * Besides the tuples, the header records an id shared by the two parties'
+ * files and how many tuples have been consumed, so that a run never reuses a
+ * tuple and both parties consume the same ones.
+ *
+ * The file layout is a kHeaderSize bytes header, then the tuples bit-packed
+ * in groups of 128: three 16-byte planes per group, holding the a, b and c
+ * bits of its tuples, and 16 bytes recording which append encrypted the
+ * group. The key stream counters include that append number, so topping up a
+ * partly filled group never encrypts twice under the same counter.
+ */
+class TupleFile {
+ public:
+  static const uint64_t kHeaderSize = 80;
+
+  /**
+   * Create a new empty file, it fails if the file already exists.
+   * @param fileId an id the two parties agreed on for their files.
+   */
+  static std::unique_ptr<TupleFile>
+  create(const std::string& path, __m128i key, __m128i fileId);
+
+  /**
+   * Open an existing file, it fails if the key doesn't match.
+   */
+  static std::unique_ptr<TupleFile> open(const std::string& path, __m128i key);
+
+  ~TupleFile();
+
+  TupleFile(const TupleFile&) = delete;
+  TupleFile& operator=(const TupleFile&) = delete;
+
+  /**
+   * Encrypt the tuples and append them to the file. They only become
+   * readable, and count in getTupleCount(), once all of them are written.
+   */
+  void append(const std::vector<ITupleGenerator::BooleanTuple>& tuples);
+
+  /**
+   * Read size tuples starting at offset. The reads are expected to be
+   * sequential, the kernel is advised accordingly.
+   */
+  std::vector<ITupleGenerator::BooleanTuple> read(
+      uint64_t offset,
+      uint64_t size);
+
+  /**
+   * Durably record that all tuples before offset are consumed. Moving it
+   * backwards hands the same tuples out again, the caller must only do so to
+   * release tuples it reserved but never used.
+   */
+  void setConsumedOffset(uint64_t offset);
+
+  uint64_t getConsumedOffset() const {
+    return consumedOffset_;
+  }
+
+  uint64_t getTupleCount() const {
+    return tupleCount_;
+  }
+
+  __m128i getFileId() const {
+    return fileId_;
+  }
+
+ private:
+  TupleFile(int fd, __m128i key);
+
+  void readHeader();
+  void writeHeader();
+
+  // the key stream for the consecutive groups from firstGroup, each encrypted
+  // by the given append, one block per plane.
+  std::vector<__m128i> getKeyStream(
+      uint64_t firstGroup,
+      const std::vector<uint64_t>& appendNumbers) const;
+
+  // map the whole file, after it grows.
+  void remap();
+
+  int fd_;
+  util::Aes cipher_;
+  __m128i fileId_;
+  uint64_t tupleCount_;
+  uint64_t consumedOffset_;
+  uint64_t appendCount_;
+
+  unsigned char* mapping_;
+  uint64_t mappingSize_;
+};
+
+} // namespace fbpcf::engine::tuple_generator
@@ -61,6 +61,10 @@ class TupleGenerator final : public ITupleGenerator {
 
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
 
+  std::pair<uint64_t, uint64_t> getStallStatistics() const override {
+    return asyncBuffer_.getStallStatistics();
+  }
+
  private:
   inline std::vector<BooleanTuple> generateTuples(uint64_t size);
 
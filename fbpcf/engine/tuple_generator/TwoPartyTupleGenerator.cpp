@@ -6,19 +6,31 @@
  */
 
 #include "fbpcf/engine/tuple_generator/TwoPartyTupleGenerator.h"
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 #include "fbpcf/engine/util/AesPrg.h"
 #include "fbpcf/engine/util/util.h"
 
 namespace fbpcf::engine::tuple_generator {
 
+namespace {
+
+uint64_t getNumberOfBuffersAhead(uint64_t bufferSize, uint64_t highWaterMark) {
+  return std::max<uint64_t>(1, (highWaterMark + bufferSize - 1) / bufferSize);
+}
+
+} // namespace
+
 TwoPartyTupleGenerator::TwoPartyTupleGenerator(
     std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
         senderRcot,
     std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
         receiverRcot,
     __m128i delta,
-    uint64_t bufferSize)
+    uint64_t bufferSize,
+    uint64_t booleanHighWaterMark,
+    uint64_t compositeHighWaterMark)
     : // the key itself is not important as long as it's a pre-agreed value
       hashFromAes_(util::Aes::getFixedKey()),
       senderRcot_{std::move(senderRcot)},
@@ -27,25 +39,17 @@ TwoPartyTupleGenerator::TwoPartyTupleGenerator(
       booleanTupleBuffer_{
           bufferSize,
           [this](uint64_t size) {
-            {
-              std::lock_guard<std::mutex> lock(scheduleMutex_);
-              toGenerate_.push_back(Boolean);
-            }
-            return std::async(
-                [this](uint64_t size) { return generateNormalTuples(size); },
-                size);
-          }},
-      rcotBuffer_{bufferSize, [this](uint64_t size) {
-                    {
-                      std::lock_guard<std::mutex> lock(scheduleMutex_);
-                      toGenerate_.push_back(Composite);
-                    }
-                    return std::async(
-                        [this](uint64_t size) {
-                          return generateRcotResults(size);
-                        },
-                        size);
-                  }} {}
+            return worker_.submit(
+                [this, size]() { return generateNormalTuples(size); });
+          },
+          getNumberOfBuffersAhead(bufferSize, booleanHighWaterMark)},
+      rcotBuffer_{
+          bufferSize,
+          [this](uint64_t size) {
+            return worker_.submit(
+                [this, size]() { return generateRcotResults(size); });
+          },
+          getNumberOfBuffersAhead(bufferSize, compositeHighWaterMark)} {}
 
 std::vector<ITupleGenerator::BooleanTuple>
 TwoPartyTupleGenerator::getBooleanTuple(uint32_t size) {
@@ -89,45 +93,24 @@ TwoPartyTupleGenerator::getNormalAndCompositeBooleanTuples(
 
 std::vector<ITupleGenerator::BooleanTuple>
 TwoPartyTupleGenerator::generateNormalTuples(uint64_t size) {
-  {
-    std::unique_lock<std::mutex> scheduleLock(scheduleMutex_);
-    cv_.wait(scheduleLock, [this] { return toGenerate_.front() == Boolean; });
-  }
-
   auto receiverMessagesFuture =
       std::async([size, this]() { return receiverRcot_->rcot(size); });
 
   auto sender0Messages = senderRcot_->rcot(size);
   auto receiverMessages = receiverMessagesFuture.get();
 
-  {
-    std::unique_lock<std::mutex> scheduleLock(scheduleMutex_);
-    toGenerate_.pop_front();
-    cv_.notify_one();
-  }
-
   return expandRCOTResults<false>(
       std::move(sender0Messages), std::move(receiverMessages), 1);
 }
 
 std::vector<std::pair<__m128i, __m128i>>
 TwoPartyTupleGenerator::generateRcotResults(uint64_t size) {
-  {
-    std::unique_lock<std::mutex> scheduleLock(scheduleMutex_);
-    cv_.wait(scheduleLock, [this] { return toGenerate_.front() == Composite; });
-  }
   auto receiverMessagesFuture =
       std::async([size, this]() { return receiverRcot_->rcot(size); });
 
   auto sender0Messages = senderRcot_->rcot(size);
   auto receiverMessages = receiverMessagesFuture.get();
 
-  {
-    std::unique_lock<std::mutex> scheduleLock(scheduleMutex_);
-    toGenerate_.pop_front();
-    cv_.notify_one();
-  }
-
   std::vector<std::pair<__m128i, __m128i>> rcotMessages(size);
 
   for (size_t i = 0; i < size; i++) {
@@ -174,83 +157,27 @@ TwoPartyTupleGenerator::expandRCOTResults(
     std::vector<__m128i> sender0Messages,
     std::vector<__m128i> receiverMessages,
     size_t requestedTupleSize) {
-  std::vector<__m128i> sender1Messages(sender0Messages.size());
-  std::vector<bool> choiceBits(receiverMessages.size());
-
-  for (size_t i = 0; i < sender0Messages.size(); i++) {
-    // k1 = k0 + delta1 / l1 = l0 + delta2
-    sender1Messages.at(i) = _mm_xor_si128(sender0Messages.at(i), delta_);
-    // r = lsb(lr) / p = lsb(kp)
-    choiceBits.at(i) = util::getLsb(receiverMessages.at(i));
-  }
-
   std::vector<TwoPartyTupleGenerator::TupleType<isComposite>> result(
       sender0Messages.size());
-  if constexpr (!isComposite) {
-    // H(k0) / H(l0)
-    hashFromAes_.inPlaceHash(sender0Messages);
-    // H(k1) / H(l1)
-    hashFromAes_.inPlaceHash(sender1Messages);
-    // H(lr) / H(kp)
-    hashFromAes_.inPlaceHash(receiverMessages);
-    for (size_t i = 0; i < sender0Messages.size(); i++) {
-      // a1 = H(k0) ^ H(k1) / a2 = H(l0) ^ H(l1)
-      auto a = util::getLsb(sender0Messages.at(i)) ^
-          util::getLsb(sender1Messages.at(i));
-      // b1 = r / b2 = p
-      auto b = choiceBits.at(i);
-      // c1 = (H(k0) ^ H(k1)) & r ^ H(k0) + H(lr)
-      //    = H(kr) + H(lr) /
-      // c2 = (H(l0) ^ H(l1)) & p ^ H(l0) + H(kp)
-      //    = H(lp) + H(kp)
-      auto c = (a & b) ^ util::getLsb(sender0Messages.at(i)) ^
-          util::getLsb(receiverMessages.at(i));
-
-      result[i] = BooleanTuple(a, b, c);
-    }
-  } else {
-    if (requestedTupleSize <= 128) {
-      // H(k0) / H(l0)
-      hashFromAes_.inPlaceHash(sender0Messages);
-      // H(k1) / H(l1)
-      hashFromAes_.inPlaceHash(sender1Messages);
-      // H(lr) / H(kp)
-      hashFromAes_.inPlaceHash(receiverMessages);
 
+  if constexpr (isComposite) {
+    if (requestedTupleSize > 128) {
       for (size_t i = 0; i < sender0Messages.size(); i++) {
-        // a1 = r / a2 = p
-        bool a = choiceBits.at(i);
-        // b1 = H(k0) ^ H(k1) / b2 = H(l0) ^ H(l1)
-        __m128i b = _mm_xor_si128(sender0Messages.at(i), sender1Messages.at(i));
-        // c1 = (H(k0) ^ H(k1)) & r ^ H(k0) + H(lr)
-        //    = H(kr) + H(lr) /
-        // c2 = (H(l0) ^ H(l1)) & p ^ H(l0) + H(kp)
-        //    = H(lp) + H(kp)
-        __m128i c = a
-            ? _mm_xor_si128(
-                  _mm_xor_si128(b, sender0Messages.at(i)),
-                  receiverMessages.at(i))
-            : _mm_xor_si128(sender0Messages.at(i), receiverMessages.at(i));
+        // k1 = k0 + delta1 / l1 = l0 + delta2
+        auto sender1Message = _mm_xor_si128(sender0Messages.at(i), delta_);
+        // r = lsb(lr) / p = lsb(kp)
+        bool a = util::getLsb(receiverMessages.at(i));
 
-        std::vector<bool> bBits(requestedTupleSize);
-        std::vector<bool> cBits(requestedTupleSize);
-        util::extractLnbToVector(b, bBits);
-        util::extractLnbToVector(c, cBits);
-        result[i] = CompositeBooleanTuple(a, bBits, cBits);
-      }
-    } else {
-      for (size_t i = 0; i < sender0Messages.size(); i++) {
         std::vector<bool> sender0Gen(requestedTupleSize);
         std::vector<bool> sender1Gen(requestedTupleSize);
         std::vector<bool> receiverGen(requestedTupleSize);
         // H(k0) / H(l0)
         util::AesPrg(sender0Messages.at(i)).getRandomBitsInPlace(sender0Gen);
         // H(k1) / H(l1)
-        util::AesPrg(sender1Messages.at(i)).getRandomBitsInPlace(sender1Gen);
+        util::AesPrg(sender1Message).getRandomBitsInPlace(sender1Gen);
         // H(lr) / H(kp)
         util::AesPrg(receiverMessages.at(i)).getRandomBitsInPlace(receiverGen);
 
-        auto a = choiceBits.at(i);
         std::vector<bool> b(requestedTupleSize);
         std::vector<bool> c(requestedTupleSize);
         for (size_t j = 0; j < requestedTupleSize; j++) {
@@ -259,6 +186,67 @@ TwoPartyTupleGenerator::expandRCOTResults(
         }
         result[i] = CompositeBooleanTuple(a, b, c);
       }
+      return result;
+    }
+  }
+
+  // The three hashes of a chunk are computed by a single call, so that the
+  // AES pipeline stays full and each message is only read once.
+  std::array<__m128i, 3 * kExpansionChunkSize> hashes;
+  for (size_t start = 0; start < sender0Messages.size();
+       start += kExpansionChunkSize) {
+    auto chunkSize =
+        std::min(kExpansionChunkSize, sender0Messages.size() - start);
+    auto sender0Hashes = hashes.data();
+    auto sender1Hashes = sender0Hashes + chunkSize;
+    auto receiverHashes = sender1Hashes + chunkSize;
+    std::array<bool, kExpansionChunkSize> choiceBits;
+    for (size_t i = 0; i < chunkSize; i++) {
+      sender0Hashes[i] = sender0Messages[start + i];
+      // k1 = k0 + delta1 / l1 = l0 + delta2
+      sender1Hashes[i] = _mm_xor_si128(sender0Messages[start + i], delta_);
+      receiverHashes[i] = receiverMessages[start + i];
+      // r = lsb(lr) / p = lsb(kp)
+      choiceBits[i] = util::getLsb(receiverMessages[start + i]);
+    }
+    // H(k0), H(k1), H(lr) / H(l0), H(l1), H(kp)
+    hashFromAes_.inPlaceHash(hashes.data(), 3 * chunkSize);
+
+    for (size_t i = 0; i < chunkSize; i++) {
+      if constexpr (!isComposite) {
+        // a1 = H(k0) ^ H(k1) / a2 = H(l0) ^ H(l1)
+        auto a =
+            util::getLsb(sender0Hashes[i]) ^ util::getLsb(sender1Hashes[i]);
+        // b1 = r / b2 = p
+        auto b = choiceBits[i];
+        // c1 = (H(k0) ^ H(k1)) & r ^ H(k0) + H(lr)
+        //    = H(kr) + H(lr) /
+        // c2 = (H(l0) ^ H(l1)) & p ^ H(l0) + H(kp)
+        //    = H(lp) + H(kp)
+        auto c = (a & b) ^ util::getLsb(sender0Hashes[i]) ^
+            util::getLsb(receiverHashes[i]);
+
+        result[start + i] = BooleanTuple(a, b, c);
+      } else {
+        // a1 = r / a2 = p
+        bool a = choiceBits[i];
+        // b1 = H(k0) ^ H(k1) / b2 = H(l0) ^ H(l1)
+        __m128i b = _mm_xor_si128(sender0Hashes[i], sender1Hashes[i]);
+        // c1 = (H(k0) ^ H(k1)) & r ^ H(k0) + H(lr)
+        //    = H(kr) + H(lr) /
+        // c2 = (H(l0) ^ H(l1)) & p ^ H(l0) + H(kp)
+        //    = H(lp) + H(kp)
+        __m128i c = a
+            ? _mm_xor_si128(
+                  _mm_xor_si128(b, sender0Hashes[i]), receiverHashes[i])
+            : _mm_xor_si128(sender0Hashes[i], receiverHashes[i]);
+
+        std::vector<bool> bBits(requestedTupleSize);
+        std::vector<bool> cBits(requestedTupleSize);
+        util::extractLnbToVector(b, bBits);
+        util::extractLnbToVector(c, cBits);
+        result[start + i] = CompositeBooleanTuple(a, bBits, cBits);
+      }
     }
   }
 
@@ -277,4 +265,13 @@ std::pair<uint64_t, uint64_t> TwoPartyTupleGenerator::getTrafficStatistics()
   return rst;
 }
 
+std::pair<uint64_t, uint64_t> TwoPartyTupleGenerator::getStallStatistics()
+    const {
+  auto booleanStats = booleanTupleBuffer_.getStallStatistics();
+  auto compositeStats = rcotBuffer_.getStallStatistics();
+  return {
+      booleanStats.first + compositeStats.first,
+      booleanStats.second + compositeStats.second};
+}
+
 } // namespace fbpcf::engine::tuple_generator
@@ -8,27 +8,44 @@
 #pragma once
 
 #include <emmintrin.h>
-#include <deque>
 #include <future>
-#include <mutex>
 #include <type_traits>
 
 #include "fbpcf/engine/tuple_generator/ITupleGenerator.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
 #include "fbpcf/engine/util/AsyncBuffer.h"
+#include "fbpcf/engine/util/BackgroundWorker.h"
 #include "fbpcf/engine/util/aes.h"
 
 namespace fbpcf::engine::tuple_generator {
 
+/**
+ * This object generates tuples from two RCOT instances, one in each
+ * direction. Tuples are produced in chunks of bufferSize by a background
+ * thread, which keeps working ahead of the caller up to a high-water mark and
+ * pauses once it is reached. The production starts right at construction, so
+ * the pool fills up while the parties are still e.g. loading their inputs.
+ */
 class TwoPartyTupleGenerator final : public ITupleGenerator {
  public:
+  /**
+   * @param bufferSize how many tuples to produce at a time.
+   * @param booleanHighWaterMark how many boolean tuples to keep ready or in
+   * production ahead of use, rounded up to whole chunks; at least one chunk.
+   * @param compositeHighWaterMark same as above, for the RCOTs backing
+   * composite tuples.
+   * Both parties must use the same buffer size and high-water marks, as they
+   * decide the order in which the RCOT instances are driven.
+   */
   TwoPartyTupleGenerator(
       std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
           senderRcot,
       std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
           receiverRcot,
       __m128i delta,
-      uint64_t bufferSize = kDefaultBufferSize);
+      uint64_t bufferSize = kDefaultBufferSize,
+      uint64_t booleanHighWaterMark = 0,
+      uint64_t compositeHighWaterMark = 0);
 
   /**
    * @inherit doc
@@ -60,6 +77,11 @@ class TwoPartyTupleGenerator final : public ITupleGenerator {
    */
   std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
 
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getStallStatistics() const override;
+
  private:
   inline std::vector<BooleanTuple> generateNormalTuples(uint64_t size);
   inline std::vector<std::pair<__m128i, __m128i>> generateRcotResults(
@@ -69,6 +91,9 @@ class TwoPartyTupleGenerator final : public ITupleGenerator {
   using TupleType = typename std::
       conditional<isComposite, CompositeBooleanTuple, BooleanTuple>::type;
 
+  // the number of RCOT results hashed together by expandRCOTResults()
+  static constexpr size_t kExpansionChunkSize = 256;
+
   template <bool isComposite>
   std::vector<TupleType<isComposite>> expandRCOTResults(
       std::vector<__m128i> sender0Messages,
@@ -76,11 +101,6 @@ class TwoPartyTupleGenerator final : public ITupleGenerator {
       size_t requestedTupleSize // ignored if isComposite = false
   );
 
-  enum ScheduledTupleType {
-    Boolean,
-    Composite,
-  };
-
   util::Aes hashFromAes_;
 
   std::unique_ptr<oblivious_transfer::IRandomCorrelatedObliviousTransfer>
@@ -89,9 +109,10 @@ class TwoPartyTupleGenerator final : public ITupleGenerator {
       receiverRcot_;
   __m128i delta_;
 
-  std::mutex scheduleMutex_;
-  std::condition_variable cv_;
-  std::deque<ScheduledTupleType> toGenerate_;
+  // both kinds of tuples share the RCOT instances, so they are produced by a
+  // single thread in the order the chunks are requested, which is the same
+  // for both parties. It must outlive the buffers below.
+  util::BackgroundWorker worker_;
 
   util::AsyncBuffer<BooleanTuple> booleanTupleBuffer_;
   util::AsyncBuffer<std::pair<__m128i, __m128i>> rcotBuffer_;
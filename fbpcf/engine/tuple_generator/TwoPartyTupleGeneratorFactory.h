@@ -19,17 +19,26 @@ namespace fbpcf::engine::tuple_generator {
 
 class TwoPartyTupleGeneratorFactory final : public ITupleGeneratorFactory {
  public:
+  /**
+   * @param booleanHighWaterMark how many boolean tuples each generator keeps
+   * ready ahead of use, see TwoPartyTupleGenerator.
+   * @param compositeHighWaterMark same as above, for composite tuples.
+   */
   TwoPartyTupleGeneratorFactory(
       std::unique_ptr<
           oblivious_transfer::IRandomCorrelatedObliviousTransferFactory>
           rcotFactory,
       communication::IPartyCommunicationAgentFactory& agentFactory,
       int myId,
-      uint64_t bufferSize)
+      uint64_t bufferSize,
+      uint64_t booleanHighWaterMark = 0,
+      uint64_t compositeHighWaterMark = 0)
       : rcotFactory_{std::move(rcotFactory)},
         agentFactory_{agentFactory},
         myId_(myId),
-        bufferSize_(bufferSize) {}
+        bufferSize_(bufferSize),
+        booleanHighWaterMark_(booleanHighWaterMark),
+        compositeHighWaterMark_(compositeHighWaterMark) {}
 
   /**
    * Create a two party tuple generator.
@@ -62,7 +71,12 @@ class TwoPartyTupleGeneratorFactory final : public ITupleGeneratorFactory {
     }
 
     return std::make_unique<TwoPartyTupleGenerator>(
-        std::move(senderRcot), std::move(receiverRcot), delta, bufferSize_);
+        std::move(senderRcot),
+        std::move(receiverRcot),
+        delta,
+        bufferSize_,
+        booleanHighWaterMark_,
+        compositeHighWaterMark_);
   }
 
  private:
@@ -71,6 +85,8 @@ class TwoPartyTupleGeneratorFactory final : public ITupleGeneratorFactory {
   communication::IPartyCommunicationAgentFactory& agentFactory_;
   int myId_;
   uint64_t bufferSize_;
+  uint64_t booleanHighWaterMark_;
+  uint64_t compositeHighWaterMark_;
 };
 
 } // namespace fbpcf::engine::tuple_generator
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/CoBaseObliviousTransfer.h"
+#include <emmintrin.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+CoBaseObliviousTransfer::CoBaseObliviousTransfer(
+    std::unique_ptr<communication::IPartyCommunicationAgent> agent)
+    : agent_{std::move(agent)} {
+  // P-256 has an optimized constant-time implementation in OpenSSL,
+  // including precomputed tables for multiplications of the generator.
+  group_ = std::unique_ptr<EC_GROUP, std::function<void(EC_GROUP*)>>(
+      EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1), EC_GROUP_clear_free);
+  if (group_ == nullptr) {
+    throw std::runtime_error("Failed to create group.");
+  }
+  order_ = BigNumberPointer(BN_new(), BN_free);
+  ContextPointer ctx(BN_CTX_new(), BN_CTX_free);
+  if (order_ == nullptr || ctx == nullptr) {
+    throw std::runtime_error("Failed to initialize.");
+  }
+  if (EC_GROUP_get_order(group_.get(), order_.get(), ctx.get()) != 1) {
+    throw std::runtime_error("Failed to get group order.");
+  }
+  encodedPointSize_ = EC_POINT_point2oct(
+      group_.get(),
+      EC_GROUP_get0_generator(group_.get()),
+      POINT_CONVERSION_COMPRESSED,
+      nullptr,
+      0,
+      ctx.get());
+  if (encodedPointSize_ == 0) {
+    throw std::runtime_error("Failed to get the size of encoded points.");
+  }
+}
+
+CoBaseObliviousTransfer::PointPointer CoBaseObliviousTransfer::createPoint()
+    const {
+  PointPointer rst(EC_POINT_new(group_.get()), EC_POINT_free);
+  if (rst == nullptr) {
+    throw std::runtime_error("Failed to create point.");
+  }
+  return rst;
+}
+
+CoBaseObliviousTransfer::BigNumberPointer
+CoBaseObliviousTransfer::generateRandomScalar() const {
+  BigNumberPointer rst(BN_new(), BN_free);
+  if (rst == nullptr) {
+    throw std::runtime_error("Failed to create big number.");
+  }
+  // a random number in [1, q - 1], so that the points are never the identity
+  do {
+    if (BN_rand_range(rst.get(), order_.get()) != 1) {
+      throw std::runtime_error("Failed to generate a random big number.");
+    }
+  } while (BN_is_zero(rst.get()));
+  return rst;
+}
+
+std::vector<unsigned char> CoBaseObliviousTransfer::encodePoints(
+    const std::vector<PointPointer>& points,
+    BN_CTX* ctx) const {
+  std::vector<EC_POINT*> rawPoints(points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    rawPoints[i] = points[i].get();
+  }
+  // one field inversion for the whole batch rather than one per point.
+  if (!points.empty() &&
+      EC_POINTs_make_affine(
+          group_.get(), rawPoints.size(), rawPoints.data(), ctx) != 1) {
+    throw std::runtime_error("Failed to convert points to affine.");
+  }
+  std::vector<unsigned char> rst(points.size() * encodedPointSize_);
+  for (size_t i = 0; i < points.size(); i++) {
+    if (EC_POINT_point2oct(
+            group_.get(),
+            points[i].get(),
+            POINT_CONVERSION_COMPRESSED,
+            rst.data() + i * encodedPointSize_,
+            encodedPointSize_,
+            ctx) != encodedPointSize_) {
+      throw std::runtime_error("Failed to encode point.");
+    }
+  }
+  return rst;
+}
+
+std::vector<CoBaseObliviousTransfer::PointPointer>
+CoBaseObliviousTransfer::decodePoints(
+    const std::vector<unsigned char>& data,
+    size_t size,
+    BN_CTX* ctx) const {
+  if (data.size() != size * encodedPointSize_) {
+    throw std::runtime_error("Unexpected size of encoded points.");
+  }
+  std::vector<PointPointer> rst;
+  rst.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    rst.push_back(createPoint());
+    // this also checks the point is on the curve.
+    if (EC_POINT_oct2point(
+            group_.get(),
+            rst[i].get(),
+            data.data() + i * encodedPointSize_,
+            encodedPointSize_,
+            ctx) != 1) {
+      throw std::runtime_error("Failed to decode point.");
+    }
+  }
+  return rst;
+}
+
+__m128i CoBaseObliviousTransfer::hashPoint(
+    const unsigned char* encodedA,
+    const unsigned char* encodedB,
+    const unsigned char* encodedPoint,
+    uint64_t index) const {
+  SHA256_CTX shaCtx;
+  std::vector<unsigned char> digest(SHA256_DIGEST_LENGTH);
+  if (SHA256_Init(&shaCtx) != 1 ||
+      SHA256_Update(&shaCtx, encodedA, encodedPointSize_) != 1 ||
+      SHA256_Update(&shaCtx, encodedB, encodedPointSize_) != 1 ||
+      SHA256_Update(&shaCtx, encodedPoint, encodedPointSize_) != 1 ||
+      SHA256_Update(&shaCtx, &index, sizeof(index)) != 1 ||
+      SHA256_Final(digest.data(), &shaCtx) != 1) {
+    throw std::runtime_error("Failed to hash point.");
+  }
+  __m128i rst;
+  std::memcpy(&rst, digest.data(), sizeof(rst));
+  return rst;
+}
+
+std::pair<std::vector<__m128i>, std::vector<__m128i>>
+CoBaseObliviousTransfer::send(size_t size) {
+  ContextPointer ctx(BN_CTX_new(), BN_CTX_free);
+  if (ctx == nullptr) {
+    throw std::runtime_error("Failed to create BN_CTX.");
+  }
+
+  // A = g^a is shared by all the OTs in this batch.
+  auto a = generateRandomScalar();
+  std::vector<PointPointer> publicKey;
+  publicKey.push_back(createPoint());
+  if (EC_POINT_mul(
+          group_.get(),
+          publicKey[0].get(),
+          a.get(),
+          nullptr,
+          nullptr,
+          ctx.get()) != 1) {
+    throw std::runtime_error("Failed to compute A.");
+  }
+  auto encodedA = encodePoints(publicKey, ctx.get());
+  agent_->send(encodedA);
+
+  // -A^a, to turn B^a into (B / A)^a
+  auto negatedT = createPoint();
+  if (EC_POINT_mul(
+          group_.get(),
+          negatedT.get(),
+          nullptr,
+          publicKey[0].get(),
+          a.get(),
+          ctx.get()) != 1 ||
+      EC_POINT_invert(group_.get(), negatedT.get(), ctx.get()) != 1) {
+    throw std::runtime_error("Failed to compute A^a.");
+  }
+
+  auto encodedB = agent_->receive(size * encodedPointSize_);
+  auto b = decodePoints(encodedB, size, ctx.get());
+
+  // t[0][i] = B[i]^a, t[1][i] = (B[i] / A)^a
+  std::vector<PointPointer> t0;
+  std::vector<PointPointer> t1;
+  t0.reserve(size);
+  t1.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    t0.push_back(createPoint());
+    t1.push_back(createPoint());
+    if (EC_POINT_mul(
+            group_.get(),
+            t0[i].get(),
+            nullptr,
+            b[i].get(),
+            a.get(),
+            ctx.get()) != 1) {
+      throw std::runtime_error("Failed to compute t[0][i].");
+    }
+    if (EC_POINT_add(
+            group_.get(),
+            t1[i].get(),
+            t0[i].get(),
+            negatedT.get(),
+            ctx.get()) != 1) {
+      throw std::runtime_error("Failed to compute t[1][i].");
+    }
+  }
+  auto encodedT0 = encodePoints(t0, ctx.get());
+  auto encodedT1 = encodePoints(t1, ctx.get());
+
+  std::vector<__m128i> m0(size);
+  std::vector<__m128i> m1(size);
+  for (size_t i = 0; i < size; i++) {
+    auto offset = i * encodedPointSize_;
+    m0[i] = hashPoint(
+        encodedA.data(),
+        encodedB.data() + offset,
+        encodedT0.data() + offset,
+        i);
+    m1[i] = hashPoint(
+        encodedA.data(),
+        encodedB.data() + offset,
+        encodedT1.data() + offset,
+        i);
+  }
+  return {std::move(m0), std::move(m1)};
+}
+
+std::vector<__m128i> CoBaseObliviousTransfer::receive(
+    const std::vector<bool>& choice) {
+  size_t size = choice.size();
+  ContextPointer ctx(BN_CTX_new(), BN_CTX_free);
+  if (ctx == nullptr) {
+    throw std::runtime_error("Failed to create BN_CTX.");
+  }
+
+  auto encodedA = agent_->receive(encodedPointSize_);
+  auto publicKey = decodePoints(encodedA, 1, ctx.get());
+
+  // B[i] = g^b[i] if choice[i] is 0, A * g^b[i] otherwise.
+  std::vector<BigNumberPointer> randomBs;
+  std::vector<PointPointer> b;
+  std::vector<PointPointer> shifted;
+  randomBs.reserve(size);
+  b.reserve(size);
+  shifted.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    randomBs.push_back(generateRandomScalar());
+    b.push_back(createPoint());
+    shifted.push_back(createPoint());
+    if (EC_POINT_mul(
+            group_.get(),
+            b[i].get(),
+            randomBs[i].get(),
+            nullptr,
+            nullptr,
+            ctx.get()) != 1) {
+      throw std::runtime_error("Failed to compute g^b[i].");
+    }
+    if (EC_POINT_add(
+            group_.get(),
+            shifted[i].get(),
+            b[i].get(),
+            publicKey[0].get(),
+            ctx.get()) != 1) {
+      throw std::runtime_error("Failed to compute A * g^b[i].");
+    }
+  }
+  // both candidates are computed and encoded, and the encoding to send is
+  // selected with a mask rather than a branch, so that neither the timing nor
+  // the memory accesses depend on the choice.
+  auto encodedB = encodePoints(b, ctx.get());
+  auto encodedShifted = encodePoints(shifted, ctx.get());
+  for (size_t i = 0; i < size; i++) {
+    auto mask = static_cast<unsigned char>(-static_cast<int>(choice[i]));
+    auto offset = i * encodedPointSize_;
+    for (size_t j = 0; j < encodedPointSize_; j++) {
+      encodedB[offset + j] ^=
+          mask & (encodedB[offset + j] ^ encodedShifted[offset + j]);
+    }
+  }
+  agent_->send(encodedB);
+
+  // A^b[i]: all the multiplications share the base A, so A is made the
+  // generator of a copy of the group and gets the same precomputed tables as
+  // the actual generator.
+  std::unique_ptr<EC_GROUP, std::function<void(EC_GROUP*)>> groupOfA(
+      EC_GROUP_dup(group_.get()), EC_GROUP_clear_free);
+  if (groupOfA == nullptr ||
+      EC_GROUP_set_generator(
+          groupOfA.get(),
+          publicKey[0].get(),
+          order_.get(),
+          EC_GROUP_get0_cofactor(group_.get())) != 1 ||
+      EC_GROUP_precompute_mult(groupOfA.get(), ctx.get()) != 1) {
+    throw std::runtime_error("Failed to precompute the multiples of A.");
+  }
+  std::vector<PointPointer> keys;
+  keys.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    keys.push_back(createPoint());
+    if (EC_POINT_mul(
+            groupOfA.get(),
+            keys[i].get(),
+            randomBs[i].get(),
+            nullptr,
+            nullptr,
+            ctx.get()) != 1) {
+      throw std::runtime_error("Failed to compute A^b[i].");
+    }
+  }
+  auto encodedKeys = encodePoints(keys, ctx.get());
+
+  std::vector<__m128i> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    auto offset = i * encodedPointSize_;
+    rst[i] = hashPoint(
+        encodedA.data(),
+        encodedB.data() + offset,
+        encodedKeys.data() + offset,
+        i);
+  }
+  return rst;
+}
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IBaseObliviousTransfer.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+/**
+ * This is a CO(CO stands for the authors' names - Chou and Orlandi) base
+ * oblivious transfer object. This is an implementation for paper 'The
+ * Simplest Protocol for Oblivious Transfer' by Tung Chou and Claudio Orlandi.
+ * Link to the paper: https://eprint.iacr.org/2015/267.pdf
+ *
+ * Compared to Naor-Pinkas, the sender does a single variable-base scalar
+ * multiplication per OT instead of two plus a fixed-base one, and the whole
+ * batch is exchanged in one message of compressed points each way.
+ */
+class CoBaseObliviousTransfer final : public IBaseObliviousTransfer {
+ public:
+  explicit CoBaseObliviousTransfer(
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent);
+
+  /**
+   * @inherit doc
+   */
+  std::pair<std::vector<__m128i>, std::vector<__m128i>> send(
+      size_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> receive(const std::vector<bool>& choice) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return agent_->getTrafficStatistics();
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::unique_ptr<communication::IPartyCommunicationAgent>
+  extractCommunicationAgent() override {
+    return std::move(agent_);
+  }
+
+ private:
+  using PointPointer =
+      std::unique_ptr<EC_POINT, std::function<void(EC_POINT*)>>;
+  using BigNumberPointer =
+      std::unique_ptr<BIGNUM, std::function<void(BIGNUM*)>>;
+  using ContextPointer = std::unique_ptr<BN_CTX, std::function<void(BN_CTX*)>>;
+
+  PointPointer createPoint() const;
+  BigNumberPointer generateRandomScalar() const;
+
+  // serialize the points in compressed form, converting them to affine
+  // coordinates as a batch.
+  std::vector<unsigned char> encodePoints(
+      const std::vector<PointPointer>& points,
+      BN_CTX* ctx) const;
+  std::vector<PointPointer> decodePoints(
+      const std::vector<unsigned char>& data,
+      size_t size,
+      BN_CTX* ctx) const;
+
+  // H(A, B, point, index), from the encodings of the points
+  __m128i hashPoint(
+      const unsigned char* encodedA,
+      const unsigned char* encodedB,
+      const unsigned char* encodedPoint,
+      uint64_t index) const;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
+
+  std::unique_ptr<EC_GROUP, std::function<void(EC_GROUP*)>> group_;
+  BigNumberPointer order_;
+  size_t encodedPointSize_;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
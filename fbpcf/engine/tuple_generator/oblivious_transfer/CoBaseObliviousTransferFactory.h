@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/CoBaseObliviousTransfer.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IBaseObliviousTransferFactory.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+/**
+ * Create a base oblivious transfer with a particular party.
+ * Some implementation may need party id to decide parties' roles in the
+ * underlying protocol.
+ */
+class CoBaseObliviousTransferFactory final
+    : public IBaseObliviousTransferFactory {
+ public:
+  explicit CoBaseObliviousTransferFactory() {}
+
+  std::unique_ptr<IBaseObliviousTransfer> create(
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent) override {
+    return std::make_unique<CoBaseObliviousTransfer>(std::move(agent));
+  }
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomVectorOle.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+namespace {
+
+// move the last size items of src to a new vector
+std::vector<uint64_t> takeLast(std::vector<uint64_t>& src, size_t size) {
+  std::vector<uint64_t> rst(src.end() - size, src.end());
+  src.erase(src.end() - size, src.end());
+  return rst;
+}
+
+void append(
+    std::vector<uint64_t>& dst,
+    const std::vector<uint64_t>& src,
+    size_t index,
+    size_t size) {
+  dst.insert(dst.end(), src.begin() + index, src.begin() + index + size);
+}
+
+} // namespace
+
+ExtenderBasedRandomVectorOle::ExtenderBasedRandomVectorOle(
+    util::Role role,
+    std::unique_ptr<ferret::VoleExtender> extender,
+    std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot)
+    : role_(role), extender_(std::move(extender)), rcot_(std::move(rcot)) {}
+
+void ExtenderBasedRandomVectorOle::setBaseVoleResults(
+    std::vector<uint64_t>&& baseW) {
+  if (role_ != util::Role::sender ||
+      static_cast<int64_t>(baseW.size()) !=
+          getNumberOfBaseVoleResultsNeeded()) {
+    throw std::invalid_argument("Unexpected base VOLE results.");
+  }
+  baseW_ = std::move(baseW);
+  extendVole();
+}
+
+void ExtenderBasedRandomVectorOle::setBaseVoleResults(
+    std::vector<uint64_t>&& baseU,
+    std::vector<uint64_t>&& baseV) {
+  if (role_ != util::Role::receiver ||
+      static_cast<int64_t>(baseU.size()) !=
+          getNumberOfBaseVoleResultsNeeded() ||
+      static_cast<int64_t>(baseV.size()) !=
+          getNumberOfBaseVoleResultsNeeded()) {
+    throw std::invalid_argument("Unexpected base VOLE results.");
+  }
+  baseU_ = std::move(baseU);
+  baseV_ = std::move(baseV);
+  extendVole();
+}
+
+std::vector<uint64_t> ExtenderBasedRandomVectorOle::senderVole(int64_t size) {
+  if (role_ != util::Role::sender) {
+    throw std::runtime_error("This VOLE object is not a sender.");
+  }
+  std::vector<uint64_t> rst;
+  rst.reserve(size);
+  while (static_cast<int64_t>(rst.size()) < size) {
+    if (voleIndex_ >= w_.size()) {
+      extendVole();
+    }
+    auto insertSize =
+        std::min<size_t>(size - rst.size(), w_.size() - voleIndex_);
+    append(rst, w_, voleIndex_, insertSize);
+    voleIndex_ += insertSize;
+  }
+  return rst;
+}
+
+std::pair<std::vector<uint64_t>, std::vector<uint64_t>>
+ExtenderBasedRandomVectorOle::receiverVole(int64_t size) {
+  if (role_ != util::Role::receiver) {
+    throw std::runtime_error("This VOLE object is not a receiver.");
+  }
+  std::vector<uint64_t> u;
+  std::vector<uint64_t> v;
+  u.reserve(size);
+  v.reserve(size);
+  while (static_cast<int64_t>(u.size()) < size) {
+    if (voleIndex_ >= u_.size()) {
+      extendVole();
+    }
+    auto insertSize = std::min<size_t>(size - u.size(), u_.size() - voleIndex_);
+    append(u, u_, voleIndex_, insertSize);
+    append(v, v_, voleIndex_, insertSize);
+    voleIndex_ += insertSize;
+  }
+  return {std::move(u), std::move(v)};
+}
+
+void ExtenderBasedRandomVectorOle::extendVole() {
+  auto baseVoleSize = extender_->getBaseVoleSize();
+  auto baseCot = rcot_->rcot(extender_->getBaseCotSize());
+
+  // keep the last part of the output as the base of the next extension.
+  switch (role_) {
+    case util::Role::sender:
+      w_ = extender_->senderExtend(std::move(baseW_), std::move(baseCot));
+      baseW_ = takeLast(w_, baseVoleSize);
+      break;
+    case util::Role::receiver:
+      std::tie(u_, v_) = extender_->receiverExtend(
+          std::move(baseU_), std::move(baseV_), std::move(baseCot));
+      baseU_ = takeLast(u_, baseVoleSize);
+      baseV_ = takeLast(v_, baseVoleSize);
+      break;
+  }
+  voleIndex_ = 0;
+}
+
+std::pair<uint64_t, uint64_t>
+ExtenderBasedRandomVectorOle::getTrafficStatistics() const {
+  auto rcotTraffic = rcot_->getTrafficStatistics();
+  auto extenderTraffic = extender_->getTrafficStatistics();
+  return {
+      rcotTraffic.first + extenderTraffic.first,
+      rcotTraffic.second + extenderTraffic.second};
+}
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomVectorOle.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/VoleExtender.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+/**
+ * A random VOLE from a VOLE extender. Like the extender based RCOT, it keeps
+ * part of each extension as the base of the next one, and draws the COTs the
+ * extender needs for its GGM trees from an RCOT.
+ */
+class ExtenderBasedRandomVectorOle final : public IRandomVectorOle {
+ public:
+  ExtenderBasedRandomVectorOle(
+      util::Role role,
+      std::unique_ptr<ferret::VoleExtender> extender,
+      std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot);
+
+  // get how many base VOLE results are needed to bootstrap the extender.
+  int64_t getNumberOfBaseVoleResultsNeeded() const {
+    return extender_->getBaseVoleSize();
+  }
+
+  // set the sender's base VOLE results, this function only needs to be called
+  // once.
+  void setBaseVoleResults(std::vector<uint64_t>&& baseW);
+
+  // set the receiver's base VOLE results, this function only needs to be
+  // called once.
+  void setBaseVoleResults(
+      std::vector<uint64_t>&& baseU,
+      std::vector<uint64_t>&& baseV);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> senderVole(int64_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<std::vector<uint64_t>, std::vector<uint64_t>> receiverVole(
+      int64_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
+
+ private:
+  void extendVole();
+
+  util::Role role_;
+  std::unique_ptr<ferret::VoleExtender> extender_;
+  std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot_;
+
+  // base VOLE for future iterations, the sender only uses w.
+  std::vector<uint64_t> baseU_;
+  std::vector<uint64_t> baseV_;
+  std::vector<uint64_t> baseW_;
+
+  // buffered VOLE results
+  std::vector<uint64_t> u_;
+  std::vector<uint64_t> v_;
+  std::vector<uint64_t> w_;
+  size_t voleIndex_ = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
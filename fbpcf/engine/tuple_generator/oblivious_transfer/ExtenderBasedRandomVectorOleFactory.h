@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomVectorOle.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomVectorOleFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedRandomVectorOle.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMultiPointCotFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/VoleExtender.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+class ExtenderBasedRandomVectorOleFactory final
+    : public IRandomVectorOleFactory {
+ public:
+  /**
+   * @param rcotFactory factory of the RCOT that bootstraps the VOLE and feeds
+   * the GGM trees of every extension afterwards.
+   * @param multiPointCotFactory the multi-point COT placing the noise.
+   * @param extendedSize a parameter for the extender
+   * @param baseSize a parameter for the extender
+   * @param weight a parameter for the extender
+   */
+  ExtenderBasedRandomVectorOleFactory(
+      std::unique_ptr<IRandomCorrelatedObliviousTransferFactory> rcotFactory,
+      std::unique_ptr<ferret::IMultiPointCotFactory> multiPointCotFactory,
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId,
+      int64_t extendedSize,
+      int64_t baseSize,
+      int64_t weight)
+      : rcotFactory_(std::move(rcotFactory)),
+        multiPointCotFactory_(std::move(multiPointCotFactory)),
+        agentFactory_(agentFactory),
+        myId_(myId),
+        extendedSize_(extendedSize),
+        baseSize_(baseSize),
+        weight_(weight) {}
+
+  std::unique_ptr<IRandomVectorOle> create(uint64_t delta) override {
+    auto rcotDelta = util::getRandomM128iFromSystemNoise();
+    util::setLsbTo1(rcotDelta);
+    auto rcot = rcotFactory_->create(
+        rcotDelta, agentFactory_.create(1 - myId_, "vole_rcot_traffic"));
+    RcotBasedRandomVectorOle bootstrapper(
+        delta,
+        rcotDelta,
+        std::move(rcot),
+        agentFactory_.create(1 - myId_, "vole_traffic"));
+    auto baseVoleResults = bootstrapper.senderVole(baseSize_ + weight_);
+
+    auto extender = std::make_unique<ferret::VoleExtender>(
+        bootstrapper.extractCommunicationAgent(), *multiPointCotFactory_);
+    extender->senderInit(rcotDelta, extendedSize_, baseSize_, weight_);
+    auto vole = std::make_unique<ExtenderBasedRandomVectorOle>(
+        util::Role::sender, std::move(extender), bootstrapper.extractRcot());
+    vole->setBaseVoleResults(std::move(baseVoleResults));
+    return vole;
+  }
+
+  std::unique_ptr<IRandomVectorOle> create() override {
+    auto rcot = rcotFactory_->create(
+        agentFactory_.create(1 - myId_, "vole_rcot_traffic"));
+    RcotBasedRandomVectorOle bootstrapper(
+        std::move(rcot), agentFactory_.create(1 - myId_, "vole_traffic"));
+    auto [baseU, baseV] = bootstrapper.receiverVole(baseSize_ + weight_);
+
+    auto extender = std::make_unique<ferret::VoleExtender>(
+        bootstrapper.extractCommunicationAgent(), *multiPointCotFactory_);
+    extender->receiverInit(extendedSize_, baseSize_, weight_);
+    auto vole = std::make_unique<ExtenderBasedRandomVectorOle>(
+        util::Role::receiver, std::move(extender), bootstrapper.extractRcot());
+    vole->setBaseVoleResults(std::move(baseU), std::move(baseV));
+    return vole;
+  }
+
+ private:
+  std::unique_ptr<IRandomCorrelatedObliviousTransferFactory> rcotFactory_;
+  std::unique_ptr<ferret::IMultiPointCotFactory> multiPointCotFactory_;
+  communication::IPartyCommunicationAgentFactory& agentFactory_;
+  int myId_;
+  int64_t extendedSize_;
+  int64_t baseSize_;
+  int64_t weight_;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+/**
+ * The Random Vector Oblivious Linear Evaluation (VOLE) API over Z_2^64.
+ * The sender holds a global delta and gets a vector w, the receiver gets two
+ * vectors u and v, such that w[i] = v[i] + u[i] * delta (mod 2^64) where u is
+ * random. It's the arithmetic counterpart of RCOT: every element carries a
+ * 64-bit correlation instead of a single bit.
+ */
+class IRandomVectorOle {
+ public:
+  virtual ~IRandomVectorOle() = default;
+
+  /**
+   * Sender's API to run a number of random VOLE.
+   * @param size: number of VOLE results to generate
+   * @return : w
+   */
+  virtual std::vector<uint64_t> senderVole(int64_t size) = 0;
+
+  /**
+   * Receiver's API to run a number of random VOLE.
+   * @param size: number of VOLE results to generate
+   * @return : u and v
+   */
+  virtual std::pair<std::vector<uint64_t>, std::vector<uint64_t>> receiverVole(
+      int64_t size) = 0;
+
+  /**
+   * Get the total amount of traffic transmitted.
+   * @return a pair of (sent, received) data in bytes.
+   */
+  virtual std::pair<uint64_t, uint64_t> getTrafficStatistics() const = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomVectorOle.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+class IRandomVectorOleFactory {
+ public:
+  virtual ~IRandomVectorOleFactory() = default;
+
+  /**
+   * Construct sender
+   */
+  virtual std::unique_ptr<IRandomVectorOle> create(uint64_t delta) = 0;
+
+  /**
+   * Construct receiver
+   */
+  virtual std::unique_ptr<IRandomVectorOle> create() = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
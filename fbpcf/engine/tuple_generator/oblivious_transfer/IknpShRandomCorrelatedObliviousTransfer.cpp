@@ -7,9 +7,12 @@
 
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransfer.h"
 #include <emmintrin.h>
+#include <immintrin.h>
 #include <sys/types.h>
+#include <cstring>
 #include <stdexcept>
 #include "fbpcf/engine/util/util.h"
+#include "fbpcf/system/CpuUtil.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer {
 
@@ -63,100 +66,304 @@ IknpShRandomCorrelatedObliviousTransfer::
   role_ = util::Role::receiver;
 }
 
-std::vector<__m128i> IknpShRandomCorrelatedObliviousTransfer::matrixTranspose(
-    const std::vector<__m128i>& src) {
-  // ensure the size of src is a multiplication of 128
-  assert((src.size() & 0x7F) == 0);
-  std::vector<__m128i> rst(src.size());
+namespace {
 
-  /**
-   *The matrix transpose is done with SIMD instructions.
-   *This function deals with 128 by 128 bit matrixes. Each 128 __m128i values
-   *in the input vector represents 1 such matrix to be transposed. The output
-   *will be the transposed 128 by 128 bit matrixes. Decomposing a byte into bits
-   *is extremely expensive compared to SIMD instructions. Therefore we leverage
-   *the instruction _mm_movemask_epi8() to do this. _mm_movemask_epi8() takes
-   *the msb of each byte in the input and put these bits together into a 16bit
-   *word. Therefore, we want to collect the first bytes of all __m128is, the
-   *second bytes of all __m128is... This is done by using unpackhi/lo family
-   *instructions. These instructions takes in two
-   *__m128i inputs, and take the first/last significant 8/16/32/64-bit words of
-   *these two inputs. For example, the first 2 bytes of the output of
-   *_mm_unpackhi_epi8() are the first bytes of some original inputs; sending the
-   *outputs of _mm_unpackhi_epi8() to _mm_unpackhi_epi16(), this instruction's
-   *output's first 4 bytes will be the first bytes of some original inputs. With
-   *4 rounds of iteration, we can get vectors of all first/second/third bytes of
-   *original inputs. Then we can use _mm_movemask_epi8() to collect the msb of
-   *these bytes, and use _mm_slli_epi16 to shift the bytes left after collecting
-   *all the msbs. This procedure can be repeats until all the bits in each byte
-   *are processed.
-   **/
-
-  for (size_t index = 0; index < src.size(); index += 128) {
-    std::array<__m128i, 128> buffer0;
-    std::array<__m128i, 128> buffer1;
-
-    for (int i = 0; i < 64; i++) {
-      buffer0[i] =
-          _mm_unpacklo_epi8(src.at(index + 2 * i), src.at(index + 2 * i + 1));
-
-      buffer0[i + 64] =
-          _mm_unpackhi_epi8(src.at(index + 2 * i), src.at(index + 2 * i + 1));
-    }
-
-    for (int j = 0; j < 2; j++) {
-      for (int i = 0; i < 32; i++) {
-        buffer1[i + (j << 6) /* j * 64 */] = _mm_unpacklo_epi16(
-            buffer0.at((i << 1) /* 2 * i */ + (j << 6) /* j * 64 */),
-            buffer0.at((i << 1) /* 2 * i */ + 1 + (j << 6) /* j * 64 */));
-
-        buffer1[i + (j << 6) /* j * 64 */ + 32] = _mm_unpackhi_epi16(
-            buffer0.at((i << 1) /* 2 * i */ + (j << 6) /* j * 64 */),
-            buffer0.at((i << 1) /* 2 * i */ + 1 + (j << 6) /* j * 64 */));
-      }
+/**
+ *The matrix transpose is done with SIMD instructions.
+ *This function deals with one 128 by 128 bit matrix, i.e. 128 __m128i values
+ *from src, and writes the transposed matrix to dst. Decomposing a byte into
+ *bits is extremely expensive compared to SIMD instructions. Therefore we
+ *leverage the instruction _mm_movemask_epi8() to do this. _mm_movemask_epi8()
+ *takes the msb of each byte in the input and put these bits together into a
+ *16bit word. Therefore, we want to collect the first bytes of all __m128is, the
+ *second bytes of all __m128is... This is done by using unpackhi/lo family
+ *instructions. These instructions takes in two
+ *__m128i inputs, and take the first/last significant 8/16/32/64-bit words of
+ *these two inputs. For example, the first 2 bytes of the output of
+ *_mm_unpackhi_epi8() are the first bytes of some original inputs; sending the
+ *outputs of _mm_unpackhi_epi8() to _mm_unpackhi_epi16(), this instruction's
+ *output's first 4 bytes will be the first bytes of some original inputs. With
+ *4 rounds of iteration, we can get vectors of all first/second/third bytes of
+ *original inputs. Then we can use _mm_movemask_epi8() to collect the msb of
+ *these bytes, and use _mm_slli_epi16 to shift the bytes left after collecting
+ *all the msbs. This procedure can be repeats until all the bits in each byte
+ *are processed.
+ **/
+void transposeOneMatrix(const __m128i* src, __m128i* dst) {
+  std::array<__m128i, 128> buffer0;
+  std::array<__m128i, 128> buffer1;
+
+  for (int i = 0; i < 64; i++) {
+    buffer0[i] = _mm_unpacklo_epi8(src[2 * i], src[2 * i + 1]);
+    buffer0[i + 64] = _mm_unpackhi_epi8(src[2 * i], src[2 * i + 1]);
+  }
+
+  for (int j = 0; j < 2; j++) {
+    for (int i = 0; i < 32; i++) {
+      buffer1[i + (j << 6) /* j * 64 */] = _mm_unpacklo_epi16(
+          buffer0[(i << 1) /* 2 * i */ + (j << 6) /* j * 64 */],
+          buffer0[(i << 1) /* 2 * i */ + 1 + (j << 6) /* j * 64 */]);
+
+      buffer1[i + (j << 6) /* j * 64 */ + 32] = _mm_unpackhi_epi16(
+          buffer0[(i << 1) /* 2 * i */ + (j << 6) /* j * 64 */],
+          buffer0[(i << 1) /* 2 * i */ + 1 + (j << 6) /* j * 64 */]);
     }
+  }
 
-    for (int j = 0; j < 4; j++) {
-      for (int i = 0; i < 16; i++) {
-        buffer0[i + (j << 5) /* j * 32 */] = _mm_unpacklo_epi32(
-            buffer1.at((i << 1) /* 2 * i */ + (j << 5) /* j * 32 */),
-            buffer1.at((i << 1) /* 2 * i */ + 1 + (j << 5) /* j * 32 */));
+  for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < 16; i++) {
+      buffer0[i + (j << 5) /* j * 32 */] = _mm_unpacklo_epi32(
+          buffer1[(i << 1) /* 2 * i */ + (j << 5) /* j * 32 */],
+          buffer1[(i << 1) /* 2 * i */ + 1 + (j << 5) /* j * 32 */]);
 
-        buffer0[i + (j << 5) /* j * 32 */ + 16] = _mm_unpackhi_epi32(
-            buffer1.at((i << 1) /* 2 * i */ + (j << 5) /* j * 32 */),
-            buffer1.at((i << 1) /* 2 * i */ + 1 + (j << 5) /* j * 32 */));
-      }
+      buffer0[i + (j << 5) /* j * 32 */ + 16] = _mm_unpackhi_epi32(
+          buffer1[(i << 1) /* 2 * i */ + (j << 5) /* j * 32 */],
+          buffer1[(i << 1) /* 2 * i */ + 1 + (j << 5) /* j * 32 */]);
     }
+  }
 
-    for (int j = 0; j < 8; j++) {
-      for (int i = 0; i < 8; i++) {
-        buffer1[i + (j << 4) /* j * 16 */] = _mm_unpacklo_epi64(
-            buffer0.at((i << 1) /* 2 * i */ + (j << 4) /* j * 16 */),
-            buffer0.at((i << 1) /* 2 * i */ + 1 + (j << 4) /* j * 16 */));
+  for (int j = 0; j < 8; j++) {
+    for (int i = 0; i < 8; i++) {
+      buffer1[i + (j << 4) /* j * 16 */] = _mm_unpacklo_epi64(
+          buffer0[(i << 1) /* 2 * i */ + (j << 4) /* j * 16 */],
+          buffer0[(i << 1) /* 2 * i */ + 1 + (j << 4) /* j * 16 */]);
 
-        buffer1[i + (j << 4) /* j * 16 */ + 8] = _mm_unpackhi_epi64(
-            buffer0.at((i << 1) /* 2 * i */ + (j << 4) /* j * 16 */),
-            buffer0.at((i << 1) /* 2 * i */ + 1 + (j << 4) /* j * 16 */));
-      }
+      buffer1[i + (j << 4) /* j * 16 */ + 8] = _mm_unpackhi_epi64(
+          buffer0[(i << 1) /* 2 * i */ + (j << 4) /* j * 16 */],
+          buffer0[(i << 1) /* 2 * i */ + 1 + (j << 4) /* j * 16 */]);
     }
+  }
 
-    for (int i = 7; i >= 0; i--) {
-      for (int j = 15; j >= 0; j--) {
-        rst[index + ((j << 3) + i)] = _mm_set_epi16(
-            _mm_movemask_epi8(buffer1.at((j << 3) + 7)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 6)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 5)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 4)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 3)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 2)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 1)),
-            _mm_movemask_epi8(buffer1.at((j << 3) + 0)));
-      }
-      for (int j = 0; j < 128; j++) {
-        buffer1[j] = _mm_slli_epi16(buffer1.at(j), 1);
-      }
+  for (int i = 7; i >= 0; i--) {
+    for (int j = 15; j >= 0; j--) {
+      dst[(j << 3) + i] = _mm_set_epi16(
+          _mm_movemask_epi8(buffer1[(j << 3) + 7]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 6]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 5]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 4]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 3]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 2]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 1]),
+          _mm_movemask_epi8(buffer1[(j << 3) + 0]));
+    }
+    for (int j = 0; j < 128; j++) {
+      buffer1[j] = _mm_slli_epi16(buffer1[j], 1);
     }
   }
+}
+
+/**
+ * The same steps as above on two matrices at a time: the unpack instructions
+ * work within each 128-bit lane, so the first matrix goes to the lower lane
+ * and the second to the upper lane, and the 32-bit movemask holds the bits of
+ * both.
+ */
+__attribute__((target("avx2"))) void transposeTwoMatrices(
+    const __m128i* src,
+    __m128i* dst) {
+  std::array<__m256i, 128> buffer0;
+  std::array<__m256i, 128> buffer1;
+  const auto wordsByMatrix = _mm256_set_epi8(
+      15, 14, 11, 10, 7, 6, 3, 2, 13, 12, 9, 8, 5, 4, 1, 0,
+      15, 14, 11, 10, 7, 6, 3, 2, 13, 12, 9, 8, 5, 4, 1, 0);
+
+  for (int i = 0; i < 128; i++) {
+    buffer1[i] = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(src[i]), src[128 + i], 1);
+  }
+
+  for (int i = 0; i < 64; i++) {
+    buffer0[i] = _mm256_unpacklo_epi8(buffer1[2 * i], buffer1[2 * i + 1]);
+    buffer0[i + 64] = _mm256_unpackhi_epi8(buffer1[2 * i], buffer1[2 * i + 1]);
+  }
+
+  for (int j = 0; j < 128; j += 64) {
+    for (int i = 0; i < 32; i++) {
+      buffer1[i + j] =
+          _mm256_unpacklo_epi16(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+      buffer1[i + j + 32] =
+          _mm256_unpackhi_epi16(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+    }
+  }
+
+  for (int j = 0; j < 128; j += 32) {
+    for (int i = 0; i < 16; i++) {
+      buffer0[i + j] =
+          _mm256_unpacklo_epi32(buffer1[2 * i + j], buffer1[2 * i + 1 + j]);
+      buffer0[i + j + 16] =
+          _mm256_unpackhi_epi32(buffer1[2 * i + j], buffer1[2 * i + 1 + j]);
+    }
+  }
+
+  for (int j = 0; j < 128; j += 16) {
+    for (int i = 0; i < 8; i++) {
+      buffer1[i + j] =
+          _mm256_unpacklo_epi64(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+      buffer1[i + j + 8] =
+          _mm256_unpackhi_epi64(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+    }
+  }
+
+  for (int i = 7; i >= 0; i--) {
+    for (int j = 15; j >= 0; j--) {
+      // each 32-bit mask holds the k-th 16-bit word of the output row of
+      // both matrices.
+      auto masks = _mm256_set_epi32(
+          _mm256_movemask_epi8(buffer1[(j << 3) + 7]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 6]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 5]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 4]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 3]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 2]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 1]),
+          _mm256_movemask_epi8(buffer1[(j << 3) + 0]));
+      // gather the words of each matrix, then the 64-bit halves.
+      masks = _mm256_shuffle_epi8(masks, wordsByMatrix);
+      masks = _mm256_permute4x64_epi64(masks, 0xD8);
+      dst[(j << 3) + i] = _mm256_castsi256_si128(masks);
+      dst[128 + (j << 3) + i] = _mm256_extracti128_si256(masks, 1);
+    }
+    for (int j = 0; j < 128; j++) {
+      buffer1[j] = _mm256_slli_epi16(buffer1[j], 1);
+    }
+  }
+}
+
+/**
+ * The same as above with four matrices at a time, one in each 128-bit lane.
+ */
+__attribute__((target("avx512f,avx512bw"))) void transposeFourMatrices(
+    const __m128i* src,
+    __m128i* dst) {
+  std::array<__m512i, 128> buffer0;
+  std::array<__m512i, 128> buffer1;
+  // word 8 * matrix + k of the output comes from word 4 * k + matrix
+  const auto wordsByMatrix = _mm512_set_epi16(
+      31, 27, 23, 19, 15, 11, 7, 3, 30, 26, 22, 18, 14, 10, 6, 2,
+      29, 25, 21, 17, 13, 9, 5, 1, 28, 24, 20, 16, 12, 8, 4, 0);
+
+  for (int i = 0; i < 128; i++) {
+    auto row = _mm512_castsi128_si512(src[i]);
+    row = _mm512_inserti32x4(row, src[128 + i], 1);
+    row = _mm512_inserti32x4(row, src[256 + i], 2);
+    buffer1[i] = _mm512_inserti32x4(row, src[384 + i], 3);
+  }
+
+  for (int i = 0; i < 64; i++) {
+    buffer0[i] = _mm512_unpacklo_epi8(buffer1[2 * i], buffer1[2 * i + 1]);
+    buffer0[i + 64] = _mm512_unpackhi_epi8(buffer1[2 * i], buffer1[2 * i + 1]);
+  }
+
+  for (int j = 0; j < 128; j += 64) {
+    for (int i = 0; i < 32; i++) {
+      buffer1[i + j] =
+          _mm512_unpacklo_epi16(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+      buffer1[i + j + 32] =
+          _mm512_unpackhi_epi16(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+    }
+  }
+
+  for (int j = 0; j < 128; j += 32) {
+    for (int i = 0; i < 16; i++) {
+      buffer0[i + j] =
+          _mm512_unpacklo_epi32(buffer1[2 * i + j], buffer1[2 * i + 1 + j]);
+      buffer0[i + j + 16] =
+          _mm512_unpackhi_epi32(buffer1[2 * i + j], buffer1[2 * i + 1 + j]);
+    }
+  }
+
+  for (int j = 0; j < 128; j += 16) {
+    for (int i = 0; i < 8; i++) {
+      buffer1[i + j] =
+          _mm512_unpacklo_epi64(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+      buffer1[i + j + 8] =
+          _mm512_unpackhi_epi64(buffer0[2 * i + j], buffer0[2 * i + 1 + j]);
+    }
+  }
+
+  for (int i = 7; i >= 0; i--) {
+    for (int j = 15; j >= 0; j--) {
+      // each 64-bit mask holds the k-th 16-bit word of the output row of
+      // all four matrices.
+      auto masks = _mm512_set_epi64(
+          _mm512_movepi8_mask(buffer1[(j << 3) + 7]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 6]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 5]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 4]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 3]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 2]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 1]),
+          _mm512_movepi8_mask(buffer1[(j << 3) + 0]));
+      masks = _mm512_permutexvar_epi16(wordsByMatrix, masks);
+      dst[(j << 3) + i] = _mm512_castsi512_si128(masks);
+      dst[128 + (j << 3) + i] = _mm512_extracti32x4_epi32(masks, 1);
+      dst[256 + (j << 3) + i] = _mm512_extracti32x4_epi32(masks, 2);
+      dst[384 + (j << 3) + i] = _mm512_extracti32x4_epi32(masks, 3);
+    }
+    for (int j = 0; j < 128; j++) {
+      buffer1[j] = _mm512_slli_epi16(buffer1[j], 1);
+    }
+  }
+}
+
+/**
+ * Transpose all the matrices in src, matricesPerKernel at a time with kernel;
+ * the remaining ones go through the SSE kernel.
+ */
+std::vector<__m128i> transposeAll(
+    const std::vector<__m128i>& src,
+    void (*kernel)(const __m128i*, __m128i*),
+    size_t matricesPerKernel) {
+  // ensure the size of src is a multiplication of 128
+  assert((src.size() & 0x7F) == 0);
+  std::vector<__m128i> rst(src.size());
+  size_t index = 0;
+  for (; index + 128 * matricesPerKernel <= src.size();
+       index += 128 * matricesPerKernel) {
+    kernel(src.data() + index, rst.data() + index);
+  }
+  for (; index < src.size(); index += 128) {
+    transposeOneMatrix(src.data() + index, rst.data() + index);
+  }
+  return rst;
+}
+
+} // namespace
+
+std::vector<__m128i> IknpShRandomCorrelatedObliviousTransfer::matrixTranspose(
+    const std::vector<__m128i>& src) {
+  // the widest kernel this machine supports, picked once.
+  static const auto kTranspose = system::isAvx512Supported()
+      ? &matrixTransposeAvx512
+      : system::isAvx2Supported() ? &matrixTransposeAvx2
+                                  : &matrixTransposeSse;
+  return kTranspose(src);
+}
+
+std::vector<__m128i>
+IknpShRandomCorrelatedObliviousTransfer::matrixTransposeSse(
+    const std::vector<__m128i>& src) {
+  return transposeAll(src, &transposeOneMatrix, 1);
+}
+
+std::vector<__m128i>
+IknpShRandomCorrelatedObliviousTransfer::matrixTransposeAvx2(
+    const std::vector<__m128i>& src) {
+  return transposeAll(src, &transposeTwoMatrices, 2);
+}
+
+std::vector<__m128i>
+IknpShRandomCorrelatedObliviousTransfer::matrixTransposeAvx512(
+    const std::vector<__m128i>& src) {
+  return transposeAll(src, &transposeFourMatrices, 4);
+}
+
+std::vector<__m128i> IknpShRandomCorrelatedObliviousTransfer::getRandomM128is(
+    util::IPrg& prg,
+    size_t size) {
+  auto bytes = prg.getRandomBytes(size * sizeof(__m128i));
+  std::vector<__m128i> rst(size);
+  std::memcpy(rst.data(), bytes.data(), bytes.size());
   return rst;
 }
 
@@ -168,17 +375,20 @@ std::vector<__m128i> IknpShRandomCorrelatedObliviousTransfer::rcot(
   if (role_ == util::receiver) {
     std::vector<__m128i> t0(blockCount * 128);
     std::vector<__m128i> u(blockCount * 127);
-    for (size_t i = 0, indexT = 0, indexU = 0; i < blockCount;
-         i++, indexT += 128, indexU += 127) {
-      // t0[indexT] stores the choice, which will become the LSBs after
-      // transpose
-      t0[indexT] = choiceBitPrg_->getRandomM128i();
-      std::vector<__m128i> t1(127);
-      for (size_t j = 0; j < 127; j++) {
-        t0[indexT + 1 + j] = receiverPrgs0_[j]->getRandomM128i();
-        t1[j] = receiverPrgs1_[j]->getRandomM128i();
-        u[indexU + j] = _mm_xor_si128(t0.at(indexT + 1 + j), t1.at(j));
-        u[indexU + j] = _mm_xor_si128(u.at(indexU + j), t0.at(indexT));
+    // t0[i * 128] stores the choice, which will become the LSBs after
+    // transpose
+    auto choices = getRandomM128is(*choiceBitPrg_, blockCount);
+    for (size_t i = 0; i < blockCount; i++) {
+      t0[i * 128] = choices[i];
+    }
+    // each PRG fills one row of all the blocks.
+    for (size_t j = 0; j < 127; j++) {
+      auto t0Row = getRandomM128is(*receiverPrgs0_[j], blockCount);
+      auto t1Row = getRandomM128is(*receiverPrgs1_[j], blockCount);
+      for (size_t i = 0; i < blockCount; i++) {
+        t0[i * 128 + 1 + j] = t0Row[i];
+        u[i * 127 + j] = _mm_xor_si128(
+            _mm_xor_si128(t0Row[i], t1Row[i]), choices[i]);
       }
     }
     agent_->sendT(u);
@@ -186,13 +396,16 @@ std::vector<__m128i> IknpShRandomCorrelatedObliviousTransfer::rcot(
 
   } else {
     std::vector<__m128i> t(blockCount * 128);
-    for (size_t i = 0, indexT = 0; i < blockCount; i++, indexT += 128) {
-      for (size_t j = 0; j < 127; j++) {
-        t[indexT + 1 + j] = senderPrgs_[j]->getRandomM128i();
+    for (size_t j = 0; j < 127; j++) {
+      auto tRow = getRandomM128is(*senderPrgs_[j], blockCount);
+      for (size_t i = 0; i < blockCount; i++) {
+        t[i * 128 + 1 + j] = tRow[i];
       }
-      //  t[indexT] will always be 0. This vector will be the LSBs after
-      //  transpose.
-      t[indexT] = _mm_set_epi64x(0, 0);
+    }
+    //  t[i * 128] will always be 0. This vector will be the LSBs after
+    //  transpose.
+    for (size_t i = 0; i < blockCount; i++) {
+      t[i * 128] = _mm_set_epi64x(0, 0);
     }
 
     auto u = agent_->receiveT<__m128i>(blockCount * 127);
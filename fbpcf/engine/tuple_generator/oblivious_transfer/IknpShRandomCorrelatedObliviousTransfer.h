@@ -63,9 +63,25 @@ class IknpShRandomCorrelatedObliviousTransfer
   }
 
  protected:
+  /**
+   * Transpose each 128 by 128 bit matrix in src, with the widest kernel the
+   * CPU supports.
+   */
   static std::vector<__m128i> matrixTranspose(const std::vector<__m128i>& src);
 
+  // the kernels to pick from, one, two or four matrices at a time.
+  static std::vector<__m128i> matrixTransposeSse(
+      const std::vector<__m128i>& src);
+  static std::vector<__m128i> matrixTransposeAvx2(
+      const std::vector<__m128i>& src);
+  static std::vector<__m128i> matrixTransposeAvx512(
+      const std::vector<__m128i>& src);
+
  private:
+  // draw the next size __m128i values of prg at once, avoiding the per call
+  // overhead of getRandomM128i().
+  static std::vector<__m128i> getRandomM128is(util::IPrg& prg, size_t size);
+
   util::Role role_;
 
   std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
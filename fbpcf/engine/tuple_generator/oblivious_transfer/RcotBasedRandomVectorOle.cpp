@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedRandomVectorOle.h"
+#include <smmintrin.h>
+#include <stdexcept>
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+namespace {
+
+const int kBitsPerElement = 64;
+
+} // namespace
+
+RcotBasedRandomVectorOle::RcotBasedRandomVectorOle(
+    uint64_t delta,
+    __m128i rcotDelta,
+    std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot,
+    std::unique_ptr<communication::IPartyCommunicationAgent> agent)
+    : role_(util::Role::sender),
+      delta_(delta),
+      rcotDelta_(rcotDelta),
+      rcot_(std::move(rcot)),
+      agent_(std::move(agent)),
+      hashFromAes_(util::Aes::getFixedKey()) {}
+
+RcotBasedRandomVectorOle::RcotBasedRandomVectorOle(
+    std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot,
+    std::unique_ptr<communication::IPartyCommunicationAgent> agent)
+    : role_(util::Role::receiver),
+      delta_(0),
+      rcotDelta_(_mm_set_epi64x(0, 0)),
+      rcot_(std::move(rcot)),
+      agent_(std::move(agent)),
+      hashFromAes_(util::Aes::getFixedKey()) {}
+
+std::vector<uint64_t> RcotBasedRandomVectorOle::hash(
+    std::vector<__m128i>&& src,
+    bool advanceIndex) {
+  for (size_t i = 0; i < src.size(); i++) {
+    src[i] = _mm_xor_si128(src[i], _mm_set_epi64x(hashIndex_ + i, 0));
+  }
+  hashFromAes_.inPlaceHash(src.data(), src.size());
+  std::vector<uint64_t> rst(src.size());
+  for (size_t i = 0; i < src.size(); i++) {
+    rst[i] = _mm_extract_epi64(src[i], 0);
+  }
+  if (advanceIndex) {
+    hashIndex_ += src.size();
+  }
+  return rst;
+}
+
+/**
+ * For the j-th bit of the i-th element, the sender has the RCOT messages m0
+ * and m1 = m0 ^ rcotDelta and the receiver has m_b for a random bit b. The
+ * sender sends c = H(m0) - H(m1) + 2^j * delta, so that the receiver can
+ * compute y = H(m_b) + b * c = H(m0) + b * 2^j * delta.
+ * Summing over the 64 bits gives
+ *   w[i] = -sum(H(m0)), v[i] = -sum(y), u[i] = sum(b * 2^j)
+ * and w[i] - v[i] = u[i] * delta.
+ */
+std::vector<uint64_t> RcotBasedRandomVectorOle::senderVole(int64_t size) {
+  if (role_ != util::Role::sender) {
+    throw std::runtime_error("This VOLE object is not a sender.");
+  }
+  auto sender0Messages = rcot_->rcot(size * kBitsPerElement);
+  auto sender1Messages = sender0Messages;
+  for (auto& message : sender1Messages) {
+    message = _mm_xor_si128(message, rcotDelta_);
+  }
+  auto hash0 = hash(std::move(sender0Messages), false);
+  auto hash1 = hash(std::move(sender1Messages), true);
+
+  std::vector<uint64_t> corrections(size * kBitsPerElement);
+  std::vector<uint64_t> rst(size, 0);
+  for (int64_t i = 0; i < size; i++) {
+    for (int j = 0; j < kBitsPerElement; j++) {
+      auto index = i * kBitsPerElement + j;
+      corrections[index] = hash0[index] - hash1[index] + (delta_ << j);
+      rst[i] -= hash0[index];
+    }
+  }
+  agent_->sendInt64(corrections);
+  return rst;
+}
+
+std::pair<std::vector<uint64_t>, std::vector<uint64_t>>
+RcotBasedRandomVectorOle::receiverVole(int64_t size) {
+  if (role_ != util::Role::receiver) {
+    throw std::runtime_error("This VOLE object is not a receiver.");
+  }
+  auto receiverMessages = rcot_->rcot(size * kBitsPerElement);
+  std::vector<bool> choices(receiverMessages.size());
+  for (size_t i = 0; i < receiverMessages.size(); i++) {
+    choices[i] = util::getLsb(receiverMessages[i]);
+  }
+  auto hashes = hash(std::move(receiverMessages), true);
+  auto corrections = agent_->receiveInt64(size * kBitsPerElement);
+
+  std::vector<uint64_t> u(size, 0);
+  std::vector<uint64_t> v(size, 0);
+  for (int64_t i = 0; i < size; i++) {
+    for (int j = 0; j < kBitsPerElement; j++) {
+      auto index = i * kBitsPerElement + j;
+      uint64_t choice = choices[index];
+      u[i] |= choice << j;
+      v[i] -= hashes[index] + choice * corrections[index];
+    }
+  }
+  return {std::move(u), std::move(v)};
+}
+
+std::pair<uint64_t, uint64_t> RcotBasedRandomVectorOle::getTrafficStatistics()
+    const {
+  // either of them may have been extracted already.
+  std::pair<uint64_t, uint64_t> rst = {0, 0};
+  if (rcot_ != nullptr) {
+    auto traffic = rcot_->getTrafficStatistics();
+    rst.first += traffic.first;
+    rst.second += traffic.second;
+  }
+  if (agent_ != nullptr) {
+    auto traffic = agent_->getTrafficStatistics();
+    rst.first += traffic.first;
+    rst.second += traffic.second;
+  }
+  return rst;
+}
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <memory>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomVectorOle.h"
+#include "fbpcf/engine/util/aes.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+/**
+ * A random VOLE built bit by bit from RCOT, following Gilboa's
+ * multiplication: each element consumes 64 RCOTs and 64 corrections of 8
+ * bytes. It is only meant to bootstrap an extender based VOLE.
+ */
+class RcotBasedRandomVectorOle final : public IRandomVectorOle {
+ public:
+  /**
+   * Construct a sender.
+   * @param rcotDelta the delta of the underlying RCOT sender.
+   */
+  RcotBasedRandomVectorOle(
+      uint64_t delta,
+      __m128i rcotDelta,
+      std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot,
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent);
+
+  /**
+   * Construct a receiver.
+   */
+  RcotBasedRandomVectorOle(
+      std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot,
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<uint64_t> senderVole(int64_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<std::vector<uint64_t>, std::vector<uint64_t>> receiverVole(
+      int64_t size) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override;
+
+  /**
+   * Hand the RCOT over, e.g. to the extender this object bootstrapped.
+   */
+  std::unique_ptr<IRandomCorrelatedObliviousTransfer> extractRcot() {
+    return std::move(rcot_);
+  }
+
+  std::unique_ptr<communication::IPartyCommunicationAgent>
+  extractCommunicationAgent() {
+    return std::move(agent_);
+  }
+
+ private:
+  // H(src[i] ^ (hashIndex_ + i)), truncated to 64 bits. The index is
+  // advanced by the size of src unless the same tweaks need to be reused.
+  std::vector<uint64_t> hash(std::vector<__m128i>&& src, bool advanceIndex);
+
+  util::Role role_;
+  uint64_t delta_;
+  __m128i rcotDelta_;
+
+  std::unique_ptr<IRandomCorrelatedObliviousTransfer> rcot_;
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
+
+  util::Aes hashFromAes_;
+  uint64_t hashIndex_ = 0;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
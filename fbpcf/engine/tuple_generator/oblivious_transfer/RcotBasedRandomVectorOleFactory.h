@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomVectorOleFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedRandomVectorOle.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+class RcotBasedRandomVectorOleFactory final : public IRandomVectorOleFactory {
+ public:
+  RcotBasedRandomVectorOleFactory(
+      std::unique_ptr<IRandomCorrelatedObliviousTransferFactory> rcotFactory,
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId)
+      : rcotFactory_(std::move(rcotFactory)),
+        agentFactory_(agentFactory),
+        myId_(myId) {}
+
+  std::unique_ptr<IRandomVectorOle> create(uint64_t delta) override {
+    auto rcotDelta = util::getRandomM128iFromSystemNoise();
+    util::setLsbTo1(rcotDelta);
+    auto rcot = rcotFactory_->create(
+        rcotDelta, agentFactory_.create(1 - myId_, "vole_rcot_traffic"));
+    return std::make_unique<RcotBasedRandomVectorOle>(
+        delta,
+        rcotDelta,
+        std::move(rcot),
+        agentFactory_.create(1 - myId_, "vole_traffic"));
+  }
+
+  std::unique_ptr<IRandomVectorOle> create() override {
+    auto rcot = rcotFactory_->create(
+        agentFactory_.create(1 - myId_, "vole_rcot_traffic"));
+    return std::make_unique<RcotBasedRandomVectorOle>(
+        std::move(rcot), agentFactory_.create(1 - myId_, "vole_traffic"));
+  }
+
+ private:
+  std::unique_ptr<IRandomCorrelatedObliviousTransferFactory> rcotFactory_;
+  communication::IPartyCommunicationAgentFactory& agentFactory_;
+  int myId_;
+};
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -9,43 +9,112 @@
 
 #include <memory>
 
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/CoBaseObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/EmpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/BatchedRegularErrorMultiPointCotFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/FerretParameters.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ParallelTenLocalLinearMatrixMultiplierFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/PrefetchingTenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/SinglePointCotFactory.h"
-#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/TenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer {
 
+/**
+ * @param useCoBaseOt whether to bootstrap IKNP with the Chou-Orlandi base OT
+ * instead of Naor-Pinkas. Its messages differ from Naor-Pinkas', so both
+ * parties must agree on this flag and it doesn't interoperate with builds
+ * that predate it.
+ */
 inline std::unique_ptr<IFlexibleRandomCorrelatedObliviousTransferFactory>
-createClassicRcotFactory() {
+createClassicRcotFactory(bool useCoBaseOt = false) {
+  std::unique_ptr<IBaseObliviousTransferFactory> baseOtFactory;
+  if (useCoBaseOt) {
+    baseOtFactory = std::make_unique<CoBaseObliviousTransferFactory>();
+  } else {
+    baseOtFactory = std::make_unique<NpBaseObliviousTransferFactory>();
+  }
   return std::make_unique<tuple_generator::oblivious_transfer::
                               IknpShRandomCorrelatedObliviousTransferFactory>(
-      std::make_unique<tuple_generator::oblivious_transfer::
-                           NpBaseObliviousTransferFactory>());
+      std::move(baseOtFactory));
 }
 
+/**
+ * @param numberOfThreads the number of threads used by each extension with
+ * the options below. It only affects speed, the two parties don't need to
+ * agree on it.
+ * @param useChunkedMatrix whether to compute the LPN matrix in chunks on
+ * numberOfThreads threads. The chunked matrix differs from the default one,
+ * so both parties must agree on this flag and it doesn't interoperate with
+ * builds that predate it.
+ * @param useBatchedMultiPointCot whether to run the GGM trees of all the
+ * single point COTs together, on numberOfThreads threads. Its messages differ
+ * from the default multi point COT's, so both parties must agree on this
+ * flag and it doesn't interoperate with builds that predate it.
+ */
 inline std::unique_ptr<IRandomCorrelatedObliviousTransferFactory>
 createFerretRcotFactory(
     int64_t extendedSize = ferret::kExtendedSize,
     int64_t baseSize = ferret::kBaseSize,
-    int64_t weight = ferret::kWeight) {
+    int64_t weight = ferret::kWeight,
+    int numberOfThreads = 1,
+    bool useChunkedMatrix = false,
+    bool useBatchedMultiPointCot = false) {
+  std::unique_ptr<ferret::IMatrixMultiplierFactory> matrixMultiplierFactory;
+  if (useChunkedMatrix) {
+    matrixMultiplierFactory =
+        std::make_unique<ferret::ParallelTenLocalLinearMatrixMultiplierFactory>(
+            numberOfThreads);
+  } else {
+    // the same matrix as TenLocalLinearMatrixMultiplier, computed with
+    // prefetching.
+    matrixMultiplierFactory = std::make_unique<
+        ferret::PrefetchingTenLocalLinearMatrixMultiplierFactory>();
+  }
+  std::unique_ptr<ferret::IMultiPointCotFactory> multiPointCotFactory;
+  if (useBatchedMultiPointCot) {
+    multiPointCotFactory =
+        std::make_unique<ferret::BatchedRegularErrorMultiPointCotFactory>(
+            numberOfThreads);
+  } else {
+    multiPointCotFactory =
+        std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
+            std::make_unique<ferret::SinglePointCotFactory>());
+  }
   return std::make_unique<
       ExtenderBasedRandomCorrelatedObliviousTransferFactory>(
       createClassicRcotFactory(),
       std::make_unique<ferret::RcotExtenderFactory>(
-          std::make_unique<ferret::TenLocalLinearMatrixMultiplierFactory>(),
-          std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
-              std::make_unique<ferret::SinglePointCotFactory>())),
+          std::move(matrixMultiplierFactory), std::move(multiPointCotFactory)),
       extendedSize,
       baseSize,
       weight);
 }
 
+/**
+ * Create a ferret RCOT factory with a parameter set from FerretParameters.h.
+ * Both parties must use the same set.
+ */
+inline std::unique_ptr<IRandomCorrelatedObliviousTransferFactory>
+createFerretRcotFactory(
+    const ferret::FerretParameters& parameters,
+    int numberOfThreads = 1,
+    bool useChunkedMatrix = false,
+    bool useBatchedMultiPointCot = false) {
+  return createFerretRcotFactory(
+      parameters.extendedSize,
+      parameters.baseSize,
+      parameters.weight,
+      numberOfThreads,
+      useChunkedMatrix,
+      useBatchedMultiPointCot);
+}
+
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
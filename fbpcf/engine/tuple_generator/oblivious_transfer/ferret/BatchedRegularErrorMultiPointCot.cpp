@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <assert.h>
+#include <emmintrin.h>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/BatchedRegularErrorMultiPointCot.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+void BatchedRegularErrorMultiPointCot::init(int64_t length, int64_t weight) {
+  assert(length % weight == 0);
+
+  spcotLength_ = length / weight;
+  spcotCount_ = weight;
+  baseCotSize_ = std::log2(spcotLength_);
+
+  assert(std::pow(2, baseCotSize_) == spcotLength_);
+}
+
+void BatchedRegularErrorMultiPointCot::senderInit(
+    __m128i delta,
+    int64_t length,
+    int64_t weight) {
+  init(length, weight);
+  role_ = util::Role::sender;
+  delta_ = delta;
+}
+
+void BatchedRegularErrorMultiPointCot::receiverInit(
+    int64_t length,
+    int64_t weight) {
+  init(length, weight);
+  role_ = util::Role::receiver;
+}
+
+void BatchedRegularErrorMultiPointCot::prepareTrees(size_t baseCotSize) {
+  if (baseCotSize != baseCotSize_ * spcotCount_) {
+    throw std::invalid_argument(
+        "unexpected amount of base COT: actual:" + std::to_string(baseCotSize) +
+        " vs expected:" + std::to_string(baseCotSize_ * spcotCount_));
+  }
+  expanders_.clear();
+  ciphersForHash_.clear();
+  expanders_.reserve(spcotCount_);
+  ciphersForHash_.reserve(spcotCount_);
+  for (size_t i = 0; i < spcotCount_; i++) {
+    expanders_.emplace_back(index_);
+    ciphersForHash_.emplace_back(_mm_set_epi64x(index_, 0));
+    index_++;
+  }
+  trees_.resize(spcotCount_);
+}
+
+std::vector<__m128i> BatchedRegularErrorMultiPointCot::collectLeaves() {
+  std::vector<__m128i> rst;
+  rst.reserve(spcotLength_ * spcotCount_);
+  for (auto& tree : trees_) {
+    rst.insert(rst.end(), tree.begin(), tree.begin() + spcotLength_);
+    // release each tree right away to keep the peak memory low.
+    std::vector<__m128i>().swap(tree);
+  }
+  return rst;
+}
+
+std::vector<__m128i> BatchedRegularErrorMultiPointCot::senderExtend(
+    std::vector<__m128i>&& baseCot) {
+  assert(role_ == util::Role::sender);
+  prepareTrees(baseCot.size());
+  for (auto& tree : trees_) {
+    tree = {util::getRandomM128iFromSystemNoise()};
+  }
+
+  std::vector<__m128i> masks(2 * spcotCount_);
+  // contruct the ggm trees, one layer of all of them at a time.
+  for (size_t layer = 0; layer < baseCotSize_; layer++) {
+    threadPool_.parallelFor(spcotCount_, [&, layer](size_t i) {
+      auto cot = baseCot.at(i * baseCotSize_ + layer);
+      auto& tree = trees_.at(i);
+      tree = expanders_.at(i).expand(std::move(tree));
+
+      std::vector<__m128i> hashInput = {cot, _mm_xor_si128(cot, delta_)};
+      ciphersForHash_.at(i).encryptInPlace(hashInput);
+
+      auto mask0 = _mm_xor_si128(hashInput[0], cot);
+      auto mask1 = _mm_xor_si128(hashInput[1], _mm_xor_si128(cot, delta_));
+      for (size_t j = 0; j < tree.size(); j += 2) {
+        mask0 = _mm_xor_si128(mask0, tree[j]);
+        mask1 = _mm_xor_si128(mask1, tree[j + 1]);
+      }
+      masks[2 * i] = mask0;
+      masks[2 * i + 1] = mask1;
+    });
+    agent_->sendT<__m128i>(masks);
+  }
+
+  std::vector<__m128i> totalXors(spcotCount_, delta_);
+  threadPool_.parallelFor(spcotCount_, [&](size_t i) {
+    for (auto& leaf : trees_.at(i)) {
+      util::setLsbTo0(leaf);
+      totalXors[i] = _mm_xor_si128(totalXors[i], leaf);
+    }
+  });
+  agent_->sendT<__m128i>(totalXors);
+
+  return collectLeaves();
+}
+
+std::vector<__m128i> BatchedRegularErrorMultiPointCot::receiverExtend(
+    std::vector<__m128i>&& baseCot) {
+  assert(role_ == util::Role::receiver);
+  prepareTrees(baseCot.size());
+  for (auto& tree : trees_) {
+    tree = {_mm_set_epi32(0, 0, 0, 0)};
+  }
+
+  std::vector<int64_t> positions(spcotCount_, 0);
+  // reconstruct the ggm trees, only the leaf at each position is missing.
+  for (size_t layer = 0; layer < baseCotSize_; layer++) {
+    // expand before waiting for the masks.
+    threadPool_.parallelFor(spcotCount_, [this](size_t i) {
+      trees_.at(i) = expanders_.at(i).expand(std::move(trees_.at(i)));
+    });
+
+    auto masks = agent_->receiveT<__m128i>(2 * spcotCount_);
+
+    threadPool_.parallelFor(spcotCount_, [&, layer](size_t i) {
+      auto cot = baseCot.at(i * baseCotSize_ + layer);
+      auto& tree = trees_.at(i);
+      auto choice = util::getLsb(cot);
+      size_t positionToFix = (positions[i] << 1) + choice;
+
+      std::vector<__m128i> hashInput = {cot};
+      ciphersForHash_.at(i).encryptInPlace(hashInput);
+      auto fixed = _mm_xor_si128(
+          masks[2 * i + choice], _mm_xor_si128(hashInput[0], cot));
+      for (size_t j = choice; j < tree.size(); j += 2) {
+        if (j != positionToFix) {
+          fixed = _mm_xor_si128(fixed, tree[j]);
+        }
+      }
+      tree[positionToFix] = fixed;
+
+      positions[i] = (positions[i] << 1) ^ !choice;
+    });
+  }
+
+  // totalXor = delta + m_0 + m_1 + ...
+  auto totalXors = agent_->receiveT<__m128i>(spcotCount_);
+  threadPool_.parallelFor(spcotCount_, [&](size_t i) {
+    auto& tree = trees_.at(i);
+    auto totalXor = totalXors[i];
+    tree[positions[i]] = _mm_set_epi64x(0, 0);
+    for (auto& leaf : tree) {
+      util::setLsbTo0(leaf);
+      totalXor = _mm_xor_si128(totalXor, leaf);
+    }
+    // totalXor = m_position + delta
+    tree[positions[i]] = totalXor;
+  });
+
+  return collectLeaves();
+}
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
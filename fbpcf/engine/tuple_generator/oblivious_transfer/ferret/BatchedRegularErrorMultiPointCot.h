@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+#include <emmintrin.h>
+#include <memory>
+#include <vector>
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMultiPointCot.h"
+#include "fbpcf/engine/util/ThreadPool.h"
+#include "fbpcf/engine/util/aes.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+/**
+ * This object realize multi-point cot under the regular-error lpn assumption,
+ * like RegularErrorMultiPointCot with SinglePointCot, but expands all the GGM
+ * trees together, one layer at a time. The masks of a layer are sent for all
+ * trees in a single message, so an extension takes as many rounds as a tree
+ * has layers, instead of that many rounds per tree. Within a layer, the trees
+ * are processed on several threads. See https://eprint.iacr.org/2020/924.pdf
+ * for more details.
+ */
+class BatchedRegularErrorMultiPointCot final : public IMultiPointCot {
+ public:
+  /**
+   * @param numberOfThreads the number of threads to expand the trees with,
+   * the result doesn't depend on it.
+   */
+  explicit BatchedRegularErrorMultiPointCot(
+      std::unique_ptr<communication::IPartyCommunicationAgent>& agent,
+      int numberOfThreads = 1)
+      : agent_(agent), threadPool_(numberOfThreads), index_(0) {}
+
+  /**
+   * @inherit doc
+   */
+  void senderInit(__m128i delta, int64_t length, int64_t weight) override;
+
+  /**
+   * @inherit doc
+   */
+  void receiverInit(int64_t length, int64_t weight) override;
+
+  /**
+   * Return the base cot results needed per iteration.
+   */
+  int getBaseCotNeeds() const override {
+    return baseCotSize_ * spcotCount_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> senderExtend(std::vector<__m128i>&& baseCot) override;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> receiverExtend(std::vector<__m128i>&& baseCot) override;
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    // we are returning {0, 0} because this object doesn't own the agent.
+    return {0, 0};
+  }
+
+ private:
+  /**
+   * This is the initialization shared by both sender and receiver.
+   */
+  void init(int64_t length, int64_t weight);
+
+  /**
+   * Create the expanders and the hash ciphers for the trees of the coming
+   * extension, each tree gets its own index like a single point cot does.
+   */
+  void prepareTrees(size_t baseCotSize);
+
+  /**
+   * Concatenate the leaves of all the trees.
+   */
+  std::vector<__m128i> collectLeaves();
+
+  std::unique_ptr<communication::IPartyCommunicationAgent>& agent_;
+  util::ThreadPool threadPool_;
+
+  std::vector<util::Expander> expanders_;
+  std::vector<util::Aes> ciphersForHash_;
+
+  // the current layer of each tree.
+  std::vector<std::vector<__m128i>> trees_;
+
+  __m128i delta_;
+
+  util::Role role_;
+  size_t baseCotSize_;
+
+  int64_t spcotLength_;
+  size_t spcotCount_;
+
+  int64_t index_;
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/BatchedRegularErrorMultiPointCot.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMultiPointCotFactory.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+class BatchedRegularErrorMultiPointCotFactory final
+    : public IMultiPointCotFactory {
+ public:
+  explicit BatchedRegularErrorMultiPointCotFactory(int numberOfThreads = 1)
+      : numberOfThreads_(numberOfThreads) {}
+
+  std::unique_ptr<IMultiPointCot> create(
+      std::unique_ptr<communication::IPartyCommunicationAgent>& agent)
+      override {
+    return std::make_unique<BatchedRegularErrorMultiPointCot>(
+        agent, numberOfThreads_);
+  }
+
+ private:
+  int numberOfThreads_;
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+const int64_t kExtendedSize = 10805248;
+const int64_t kWeight = 1319;
+const int64_t kBaseSize = 589760;
+
+/**
+ * A set of regular-error LPN parameters for the ferret RCOT extender. The
+ * extendedSize must be a multiple of the weight, and the quotient must be a
+ * power of 2, as each noise position is picked by a GGM tree.
+ */
+struct FerretParameters {
+  int64_t extendedSize;
+  int64_t baseSize;
+  int64_t weight;
+
+  /**
+   * The number of base RCOTs consumed by each extension: baseSize for the
+   * matrix multiplication, plus one per layer of each GGM tree.
+   */
+  int64_t getBaseRcotSize() const {
+    int64_t treeDepth = 0;
+    while ((weight << treeDepth) < extendedSize) {
+      treeDepth++;
+    }
+    return baseSize + weight * treeDepth;
+  }
+
+  /**
+   * The number of RCOTs an extension yields to the caller, the rest are kept
+   * as the base of the next extension.
+   */
+  int64_t getOutputSizePerExtension() const {
+    return extendedSize - getBaseRcotSize();
+  }
+};
+
+/**
+ * The regular-error LPN parameters of the ferret paper's main iteration, see
+ * https://eprint.iacr.org/2020/924.pdf, targeting 128-bit security. ~10.2M
+ * RCOTs per extension with ~607k base RCOTs. Any other set must come with the
+ * table it is taken from or the output of an LPN estimator run.
+ */
+const FerretParameters kDefaultFerretParameters{
+    kExtendedSize,
+    kBaseSize,
+    kWeight};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
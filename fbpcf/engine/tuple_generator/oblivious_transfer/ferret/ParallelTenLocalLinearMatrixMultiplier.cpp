@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ParallelTenLocalLinearMatrixMultiplier.h"
+
+#include <emmintrin.h>
+#include <algorithm>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/PrefetchingTenLocalLinearMatrixMultiplier.h"
+#include "fbpcf/engine/util/aes.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+std::vector<__m128i>
+ParallelTenLocalLinearMatrixMultiplier::multiplyWithRandomMatrix(
+    __m128i seed,
+    int64_t rstLength,
+    const std::vector<__m128i>& src) const {
+  std::vector<__m128i> rst(rstLength);
+  int64_t chunkSize = kChunkSize;
+  auto chunkCount = (rstLength + chunkSize - 1) / chunkSize;
+
+  std::vector<__m128i> chunkSeeds(chunkCount);
+  for (int64_t i = 0; i < chunkCount; i++) {
+    chunkSeeds[i] = _mm_set_epi64x(0, i);
+  }
+  util::Aes(seed).encryptInPlace(chunkSeeds);
+
+  threadPool_.parallelFor(
+      chunkCount,
+      [&chunkSeeds, &src, &rst, chunkSize, rstLength](size_t chunk) {
+        auto offset = chunk * chunkSize;
+        auto length = std::min(chunkSize, rstLength - (int64_t)offset);
+        PrefetchingTenLocalLinearMatrixMultiplier::multiplyInPlace(
+            chunkSeeds[chunk], src, rst.data() + offset, length);
+      });
+  return rst;
+}
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplier.h"
+#include "fbpcf/engine/util/ThreadPool.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+/**
+ * This lpn calculator uses the same 10 local linear code as
+ * TenLocalLinearMatrixMultiplier, but cuts the output into fixed-size chunks
+ * that are computed on several threads. Each chunk has its own code
+ * generator, seeded with the encryption of the chunk index under the given
+ * seed, so the result only depends on the seed and not on the number of
+ * threads; the two parties may use different thread counts. The result does
+ * differ from TenLocalLinearMatrixMultiplier's, so both parties must use this
+ * class.
+ */
+class ParallelTenLocalLinearMatrixMultiplier final : public IMatrixMultiplier {
+ public:
+  static const int64_t kChunkSize = 1 << 16;
+
+  explicit ParallelTenLocalLinearMatrixMultiplier(int numberOfThreads)
+      : threadPool_(numberOfThreads) {}
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> multiplyWithRandomMatrix(
+      __m128i seed,
+      int64_t rstLength,
+      const std::vector<__m128i>& src) const override;
+
+ private:
+  util::ThreadPool threadPool_;
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplierFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ParallelTenLocalLinearMatrixMultiplier.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+class ParallelTenLocalLinearMatrixMultiplierFactory final
+    : public IMatrixMultiplierFactory {
+ public:
+  explicit ParallelTenLocalLinearMatrixMultiplierFactory(int numberOfThreads)
+      : numberOfThreads_(numberOfThreads) {}
+
+  std::unique_ptr<IMatrixMultiplier> create() override {
+    return std::make_unique<ParallelTenLocalLinearMatrixMultiplier>(
+        numberOfThreads_);
+  }
+
+ private:
+  int numberOfThreads_;
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/PrefetchingTenLocalLinearMatrixMultiplier.h"
+#include "fbpcf/engine/util/AesPrg.h"
+
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+std::vector<__m128i>
+PrefetchingTenLocalLinearMatrixMultiplier::multiplyWithRandomMatrix(
+    __m128i seed,
+    int64_t rstLength,
+    const std::vector<__m128i>& src) const {
+  std::vector<__m128i> rst(rstLength);
+  multiplyInPlace(seed, src, rst.data(), rstLength);
+  return rst;
+}
+
+void PrefetchingTenLocalLinearMatrixMultiplier::multiplyInPlace(
+    __m128i seed,
+    const std::vector<__m128i>& src,
+    __m128i* rst,
+    int64_t rstLength) {
+  uint32_t srcSize = src.size();
+  uint32_t mask = 1;
+  while (mask < srcSize) {
+    mask = (mask << 1) ^ 1;
+  }
+  util::AesPrg prg(seed);
+
+  // 10 blocks of random data give the indices of 4 outputs, the same way
+  // TenLocalLinearMatrixMultiplier consumes them.
+  std::vector<__m128i> randomData(kBatchSize / 4 * 10);
+  for (int64_t index = 0; index < rstLength; index += kBatchSize) {
+    prg.getRandomDataInPlace(randomData);
+    auto randomNumberIndex = reinterpret_cast<uint32_t*>(randomData.data());
+    int64_t batchSize = rstLength - index;
+    if (batchSize > kBatchSize) {
+      batchSize = kBatchSize;
+    }
+
+    for (int64_t i = 0; i < batchSize * 10; i++) {
+      randomNumberIndex[i] &= mask;
+      randomNumberIndex[i] = randomNumberIndex[i] >= srcSize
+          ? (randomNumberIndex[i] - srcSize)
+          : randomNumberIndex[i];
+      _mm_prefetch(
+          reinterpret_cast<const char*>(&src[randomNumberIndex[i]]),
+          _MM_HINT_T0);
+    }
+
+    for (int64_t i = 0; i < batchSize; i++) {
+      auto item = _mm_set_epi64x(0, 0);
+      for (int j = 0; j < 10; j++) {
+        item = _mm_xor_si128(item, src[randomNumberIndex[j]]);
+      }
+      rst[index + i] = item;
+      randomNumberIndex += 10;
+    }
+  }
+}
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplier.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+/**
+ * This lpn calculator computes exactly the same product as
+ * TenLocalLinearMatrixMultiplier, so the two are interchangeable, but is
+ * friendlier to the cache. The source vector is usually much larger than the
+ * L2 cache and each output gathers 10 random items from it, so almost every
+ * gather misses. Here the indices for a batch of outputs are generated first
+ * and all their items are prefetched, then the batch is computed; the misses
+ * of a whole batch overlap instead of being served one at a time.
+ */
+class PrefetchingTenLocalLinearMatrixMultiplier final
+    : public IMatrixMultiplier {
+ public:
+  // must be a multiple of 4, the number of outputs per 10 random blocks.
+  static const int kBatchSize = 64;
+
+  PrefetchingTenLocalLinearMatrixMultiplier() {}
+
+  /**
+   * @inherit doc
+   */
+  std::vector<__m128i> multiplyWithRandomMatrix(
+      __m128i seed,
+      int64_t rstLength,
+      const std::vector<__m128i>& src) const override;
+
+  /**
+   * Write the product of src and the matrix generated from seed to
+   * rst[0, rstLength).
+   */
+  static void multiplyInPlace(
+      __m128i seed,
+      const std::vector<__m128i>& src,
+      __m128i* rst,
+      int64_t rstLength);
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -8,16 +8,13 @@
 #pragma once
 #include <memory>
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/FerretParameters.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ISinglePointCot.h"
 #include "fbpcf/engine/util/IPrg.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
 
-const int64_t kExtendedSize = 10805248;
-const int64_t kWeight = 1319;
-const int64_t kBaseSize = 589760;
-
 /**
  * This object realize multi-point cot under the regular-error lpn assumption.
  * See https://eprint.iacr.org/2019/1159.pdf for more details.
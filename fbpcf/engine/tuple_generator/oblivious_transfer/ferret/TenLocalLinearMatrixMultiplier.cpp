@@ -16,13 +16,22 @@ std::vector<__m128i> TenLocalLinearMatrixMultiplier::multiplyWithRandomMatrix(
     __m128i seed,
     int64_t rstLength,
     const std::vector<__m128i>& src) const {
+  std::vector<__m128i> rst(rstLength);
+  multiplyInPlace(seed, src, rst.data(), rstLength);
+  return rst;
+}
+
+void TenLocalLinearMatrixMultiplier::multiplyInPlace(
+    __m128i seed,
+    const std::vector<__m128i>& src,
+    __m128i* rst,
+    int64_t rstLength) {
   uint32_t srcSize = src.size();
   uint32_t mask = 1;
   while (mask < srcSize) {
     mask = (mask << 1) ^ 1;
   }
   util::AesPrg prg(seed);
-  std::vector<__m128i> rst(rstLength);
 
   int index = 0;
   std::vector<__m128i> randomData(10);
@@ -44,7 +53,6 @@ std::vector<__m128i> TenLocalLinearMatrixMultiplier::multiplyWithRandomMatrix(
       randomNumberIndex += 10;
     }
   }
-  return rst;
 }
 
 } // namespace
@@ -28,6 +28,16 @@ class TenLocalLinearMatrixMultiplier final : public IMatrixMultiplier {
       __m128i seed,
       int64_t rstLength,
       const std::vector<__m128i>& src) const override;
+
+  /**
+   * Write the product of src and the matrix generated from seed to
+   * rst[0, rstLength).
+   */
+  static void multiplyInPlace(
+      __m128i seed,
+      const std::vector<__m128i>& src,
+      __m128i* rst,
+      int64_t rstLength);
 };
 
 } // namespace
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/VoleExtender.h"
+
+#include <smmintrin.h>
+#include <stdexcept>
+#include <string>
+
+#include "fbpcf/engine/util/AesPrg.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+VoleExtender::VoleExtender(
+    std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+    IMultiPointCotFactory& multiPointCotFactory)
+    : agent_(std::move(agent)),
+      multiPointCot_(multiPointCotFactory.create(agent_)),
+      hashFromAes_(util::Aes::getFixedKey()) {}
+
+void VoleExtender::init(
+    int64_t extendedSize,
+    int64_t baseSize,
+    int64_t weight) {
+  if (weight <= 0 || extendedSize % weight != 0) {
+    throw std::invalid_argument(
+        "The extended size must be a multiple of the weight.");
+  }
+  // part of each extension is kept as the base of the next one.
+  if (extendedSize <= baseSize + weight) {
+    throw std::invalid_argument(
+        "The extended size must be larger than the base VOLEs it needs.");
+  }
+  extendedSize_ = extendedSize;
+  baseSize_ = baseSize;
+  weight_ = weight;
+  blockSize_ = extendedSize / weight;
+}
+
+int64_t VoleExtender::senderInit(
+    __m128i rcotDelta,
+    int64_t extendedSize,
+    int64_t baseSize,
+    int64_t weight) {
+  init(extendedSize, baseSize, weight);
+  role_ = util::Role::sender;
+  multiPointCot_->senderInit(rcotDelta, extendedSize, weight);
+  return getBaseVoleSize();
+}
+
+int64_t VoleExtender::receiverInit(
+    int64_t extendedSize,
+    int64_t baseSize,
+    int64_t weight) {
+  init(extendedSize, baseSize, weight);
+  role_ = util::Role::receiver;
+  multiPointCot_->receiverInit(extendedSize, weight);
+  return getBaseVoleSize();
+}
+
+std::vector<uint64_t> VoleExtender::hashLeaves(
+    std::vector<__m128i>&& leaves) const {
+  for (size_t i = 0; i < leaves.size(); i++) {
+    leaves[i] = _mm_xor_si128(leaves[i], _mm_set_epi64x(iteration_, i));
+  }
+  hashFromAes_.inPlaceHash(leaves.data(), leaves.size());
+  std::vector<uint64_t> rst(leaves.size());
+  for (size_t i = 0; i < leaves.size(); i++) {
+    rst[i] = _mm_extract_epi64(leaves[i], 0);
+  }
+  return rst;
+}
+
+void VoleExtender::multiplyWithRandomMatrixAndAdd(
+    __m128i seed,
+    const std::vector<uint64_t>& src,
+    size_t srcSize,
+    std::vector<uint64_t>& dst) {
+  // the same code as TenLocalLinearMatrixMultiplier, with additions in
+  // Z_2^64 instead of xors.
+  uint32_t mask = 1;
+  while (mask < srcSize) {
+    mask = (mask << 1) ^ 1;
+  }
+  util::AesPrg prg(seed);
+
+  std::vector<__m128i> randomData(10);
+  for (size_t index = 0; index < dst.size(); index += 4) {
+    prg.getRandomDataInPlace(randomData);
+    auto randomNumberIndex = reinterpret_cast<uint32_t*>(randomData.data());
+    for (size_t i = 0; i < 4 && index + i < dst.size(); i++) {
+      // each iteration consumes 10 uint32_t random numbers
+      for (int j = 0; j < 10; j++) {
+        auto position = randomNumberIndex[j] & mask;
+        position = position >= srcSize ? position - srcSize : position;
+        dst[index + i] += src[position];
+      }
+      randomNumberIndex += 10;
+    }
+  }
+}
+
+std::vector<uint64_t> VoleExtender::senderExtend(
+    std::vector<uint64_t>&& baseW,
+    std::vector<__m128i>&& baseCot) {
+  if (static_cast<int64_t>(baseW.size()) != getBaseVoleSize()) {
+    throw std::invalid_argument(
+        "unexpected amount of base VOLE: actual:" +
+        std::to_string(baseW.size()) +
+        " vs expected:" + std::to_string(getBaseVoleSize()));
+  }
+  auto seed = agent_->receiveSingleT<__m128i>();
+
+  auto w = hashLeaves(multiPointCot_->senderExtend(std::move(baseCot)));
+
+  // the receiver misses one leaf in each block, it will recover the value it
+  // needs from the sum of the block and a base VOLE.
+  std::vector<uint64_t> corrections(weight_);
+  for (int64_t i = 0; i < weight_; i++) {
+    corrections[i] = baseW[baseSize_ + i];
+    for (int64_t j = i * blockSize_; j < (i + 1) * blockSize_; j++) {
+      corrections[i] -= w[j];
+    }
+  }
+  agent_->sendInt64(corrections);
+
+  multiplyWithRandomMatrixAndAdd(seed, baseW, baseSize_, w);
+  iteration_++;
+  return w;
+}
+
+std::pair<std::vector<uint64_t>, std::vector<uint64_t>>
+VoleExtender::receiverExtend(
+    std::vector<uint64_t>&& baseU,
+    std::vector<uint64_t>&& baseV,
+    std::vector<__m128i>&& baseCot) {
+  if (static_cast<int64_t>(baseU.size()) != getBaseVoleSize() ||
+      static_cast<int64_t>(baseV.size()) != getBaseVoleSize()) {
+    throw std::invalid_argument(
+        "unexpected amount of base VOLE: actual:" +
+        std::to_string(baseU.size()) +
+        " vs expected:" + std::to_string(getBaseVoleSize()));
+  }
+  auto seed = util::getRandomM128iFromSystemNoise();
+  agent_->sendSingleT<__m128i>(seed);
+
+  auto leaves = multiPointCot_->receiverExtend(std::move(baseCot));
+  // the noise positions are the only leaves with a choice bit of 1.
+  std::vector<int64_t> noisePositions(weight_, -1);
+  for (int64_t i = 0; i < extendedSize_; i++) {
+    if (util::getLsb(leaves[i])) {
+      auto& position = noisePositions[i / blockSize_];
+      if (position != -1) {
+        throw std::runtime_error("More than one noise position in a block.");
+      }
+      position = i;
+    }
+  }
+  auto v = hashLeaves(std::move(leaves));
+  auto corrections = agent_->receiveInt64(weight_);
+
+  std::vector<uint64_t> u(extendedSize_, 0);
+  for (int64_t i = 0; i < weight_; i++) {
+    if (noisePositions[i] == -1) {
+      throw std::runtime_error("Missing the noise position of a block.");
+    }
+    // v[position] = w[position] - u[position] * delta
+    //             = baseV - corrections - sum of the other leaves
+    uint64_t value = baseV[baseSize_ + i] - corrections[i];
+    for (int64_t j = i * blockSize_; j < (i + 1) * blockSize_; j++) {
+      if (j != noisePositions[i]) {
+        value -= v[j];
+      }
+    }
+    v[noisePositions[i]] = value;
+    u[noisePositions[i]] = baseU[baseSize_ + i];
+  }
+
+  multiplyWithRandomMatrixAndAdd(seed, baseU, baseSize_, u);
+  multiplyWithRandomMatrixAndAdd(seed, baseV, baseSize_, v);
+  iteration_++;
+  return {std::move(u), std::move(v)};
+}
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
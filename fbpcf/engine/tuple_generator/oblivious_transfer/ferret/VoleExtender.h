@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMultiPointCotFactory.h"
+#include "fbpcf/engine/util/aes.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
+
+/**
+ * This object extends VOLE over Z_2^64 the same way RcotExtender extends
+ * RCOT, under the regular-error LPN assumption over the ring: the output is
+ * A * base + e, where A is a 10-local matrix and e has a single random
+ * non-zero entry in each of the weight blocks. See
+ * https://eprint.iacr.org/2019/1159.pdf and, for the ring variant,
+ * https://eprint.iacr.org/2022/819.pdf
+ * The noise comes from a multi-point COT: both parties hash the GGM leaves
+ * into Z_2^64, which gives them the same values except at the noise position
+ * of each block, where one base VOLE per block fixes the receiver's value.
+ */
+class VoleExtender final {
+ public:
+  VoleExtender(
+      std::unique_ptr<communication::IPartyCommunicationAgent> agent,
+      IMultiPointCotFactory& multiPointCotFactory);
+
+  /**
+   * Sender's API to init the extender. The VOLE delta itself is not needed,
+   * the extension is linear and carries the delta of the base VOLEs over.
+   * @param rcotDelta : the delta of the RCOT providing the base COTs
+   * @param extendedSize : number of VOLEs in each extended output.
+   * @param baseSize : number of base VOLEs used for the matrix multiplication.
+   * @param weight: the number of noise blocks.
+   * @return number of base VOLEs needed for each extension.
+   */
+  int64_t senderInit(
+      __m128i rcotDelta,
+      int64_t extendedSize,
+      int64_t baseSize,
+      int64_t weight);
+
+  /**
+   * Receiver's API to init the extender, see senderInit().
+   */
+  int64_t receiverInit(int64_t extendedSize, int64_t baseSize, int64_t weight);
+
+  int64_t getBaseVoleSize() const {
+    return baseSize_ + weight_;
+  }
+
+  /**
+   * Indicates how many base COTs are needed for each extension.
+   */
+  int64_t getBaseCotSize() const {
+    return multiPointCot_->getBaseCotNeeds();
+  }
+
+  /**
+   * Sender's API to extend the base VOLEs.
+   * @param baseW : the sender's part of getBaseVoleSize() base VOLEs
+   * @param baseCot : getBaseCotSize() RCOTs as sender
+   * @return : the extended w
+   */
+  std::vector<uint64_t> senderExtend(
+      std::vector<uint64_t>&& baseW,
+      std::vector<__m128i>&& baseCot);
+
+  /**
+   * Receiver's API to extend the base VOLEs.
+   * @param baseU, baseV : the receiver's part of getBaseVoleSize() base VOLEs
+   * @param baseCot : getBaseCotSize() RCOTs as receiver
+   * @return : the extended u and v
+   */
+  std::pair<std::vector<uint64_t>, std::vector<uint64_t>> receiverExtend(
+      std::vector<uint64_t>&& baseU,
+      std::vector<uint64_t>&& baseV,
+      std::vector<__m128i>&& baseCot);
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const {
+    return agent_->getTrafficStatistics();
+  }
+
+ private:
+  void init(int64_t extendedSize, int64_t baseSize, int64_t weight);
+
+  // H(leaf ^ (iteration, index)), truncated to 64 bits.
+  std::vector<uint64_t> hashLeaves(std::vector<__m128i>&& leaves) const;
+
+  // dst += A * src, with the 10-local matrix A generated from seed.
+  static void multiplyWithRandomMatrixAndAdd(
+      __m128i seed,
+      const std::vector<uint64_t>& src,
+      size_t srcSize,
+      std::vector<uint64_t>& dst);
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent_;
+  std::unique_ptr<IMultiPointCot> multiPointCot_;
+
+  util::Role role_;
+  int64_t extendedSize_;
+  int64_t baseSize_;
+  int64_t weight_;
+  int64_t blockSize_;
+
+  util::Aes hashFromAes_;
+  int64_t iteration_ = 0;
+};
+
+} // namespace
+  // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
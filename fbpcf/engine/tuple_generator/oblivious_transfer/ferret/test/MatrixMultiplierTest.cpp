@@ -14,6 +14,8 @@
 
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMatrixMultiplier.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ParallelTenLocalLinearMatrixMultiplierFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/PrefetchingTenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/TenLocalLinearMatrixMultiplierFactory.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
@@ -66,5 +68,60 @@ TEST(MatrixMultiplierTest, test10LocalLinearMatrixMultiplier) {
   testMatrixMultiplier(factory.create(), 10);
 }
 
+TEST(MatrixMultiplierTest, testPrefetching10LocalLinearMatrixMultiplier) {
+  PrefetchingTenLocalLinearMatrixMultiplierFactory factory;
+
+  testMatrixMultiplier(factory.create(), 10);
+}
+
+TEST(MatrixMultiplierTest, testPrefetchingMatrixMultiplierMatchesOriginal) {
+  std::vector<__m128i> src(1000);
+  for (size_t i = 0; i < src.size(); i++) {
+    src[i] = _mm_set_epi64x(i, i * i);
+  }
+  __m128i seed = _mm_set_epi64x(123, 456);
+  // a partial last batch.
+  size_t length =
+      10 * PrefetchingTenLocalLinearMatrixMultiplier::kBatchSize + 7;
+
+  auto expected = TenLocalLinearMatrixMultiplierFactory()
+                      .create()
+                      ->multiplyWithRandomMatrix(seed, length, src);
+  auto rst = PrefetchingTenLocalLinearMatrixMultiplierFactory()
+                 .create()
+                 ->multiplyWithRandomMatrix(seed, length, src);
+  EXPECT_EQ(rst.size(), length);
+  for (size_t i = 0; i < length; i++) {
+    EXPECT_EQ(_mm_movemask_epi8(_mm_cmpeq_epi8(rst[i], expected[i])), 0xFFFF);
+  }
+}
+
+TEST(MatrixMultiplierTest, testParallel10LocalLinearMatrixMultiplier) {
+  ParallelTenLocalLinearMatrixMultiplierFactory factory(4);
+
+  testMatrixMultiplier(factory.create(), 10);
+}
+
+TEST(MatrixMultiplierTest, testParallelMatrixMultiplierIgnoresThreadCount) {
+  std::vector<__m128i> src(1000);
+  for (size_t i = 0; i < src.size(); i++) {
+    src[i] = _mm_set_epi64x(i, i * i);
+  }
+  __m128i seed = _mm_set_epi64x(123, 456);
+  // a partial last chunk.
+  size_t length = 3 * ParallelTenLocalLinearMatrixMultiplier::kChunkSize + 5;
+
+  auto expected = ParallelTenLocalLinearMatrixMultiplierFactory(1)
+                      .create()
+                      ->multiplyWithRandomMatrix(seed, length, src);
+  auto rst = ParallelTenLocalLinearMatrixMultiplierFactory(3)
+                 .create()
+                 ->multiplyWithRandomMatrix(seed, length, src);
+  EXPECT_EQ(rst.size(), length);
+  for (size_t i = 0; i < length; i++) {
+    EXPECT_EQ(_mm_movemask_epi8(_mm_cmpeq_epi8(rst[i], expected[i])), 0xFFFF);
+  }
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -14,6 +14,7 @@
 #include <random>
 
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentHost.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/BatchedRegularErrorMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummySinglePointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -135,5 +136,36 @@ TEST(MPCotExtenderTest, testRealMPCotWithRealSpcot) {
   testMpCot(std::move(sender), std::move(receiver));
 }
 
+TEST(MPCotExtenderTest, testBatchedMPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  BatchedRegularErrorMultiPointCotFactory factory;
+
+  auto sender = factory.create(agent0);
+  auto receiver = factory.create(agent1);
+
+  testMpCot(std::move(sender), std::move(receiver));
+}
+
+TEST(MPCotExtenderTest, testMultiThreadedBatchedMPCot) {
+  communication::InMemoryPartyCommunicationAgentHost host;
+
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent0 =
+      host.getAgent(0);
+  std::unique_ptr<communication::IPartyCommunicationAgent> agent1 =
+      host.getAgent(1);
+
+  // the parties don't need to agree on the number of threads.
+  auto sender = BatchedRegularErrorMultiPointCotFactory(4).create(agent0);
+  auto receiver = BatchedRegularErrorMultiPointCotFactory(3).create(agent1);
+
+  testMpCot(std::move(sender), std::move(receiver));
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -13,11 +13,13 @@
 #include <memory>
 
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentHost.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/BatchedRegularErrorMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyRcotExtender.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyRcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummySinglePointCotFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/FerretParameters.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtender.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -127,5 +129,22 @@ TEST(RcotExtenderTest, testWithRegularErrorMPCOTandRealSPCOT) {
           std::make_unique<SinglePointCotFactory>())));
 }
 
+TEST(RcotExtenderTest, testDefaultFerretParameters) {
+  RcotExtenderFactory factory(
+      std::make_unique<TenLocalLinearMatrixMultiplierFactory>(),
+      std::make_unique<BatchedRegularErrorMultiPointCotFactory>());
+  auto& parameters = kDefaultFerretParameters;
+  auto spcotLength = parameters.extendedSize / parameters.weight;
+  EXPECT_EQ(parameters.extendedSize % parameters.weight, 0);
+  EXPECT_EQ(spcotLength & (spcotLength - 1), 0);
+  EXPECT_GT(parameters.getOutputSizePerExtension(), 0);
+
+  auto extender = factory.create();
+  EXPECT_EQ(
+      extender->receiverInit(
+          parameters.extendedSize, parameters.baseSize, parameters.weight),
+      parameters.getBaseRcotSize());
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
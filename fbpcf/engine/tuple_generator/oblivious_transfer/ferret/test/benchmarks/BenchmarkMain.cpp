@@ -10,6 +10,7 @@
 #include "common/init/Init.h"
 
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMatrixMultiplierFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/PrefetchingTenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/TenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/test/benchmarks/CotBenchmark.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/test/benchmarks/MatrixMultiplierBenchmark.h"
@@ -26,13 +27,47 @@ BENCHMARK(TenLocalLinearMatrixMultiplier, n) {
       std::make_unique<TenLocalLinearMatrixMultiplierFactory>(), n);
 }
 
+BENCHMARK_RELATIVE(PrefetchingTenLocalLinearMatrixMultiplier, n) {
+  benchmarkMatrixMultiplier(
+      std::make_unique<PrefetchingTenLocalLinearMatrixMultiplierFactory>(), n);
+}
+
+BENCHMARK_PARAM(benchmarkParallelMatrixMultiplier, 1)
+BENCHMARK_PARAM(benchmarkParallelMatrixMultiplier, 2)
+BENCHMARK_PARAM(benchmarkParallelMatrixMultiplier, 4)
+BENCHMARK_PARAM(benchmarkParallelMatrixMultiplier, 8)
+BENCHMARK_PARAM(benchmarkParallelMatrixMultiplier, 16)
+
 BENCHMARK_COUNTERS(SinglePointCot, counters) {
   SinglePointCotBenchmark benchmark;
   benchmark.runBenchmark(counters);
 }
 
 BENCHMARK_COUNTERS(RegularErrorMultiPointCot, counters) {
-  RegularErrorMultiPointCotBenchmark benchmark;
+  MultiPointCotBenchmark benchmark(
+      std::make_unique<RegularErrorMultiPointCotFactory>(
+          std::make_unique<SinglePointCotFactory>()));
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedRegularErrorMultiPointCot, counters) {
+  MultiPointCotBenchmark benchmark(
+      std::make_unique<BatchedRegularErrorMultiPointCotFactory>());
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(RegularErrorMultiPointCot_SameRegion, counters) {
+  MultiPointCotBenchmark benchmark(
+      std::make_unique<RegularErrorMultiPointCotFactory>(
+          std::make_unique<SinglePointCotFactory>()),
+      communication::NetworkProfile::sameRegion());
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedRegularErrorMultiPointCot_SameRegion, counters) {
+  MultiPointCotBenchmark benchmark(
+      std::make_unique<BatchedRegularErrorMultiPointCotFactory>(),
+      communication::NetworkProfile::sameRegion());
   benchmark.runBenchmark(counters);
 }
 
@@ -40,6 +75,22 @@ BENCHMARK_COUNTERS(RcotExtender, counters) {
   RcotExtenderBenchmark benchmark;
   benchmark.runBenchmark(counters);
 }
+
+BENCHMARK_COUNTERS(ParallelRcotExtender_1Thread, counters) {
+  benchmarkParallelRcotExtender(counters, 1);
+}
+
+BENCHMARK_COUNTERS(ParallelRcotExtender_2Threads, counters) {
+  benchmarkParallelRcotExtender(counters, 2);
+}
+
+BENCHMARK_COUNTERS(ParallelRcotExtender_4Threads, counters) {
+  benchmarkParallelRcotExtender(counters, 4);
+}
+
+BENCHMARK_COUNTERS(ParallelRcotExtender_8Threads, counters) {
+  benchmarkParallelRcotExtender(counters, 8);
+}
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret
 
 int main(int argc, char* argv[]) {
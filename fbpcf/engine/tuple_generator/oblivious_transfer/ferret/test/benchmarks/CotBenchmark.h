@@ -7,10 +7,13 @@
 
 #include <folly/Benchmark.h>
 #include <future>
+#include <optional>
 #include <random>
 
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/BatchedRegularErrorMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/IMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ISinglePointCot.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ParallelTenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -99,16 +102,30 @@ class SinglePointCotBenchmark final : public util::NetworkedBenchmark {
   __m128i delta_;
 };
 
-class RegularErrorMultiPointCotBenchmark final
-    : public util::NetworkedBenchmark {
+class MultiPointCotBenchmark final : public util::NetworkedBenchmark {
  public:
-  void setup() override {
-    auto [agent0, agent1] = util::getSocketAgents();
-    agent0_ = std::move(agent0);
-    agent1_ = std::move(agent1);
+  /**
+   * @param profile if set, the parties talk over an emulated network link
+   * instead of local sockets, so that round trips show up in the timing.
+   */
+  explicit MultiPointCotBenchmark(
+      std::unique_ptr<IMultiPointCotFactory> factory,
+      std::optional<communication::NetworkProfile> profile = std::nullopt)
+      : factory_(std::move(factory)), profile_(profile) {}
 
-    factory_ = std::make_unique<RegularErrorMultiPointCotFactory>(
-        std::make_unique<SinglePointCotFactory>());
+  void setup() override {
+    if (profile_.has_value()) {
+      auto [agentFactory0, agentFactory1] =
+          util::getEmulatedNetworkAgentFactories(profile_.value());
+      agentFactory0_ = std::move(agentFactory0);
+      agentFactory1_ = std::move(agentFactory1);
+      agent0_ = agentFactory0_->create(1, "benchmark_traffic");
+      agent1_ = agentFactory1_->create(0, "benchmark_traffic");
+    } else {
+      auto [agent0, agent1] = util::getSocketAgents();
+      agent0_ = std::move(agent0);
+      agent1_ = std::move(agent1);
+    }
 
     auto baseOtSize = std::log2(kExtendedSize / kWeight) * kWeight;
     auto [baseOTSend, baseOTReceive, delta] = getBaseOT(baseOtSize);
@@ -141,7 +158,13 @@ class RegularErrorMultiPointCotBenchmark final
   }
 
  private:
-  std::unique_ptr<RegularErrorMultiPointCotFactory> factory_;
+  std::unique_ptr<IMultiPointCotFactory> factory_;
+  std::optional<communication::NetworkProfile> profile_;
+
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
 
   std::unique_ptr<communication::IPartyCommunicationAgent> agent0_;
   std::unique_ptr<communication::IPartyCommunicationAgent> agent1_;
@@ -156,16 +179,24 @@ class RegularErrorMultiPointCotBenchmark final
 
 class RcotExtenderBenchmark final : public util::NetworkedBenchmark {
  public:
+  RcotExtenderBenchmark()
+      : RcotExtenderBenchmark(
+            std::make_unique<TenLocalLinearMatrixMultiplierFactory>(),
+            std::make_unique<RegularErrorMultiPointCotFactory>(
+                std::make_unique<SinglePointCotFactory>())) {}
+
+  RcotExtenderBenchmark(
+      std::unique_ptr<IMatrixMultiplierFactory> matrixMultiplierFactory,
+      std::unique_ptr<IMultiPointCotFactory> multiPointCotFactory)
+      : factory_(std::make_unique<RcotExtenderFactory>(
+            std::move(matrixMultiplierFactory),
+            std::move(multiPointCotFactory))) {}
+
   void setup() override {
     auto [agent0, agent1] = util::getSocketAgents();
     agent0_ = std::move(agent0);
     agent1_ = std::move(agent1);
 
-    factory_ = std::make_unique<RcotExtenderFactory>(
-        std::make_unique<TenLocalLinearMatrixMultiplierFactory>(),
-        std::make_unique<RegularErrorMultiPointCotFactory>(
-            std::make_unique<SinglePointCotFactory>()));
-
     auto baseOtSize = kBaseSize + std::log2(kExtendedSize / kWeight) * kWeight;
     auto [baseOTSend, baseOTReceive, delta] = getBaseOT(baseOtSize);
     baseOTSend_ = std::move(baseOTSend);
@@ -212,4 +243,16 @@ class RcotExtenderBenchmark final : public util::NetworkedBenchmark {
   __m128i delta_;
 };
 
+// extend with the multi-threaded components, for thread scaling curves.
+inline void benchmarkParallelRcotExtender(
+    folly::UserCounters& counters,
+    int numberOfThreads) {
+  RcotExtenderBenchmark benchmark(
+      std::make_unique<ParallelTenLocalLinearMatrixMultiplierFactory>(
+          numberOfThreads),
+      std::make_unique<BatchedRegularErrorMultiPointCotFactory>(
+          numberOfThreads));
+  benchmark.runBenchmark(counters);
+}
+
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -8,6 +8,7 @@
 #include <memory>
 #include <random>
 
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/ParallelTenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/test/benchmarks/MatrixMultiplierBenchmark.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer::ferret {
@@ -34,5 +35,12 @@ std::vector<__m128i> MatrixMultiplierBenchmark::benchmark() const {
   return multiplier_->multiplyWithRandomMatrix(seed_, rstLength_, src_);
 }
 
+void benchmarkParallelMatrixMultiplier(uint32_t n, int numberOfThreads) {
+  benchmarkMatrixMultiplier(
+      std::make_unique<ParallelTenLocalLinearMatrixMultiplierFactory>(
+          numberOfThreads),
+      n);
+}
+
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -56,5 +56,10 @@ inline void benchmarkMatrixMultiplier(
   }
   folly::doNotOptimizeAway(rst);
 }
+
+/**
+ * Benchmark ParallelTenLocalLinearMatrixMultiplier, for thread scaling curves.
+ */
+void benchmarkParallelMatrixMultiplier(uint32_t n, int numberOfThreads);
 } // namespace
   // fbpcf::engine::tuple_generator::oblivious_transfer::ferret
@@ -13,6 +13,7 @@
 #include <random>
 #include <thread>
 #include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentHost.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/CoBaseObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/DummyBaseObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransfer.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransferFactory.h"
@@ -130,4 +131,10 @@ TEST(BaseObliviousTransferTest, testNpBaseOT) {
       std::make_unique<NpBaseObliviousTransferFactory>());
 }
 
+TEST(BaseObliviousTransferTest, testCoBaseOT) {
+  testBaseObliviousTransfer(
+      std::make_unique<CoBaseObliviousTransferFactory>(),
+      std::make_unique<CoBaseObliviousTransferFactory>());
+}
+
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
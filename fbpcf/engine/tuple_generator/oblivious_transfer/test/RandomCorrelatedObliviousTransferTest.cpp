@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 #include <smmintrin.h>
 #include <xmmintrin.h>
+#include <functional>
 #include <future>
 #include <memory>
 #include <random>
@@ -22,6 +23,7 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotHelper.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMatrixMultiplierFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyMultiPointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/DummyRcotExtenderFactory.h"
@@ -31,6 +33,7 @@
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/SinglePointCotFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/TenLocalLinearMatrixMultiplierFactory.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/system/CpuUtil.h"
 #include "fbpcf/test/TestHelper.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer {
@@ -261,6 +264,21 @@ TEST(
           ferret::kWeight));
 }
 
+TEST(RandomCorrelatedObliviousTransferTest, testFerretRcotWithChunkedMatrix) {
+  testRandomCorrelatedObliviousTransfer(
+      createFerretRcotFactory(ferret::kDefaultFerretParameters, 2, true),
+      createFerretRcotFactory(ferret::kDefaultFerretParameters, 2, true));
+}
+
+TEST(
+    RandomCorrelatedObliviousTransferTest,
+    testFerretRcotWithBatchedMultiPointCot) {
+  testRandomCorrelatedObliviousTransfer(
+      createFerretRcotFactory(ferret::kDefaultFerretParameters, 2, false, true),
+      createFerretRcotFactory(
+          ferret::kDefaultFerretParameters, 2, false, true));
+}
+
 bool extractIJ(const std::vector<__m128i>& matrixes, int index, int i, int j) {
   assert(matrixes.size() >= (index + 1) * 128);
   assert(i < 128);
@@ -278,10 +296,15 @@ bool extractIJ(const std::vector<__m128i>& matrixes, int index, int i, int j) {
 class IKNPMatrixTransposeTestHelper final
     : IknpShRandomCorrelatedObliviousTransfer {
   FRIEND_TEST(IKNPRandomCorrelatedObliviousTransferTest, testMatrixTranspose);
+  FRIEND_TEST(
+      IKNPRandomCorrelatedObliviousTransferTest,
+      testMatrixTransposeKernels);
 };
 
-TEST(IKNPRandomCorrelatedObliviousTransferTest, testMatrixTranspose) {
-  int size = 128;
+void testMatrixTransposeKernel(
+    std::function<std::vector<__m128i>(const std::vector<__m128i>&)>
+        transpose,
+    int size) {
   std::vector<__m128i> testData(size * 128);
   std::random_device rd;
   std::mt19937_64 e(rd());
@@ -289,7 +312,7 @@ TEST(IKNPRandomCorrelatedObliviousTransferTest, testMatrixTranspose) {
   for (auto& item : testData) {
     item = _mm_set_epi64x(dist(e), dist(e));
   }
-  auto dst0 = IKNPMatrixTransposeTestHelper::matrixTranspose(testData);
+  auto dst0 = transpose(testData);
 
   for (size_t index = 0; index < size; index++) {
     for (int i = 0; i < 128; i++) {
@@ -300,13 +323,32 @@ TEST(IKNPRandomCorrelatedObliviousTransferTest, testMatrixTranspose) {
     }
   }
 
-  auto dst1 = IKNPMatrixTransposeTestHelper::matrixTranspose(dst0);
+  auto dst1 = transpose(dst0);
 
   for (size_t i = 0; i < testData.size(); i++) {
     EXPECT_TRUE(compareM128i(dst1.at(i), testData.at(i)));
   }
 }
 
+TEST(IKNPRandomCorrelatedObliviousTransferTest, testMatrixTranspose) {
+  testMatrixTransposeKernel(
+      IKNPMatrixTransposeTestHelper::matrixTranspose, 128);
+}
+
+TEST(IKNPRandomCorrelatedObliviousTransferTest, testMatrixTransposeKernels) {
+  // 7 matrices leaves a remainder for each of the wider kernels.
+  testMatrixTransposeKernel(
+      IKNPMatrixTransposeTestHelper::matrixTransposeSse, 7);
+  if (system::isAvx2Supported()) {
+    testMatrixTransposeKernel(
+        IKNPMatrixTransposeTestHelper::matrixTransposeAvx2, 7);
+  }
+  if (system::isAvx512Supported()) {
+    testMatrixTransposeKernel(
+        IKNPMatrixTransposeTestHelper::matrixTransposeAvx512, 7);
+  }
+}
+
 TEST(
     IKNPRandomCorrelatedObliviousTransferTest,
     testIKNPRandomCorrelatedObliviousTransferWithDummyBaseOt) {
@@ -327,6 +369,13 @@ TEST(
           std::make_unique<NpBaseObliviousTransferFactory>()));
 }
 
+TEST(
+    IKNPRandomCorrelatedObliviousTransferTest,
+    testIKNPRandomCorrelatedObliviousTransferWithCoBaseOt) {
+  testRandomCorrelatedObliviousTransfer(
+      createClassicRcotFactory(true), createClassicRcotFactory(true));
+}
+
 TEST(
     RandomCorrelatedObliviousTransferTest,
     testIKNPBootstrappedExtenderBasedRcotWithFerretExtenderPoweredByMpcotWithRealSpcotAnd10LocalLinearMatrixMultipler) {
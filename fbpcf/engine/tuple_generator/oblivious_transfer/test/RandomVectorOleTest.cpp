@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/DummyBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomVectorOleFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedRandomVectorOleFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/SinglePointCotFactory.h"
+
+namespace fbpcf::engine::tuple_generator::oblivious_transfer {
+
+std::unique_ptr<IRandomCorrelatedObliviousTransferFactory>
+createRcotFactoryForVoleTest() {
+  return std::make_unique<IknpShRandomCorrelatedObliviousTransferFactory>(
+      std::make_unique<insecure::DummyBaseObliviousTransferFactory>());
+}
+
+void testRandomVectorOle(
+    std::function<std::unique_ptr<IRandomVectorOleFactory>(
+        communication::IPartyCommunicationAgentFactory&,
+        int)> createFactory) {
+  auto agentFactories = communication::getInMemoryAgentFactory(2);
+  const uint64_t delta = 0x0123456789ABCDEF;
+  const size_t size = 5000;
+  const int kRounds = 4;
+
+  auto senderTask = [&]() {
+    auto vole = createFactory(*agentFactories[0], 0)->create(delta);
+    std::vector<uint64_t> w;
+    for (int i = 0; i < kRounds; i++) {
+      auto tmp = vole->senderVole(size);
+      EXPECT_EQ(tmp.size(), size);
+      w.insert(w.end(), tmp.begin(), tmp.end());
+    }
+    EXPECT_THROW(vole->receiverVole(1), std::runtime_error);
+    return w;
+  };
+  auto receiverTask = [&]() {
+    auto vole = createFactory(*agentFactories[1], 1)->create();
+    std::vector<uint64_t> u;
+    std::vector<uint64_t> v;
+    for (int i = 0; i < kRounds; i++) {
+      auto [tmpU, tmpV] = vole->receiverVole(size);
+      EXPECT_EQ(tmpU.size(), size);
+      EXPECT_EQ(tmpV.size(), size);
+      u.insert(u.end(), tmpU.begin(), tmpU.end());
+      v.insert(v.end(), tmpV.begin(), tmpV.end());
+    }
+    EXPECT_THROW(vole->senderVole(1), std::runtime_error);
+    return std::make_pair(u, v);
+  };
+
+  auto senderFuture = std::async(senderTask);
+  auto receiverFuture = std::async(receiverTask);
+  auto w = senderFuture.get();
+  auto [u, v] = receiverFuture.get();
+
+  ASSERT_EQ(w.size(), size * kRounds);
+  int64_t zeroCount = 0;
+  for (size_t i = 0; i < w.size(); i++) {
+    EXPECT_EQ(w[i], v[i] + u[i] * delta);
+    zeroCount += u[i] == 0;
+  }
+  // u must be random
+  EXPECT_LT(zeroCount, 10);
+}
+
+TEST(RandomVectorOleTest, testRcotBasedVole) {
+  testRandomVectorOle(
+      [](communication::IPartyCommunicationAgentFactory& agentFactory,
+         int myId) {
+        return std::make_unique<RcotBasedRandomVectorOleFactory>(
+            createRcotFactoryForVoleTest(), agentFactory, myId);
+      });
+}
+
+TEST(RandomVectorOleTest, testExtenderBasedVole) {
+  // 4096 VOLEs per extension, of which 512 + 64 are kept as the next base.
+  testRandomVectorOle(
+      [](communication::IPartyCommunicationAgentFactory& agentFactory,
+         int myId) {
+        return std::make_unique<ExtenderBasedRandomVectorOleFactory>(
+            createRcotFactoryForVoleTest(),
+            std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
+                std::make_unique<ferret::SinglePointCotFactory>()),
+            agentFactory,
+            myId,
+            4096,
+            512,
+            64);
+      });
+}
+
+} // namespace fbpcf::engine::tuple_generator::oblivious_transfer
@@ -10,13 +10,18 @@
 
 #include "common/init/Init.h"
 
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/CoBaseObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/EmpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ExtenderBasedRandomVectorOleFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IBaseObliviousTransfer.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IBaseObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/NpBaseObliviousTransferFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedBidirectionObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotBasedRandomVectorOleFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/FerretParameters.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RcotExtenderFactory.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCot.h"
 #include "fbpcf/engine/tuple_generator/oblivious_transfer/ferret/RegularErrorMultiPointCotFactory.h"
@@ -25,11 +30,16 @@
 #include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
 #include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
 #include "fbpcf/engine/util/util.h"
+#include "fbpcf/system/CpuUtil.h"
 
 namespace fbpcf::engine::tuple_generator::oblivious_transfer {
 
-class NpBaseObliviousTransferBenchmark : public util::NetworkedBenchmark {
+class BaseObliviousTransferBenchmark : public util::NetworkedBenchmark {
  public:
+  explicit BaseObliviousTransferBenchmark(
+      std::unique_ptr<IBaseObliviousTransferFactory> factory)
+      : factory_(std::move(factory)) {}
+
   void setup() override {
     auto [agent0, agent1] = util::getSocketAgents();
     agent0_ = std::move(agent0);
@@ -40,8 +50,7 @@ class NpBaseObliviousTransferBenchmark : public util::NetworkedBenchmark {
 
  protected:
   void initSender() override {
-    NpBaseObliviousTransferFactory factory;
-    sender_ = factory.create(std::move(agent0_));
+    sender_ = factory_->create(std::move(agent0_));
   }
 
   void runSender() override {
@@ -49,8 +58,7 @@ class NpBaseObliviousTransferBenchmark : public util::NetworkedBenchmark {
   }
 
   void initReceiver() override {
-    NpBaseObliviousTransferFactory factory;
-    receiver_ = factory.create(std::move(agent1_));
+    receiver_ = factory_->create(std::move(agent1_));
   }
 
   void runReceiver() override {
@@ -62,6 +70,7 @@ class NpBaseObliviousTransferBenchmark : public util::NetworkedBenchmark {
   }
 
  private:
+  std::unique_ptr<IBaseObliviousTransferFactory> factory_;
   size_t size_ = 1024;
 
   std::unique_ptr<communication::IPartyCommunicationAgent> agent0_;
@@ -74,7 +83,14 @@ class NpBaseObliviousTransferBenchmark : public util::NetworkedBenchmark {
 };
 
 BENCHMARK_COUNTERS(NpBaseObliviousTransfer, counters) {
-  NpBaseObliviousTransferBenchmark benchmark;
+  BaseObliviousTransferBenchmark benchmark(
+      std::make_unique<NpBaseObliviousTransferFactory>());
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(CoBaseObliviousTransfer, counters) {
+  BaseObliviousTransferBenchmark benchmark(
+      std::make_unique<CoBaseObliviousTransferFactory>());
   benchmark.runBenchmark(counters);
 }
 
@@ -157,6 +173,66 @@ BENCHMARK_COUNTERS(IknpShRandomCorrelatedObliviousTransfer, counters) {
   benchmark.runBenchmark(counters);
 }
 
+// exposes the transpose kernels of IKNP
+class IknpMatrixTransposeBenchmarkHelper final
+    : public IknpShRandomCorrelatedObliviousTransfer {
+ public:
+  using TransposeKernel =
+      std::vector<__m128i> (*)(const std::vector<__m128i>& src);
+
+  static void run(TransposeKernel kernel, unsigned int n) {
+    std::vector<__m128i> matrices;
+    BENCHMARK_SUSPEND {
+      // 1024 matrices, i.e. the transposes of 131072 RCOTs.
+      matrices.resize(1024 * 128);
+      std::mt19937_64 e(std::random_device{}());
+      for (auto& item : matrices) {
+        item = _mm_set_epi64x(e(), e());
+      }
+    }
+    for (unsigned int i = 0; i < n; i++) {
+      matrices = kernel(matrices);
+    }
+    folly::doNotOptimizeAway(matrices);
+  }
+
+  static void runSse(unsigned int n) {
+    run(&matrixTransposeSse, n);
+  }
+
+  static void runAvx2(unsigned int n) {
+    run(&matrixTransposeAvx2, n);
+  }
+
+  static void runAvx512(unsigned int n) {
+    run(&matrixTransposeAvx512, n);
+  }
+
+  // the AVX kernels are only registered when the CPU supports them, rather
+  // than reported as doing nothing in no time. They are all registered at
+  // run time, so that the AVX ones are reported relative to the SSE one.
+  static void addBenchmarks() {
+    folly::addBenchmark(__FILE__, "IknpMatrixTransposeSse", [](unsigned int n) {
+      runSse(n);
+      return n;
+    });
+    if (system::isAvx2Supported()) {
+      folly::addBenchmark(
+          __FILE__, "%IknpMatrixTransposeAvx2", [](unsigned int n) {
+            runAvx2(n);
+            return n;
+          });
+    }
+    if (system::isAvx512Supported()) {
+      folly::addBenchmark(
+          __FILE__, "%IknpMatrixTransposeAvx512", [](unsigned int n) {
+            runAvx512(n);
+            return n;
+          });
+    }
+  }
+};
+
 class ExtenderBasedRandomCorrelatedObliviousTransferWithIknpBenchmark final
     : public RandomCorrelatedObliviousTransferBenchmark {
  public:
@@ -328,10 +404,123 @@ BENCHMARK_COUNTERS(RcotBasedBidirectionObliviousTransferWithEmp, counters) {
   benchmark.runBenchmark(counters);
 }
 
+class RandomVectorOleBenchmark : public util::NetworkedBenchmark {
+ public:
+  void setup() override {
+    auto [agentFactory0, agentFactory1] = util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    senderFactory_ = getVoleFactory(*agentFactory0_, 0);
+    receiverFactory_ = getVoleFactory(*agentFactory1_, 1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    delta_ = e();
+  }
+
+ protected:
+  void initSender() override {
+    sender_ = senderFactory_->create(delta_);
+  }
+
+  void runSender() override {
+    sender_->senderVole(size_);
+  }
+
+  void initReceiver() override {
+    receiver_ = receiverFactory_->create();
+  }
+
+  void runReceiver() override {
+    receiver_->receiverVole(size_);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return sender_->getTrafficStatistics();
+  }
+
+  virtual std::unique_ptr<IRandomVectorOleFactory> getVoleFactory(
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId) = 0;
+
+  std::unique_ptr<IRandomCorrelatedObliviousTransferFactory> getRcotFactory() {
+    return std::make_unique<
+        ExtenderBasedRandomCorrelatedObliviousTransferFactory>(
+        std::make_unique<IknpShRandomCorrelatedObliviousTransferFactory>(
+            std::make_unique<NpBaseObliviousTransferFactory>()),
+        std::make_unique<ferret::RcotExtenderFactory>(
+            std::make_unique<ferret::TenLocalLinearMatrixMultiplierFactory>(),
+            std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
+                std::make_unique<ferret::SinglePointCotFactory>())),
+        ferret::kExtendedSize,
+        ferret::kBaseSize,
+        ferret::kWeight);
+  }
+
+ private:
+  // the RCOT based VOLE needs 64 RCOTs per element
+  size_t size_ = 100000;
+  uint64_t delta_;
+
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::unique_ptr<IRandomVectorOleFactory> senderFactory_;
+  std::unique_ptr<IRandomVectorOleFactory> receiverFactory_;
+
+  std::unique_ptr<IRandomVectorOle> sender_;
+  std::unique_ptr<IRandomVectorOle> receiver_;
+};
+
+// 64 RCOTs per element, the baseline for the extender based VOLE.
+class RcotBasedRandomVectorOleBenchmark final
+    : public RandomVectorOleBenchmark {
+ protected:
+  std::unique_ptr<IRandomVectorOleFactory> getVoleFactory(
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId) override {
+    return std::make_unique<RcotBasedRandomVectorOleFactory>(
+        getRcotFactory(), agentFactory, myId);
+  }
+};
+
+BENCHMARK_COUNTERS(RcotBasedRandomVectorOle, counters) {
+  RcotBasedRandomVectorOleBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class ExtenderBasedRandomVectorOleBenchmark final
+    : public RandomVectorOleBenchmark {
+ protected:
+  std::unique_ptr<IRandomVectorOleFactory> getVoleFactory(
+      communication::IPartyCommunicationAgentFactory& agentFactory,
+      int myId) override {
+    return std::make_unique<ExtenderBasedRandomVectorOleFactory>(
+        getRcotFactory(),
+        std::make_unique<ferret::RegularErrorMultiPointCotFactory>(
+            std::make_unique<ferret::SinglePointCotFactory>()),
+        agentFactory,
+        myId,
+        ferret::kExtendedSize,
+        ferret::kBaseSize,
+        ferret::kWeight);
+  }
+};
+
+BENCHMARK_COUNTERS(ExtenderBasedRandomVectorOle, counters) {
+  ExtenderBasedRandomVectorOleBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
 } // namespace fbpcf::engine::tuple_generator::oblivious_transfer
 
 int main(int argc, char* argv[]) {
   facebook::initFacebook(&argc, &argv);
+  fbpcf::engine::tuple_generator::oblivious_transfer::
+      IknpMatrixTransposeBenchmarkHelper::addBenchmarks();
   folly::runBenchmarks();
   return 0;
 }
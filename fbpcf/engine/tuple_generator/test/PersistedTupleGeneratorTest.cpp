@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+
+#include <folly/Random.h>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/PersistedTupleGenerator.h"
+#include "fbpcf/engine/tuple_generator/PersistedTupleGeneratorFactory.h"
+#include "fbpcf/engine/tuple_generator/TupleFile.h"
+#include "fbpcf/engine/tuple_generator/test/TupleGeneratorTestHelper.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::engine::tuple_generator {
+
+std::string getTemporaryTupleFilePath() {
+  return std::filesystem::temp_directory_path().string() + "/tuple_file_" +
+      std::to_string(folly::Random::rand64());
+}
+
+std::vector<ITupleGenerator::BooleanTuple> getRandomTuples(size_t size) {
+  std::vector<ITupleGenerator::BooleanTuple> rst(size);
+  for (auto& tuple : rst) {
+    auto value = folly::Random::rand32();
+    tuple = ITupleGenerator::BooleanTuple(value & 1, value & 2, value & 4);
+  }
+  return rst;
+}
+
+void assertSameTuples(
+    const std::vector<ITupleGenerator::BooleanTuple>& expected,
+    size_t offset,
+    const std::vector<ITupleGenerator::BooleanTuple>& actual) {
+  for (size_t i = 0; i < actual.size(); i++) {
+    ASSERT_EQ(actual[i].getA(), expected[offset + i].getA());
+    ASSERT_EQ(actual[i].getB(), expected[offset + i].getB());
+    ASSERT_EQ(actual[i].getC(), expected[offset + i].getC());
+  }
+}
+
+TEST(TupleFileTest, testAppendAndRead) {
+  auto path = getTemporaryTupleFilePath();
+  auto key = util::getRandomM128iFromSystemNoise();
+  auto fileId = util::getRandomM128iFromSystemNoise();
+  // sizes that don't line up with the AES blocks.
+  auto tuples = getRandomTuples(70001 + 1003);
+
+  {
+    auto file = TupleFile::create(path, key, fileId);
+    file->append(std::vector<ITupleGenerator::BooleanTuple>(
+        tuples.begin(), tuples.begin() + 70001));
+    assertSameTuples(tuples, 5, file->read(5, 1000));
+    file->append(std::vector<ITupleGenerator::BooleanTuple>(
+        tuples.begin() + 70001, tuples.end()));
+    EXPECT_EQ(file->getTupleCount(), tuples.size());
+    assertSameTuples(tuples, 69999, file->read(69999, 1005));
+  }
+
+  EXPECT_THROW(TupleFile::create(path, key, fileId), std::runtime_error);
+
+  auto file = TupleFile::open(path, key);
+  EXPECT_EQ(file->getTupleCount(), tuples.size());
+  auto actualFileId = file->getFileId();
+  EXPECT_EQ(std::memcmp(&actualFileId, &fileId, sizeof(fileId)), 0);
+  assertSameTuples(tuples, 0, file->read(0, tuples.size()));
+  EXPECT_THROW(file->read(tuples.size() - 1, 2), std::out_of_range);
+
+  std::remove(path.c_str());
+}
+
+TEST(TupleFileTest, testSmallAppends) {
+  auto path = getTemporaryTupleFilePath();
+  auto key = util::getRandomM128iFromSystemNoise();
+  // appends that fill the 128-tuple groups partially and across boundaries.
+  std::vector<size_t> sizes = {1, 5, 122, 1, 130, 255, 0, 1000};
+  std::vector<ITupleGenerator::BooleanTuple> tuples;
+  {
+    auto file =
+        TupleFile::create(path, key, util::getRandomM128iFromSystemNoise());
+    for (auto size : sizes) {
+      auto batch = getRandomTuples(size);
+      file->append(batch);
+      tuples.insert(tuples.end(), batch.begin(), batch.end());
+      assertSameTuples(tuples, 0, file->read(0, tuples.size()));
+    }
+  }
+  auto file = TupleFile::open(path, key);
+  EXPECT_EQ(file->getTupleCount(), tuples.size());
+  assertSameTuples(tuples, 127, file->read(127, 300));
+  // 3 bits per tuple and 16 bytes of append number per group of 128.
+  EXPECT_EQ(
+      std::filesystem::file_size(path),
+      TupleFile::kHeaderSize + (tuples.size() + 127) / 128 * 64);
+
+  std::remove(path.c_str());
+}
+
+std::vector<uint64_t> readFirstGroup(const std::string& path) {
+  std::vector<uint64_t> rst(8);
+  std::ifstream file(path, std::ios::binary);
+  file.seekg(TupleFile::kHeaderSize);
+  file.read(reinterpret_cast<char*>(rst.data()), rst.size() * sizeof(uint64_t));
+  return rst;
+}
+
+TEST(TupleFileTest, testAppendsIntoSameGroup) {
+  auto path = getTemporaryTupleFilePath();
+  auto key = util::getRandomM128iFromSystemNoise();
+  auto first = getRandomTuples(10);
+  auto second = getRandomTuples(10);
+  auto file =
+      TupleFile::create(path, key, util::getRandomM128iFromSystemNoise());
+  file->append(first);
+  auto before = readFirstGroup(path);
+  file->append(second);
+  auto after = readFirstGroup(path);
+
+  // Under a reused key stream, the bytes would only change by the new
+  // tuples: the a, b and c planes in words 0, 2 and 4, at bits 10 to 19.
+  std::vector<uint64_t> reuseDifference(6);
+  for (size_t i = 0; i < second.size(); i++) {
+    reuseDifference[0] |= static_cast<uint64_t>(second[i].getA()) << (10 + i);
+    reuseDifference[2] |= static_cast<uint64_t>(second[i].getB()) << (10 + i);
+    reuseDifference[4] |= static_cast<uint64_t>(second[i].getC()) << (10 + i);
+  }
+  std::vector<uint64_t> difference(6);
+  for (size_t i = 0; i < difference.size(); i++) {
+    difference[i] = before[i] ^ after[i];
+  }
+  EXPECT_NE(difference, reuseDifference);
+  // the group is encrypted again under the second append's counters.
+  EXPECT_NE(before[6], after[6]);
+
+  auto tuples = first;
+  tuples.insert(tuples.end(), second.begin(), second.end());
+  assertSameTuples(tuples, 0, file->read(0, tuples.size()));
+  file.reset();
+  assertSameTuples(tuples, 0, TupleFile::open(path, key)->read(0, 20));
+
+  std::remove(path.c_str());
+}
+
+TEST(TupleFileTest, testConsumedOffset) {
+  auto path = getTemporaryTupleFilePath();
+  auto key = util::getRandomM128iFromSystemNoise();
+  {
+    auto file =
+        TupleFile::create(path, key, util::getRandomM128iFromSystemNoise());
+    file->append(getRandomTuples(100));
+    EXPECT_EQ(file->getConsumedOffset(), 0);
+    file->setConsumedOffset(42);
+    EXPECT_THROW(file->setConsumedOffset(101), std::invalid_argument);
+  }
+  EXPECT_EQ(TupleFile::open(path, key)->getConsumedOffset(), 42);
+
+  // the tuples can't be read without the key.
+  EXPECT_THROW(
+      TupleFile::open(path, util::getRandomM128iFromSystemNoise()),
+      std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+void testOfflineThenOnline(uint64_t reservationSize) {
+  auto agentFactories = communication::getInMemoryAgentFactory(2);
+  std::vector<std::string> paths = {
+      getTemporaryTupleFilePath(), getTemporaryTupleFilePath()};
+  std::vector<__m128i> keys = {
+      util::getRandomM128iFromSystemNoise(),
+      util::getRandomM128iFromSystemNoise()};
+  const uint64_t kOfflineBatch = 3000;
+  const uint32_t kOnlineBatch = 700;
+
+  auto task = [&](int myId) {
+    auto& agentFactory = *agentFactories.at(myId);
+    {
+      auto generator = createTwoPartyTupleGeneratorFactoryWithDummyRcot(
+                           2, myId, agentFactory)
+                           ->create();
+      auto agent = agentFactory.create(1 - myId, "offline_traffic");
+      // the second call extends the existing file.
+      for (int i = 0; i < 2; i++) {
+        PersistedTupleGenerator::generateOffline(
+            *generator, *agent, myId, paths[myId], keys[myId], kOfflineBatch);
+      }
+    }
+
+    PersistedTupleGeneratorFactory factory(
+        paths[myId], keys[myId], agentFactory, myId, reservationSize);
+    std::vector<ITupleGenerator::BooleanTuple> rst;
+    // two runs, the second one must resume where the first one stopped.
+    for (int run = 0; run < 2; run++) {
+      auto generator = factory.create();
+      EXPECT_FALSE(generator->supportsCompositeTupleGeneration());
+      for (int i = 0; i < 2; i++) {
+        auto tuples = generator->getBooleanTuple(kOnlineBatch);
+        rst.insert(rst.end(), tuples.begin(), tuples.end());
+      }
+    }
+    auto generator = factory.create();
+    auto remaining = 2 * kOfflineBatch - rst.size();
+    EXPECT_THROW(
+        generator->getBooleanTuple(remaining + 1), std::runtime_error);
+    auto tuples = generator->getBooleanTuple(remaining);
+    rst.insert(rst.end(), tuples.begin(), tuples.end());
+    return rst;
+  };
+
+  auto future0 = std::async(task, 0);
+  auto future1 = std::async(task, 1);
+  auto tuples0 = future0.get();
+  auto tuples1 = future1.get();
+
+  ASSERT_EQ(tuples0.size(), 2 * kOfflineBatch);
+  ASSERT_EQ(tuples1.size(), 2 * kOfflineBatch);
+  for (size_t i = 0; i < tuples0.size(); i++) {
+    bool a = tuples0[i].getA() ^ tuples1[i].getA();
+    bool b = tuples0[i].getB() ^ tuples1[i].getB();
+    bool c = tuples0[i].getC() ^ tuples1[i].getC();
+    EXPECT_EQ(c, a & b);
+  }
+
+  for (auto& path : paths) {
+    std::remove(path.c_str());
+  }
+}
+
+TEST(PersistedTupleGeneratorTest, testOfflineThenOnline) {
+  testOfflineThenOnline(PersistedTupleGenerator::kDefaultReservationSize);
+}
+
+TEST(PersistedTupleGeneratorTest, testOfflineThenOnlineWithSmallReservation) {
+  // smaller than a request, so that every request extends the reservation.
+  testOfflineThenOnline(500);
+}
+
+} // namespace fbpcf::engine::tuple_generator
@@ -182,6 +182,11 @@ TEST(TupleGeneratorTest, testTwoPartyTupleGeneratorWithRcotExtender) {
       2, createTwoPartyTupleGeneratorFactoryWithRcotExtender);
 }
 
+TEST(TupleGeneratorTest, testTwoPartyTupleGeneratorWithHighWaterMark) {
+  testTupleGenerator<true>(
+      2, createTwoPartyTupleGeneratorFactoryWithRcotExtenderAndHighWaterMark);
+}
+
 void testTupleGeneratorThreadSynchronization(
     int numberOfParty,
     TupleGeneratorFactoryCreator creator) {
@@ -250,4 +255,11 @@ TEST(
       2, createTwoPartyTupleGeneratorFactoryWithRcotExtenderAndSmallBuffer);
 }
 
+TEST(
+    TupleGeneratorTest,
+    testTwoPartyTupleGeneratorSynchronizationWithHighWaterMark) {
+  testTupleGeneratorThreadSynchronization(
+      2, createTwoPartyTupleGeneratorFactoryWithRcotExtenderAndHighWaterMark);
+}
+
 } // namespace fbpcf::engine::tuple_generator
@@ -152,4 +152,23 @@ createTwoPartyTupleGeneratorFactoryWithRcotExtenderAndSmallBuffer(
       1);
 }
 
+inline std::unique_ptr<ITupleGeneratorFactory>
+createTwoPartyTupleGeneratorFactoryWithRcotExtenderAndHighWaterMark(
+    int /*numberOfParty*/,
+    int myId,
+    communication::IPartyCommunicationAgentFactory& agentFactory) {
+  auto rcot = oblivious_transfer::createFerretRcotFactory(
+      kTestExtendedSize, kTestBaseSize, kTestWeight);
+  // a small buffer with many chunks ahead, to stress the ordering of the
+  // chunks across the two parties.
+  return std::make_unique<TwoPartyTupleGeneratorFactory>(
+      std::move(rcot),
+      std::reference_wrapper<communication::IPartyCommunicationAgentFactory>(
+          agentFactory),
+      myId,
+      16,
+      kTestBufferSize,
+      kTestBufferSize / 2);
+}
+
 } // namespace fbpcf::engine::tuple_generator
@@ -6,6 +6,8 @@
  */
 
 #include <folly/Benchmark.h>
+#include <chrono>
+#include <thread>
 
 #include "common/init/Init.h"
 
@@ -105,6 +107,12 @@ class BaseTupleGeneratorBenchmark : public util::NetworkedBenchmark {
     receiverFactory_ = getTupleGeneratorFactory(1, *agentFactory1_);
   }
 
+  void addStallCounters(folly::UserCounters& counters) {
+    auto [stallCount, stallTime] = sender_->getStallStatistics();
+    counters["stall_count"] = stallCount;
+    counters["stall_time_usec"] = stallTime;
+  }
+
  protected:
   size_t size_ = 10000000;
   std::unique_ptr<ITupleGenerator> sender_;
@@ -189,6 +197,65 @@ class TwoPartyTupleGeneratorBenchmark final
 BENCHMARK_COUNTERS(TwoPartyTupleGenerator, counters) {
   TwoPartyTupleGeneratorBenchmark benchmark;
   benchmark.runBenchmark(counters);
+  benchmark.addStallCounters(counters);
+}
+
+/**
+ * Mimics a job that loads its inputs for a while after the engine is created,
+ * then runs the gates in bursts with some local work in between.
+ */
+class TwoPartyTupleGeneratorWithInputLoadingBenchmark final
+    : public BaseTupleGeneratorBenchmark {
+ public:
+  explicit TwoPartyTupleGeneratorWithInputLoadingBenchmark(
+      uint64_t highWaterMark)
+      : highWaterMark_(highWaterMark) {}
+
+ protected:
+  std::unique_ptr<ITupleGeneratorFactory> getTupleGeneratorFactory(
+      int myId,
+      communication::IPartyCommunicationAgentFactory& agentFactory) override {
+    return std::make_unique<TwoPartyTupleGeneratorFactory>(
+        oblivious_transfer::createFerretRcotFactory(),
+        agentFactory,
+        myId,
+        bufferSize_,
+        highWaterMark_);
+  }
+
+  void runSender() override {
+    runBursts(*sender_);
+  }
+
+  void runReceiver() override {
+    runBursts(*receiver_);
+  }
+
+ private:
+  void runBursts(ITupleGenerator& generator) {
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    for (int i = 0; i < kBursts; i++) {
+      generator.getBooleanTuple(size_ / kBursts);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+
+  static const int kBursts = 10;
+  uint64_t highWaterMark_;
+};
+
+BENCHMARK_COUNTERS(TwoPartyTupleGeneratorWithInputLoading, counters) {
+  TwoPartyTupleGeneratorWithInputLoadingBenchmark benchmark(0);
+  benchmark.runBenchmark(counters);
+  benchmark.addStallCounters(counters);
+}
+
+BENCHMARK_COUNTERS(
+    TwoPartyTupleGeneratorWithInputLoadingAndHighWaterMark,
+    counters) {
+  TwoPartyTupleGeneratorWithInputLoadingBenchmark benchmark(10000000);
+  benchmark.runBenchmark(counters);
+  benchmark.addStallCounters(counters);
 }
 
 class TwoPartyCompositeTupleGeneratorBenchmark
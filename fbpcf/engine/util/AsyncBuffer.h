@@ -7,40 +7,54 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <future>
+#include <utility>
 #include <vector>
 
 namespace fbpcf::engine::util {
 
 /**
  * Holds a buffer that returns the requested amount of data on-demand. Data is
- * regenerated in chunks asynchronously.
+ * regenerated in chunks asynchronously, with up to numberOfBuffersAhead
+ * chunks requested ahead of use. A new chunk is only requested when one is
+ * drained, so the amount of data ready or in production never exceeds that
+ * many chunks.
  */
 template <typename T>
 class AsyncBuffer {
  public:
   AsyncBuffer(
       uint64_t bufferSize,
-      std::function<std::future<std::vector<T>>(uint64_t size)> generateData)
+      std::function<std::future<std::vector<T>>(uint64_t size)> generateData,
+      uint64_t numberOfBuffersAhead = 1)
       : bufferSize_{bufferSize},
         bufferIndex_{bufferSize},
-        generateData_{generateData} {
-    futureBuffer_ = generateData_(bufferSize_);
+        generateData_{generateData},
+        stallCount_{0},
+        stallTimeInMicroseconds_{0} {
+    for (uint64_t i = 0; i < numberOfBuffersAhead; i++) {
+      futureBuffers_.push_back(generateData_(bufferSize_));
+    }
   }
 
   ~AsyncBuffer() {
-    futureBuffer_.get();
+    for (auto& futureBuffer : futureBuffers_) {
+      futureBuffer.get();
+    }
   }
 
   std::vector<T> getData(uint64_t size) {
     std::vector<T> rst;
     while (rst.size() < size) {
       if (bufferIndex_ >= bufferSize_) {
-        buffer_ = futureBuffer_.get();
+        buffer_ = waitForNextBuffer();
         bufferIndex_ = 0;
-        futureBuffer_ = generateData_(bufferSize_);
+        futureBuffers_.push_back(generateData_(bufferSize_));
       }
 
       auto insertSize = std::min(size - rst.size(), bufferSize_ - bufferIndex_);
@@ -53,7 +67,32 @@ class AsyncBuffer {
     return rst;
   }
 
+  /**
+   * Get how often, and for how long in total, getData had to wait for a chunk
+   * that was not ready yet.
+   * @return a pair of (number of stalls, stall time in microseconds).
+   */
+  std::pair<uint64_t, uint64_t> getStallStatistics() const {
+    return {stallCount_, stallTimeInMicroseconds_};
+  }
+
  private:
+  std::vector<T> waitForNextBuffer() {
+    auto futureBuffer = std::move(futureBuffers_.front());
+    futureBuffers_.pop_front();
+    if (futureBuffer.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      auto start = std::chrono::steady_clock::now();
+      futureBuffer.wait();
+      stallCount_++;
+      stallTimeInMicroseconds_ +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+    }
+    return futureBuffer.get();
+  }
+
   uint64_t bufferSize_;
   uint64_t bufferIndex_;
 
@@ -61,7 +100,11 @@ class AsyncBuffer {
 
   std::vector<T> buffer_;
 
-  std::future<std::vector<T>> futureBuffer_;
+  std::deque<std::future<std::vector<T>>> futureBuffers_;
+
+  // they may be read from other threads.
+  std::atomic<uint64_t> stallCount_;
+  std::atomic<uint64_t> stallTimeInMicroseconds_;
 };
 
 } // namespace fbpcf::engine::util
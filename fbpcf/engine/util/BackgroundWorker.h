@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace fbpcf::engine::util {
+
+/**
+ * A single background thread that runs the submitted tasks one at a time, in
+ * the order they were submitted. This is useful when the tasks share a
+ * resource that both parties have to drive in the same order, e.g. an OT
+ * instance. The tasks still pending on destruction are run before the thread
+ * exits.
+ */
+class BackgroundWorker {
+ public:
+  BackgroundWorker() : stopped_(false), thread_([this]() { run(); }) {}
+
+  BackgroundWorker(const BackgroundWorker&) = delete;
+  BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+  ~BackgroundWorker() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+  /**
+   * Queue a task after all the previously submitted ones.
+   * @return a future of the task's result.
+   */
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F&& f) {
+    using ResultType = std::invoke_result_t<F>;
+    auto task =
+        std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(f));
+    auto future = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back([task]() { (*task)(); });
+    }
+    cv_.notify_one();
+    return future;
+  }
+
+ private:
+  void run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopped_;
+
+  // declared last so that everything above is ready when the thread starts.
+  std::thread thread_;
+};
+
+} // namespace fbpcf::engine::util
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/engine/util/BackgroundWorker.h"
+
+namespace fbpcf::engine::util {
+
+/**
+ * A fixed set of threads that parallel loops run on. The threads are started
+ * once and reused by every loop, so an object running many short loops
+ * should own a pool rather than start threads for each of them.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param numberOfThreads the number of threads a loop runs on, including
+   * the calling one.
+   */
+  explicit ThreadPool(int numberOfThreads) {
+    if (numberOfThreads < 1) {
+      throw std::invalid_argument("Need at least one thread.");
+    }
+    for (int i = 1; i < numberOfThreads; i++) {
+      workers_.push_back(std::make_unique<BackgroundWorker>());
+    }
+  }
+
+  size_t getNumberOfThreads() const {
+    return workers_.size() + 1;
+  }
+
+  /**
+   * Run f(i) for every i in [0, numberOfTasks), on the pool's threads and
+   * the calling one. Tasks are handed out one at a time as threads become
+   * free, so f must not depend on which thread runs it, and it must not run
+   * a loop on the same pool. An exception thrown by any task is rethrown to
+   * the caller, once all the threads are done.
+   */
+  void parallelFor(size_t numberOfTasks, const std::function<void(size_t)>& f)
+      const {
+    parallelFor(numberOfTasks, [&f](size_t task, size_t) { f(task); });
+  }
+
+  /**
+   * Like the above, but runs f(i, thread), where thread in [0,
+   * getNumberOfThreads()) is the index of the thread running the task, 0 for
+   * the calling one. No two tasks run on the same thread at once, so f can
+   * use per-thread scratch space indexed by it.
+   */
+  void parallelFor(
+      size_t numberOfTasks,
+      const std::function<void(size_t, size_t)>& f) const {
+    std::atomic<size_t> nextTask(0);
+    auto worker = [&nextTask, numberOfTasks, &f](size_t thread) {
+      for (auto task = nextTask++; task < numberOfTasks; task = nextTask++) {
+        f(task, thread);
+      }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i + 1 < numberOfTasks && i < workers_.size(); i++) {
+      futures.push_back(
+          workers_.at(i)->submit([&worker, i]() { worker(i + 1); }));
+    }
+    // the other threads refer to this frame, so wait for all of them even if
+    // a task fails.
+    std::exception_ptr error;
+    try {
+      worker(0);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    for (auto& future : futures) {
+      try {
+        future.get();
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<BackgroundWorker>> workers_;
+};
+
+} // namespace fbpcf::engine::util
@@ -7,9 +7,98 @@
 
 #include "fbpcf/engine/util/aes.h"
 #include <emmintrin.h>
+#include <immintrin.h>
+#include "fbpcf/system/CpuUtil.h"
 
 namespace fbpcf::engine::util {
 
+namespace {
+
+// AES-NI has a latency of several cycles but can start a new round every
+// cycle, so this many independent blocks keep it busy.
+const size_t kAesNiWidth = 8;
+// the number of 512-bit registers, each holding 4 blocks, processed together
+const size_t kVaesWidth = 8;
+
+template <bool isHash>
+inline void processAesNi(
+    const std::array<__m128i, 11>& roundKey,
+    __m128i* data,
+    size_t size) {
+  size_t i = 0;
+  // the loops over the blocks must be unrolled for the blocks to stay in
+  // registers.
+  for (; i + kAesNiWidth <= size; i += kAesNiWidth) {
+    __m128i blocks[kAesNiWidth];
+#pragma GCC unroll 8
+    for (size_t j = 0; j < kAesNiWidth; j++) {
+      blocks[j] = _mm_xor_si128(_mm_loadu_si128(data + i + j), roundKey[0]);
+    }
+    for (size_t round = 1; round < 10; round++) {
+#pragma GCC unroll 8
+      for (size_t j = 0; j < kAesNiWidth; j++) {
+        blocks[j] = _mm_aesenc_si128(blocks[j], roundKey[round]);
+      }
+    }
+#pragma GCC unroll 8
+    for (size_t j = 0; j < kAesNiWidth; j++) {
+      blocks[j] = _mm_aesenclast_si128(blocks[j], roundKey[10]);
+      if constexpr (isHash) {
+        blocks[j] = _mm_xor_si128(blocks[j], _mm_loadu_si128(data + i + j));
+      }
+      _mm_storeu_si128(data + i + j, blocks[j]);
+    }
+  }
+  for (; i < size; i++) {
+    auto block = _mm_xor_si128(data[i], roundKey[0]);
+    for (size_t round = 1; round < 10; round++) {
+      block = _mm_aesenc_si128(block, roundKey[round]);
+    }
+    block = _mm_aesenclast_si128(block, roundKey[10]);
+    data[i] = isHash ? _mm_xor_si128(block, data[i]) : block;
+  }
+}
+
+template <bool isHash>
+__attribute__((target("avx512f,vaes"))) void processVaes(
+    const std::array<__m128i, 11>& roundKey,
+    __m128i* data,
+    size_t size) {
+  __m512i wideRoundKey[11];
+  for (size_t round = 0; round < 11; round++) {
+    wideRoundKey[round] = _mm512_broadcast_i32x4(roundKey[round]);
+  }
+  const size_t kBlocksPerStep = 4 * kVaesWidth;
+  size_t i = 0;
+  for (; i + kBlocksPerStep <= size; i += kBlocksPerStep) {
+    auto source = data + i;
+    __m512i blocks[kVaesWidth];
+#pragma GCC unroll 8
+    for (size_t j = 0; j < kVaesWidth; j++) {
+      blocks[j] = _mm512_xor_si512(
+          _mm512_loadu_si512(source + 4 * j), wideRoundKey[0]);
+    }
+    for (size_t round = 1; round < 10; round++) {
+#pragma GCC unroll 8
+      for (size_t j = 0; j < kVaesWidth; j++) {
+        blocks[j] = _mm512_aesenc_epi128(blocks[j], wideRoundKey[round]);
+      }
+    }
+#pragma GCC unroll 8
+    for (size_t j = 0; j < kVaesWidth; j++) {
+      blocks[j] = _mm512_aesenclast_epi128(blocks[j], wideRoundKey[10]);
+      if constexpr (isHash) {
+        blocks[j] =
+            _mm512_xor_si512(blocks[j], _mm512_loadu_si512(source + 4 * j));
+      }
+      _mm512_storeu_si512(source + 4 * j, blocks[j]);
+    }
+  }
+  processAesNi<isHash>(roundKey, data + i, size - i);
+}
+
+} // namespace
+
 __m128i Aes::getFixedKey() {
   return _mm_set_epi64x(0, 0);
 }
@@ -71,28 +160,45 @@ std::array<__m128i, 11> Aes::expandDecryptionKey(__m128i key) {
 }
 
 void Aes::encryptInPlace(std::vector<__m128i>& plaintext) const {
-  // Using naked pointer for best performance. This is very hot code.
-  uint32_t size = plaintext.size();
-  auto dataPointer = plaintext.data();
-  for (unsigned int i = 0; i < size; ++i) {
-    dataPointer[i] = _mm_xor_si128(dataPointer[i], roundKey_.at(0));
-  }
-  for (unsigned int j = 1; j < kRound; ++j) {
-    for (unsigned int i = 0; i < size; ++i) {
-      dataPointer[i] = _mm_aesenc_si128(dataPointer[i], roundKey_.at(j));
-    }
-  }
-  for (unsigned int i = 0; i < size; ++i) {
-    dataPointer[i] = _mm_aesenclast_si128(dataPointer[i], roundKey_.at(kRound));
+  encryptInPlace(plaintext.data(), plaintext.size());
+}
+
+void Aes::encryptInPlace(__m128i* data, size_t size) const {
+  static const bool kUseVaes = system::isVaesSupported();
+  if (kUseVaes) {
+    processBlocksVaes(data, size, false);
+  } else {
+    processBlocksAesNi(data, size, false);
   }
 }
 
 void Aes::inPlaceHash(std::vector<__m128i>& src) const {
   assert(!std::empty(src));
-  auto tmp = src;
-  encryptInPlace(src);
-  for (size_t i = 0; i < src.size(); i++) {
-    src[i] = _mm_xor_si128(src[i], tmp[i]);
+  inPlaceHash(src.data(), src.size());
+}
+
+void Aes::inPlaceHash(__m128i* data, size_t size) const {
+  static const bool kUseVaes = system::isVaesSupported();
+  if (kUseVaes) {
+    processBlocksVaes(data, size, true);
+  } else {
+    processBlocksAesNi(data, size, true);
+  }
+}
+
+void Aes::processBlocksAesNi(__m128i* data, size_t size, bool isHash) const {
+  if (isHash) {
+    processAesNi<true>(roundKey_, data, size);
+  } else {
+    processAesNi<false>(roundKey_, data, size);
+  }
+}
+
+void Aes::processBlocksVaes(__m128i* data, size_t size, bool isHash) const {
+  if (isHash) {
+    processVaes<true>(roundKey_, data, size);
+  } else {
+    processVaes<false>(roundKey_, data, size);
   }
 }
 
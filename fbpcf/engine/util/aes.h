@@ -57,8 +57,21 @@ class Aes {
 
   void encryptInPlace(std::vector<__m128i>& plaintext) const;
 
+  /**
+   * Encrypt size blocks starting from data. Independent blocks are
+   * interleaved so that the AES units are pipelined, with VAES on 512-bit
+   * registers when the CPU supports it.
+   */
+  void encryptInPlace(__m128i* data, size_t size) const;
+
   void inPlaceHash(std::vector<__m128i>& src) const;
 
+  /**
+   * Compute AES(x) ^ x in place for size blocks starting from data, in a
+   * single pass over the memory.
+   */
+  void inPlaceHash(__m128i* data, size_t size) const;
+
   static __m128i getFixedKey();
 
   static std::array<__m128i, 11> expandEncryptionKey(__m128i key);
@@ -69,6 +82,10 @@ class Aes {
   static const uint8_t kRound = 10;
   std::array<__m128i, 11> roundKey_;
 
+  // the kernels behind encryptInPlace() and inPlaceHash()
+  void processBlocksAesNi(__m128i* data, size_t size, bool isHash) const;
+  void processBlocksVaes(__m128i* data, size_t size, bool isHash) const;
+
   // copy-pasted from intel's whitepaper
   inline static __m128i aes128KeyExpandAssist(__m128i& temp1, __m128i& temp2) {
     __m128i temp3;
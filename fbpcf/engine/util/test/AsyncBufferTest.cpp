@@ -6,6 +6,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
 
 #include "fbpcf/engine/util/AsyncBuffer.h"
 
@@ -57,4 +59,58 @@ TEST(AsyncBufferTest, TestGetData) {
     EXPECT_EQ(allData.at(i), i);
   }
 }
+
+TEST(AsyncBufferTest, TestGetDataWithBuffersAhead) {
+  auto index = 0;
+  auto generationCount = 0;
+  auto asyncBuffer = AsyncBuffer<int32_t>(
+      100,
+      [&index, &generationCount](uint64_t size) {
+        generationCount++;
+        std::vector<int32_t> res;
+        for (auto i = 0; i < size; ++i) {
+          res.push_back(index++);
+        }
+        std::promise<std::vector<int32_t>> promise;
+        promise.set_value(std::move(res));
+        return promise.get_future();
+      },
+      3);
+
+  // three chunks are requested ahead of use.
+  EXPECT_EQ(generationCount, 3);
+
+  auto allData = asyncBuffer.getData(150);
+  ASSERT_EQ(allData.size(), 150);
+  // each drained chunk is replaced by a new request.
+  EXPECT_EQ(generationCount, 5);
+
+  auto newData = asyncBuffer.getData(320);
+  ASSERT_EQ(newData.size(), 320);
+  allData.insert(allData.end(), newData.begin(), newData.end());
+  EXPECT_EQ(generationCount, 8);
+
+  for (auto i = 0; i < 470; i++) {
+    EXPECT_EQ(allData.at(i), i);
+  }
+
+  // all chunks were ready when they were needed.
+  EXPECT_EQ(asyncBuffer.getStallStatistics().first, 0);
+}
+
+TEST(AsyncBufferTest, TestStallStatistics) {
+  auto asyncBuffer = AsyncBuffer<int32_t>(100, [](uint64_t size) {
+    return std::async(std::launch::async, [size]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      return std::vector<int32_t>(size);
+    });
+  });
+
+  asyncBuffer.getData(250);
+  auto [stallCount, stallTime] = asyncBuffer.getStallStatistics();
+  EXPECT_GE(stallCount, 1);
+  EXPECT_LE(stallCount, 3);
+  EXPECT_GE(stallTime, 10000);
+}
+
 } // namespace fbpcf::engine::util
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "fbpcf/engine/util/BackgroundWorker.h"
+
+namespace fbpcf::engine::util {
+
+TEST(BackgroundWorkerTest, TestTasksRunInOrder) {
+  std::vector<int> order;
+  std::vector<std::future<int>> futures;
+  {
+    BackgroundWorker worker;
+    for (int i = 0; i < 100; i++) {
+      futures.push_back(worker.submit([i, &order]() {
+        if (i % 10 == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        order.push_back(i);
+        return i * i;
+      }));
+    }
+    EXPECT_EQ(futures.at(50).get(), 2500);
+  }
+  // the pending tasks are run before the worker is destroyed.
+  ASSERT_EQ(order.size(), 100);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(order.at(i), i);
+  }
+  for (int i = 51; i < 100; i++) {
+    EXPECT_EQ(futures.at(i).get(), i * i);
+  }
+}
+
+TEST(BackgroundWorkerTest, TestExceptionIsForwarded) {
+  BackgroundWorker worker;
+  auto future = worker.submit([]() -> int { throw std::runtime_error("e"); });
+  auto nextFuture = worker.submit([]() { return 1; });
+  EXPECT_THROW(future.get(), std::runtime_error);
+  EXPECT_EQ(nextFuture.get(), 1);
+}
+
+} // namespace fbpcf::engine::util
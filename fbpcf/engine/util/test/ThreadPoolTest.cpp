@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "fbpcf/engine/util/ThreadPool.h"
+
+namespace fbpcf::engine::util {
+
+TEST(ThreadPoolTest, TestEveryTaskRunsOnce) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.getNumberOfThreads(), 4);
+  // the same pool runs several loops, including ones with fewer tasks than
+  // threads.
+  for (size_t size : {1000, 2, 1, 0}) {
+    std::vector<std::atomic<int>> counts(size);
+    pool.parallelFor(size, [&counts](size_t i) { counts.at(i)++; });
+    for (auto& count : counts) {
+      EXPECT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestThreadsAreReused) {
+  ThreadPool pool(3);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  for (int loop = 0; loop < 20; loop++) {
+    pool.parallelFor(30, [&mutex, &threads](size_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.insert(std::this_thread::get_id());
+    });
+  }
+  EXPECT_LE(threads.size(), 3);
+}
+
+TEST(ThreadPoolTest, TestThreadIndex) {
+  ThreadPool pool(3);
+  std::vector<std::atomic<int>> running(pool.getNumberOfThreads());
+  std::atomic<bool> overlapped(false);
+  pool.parallelFor(300, [&running, &overlapped](size_t, size_t thread) {
+    if (running.at(thread)++ != 0) {
+      overlapped = true;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+    running.at(thread)--;
+  });
+  EXPECT_FALSE(overlapped);
+}
+
+TEST(ThreadPoolTest, TestExceptionIsForwarded) {
+  ThreadPool pool(4);
+  std::atomic<int> count(0);
+  EXPECT_THROW(
+      pool.parallelFor(
+          100,
+          [&count](size_t i) {
+            count++;
+            if (i == 50) {
+              throw std::runtime_error("e");
+            }
+          }),
+      std::runtime_error);
+  // the other tasks still ran, and the pool is still usable.
+  EXPECT_EQ(count, 100);
+  pool.parallelFor(10, [&count](size_t) { count++; });
+  EXPECT_EQ(count, 110);
+}
+
+TEST(ThreadPoolTest, TestInvalidNumberOfThreads) {
+  EXPECT_THROW(ThreadPool(0), std::invalid_argument);
+}
+
+} // namespace fbpcf::engine::util
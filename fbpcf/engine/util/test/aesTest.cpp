@@ -8,8 +8,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <smmintrin.h>
+#include <functional>
 #include <random>
 #include "fbpcf/engine/util/test/aesTestHelper.h"
+#include "fbpcf/system/CpuUtil.h"
 
 namespace fbpcf::engine::util {
 
@@ -38,4 +40,73 @@ TEST(aesTest, testEncryptionAndDecryption) {
   }
 }
 
+// one block at a time, as a reference for the pipelined kernels.
+__m128i encryptBlock(const std::array<__m128i, 11>& roundKey, __m128i block) {
+  block = _mm_xor_si128(block, roundKey[0]);
+  for (int i = 1; i < 10; i++) {
+    block = _mm_aesenc_si128(block, roundKey[i]);
+  }
+  return _mm_aesenclast_si128(block, roundKey[10]);
+}
+
+void testPipelinedKernel(
+    std::function<void(__m128i*, size_t, bool)> kernel,
+    __m128i key) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist;
+  auto roundKey = Aes::expandEncryptionKey(key);
+
+  // sizes around the widths of the kernels.
+  for (size_t size : {0, 1, 7, 8, 9, 31, 32, 33, 63, 100, 1027}) {
+    std::vector<__m128i> plaintext(size);
+    for (auto& block : plaintext) {
+      block = _mm_set_epi64x(dist(e), dist(e));
+    }
+    for (bool isHash : {false, true}) {
+      auto data = plaintext;
+      kernel(data.data(), data.size(), isHash);
+      for (size_t i = 0; i < size; i++) {
+        auto expected = encryptBlock(roundKey, plaintext[i]);
+        if (isHash) {
+          expected = _mm_xor_si128(expected, plaintext[i]);
+        }
+        auto difference = _mm_xor_si128(data[i], expected);
+        EXPECT_TRUE(_mm_testz_si128(difference, difference));
+      }
+    }
+  }
+}
+
+TEST(aesTest, testPipelinedKernels) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist;
+  __m128i key = _mm_set_epi64x(dist(e), dist(e));
+  AesTestHelper cipher(key);
+
+  testPipelinedKernel(
+      [&cipher](__m128i* data, size_t size, bool isHash) {
+        cipher.processBlocksAesNi(data, size, isHash);
+      },
+      key);
+  if (system::isVaesSupported()) {
+    testPipelinedKernel(
+        [&cipher](__m128i* data, size_t size, bool isHash) {
+          cipher.processBlocksVaes(data, size, isHash);
+        },
+        key);
+  }
+  // the dispatched versions
+  testPipelinedKernel(
+      [&cipher](__m128i* data, size_t size, bool isHash) {
+        if (isHash) {
+          cipher.inPlaceHash(data, size);
+        } else {
+          cipher.encryptInPlace(data, size);
+        }
+      },
+      key);
+}
+
 } // namespace fbpcf::engine::util
@@ -22,6 +22,9 @@ class AesTestHelper final : public Aes {
 
   void decryptInPlace(std::vector<__m128i>& ciphertext) const;
 
+  using Aes::processBlocksAesNi;
+  using Aes::processBlocksVaes;
+
  private:
   __m128i key_;
 };
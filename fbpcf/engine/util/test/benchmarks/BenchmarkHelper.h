@@ -17,7 +17,9 @@
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/NetworkEmulatingPartyCommunicationAgentFactory.h"
 #include "fbpcf/engine/communication/SocketPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
 #include "fbpcf/engine/communication/test/SocketInTestHelper.h"
 #include "folly/Random.h"
 #include "folly/logging/xlog.h"
@@ -134,4 +136,20 @@ getSocketAgentFactories() {
       std::make_unique<util::BenchmarkSocketAgentFactory>(1, agentsByParty)};
 };
 
+// In-memory agent factories whose traffic goes through an emulated network
+// link, so that round trips and bandwidth show up in the measured time.
+inline std::pair<
+    std::unique_ptr<communication::IPartyCommunicationAgentFactory>,
+    std::unique_ptr<communication::IPartyCommunicationAgentFactory>>
+getEmulatedNetworkAgentFactories(communication::NetworkProfile profile) {
+  auto factories = communication::getInMemoryAgentFactory(2);
+  return {
+      std::make_unique<
+          communication::NetworkEmulatingPartyCommunicationAgentFactory>(
+          std::move(factories.at(0)), profile, "benchmark_traffic"),
+      std::make_unique<
+          communication::NetworkEmulatingPartyCommunicationAgentFactory>(
+          std::move(factories.at(1)), profile, "benchmark_traffic")};
+}
+
 } // namespace fbpcf::engine::util
@@ -6,6 +6,7 @@
  */
 
 #include "fbpcf/engine/util/util.h"
+#include <algorithm>
 
 namespace fbpcf::engine::util {
 
@@ -17,17 +18,32 @@ std::vector<__m128i> Expander::expand(std::vector<__m128i>&& src) const {
   // expand n __m128i variable to 2n __m128i variable with two ciphers
   assert(!std::empty(src));
   std::vector<__m128i> tmp = src;
-  cipher0_.encryptInPlace(tmp);
+  cipher0_.inPlaceHash(tmp);
+  cipher1_.inPlaceHash(src);
   std::vector<__m128i> rst(src.size() * 2);
   for (size_t i = 0; i < src.size(); i++) {
-    rst[2 * i] = _mm_xor_si128(tmp.at(i), src.at(i));
-    rst[2 * i + 1] = src.at(i);
-  }
-  cipher1_.encryptInPlace(src);
-  for (size_t i = 0; i < src.size(); i++) {
-    rst[2 * i + 1] = _mm_xor_si128(src.at(i), rst.at(2 * i + 1));
+    rst[2 * i] = tmp[i];
+    rst[2 * i + 1] = src[i];
   }
   return rst;
 }
 
+void Expander::expand(const __m128i* src, size_t size, __m128i* dst) const {
+  // work on small tiles so that both hashes of a key stay in cache.
+  const size_t kTileSize = 64;
+  __m128i tile0[kTileSize];
+  __m128i tile1[kTileSize];
+  for (size_t start = 0; start < size; start += kTileSize) {
+    auto tileSize = std::min(kTileSize, size - start);
+    std::copy(src + start, src + start + tileSize, tile0);
+    std::copy(src + start, src + start + tileSize, tile1);
+    cipher0_.inPlaceHash(tile0, tileSize);
+    cipher1_.inPlaceHash(tile1, tileSize);
+    for (size_t i = 0; i < tileSize; i++) {
+      dst[2 * (start + i)] = tile0[i];
+      dst[2 * (start + i) + 1] = tile1[i];
+    }
+  }
+}
+
 } // namespace fbpcf::engine::util
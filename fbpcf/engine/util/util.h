@@ -146,6 +146,13 @@ class Expander {
   explicit Expander(int64_t index);
   std::vector<__m128i> expand(std::vector<__m128i>&& src) const;
 
+  /**
+   * Expand size keys starting from src into 2 * size keys starting from dst,
+   * the same way as above but without any allocation. src and dst must not
+   * overlap.
+   */
+  void expand(const __m128i* src, size_t size, __m128i* dst) const;
+
  private:
   Aes cipher0_;
   Aes cipher1_;
@@ -26,8 +26,6 @@ class AesCircuit : public IAesCircuit<BitType> {
       const BitType& D,
       std::array<BitType, 64>& M) const;
 
-  using ByteType = std::array<BitType, 8>;
-  using WordType = std::array<ByteType, 4>;
   /**
    * @inherit doc
    */
@@ -36,6 +34,9 @@ class AesCircuit : public IAesCircuit<BitType> {
       const std::vector<BitType>& expandedDecKey) const;
 
  protected:
+  using ByteType = std::array<BitType, 8>;
+  using WordType = std::array<ByteType, 4>;
+
   std::vector<std::array<WordType, 4>> convertToWords(
       const std::vector<BitType>& src) const;
 
@@ -48,7 +49,14 @@ class AesCircuit : public IAesCircuit<BitType> {
   void mixColumnsInPlace(WordType& src) const;
   void inverseMixColumnsInPlace(WordType& src) const;
 
-  void shiftRowInPlace(WordType& src, int8_t offset);
+  void shiftRowInPlace(WordType& src, int8_t offset) const;
+
+  void addRoundKeyInPlace(
+      std::vector<std::array<WordType, 4>>& state,
+      const std::array<WordType, 4>& roundKey) const;
+
+  // shift the rows of a block, the words of which are its columns.
+  void shiftRowsInPlace(std::array<WordType, 4>& block, bool inverse) const;
 
 #ifdef AES_CIRCUIT_TEST_FRIENDS
   AES_CIRCUIT_TEST_FRIENDS;
@@ -18,26 +18,124 @@ template <typename BitType>
 std::vector<BitType> AesCircuit<BitType>::encrypt_impl(
     const std::vector<BitType>& plaintext,
     const std::vector<BitType>& expandedEncKey) const {
-  throw std::runtime_error("Not implemented!");
+  auto state = convertToWords(plaintext);
+  auto roundKeys = convertToWords(expandedEncKey);
+
+  addRoundKeyInPlace(state, roundKeys.at(0));
+  for (size_t round = 1; round < 11; round++) {
+    for (auto& block : state) {
+      for (auto& word : block) {
+        for (auto& byte : word) {
+          sBoxInPlace(byte);
+        }
+      }
+      shiftRowsInPlace(block, false);
+      // the last round doesn't mix the columns
+      if (round < 10) {
+        for (auto& word : block) {
+          mixColumnsInPlace(word);
+        }
+      }
+    }
+    addRoundKeyInPlace(state, roundKeys.at(round));
+  }
+  return convertFromWords(state);
 }
 
+// This is the equivalent inverse cipher, the mix columns of the round keys
+// are already applied by the decryption key expansion.
 template <typename BitType>
 std::vector<BitType> AesCircuit<BitType>::decrypt_impl(
     const std::vector<BitType>& ciphertext,
     const std::vector<BitType>& expandedDecKey) const {
-  throw std::runtime_error("Not implemented!");
+  auto state = convertToWords(ciphertext);
+  auto roundKeys = convertToWords(expandedDecKey);
+
+  addRoundKeyInPlace(state, roundKeys.at(0));
+  for (size_t round = 1; round < 11; round++) {
+    for (auto& block : state) {
+      for (auto& word : block) {
+        for (auto& byte : word) {
+          inverseSBoxInPlace(byte);
+        }
+      }
+      shiftRowsInPlace(block, true);
+      if (round < 10) {
+        for (auto& word : block) {
+          inverseMixColumnsInPlace(word);
+        }
+      }
+    }
+    addRoundKeyInPlace(state, roundKeys.at(round));
+  }
+  return convertFromWords(state);
 }
 
+// The bits of a block are laid out as the standard AES byte sequence, the
+// (4 * c + r)-th byte being in the c-th column and r-th row of the state, and
+// each byte starts from its most significant bit.
 template <typename BitType>
 std::vector<std::array<typename AesCircuit<BitType>::WordType, 4>>
 AesCircuit<BitType>::convertToWords(const std::vector<BitType>& src) const {
-  throw std::runtime_error("Not implemented!");
+  std::vector<std::array<WordType, 4>> rst(src.size() / 128);
+  for (size_t i = 0; i < rst.size(); i++) {
+    for (size_t c = 0; c < 4; c++) {
+      for (size_t r = 0; r < 4; r++) {
+        for (size_t j = 0; j < 8; j++) {
+          rst[i][c][r][j] = src.at(128 * i + 32 * c + 8 * r + j);
+        }
+      }
+    }
+  }
+  return rst;
 }
 
 template <typename BitType>
 std::vector<BitType> AesCircuit<BitType>::convertFromWords(
     std::vector<std::array<WordType, 4>>& src) const {
-  throw std::runtime_error("Not implemented!");
+  std::vector<BitType> rst;
+  rst.reserve(src.size() * 128);
+  for (auto& block : src) {
+    for (auto& word : block) {
+      for (auto& byte : word) {
+        for (auto& bit : byte) {
+          rst.push_back(std::move(bit));
+        }
+      }
+    }
+  }
+  return rst;
+}
+
+template <typename BitType>
+void AesCircuit<BitType>::addRoundKeyInPlace(
+    std::vector<std::array<WordType, 4>>& state,
+    const std::array<WordType, 4>& roundKey) const {
+  for (auto& block : state) {
+    for (size_t c = 0; c < 4; c++) {
+      for (size_t r = 0; r < 4; r++) {
+        for (size_t j = 0; j < 8; j++) {
+          block[c][r][j] = block[c][r][j] ^ roundKey[c][r][j];
+        }
+      }
+    }
+  }
+}
+
+template <typename BitType>
+void AesCircuit<BitType>::shiftRowsInPlace(
+    std::array<WordType, 4>& block,
+    bool inverse) const {
+  for (size_t r = 1; r < 4; r++) {
+    WordType row;
+    for (size_t c = 0; c < 4; c++) {
+      row[c] = std::move(block[c][r]);
+    }
+    shiftRowInPlace(row, inverse ? 4 - r : r);
+    for (size_t c = 0; c < 4; c++) {
+      block[c][r] = std::move(row[c]);
+    }
+  }
 }
 
 template <typename BitType>
@@ -392,7 +490,8 @@ void AesCircuit<BitType>::inverseMixColumnsInPlace(WordType& src) const {
 }
 
 template <typename BitType>
-void AesCircuit<BitType>::shiftRowInPlace(WordType& src, int8_t offset) {
+void AesCircuit<BitType>::shiftRowInPlace(WordType& src, int8_t offset)
+    const {
   if (offset == 1) {
     std::swap(src[0], src[1]);
     std::swap(src[1], src[2]);
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit {
+
+/*
+ * This is a bitsliced version of the AES circuit for batch bit types (e.g.
+ * frontend::Bit with batching), each input bit being a batch of batchSize
+ * values. The j-th bits of all the bytes of all the blocks are banded into one
+ * batch, so the 16 S-boxes of a round are evaluated as a single S-box over 16
+ * times the batch: 34 batched AND gates in 4 layers per round, instead of 34
+ * per byte. The shift rows and mix columns steps are free and are done on the
+ * unbatched bytes.
+ */
+template <typename BitType>
+class BatchedAesCircuit final : public AesCircuit<BitType> {
+ public:
+  /**
+   * @param batchSize the number of values in each input and key bit. The
+   * inputs and keys of every call must have this batch size. Public inputs of
+   * another batch size make the call throw; secret ones aren't checked, as
+   * that would force their evaluation.
+   */
+  explicit BatchedAesCircuit(size_t batchSize);
+
+  using IAesCircuit<BitType>::encrypt;
+
+  /**
+   * Rearrange the expanded enc key into the batched layout and keep it for the
+   * following encrypt(plaintext) calls.
+   * @param expandedEncKey the expanded enc AES key inside MPC. It must be the
+   * expected expanded key size.
+   */
+  void cacheExpandedEncKey(const std::vector<BitType>& expandedEncKey);
+
+  /**
+   * Encrypt the plaintext with the cached expanded enc key.
+   * @param plaintext the plaintext for AES inside MPC. It must be a
+   * multiplication of 128.
+   * @return the ciphertext inside MPC;
+   */
+  std::vector<BitType> encrypt(const std::vector<BitType>& plaintext) const;
+
+ private:
+  using ByteType = typename AesCircuit<BitType>::ByteType;
+  using WordType = typename AesCircuit<BitType>::WordType;
+
+  std::vector<BitType> encrypt_impl(
+      const std::vector<BitType>& plaintext,
+      const std::vector<BitType>& expandedEncKey) const;
+
+  /**
+   * @inherit doc
+   */
+  std::vector<BitType> decrypt_impl(
+      const std::vector<BitType>& ciphertext,
+      const std::vector<BitType>& expandedDecKey) const;
+
+  // throw if the bits of src are public and don't hold batchSize_ values
+  // each.
+  void checkBatchWidth(
+      const std::vector<BitType>& src,
+      const std::string& name) const;
+
+  // the r-th item holds the r-th round key, sliced the same way as a block.
+  std::vector<ByteType> sliceRoundKeys(
+      const std::vector<BitType>& expandedKey) const;
+
+  std::vector<BitType> evaluate(
+      const std::vector<BitType>& src,
+      const std::vector<ByteType>& roundKeys,
+      bool inverse) const;
+
+  // the j-th slice holds the j-th bit of every byte of every block.
+  ByteType sliceBlocks(std::vector<std::array<WordType, 4>>& blocks) const;
+
+  void unsliceBlocks(
+      const ByteType& slices,
+      std::vector<std::array<WordType, 4>>& blocks) const;
+
+  size_t batchSize_;
+  std::vector<ByteType> cachedRoundKeys_;
+};
+
+} // namespace fbpcf::mpc_std_lib::aes_circuit
+
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit_impl.h"
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuitFactory.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit {
+
+template <typename BitType>
+class BatchedAesCircuitFactory final : public IAesCircuitFactory<BitType> {
+ public:
+  explicit BatchedAesCircuitFactory(size_t batchSize) : batchSize_(batchSize) {}
+
+  std::unique_ptr<IAesCircuit<BitType>> create() override {
+    return std::make_unique<BatchedAesCircuit<BitType>>(batchSize_);
+  }
+
+  typename IAesCircuitFactory<BitType>::CircuitType getCircuitType()
+      const override {
+    return IAesCircuitFactory<BitType>::CircuitType::Secure;
+  }
+
+ private:
+  size_t batchSize_;
+};
+
+} // namespace fbpcf::mpc_std_lib::aes_circuit
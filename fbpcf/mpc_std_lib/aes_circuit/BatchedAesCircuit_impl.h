@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit_impl.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit {
+
+namespace detail {
+
+// The number of values a batch bit holds, if it can be told without
+// evaluating a secret wire. Only public bits tell it, through their value;
+// the shares of a secret bit would force the scheduler to evaluate it.
+template <typename BitType>
+struct BatchWidth {
+  static std::optional<size_t> get(const BitType& /*bit*/) {
+    return std::nullopt;
+  }
+};
+
+template <int schedulerId>
+struct BatchWidth<frontend::Bit<false, schedulerId, true>> {
+  static std::optional<size_t> get(
+      const frontend::Bit<false, schedulerId, true>& bit) {
+    return bit.getValue().size();
+  }
+};
+
+} // namespace detail
+
+template <typename BitType>
+BatchedAesCircuit<BitType>::BatchedAesCircuit(size_t batchSize)
+    : batchSize_(batchSize) {
+  if (batchSize == 0) {
+    throw std::invalid_argument("Batch size must be positive.");
+  }
+}
+
+template <typename BitType>
+void BatchedAesCircuit<BitType>::cacheExpandedEncKey(
+    const std::vector<BitType>& expandedEncKey) {
+  if (expandedEncKey.size() != IAesCircuit<BitType>::kExpandedKeyWidth) {
+    throw std::runtime_error("Expanded Enc AES key must be 1408 bits.");
+  }
+  cachedRoundKeys_ = sliceRoundKeys(expandedEncKey);
+}
+
+template <typename BitType>
+std::vector<BitType> BatchedAesCircuit<BitType>::encrypt(
+    const std::vector<BitType>& plaintext) const {
+  if (plaintext.size() % 128 != 0) {
+    throw std::runtime_error("Input plaintext must be a multiple of 128");
+  }
+  if (cachedRoundKeys_.empty()) {
+    throw std::runtime_error("No expanded Enc AES key is cached.");
+  }
+  return evaluate(plaintext, cachedRoundKeys_, false);
+}
+
+template <typename BitType>
+std::vector<BitType> BatchedAesCircuit<BitType>::encrypt_impl(
+    const std::vector<BitType>& plaintext,
+    const std::vector<BitType>& expandedEncKey) const {
+  return evaluate(plaintext, sliceRoundKeys(expandedEncKey), false);
+}
+
+// This is the equivalent inverse cipher, the same as AesCircuit.
+template <typename BitType>
+std::vector<BitType> BatchedAesCircuit<BitType>::decrypt_impl(
+    const std::vector<BitType>& ciphertext,
+    const std::vector<BitType>& expandedDecKey) const {
+  return evaluate(ciphertext, sliceRoundKeys(expandedDecKey), true);
+}
+
+// All the bits of an input share one width, so checking the first one is
+// enough. Secret inputs aren't checked: their width is only known once they
+// are evaluated, and checking must not force that.
+template <typename BitType>
+void BatchedAesCircuit<BitType>::checkBatchWidth(
+    const std::vector<BitType>& src,
+    const std::string& name) const {
+  if (src.empty()) {
+    return;
+  }
+  auto width = detail::BatchWidth<BitType>::get(src.at(0));
+  if (width.has_value() && width.value() != batchSize_) {
+    throw std::runtime_error(
+        "The " + name + " has batch size " + std::to_string(width.value()) +
+        " but the AES circuit was created for batch size " +
+        std::to_string(batchSize_) + ".");
+  }
+}
+
+template <typename BitType>
+std::vector<typename BatchedAesCircuit<BitType>::ByteType>
+BatchedAesCircuit<BitType>::sliceRoundKeys(
+    const std::vector<BitType>& expandedKey) const {
+  checkBatchWidth(expandedKey, "expanded key");
+  // the round keys have the same layout as a sequence of 11 blocks.
+  auto roundKeys = this->convertToWords(expandedKey);
+  std::vector<ByteType> rst;
+  rst.reserve(roundKeys.size());
+  for (auto& roundKey : roundKeys) {
+    std::vector<std::array<WordType, 4>> block(1, std::move(roundKey));
+    rst.push_back(sliceBlocks(block));
+  }
+  return rst;
+}
+
+template <typename BitType>
+std::vector<BitType> BatchedAesCircuit<BitType>::evaluate(
+    const std::vector<BitType>& src,
+    const std::vector<ByteType>& roundKeys,
+    bool inverse) const {
+  checkBatchWidth(src, "input");
+  auto blocks = this->convertToWords(src);
+  if (blocks.empty()) {
+    return {};
+  }
+
+  // every block is xored with the same round keys.
+  std::vector<ByteType> keys(roundKeys);
+  if (blocks.size() > 1) {
+    for (auto& key : keys) {
+      for (auto& slice : key) {
+        slice = slice.batchingWith(
+            std::vector<BitType>(blocks.size() - 1, slice));
+      }
+    }
+  }
+
+  auto state = sliceBlocks(blocks);
+  for (size_t j = 0; j < 8; j++) {
+    state[j] = state[j] ^ keys.at(0)[j];
+  }
+  for (size_t round = 1; round < 11; round++) {
+    if (inverse) {
+      this->inverseSBoxInPlace(state);
+    } else {
+      this->sBoxInPlace(state);
+    }
+    unsliceBlocks(state, blocks);
+    for (auto& block : blocks) {
+      this->shiftRowsInPlace(block, inverse);
+      // the last round doesn't mix the columns
+      if (round < 10) {
+        for (auto& word : block) {
+          if (inverse) {
+            this->inverseMixColumnsInPlace(word);
+          } else {
+            this->mixColumnsInPlace(word);
+          }
+        }
+      }
+    }
+    state = sliceBlocks(blocks);
+    for (size_t j = 0; j < 8; j++) {
+      state[j] = state[j] ^ keys.at(round)[j];
+    }
+  }
+  unsliceBlocks(state, blocks);
+  return this->convertFromWords(blocks);
+}
+
+// The bytes are banded in the order of the blocks, and the standard AES byte
+// sequence within a block.
+template <typename BitType>
+typename BatchedAesCircuit<BitType>::ByteType
+BatchedAesCircuit<BitType>::sliceBlocks(
+    std::vector<std::array<WordType, 4>>& blocks) const {
+  ByteType rst;
+  std::vector<BitType> others(16 * blocks.size() - 1);
+  for (size_t j = 0; j < 8; j++) {
+    for (size_t i = 0; i < blocks.size(); i++) {
+      for (size_t c = 0; c < 4; c++) {
+        for (size_t r = 0; r < 4; r++) {
+          auto position = 16 * i + 4 * c + r;
+          if (position > 0) {
+            others[position - 1] = std::move(blocks[i][c][r][j]);
+          }
+        }
+      }
+    }
+    rst[j] = blocks[0][0][0][j].batchingWith(others);
+  }
+  return rst;
+}
+
+template <typename BitType>
+void BatchedAesCircuit<BitType>::unsliceBlocks(
+    const ByteType& slices,
+    std::vector<std::array<WordType, 4>>& blocks) const {
+  auto unbatchingStrategy =
+      std::make_shared<std::vector<uint32_t>>(16 * blocks.size(), batchSize_);
+  for (size_t j = 0; j < 8; j++) {
+    auto bytes = slices[j].unbatching(unbatchingStrategy);
+    for (size_t i = 0; i < blocks.size(); i++) {
+      for (size_t c = 0; c < 4; c++) {
+        for (size_t r = 0; r < 4; r++) {
+          blocks[i][c][r][j] = std::move(bytes[16 * i + 4 * c + r]);
+        }
+      }
+    }
+  }
+}
+
+} // namespace fbpcf::mpc_std_lib::aes_circuit
@@ -24,8 +24,12 @@
   FRIEND_TEST(AesCircuitMixColumnsTestSuite, InverseMixColumnsInplaceTest);
 
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/util/aes.h"
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/frontend/Bit.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit_impl.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/DummyAesCircuitFactory.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuit.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
@@ -230,4 +234,165 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(0xd4, 0xd4, 0xd4, 0xd5, 0xd5, 0xd5, 0xd7, 0xd6),
         std::make_tuple(0x2d, 0x26, 0x31, 0x4c, 0x4d, 0x7e, 0xbd, 0xf8)));
 
+// the bits of a block as AES sees the bytes, from the most significant bit of
+// the first byte.
+std::vector<bool> blockToBits(__m128i src) {
+  std::array<uint8_t, 16> bytes;
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes.data()), src);
+  std::vector<bool> rst(128);
+  for (size_t i = 0; i < 16; i++) {
+    for (size_t j = 0; j < 8; j++) {
+      rst[8 * i + j] = (bytes[i] >> (7 - j)) & 1;
+    }
+  }
+  return rst;
+}
+
+std::vector<bool> expandedKeyToBits(const std::array<__m128i, 11>& keys) {
+  std::vector<bool> rst;
+  for (auto& key : keys) {
+    auto bits = blockToBits(key);
+    rst.insert(rst.end(), bits.begin(), bits.end());
+  }
+  return rst;
+}
+
+TEST(AesCircuitTest, testEncryptAndDecrypt) {
+  const size_t kBlocks = 5;
+  AesCircuit<bool> aes;
+  auto key = engine::util::getRandomM128iFromSystemNoise();
+  engine::util::Aes expectedAes(key);
+
+  std::vector<__m128i> blocks(kBlocks);
+  std::vector<bool> plaintext;
+  for (auto& block : blocks) {
+    block = engine::util::getRandomM128iFromSystemNoise();
+    auto bits = blockToBits(block);
+    plaintext.insert(plaintext.end(), bits.begin(), bits.end());
+  }
+  expectedAes.encryptInPlace(blocks);
+  std::vector<bool> expectedCiphertext;
+  for (auto& block : blocks) {
+    auto bits = blockToBits(block);
+    expectedCiphertext.insert(
+        expectedCiphertext.end(), bits.begin(), bits.end());
+  }
+
+  auto ciphertext = aes.encrypt(
+      plaintext,
+      expandedKeyToBits(engine::util::Aes::expandEncryptionKey(key)));
+  testVectorEq(ciphertext, expectedCiphertext);
+
+  auto decrypted = aes.decrypt(
+      ciphertext,
+      expandedKeyToBits(engine::util::Aes::expandDecryptionKey(key)));
+  testVectorEq(decrypted, plaintext);
+}
+
+// each input bit is a batch of the same bit of batchSize blocks.
+template <int schedulerId>
+std::vector<std::vector<bool>> batchedAesCircuitTask(
+    const std::vector<std::vector<bool>>& plaintext,
+    const std::vector<bool>& expandedEncKey,
+    const std::vector<bool>& expandedDecKey,
+    size_t batchSize) {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+  std::vector<SecBit> secPlaintext;
+  for (auto& bits : plaintext) {
+    secPlaintext.push_back(SecBit(bits, 0));
+  }
+  auto processKey = [batchSize](const std::vector<bool>& key) {
+    std::vector<SecBit> rst;
+    for (auto bit : key) {
+      rst.push_back(SecBit(std::vector<bool>(batchSize, bit), 1));
+    }
+    return rst;
+  };
+  auto encKey = processKey(expandedEncKey);
+
+  BatchedAesCircuit<SecBit> aes(batchSize);
+  auto ciphertext = aes.encrypt(secPlaintext, encKey);
+  aes.cacheExpandedEncKey(encKey);
+  auto cachedKeyCiphertext = aes.encrypt(secPlaintext);
+  auto decrypted = aes.decrypt(ciphertext, processKey(expandedDecKey));
+
+  // public inputs of another batch size are rejected before any gate is
+  // issued.
+  using PubBit = frontend::Bit<false, schedulerId, true>;
+  std::vector<PubBit> pubKey;
+  for (auto bit : expandedEncKey) {
+    pubKey.push_back(PubBit(std::vector<bool>(batchSize, bit)));
+  }
+  BatchedAesCircuit<PubBit> wrongBatchSizeAes(batchSize + 1);
+  EXPECT_THROW(
+      wrongBatchSizeAes.cacheExpandedEncKey(pubKey), std::runtime_error);
+
+  std::vector<std::vector<bool>> rst;
+  for (auto& output : {ciphertext, cachedKeyCiphertext, decrypted}) {
+    for (auto& bit : output) {
+      rst.push_back(bit.openToParty(0).getValue());
+    }
+  }
+  return rst;
+}
+
+void testBatchedAesCircuit(size_t batchSize, size_t blockGroups) {
+  auto key = engine::util::getRandomM128iFromSystemNoise();
+  auto expandedEncKey =
+      expandedKeyToBits(engine::util::Aes::expandEncryptionKey(key));
+  auto expandedDecKey =
+      expandedKeyToBits(engine::util::Aes::expandDecryptionKey(key));
+
+  std::vector<__m128i> blocks(batchSize * blockGroups);
+  for (auto& block : blocks) {
+    block = engine::util::getRandomM128iFromSystemNoise();
+  }
+  auto toBatches = [batchSize, blockGroups](const std::vector<__m128i>& src) {
+    std::vector<std::vector<bool>> rst(
+        128 * blockGroups, std::vector<bool>(batchSize));
+    for (size_t g = 0; g < blockGroups; g++) {
+      for (size_t b = 0; b < batchSize; b++) {
+        auto bits = blockToBits(src.at(g * batchSize + b));
+        for (size_t k = 0; k < 128; k++) {
+          rst[128 * g + k][b] = bits.at(k);
+        }
+      }
+    }
+    return rst;
+  };
+  auto plaintext = toBatches(blocks);
+  engine::util::Aes(key).encryptInPlace(blocks);
+  auto expectedCiphertext = toBatches(blocks);
+
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  auto future0 = std::async(
+      batchedAesCircuitTask<0>,
+      plaintext,
+      expandedEncKey,
+      expandedDecKey,
+      batchSize);
+  auto future1 = std::async(
+      batchedAesCircuitTask<1>,
+      plaintext,
+      expandedEncKey,
+      expandedDecKey,
+      batchSize);
+  auto rst = future0.get();
+  future1.get();
+
+  ASSERT_EQ(rst.size(), 3 * plaintext.size());
+  for (size_t i = 0; i < plaintext.size(); i++) {
+    testVectorEq(rst.at(i), expectedCiphertext.at(i));
+    testVectorEq(rst.at(plaintext.size() + i), expectedCiphertext.at(i));
+    testVectorEq(rst.at(2 * plaintext.size() + i), plaintext.at(i));
+  }
+}
+
+TEST(AesCircuitTest, testBatchedAesCircuit) {
+  testBatchedAesCircuit(1, 1);
+  testBatchedAesCircuit(7, 1);
+  testBatchedAesCircuit(16, 3);
+}
+
 } // namespace fbpcf::mpc_std_lib::aes_circuit
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit_impl.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit.h"
+#include "fbpcf/mpc_std_lib/util/test/benchmarks/AndCountingBit.h"
+#include "fbpcf/mpc_std_lib/util/test/benchmarks/TwoPartyMpcBenchmark.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit {
+
+const size_t kCountingBatchSize = 1024;
+
+BENCHMARK_COUNTERS(AesCircuit_AndCount, counters) {
+  std::vector<util::AndCountingBit> plaintext(
+      128, util::AndCountingBit(kCountingBatchSize));
+  std::vector<util::AndCountingBit> key(
+      IAesCircuit<util::AndCountingBit>::kExpandedKeyWidth,
+      util::AndCountingBit(kCountingBatchSize));
+  util::AndCountingBit::resetCounters();
+  AesCircuit<util::AndCountingBit>().encrypt(plaintext, key);
+  util::AndCountingBit::reportCounters(counters, kCountingBatchSize);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_AndCount, counters) {
+  std::vector<util::AndCountingBit> plaintext(
+      128, util::AndCountingBit(kCountingBatchSize));
+  std::vector<util::AndCountingBit> key(
+      IAesCircuit<util::AndCountingBit>::kExpandedKeyWidth,
+      util::AndCountingBit(kCountingBatchSize));
+  util::AndCountingBit::resetCounters();
+  BatchedAesCircuit<util::AndCountingBit>(kCountingBatchSize)
+      .encrypt(plaintext, key);
+  util::AndCountingBit::reportCounters(counters, kCountingBatchSize);
+}
+
+class BaseAesCircuitBenchmark : public util::TwoPartyMpcBenchmark {
+ public:
+  explicit BaseAesCircuitBenchmark(
+      size_t batchSize,
+      bool useEagerScheduler = false)
+      : util::TwoPartyMpcBenchmark(useEagerScheduler), batchSize_(batchSize) {}
+
+  void setup() override {
+    util::TwoPartyMpcBenchmark::setup();
+    plaintext_ = generateRandomBatches(128, batchSize_);
+    expandedKey_ = generateRandomConstantBatches(
+        IAesCircuit<bool>::kExpandedKeyWidth, batchSize_);
+  }
+
+ protected:
+  void runParty0() override {
+    openToParty0<0>(runAesCircuit0(processInputs<0>(plaintext_, 0)));
+  }
+
+  void runParty1() override {
+    openToParty0<1>(runAesCircuit1(processInputs<1>(plaintext_, 0)));
+  }
+
+  virtual std::vector<SecBit<0>> runAesCircuit0(
+      const std::vector<SecBit<0>>& plaintext) = 0;
+  virtual std::vector<SecBit<1>> runAesCircuit1(
+      const std::vector<SecBit<1>>& plaintext) = 0;
+
+  size_t batchSize_;
+  std::vector<std::vector<bool>> plaintext_;
+  // the expanded key is provided by party 1.
+  std::vector<std::vector<bool>> expandedKey_;
+};
+
+class AesCircuitBenchmark : public BaseAesCircuitBenchmark {
+ public:
+  using BaseAesCircuitBenchmark::BaseAesCircuitBenchmark;
+
+ protected:
+  std::vector<SecBit<0>> runAesCircuit0(
+      const std::vector<SecBit<0>>& plaintext) override {
+    return AesCircuit<SecBit<0>>().encrypt(
+        plaintext, processInputs<0>(expandedKey_, 1));
+  }
+
+  std::vector<SecBit<1>> runAesCircuit1(
+      const std::vector<SecBit<1>>& plaintext) override {
+    return AesCircuit<SecBit<1>>().encrypt(
+        plaintext, processInputs<1>(expandedKey_, 1));
+  }
+};
+
+class BatchedAesCircuitBenchmark : public BaseAesCircuitBenchmark {
+ public:
+  using BaseAesCircuitBenchmark::BaseAesCircuitBenchmark;
+
+ protected:
+  std::vector<SecBit<0>> runAesCircuit0(
+      const std::vector<SecBit<0>>& plaintext) override {
+    return BatchedAesCircuit<SecBit<0>>(batchSize_)
+        .encrypt(plaintext, processInputs<0>(expandedKey_, 1));
+  }
+
+  std::vector<SecBit<1>> runAesCircuit1(
+      const std::vector<SecBit<1>>& plaintext) override {
+    return BatchedAesCircuit<SecBit<1>>(batchSize_)
+        .encrypt(plaintext, processInputs<1>(expandedKey_, 1));
+  }
+};
+
+// the key is input and sliced during init, only the encryption is measured.
+class CachedKeyBatchedAesCircuitBenchmark : public BaseAesCircuitBenchmark {
+ public:
+  using BaseAesCircuitBenchmark::BaseAesCircuitBenchmark;
+
+ protected:
+  void initParty0() override {
+    aesCircuit0_ = std::make_unique<BatchedAesCircuit<SecBit<0>>>(batchSize_);
+    aesCircuit0_->cacheExpandedEncKey(processInputs<0>(expandedKey_, 1));
+  }
+
+  void initParty1() override {
+    aesCircuit1_ = std::make_unique<BatchedAesCircuit<SecBit<1>>>(batchSize_);
+    aesCircuit1_->cacheExpandedEncKey(processInputs<1>(expandedKey_, 1));
+  }
+
+  std::vector<SecBit<0>> runAesCircuit0(
+      const std::vector<SecBit<0>>& plaintext) override {
+    return aesCircuit0_->encrypt(plaintext);
+  }
+
+  std::vector<SecBit<1>> runAesCircuit1(
+      const std::vector<SecBit<1>>& plaintext) override {
+    return aesCircuit1_->encrypt(plaintext);
+  }
+
+ private:
+  std::unique_ptr<BatchedAesCircuit<SecBit<0>>> aesCircuit0_;
+  std::unique_ptr<BatchedAesCircuit<SecBit<1>>> aesCircuit1_;
+};
+
+BENCHMARK_COUNTERS(AesCircuit_Benchmark, counters) {
+  AesCircuitBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_Benchmark, counters) {
+  BatchedAesCircuitBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(CachedKeyBatchedAesCircuit_Benchmark, counters) {
+  CachedKeyBatchedAesCircuitBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(AesCircuit_EagerScheduler_Benchmark, counters) {
+  AesCircuitBenchmark benchmark(1024, true);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_EagerScheduler_Benchmark, counters) {
+  BatchedAesCircuitBenchmark benchmark(1024, true);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(AesCircuit_16K_Benchmark, counters) {
+  AesCircuitBenchmark benchmark(16384);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_16K_Benchmark, counters) {
+  BatchedAesCircuitBenchmark benchmark(16384);
+  benchmark.runBenchmark(counters);
+}
+} // namespace fbpcf::mpc_std_lib::aes_circuit
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
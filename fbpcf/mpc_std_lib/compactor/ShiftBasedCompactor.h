@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/compactor/ICompactor.h"
+#include "fbpcf/mpc_std_lib/util/SecretArithmetic.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::compactor {
+
+/*
+ * This compactor doesn't reveal anything, not even the number of items
+ * labeled 1, unless asked to. It is an order-preserving tight compaction:
+ * every item labeled 1 needs to move towards the front by the number of items
+ * labeled 0 before it, which is computed with a secret prefix sum: O(log n)
+ * levels of batched additions of log(n)-bit integers, each a ripple-carry
+ * adder, so O(log^2 n) rounds. The moves are then applied by a network of
+ * log(n) levels, the j-th level moving the items whose distance has the j-th
+ * bit set by 2^j positions. Going from the least significant bit, the items
+ * labeled 1 stay in order and never land on the same position, so every level
+ * only takes one batch of ANDs: O(n log n) ANDs in O(log n) rounds. The
+ * prefix sum dominates the rounds, O(log^2 n) overall. The items labeled 0
+ * are cleared.
+ * T needs to support extractBatchSharedSecrets() and
+ * recoverBatchSharedSecrets() in its MpcAdapters.
+ */
+
+/*
+ * We assume that there are two parties. In our implementation, a party with a
+ * smaller id is assigned to party0 and the other party is assigned to party1.
+ */
+template <typename T, typename LabelT, int schedulerId>
+class ShiftBasedCompactor final
+    : public ICompactor<
+          typename util::SecBatchType<T, schedulerId>::type,
+          typename util::SecBatchType<LabelT, schedulerId>::type> {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+ public:
+  using SecBatchSrcType = typename util::SecBatchType<T, schedulerId>::type;
+  using SecBatchLabelType =
+      typename util::SecBatchType<LabelT, schedulerId>::type;
+  ShiftBasedCompactor(int myId, int partnerId)
+      : myId_(myId), partnerId_(partnerId) {}
+
+  /**
+   * @inherit doc
+   * Without revealing the size, the output has the same size as the input:
+   * the items labeled 1 come first and in their original order, followed by
+   * cleared items labeled 0.
+   */
+  std::pair<SecBatchSrcType, SecBatchLabelType> compaction(
+      const SecBatchSrcType& src,
+      const SecBatchLabelType& label,
+      size_t size,
+      bool shouldRevealSize) const override {
+    auto srcShares =
+        util::MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(src);
+    auto labelShares =
+        util::MpcAdapters<LabelT, schedulerId>::extractBatchSharedSecrets(
+            label);
+    for (auto& item : srcShares) {
+      if (item.size() != size) {
+        throw std::invalid_argument("Inconsistent size.");
+      }
+    }
+    if (labelShares.size() != 1 || labelShares.at(0).size() != size) {
+      throw std::invalid_argument("Inconsistent size.");
+    }
+    if (size == 0) {
+      return {src, label};
+    }
+    SecBit labelBit((typename SecBit::ExtractedBit(labelShares.at(0))));
+
+    // the distance of an item is the number of items labeled 0 before it.
+    size_t countWidth = std::ceil(std::log2(size + 1));
+    size_t distanceWidth = size < 2 ? 0 : std::ceil(std::log2(size));
+    std::vector<std::vector<bool>> counts(
+        countWidth, std::vector<bool>(size, false));
+    counts[0] = (!labelBit).extractBit().getValue();
+    auto [distanceShares, zeroCountShares] =
+        util::SecretArithmetic<schedulerId>::computeExclusivePrefixSums(
+            std::move(counts));
+    distanceShares.resize(distanceWidth);
+
+    // clear the items labeled 0 and their distances, so that only the items
+    // labeled 1 move.
+    std::vector<SecBit> columns;
+    columns.reserve(srcShares.size() + distanceWidth);
+    for (auto& item : srcShares) {
+      columns.push_back(
+          SecBit(typename SecBit::ExtractedBit(std::move(item))));
+    }
+    for (auto& item : distanceShares) {
+      columns.push_back(
+          SecBit(typename SecBit::ExtractedBit(std::move(item))));
+    }
+    auto cleared = labelBit & columns;
+    std::vector<std::vector<bool>> itemShares;
+    itemShares.reserve(srcShares.size() + 1 + distanceWidth);
+    for (size_t i = 0; i < srcShares.size(); i++) {
+      itemShares.push_back(cleared.at(i).extractBit().getValue());
+    }
+    itemShares.push_back(std::move(labelShares[0]));
+    for (size_t i = 0; i < distanceWidth; i++) {
+      itemShares.push_back(
+          cleared.at(srcShares.size() + i).extractBit().getValue());
+    }
+
+    // the j-th level moves the items with the j-th bit of their distances set
+    // by 2^j positions, along with the remaining bits of their distances.
+    auto movingWidth = srcShares.size() + 1;
+    for (size_t level = 0; level < distanceWidth; level++) {
+      size_t shift = 1 << level;
+      SecBit isMoving((typename SecBit::ExtractedBit(
+          std::move(itemShares[movingWidth + level]))));
+      std::vector<SecBit> toMove;
+      toMove.reserve(itemShares.size());
+      for (size_t i = 0; i < itemShares.size(); i++) {
+        if (i < movingWidth || i > movingWidth + level) {
+          toMove.push_back(
+              SecBit(typename SecBit::ExtractedBit(itemShares.at(i))));
+        }
+      }
+      auto moved = isMoving & toMove;
+      size_t k = 0;
+      for (size_t i = 0; i < itemShares.size(); i++) {
+        if (i < movingWidth || i > movingWidth + level) {
+          auto movedShares = moved.at(k++).extractBit().getValue();
+          auto& column = itemShares[i];
+          for (size_t p = 0; p < size; p++) {
+            column[p] = column[p] ^ movedShares.at(p);
+          }
+          for (size_t p = 0; p + shift < size; p++) {
+            column[p] = column[p] ^ movedShares.at(p + shift);
+          }
+        }
+      }
+    }
+    itemShares.resize(movingWidth);
+
+    if (shouldRevealSize) {
+      auto party0 = (myId_ < partnerId_) ? myId_ : partnerId_;
+      auto party1 = (myId_ < partnerId_) ? partnerId_ : myId_;
+      SecBit zeroCount((typename SecBit::ExtractedBit(zeroCountShares)));
+      auto revealed0 = zeroCount.openToParty(party0);
+      auto revealed1 = zeroCount.openToParty(party1);
+      auto bits =
+          (myId_ == party0) ? revealed0.getValue() : revealed1.getValue();
+      size_t outputSize = size;
+      for (size_t k = 0; k < bits.size(); k++) {
+        outputSize -= static_cast<size_t>(bits.at(k)) << k;
+      }
+      for (auto& item : itemShares) {
+        item.resize(outputSize);
+      }
+    }
+
+    auto labelColumn = std::move(itemShares.back());
+    itemShares.pop_back();
+    return {
+        util::MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(
+            itemShares),
+        util::MpcAdapters<LabelT, schedulerId>::recoverBatchSharedSecrets(
+            std::vector<std::vector<bool>>{std::move(labelColumn)})};
+  }
+
+ private:
+  int myId_;
+  int partnerId_;
+};
+
+} // namespace fbpcf::mpc_std_lib::compactor
@@ -7,6 +7,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include <fbpcf/engine/util/util.h>
 #include "fbpcf/mpc_std_lib/compactor/ICompactor.h"
 #include "fbpcf/mpc_std_lib/shuffler/IShuffler.h"
@@ -35,11 +40,24 @@ class ShuffleBasedCompactor final
   using SecBatchSrcType = typename util::SecBatchType<T, schedulerId>::type;
   using SecBatchLabelType =
       typename util::SecBatchType<LabelT, schedulerId>::type;
+  static const size_t kDefaultChunkSize = 1 << 20;
+
+  /**
+   * @param chunkSize how many items are revealed and selected at a time.
+   */
   ShuffleBasedCompactor(
       int myId,
       int partnerId,
-      std::unique_ptr<shuffler::IShuffler<SecBatchType>> shuffler)
-      : myId_(myId), partnerId_(partnerId), shuffler_(std::move(shuffler)) {}
+      std::unique_ptr<shuffler::IShuffler<SecBatchType>> shuffler,
+      size_t chunkSize = kDefaultChunkSize)
+      : myId_(myId),
+        partnerId_(partnerId),
+        shuffler_(std::move(shuffler)),
+        chunkSize_(chunkSize) {
+    if (chunkSize == 0) {
+      throw std::invalid_argument("The chunk size can't be 0.");
+    }
+  }
 
   std::pair<SecBatchSrcType, SecBatchLabelType> compaction(
       const SecBatchSrcType& src,
@@ -50,60 +68,91 @@ class ShuffleBasedCompactor final
       throw std::runtime_error("shouldRevealSize should be true");
     }
 
-    // shuffle the data which includes both src and label.
-    auto shuffled = shuffler_->shuffle({src, label}, size);
-    auto shuffledSrc = shuffled.first;
-    auto shuffledLabel = shuffled.second;
-
-    // reveal Label to both party;
     auto party0 =
         (myId_ < partnerId_) ? myId_ : partnerId_; // a party with a smaller id
     auto party1 =
         (myId_ < partnerId_) ? partnerId_ : myId_; // a party with a larger id
 
-    auto revealedLabel0 = util::MpcAdapters<LabelT, schedulerId>::openToParty(
-        shuffledLabel, party0); // reveal to party0
-    auto revealedLabel1 = util::MpcAdapters<LabelT, schedulerId>::openToParty(
-        shuffledLabel, party1); // reveal to party1
-    auto plaintextLabel = (myId_ == party0) ? revealedLabel0 : revealedLabel1;
-
-    // unbatch the batch type shuffledSrc and shuffledLabel into a vector format
-    // to select elements that are labeled as 1.
-    auto unbatchSize = std::make_shared<std::vector<uint32_t>>(size);
-    for (size_t i = 0; i < size; i++) {
-      (*unbatchSize)[i] = 1;
+    // Take this party's shares of the shuffled batch once and release the
+    // batch, then work through them in windows of chunkSize_ items, so that
+    // only one window of labels is rebuilt and revealed at a time. The kept
+    // items are gathered by their indexes from the shares rather than by
+    // unbatching every single item.
+    std::vector<std::vector<bool>> srcShares;
+    std::vector<std::vector<bool>> labelShares;
+    {
+      // shuffle the data which includes both src and label.
+      auto shuffled = shuffler_->shuffle({src, label}, size);
+      srcShares = util::MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(
+          shuffled.first);
+      labelShares =
+          util::MpcAdapters<LabelT, schedulerId>::extractBatchSharedSecrets(
+              shuffled.second);
     }
-    auto shuffledSrcBatches = util::MpcAdapters<T, schedulerId>::unbatching(
-        shuffledSrc, unbatchSize); // unbatch
-    auto shuffledLabelBatches =
-        util::MpcAdapters<LabelT, schedulerId>::unbatching(
-            shuffledLabel, unbatchSize); // unbatch
-
-    // select all 1s items.
-    std::vector<SecBatchSrcType> compactifiedSrc;
-    std::vector<SecBatchLabelType> compactifiedLabel;
-    for (size_t i = 0; i < size; i++) {
-      if (plaintextLabel.at(i)) {
-        compactifiedSrc.push_back(shuffledSrcBatches.at(i));
-        compactifiedLabel.push_back(shuffledLabelBatches.at(i));
-      }
+
+    std::vector<std::vector<bool>> rstSrcShares(srcShares.size());
+    std::vector<std::vector<bool>> rstLabelShares(labelShares.size());
+    for (size_t begin = 0; begin < size; begin += chunkSize_) {
+      auto end = std::min(begin + chunkSize_, size);
+      auto labelChunk =
+          util::MpcAdapters<LabelT, schedulerId>::recoverBatchSharedSecrets(
+              getWindow(labelShares, begin, end));
+
+      // reveal labels to both parties
+      auto revealedLabel0 =
+          util::MpcAdapters<LabelT, schedulerId>::openToParty(
+              labelChunk, party0); // reveal to party0
+      auto revealedLabel1 =
+          util::MpcAdapters<LabelT, schedulerId>::openToParty(
+              labelChunk, party1); // reveal to party1
+      auto plaintextLabel =
+          (myId_ == party0) ? revealedLabel0 : revealedLabel1;
+
+      // select all 1s items.
+      gatherKeptShares(plaintextLabel, begin, srcShares, rstSrcShares);
+      gatherKeptShares(plaintextLabel, begin, labelShares, rstLabelShares);
     }
 
-    // rebatch
-    auto rstLabel = util::MpcAdapters<LabelT, schedulerId>::batchingWith(
-        compactifiedLabel.at(0),
-        std::vector<SecBatchLabelType>(
-            compactifiedLabel.begin() + 1, compactifiedLabel.end()));
-    auto rstSrc = util::MpcAdapters<T, schedulerId>::batchingWith(
-        compactifiedSrc.at(0),
-        std::vector<SecBatchSrcType>(
-            compactifiedSrc.begin() + 1, compactifiedSrc.end()));
-    return {rstSrc, rstLabel};
+    return {
+        util::MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(
+            rstSrcShares),
+        util::MpcAdapters<LabelT, schedulerId>::recoverBatchSharedSecrets(
+            rstLabelShares)};
   }
 
  private:
+  // the shares of the items in [begin, end).
+  static std::vector<std::vector<bool>> getWindow(
+      const std::vector<std::vector<bool>>& src,
+      size_t begin,
+      size_t end) {
+    std::vector<std::vector<bool>> rst;
+    rst.reserve(src.size());
+    for (auto& bits : src) {
+      rst.emplace_back(bits.begin() + begin, bits.begin() + end);
+    }
+    return rst;
+  }
+
+  // append the shares of the items labeled 1 to dst, the labels being those
+  // of the items from offset on.
+  static void gatherKeptShares(
+      const std::vector<bool>& plaintextLabel,
+      size_t offset,
+      const std::vector<std::vector<bool>>& src,
+      std::vector<std::vector<bool>>& dst) {
+    for (size_t i = 0; i < src.size(); i++) {
+      for (size_t j = 0; j < plaintextLabel.size(); j++) {
+        if (plaintextLabel.at(j)) {
+          dst[i].push_back(src.at(i).at(offset + j));
+        }
+      }
+    }
+  }
+
   int myId_;
   int partnerId_;
   std::unique_ptr<shuffler::IShuffler<SecBatchType>> shuffler_;
+  size_t chunkSize_;
 };
 } // namespace fbpcf::mpc_std_lib::compactor
@@ -29,21 +29,25 @@ class ShuffleBasedCompactorFactory final
   ShuffleBasedCompactorFactory(
       int myId,
       int partnerId,
-      std::unique_ptr<shuffler::IShufflerFactory<SecBatchType>> shufflerFactory)
+      std::unique_ptr<shuffler::IShufflerFactory<SecBatchType>> shufflerFactory,
+      size_t chunkSize =
+          ShuffleBasedCompactor<T, LabelT, schedulerId>::kDefaultChunkSize)
       : myId_(myId),
         partnerId_(partnerId),
-        shufflerFactory_(std::move(shufflerFactory)) {}
+        shufflerFactory_(std::move(shufflerFactory)),
+        chunkSize_(chunkSize) {}
 
   std::unique_ptr<ICompactor<SecBatchSrcType, SecBatchLabelType>> create()
       override {
     return std::make_unique<ShuffleBasedCompactor<T, LabelT, schedulerId>>(
-        myId_, partnerId_, shufflerFactory_->create());
+        myId_, partnerId_, shufflerFactory_->create(), chunkSize_);
   }
 
  private:
   int myId_;
   int partnerId_;
   std::unique_ptr<shuffler::IShufflerFactory<SecBatchType>> shufflerFactory_;
+  size_t chunkSize_;
 };
 
 } // namespace fbpcf::mpc_std_lib::compactor
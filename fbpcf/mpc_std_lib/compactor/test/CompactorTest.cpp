@@ -21,6 +21,7 @@
 #include "fbpcf/mpc_std_lib/compactor/DummyCompactorFactory.h"
 #include "fbpcf/mpc_std_lib/compactor/ICompactor.h"
 #include "fbpcf/mpc_std_lib/compactor/ICompactorFactory.h"
+#include "fbpcf/mpc_std_lib/compactor/ShiftBasedCompactorFactory.h"
 #include "fbpcf/mpc_std_lib/compactor/ShuffleBasedCompactor.h"
 #include "fbpcf/mpc_std_lib/compactor/ShuffleBasedCompactorFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
@@ -185,4 +186,94 @@ TEST(compactorTest, testShuffleBasedCompactor) {
   compactorTest<AttributionValue>(factory0, factory1);
 }
 
+TEST(compactorTest, testChunkedShuffleBasedCompactor) {
+  // a chunk size which doesn't divide the batch size
+  size_t chunkSize = 4;
+  ShuffleBasedCompactorFactory<AttributionValue, bool, 0> factory0(
+      0,
+      1,
+      std::make_unique<shuffler::PermuteBasedShufflerFactory<std::pair<
+          typename util::SecBatchType<AttributionValue, 0>::type,
+          typename util::SecBatchType<bool, 0>::type>>>(
+          0,
+          1,
+          std::make_unique<permuter::AsWaksmanPermuterFactory<
+              std::pair<AttributionValue, bool>,
+              0>>(0, 1),
+          std::make_unique<engine::util::AesPrgFactory>()),
+      chunkSize);
+  ShuffleBasedCompactorFactory<AttributionValue, bool, 1> factory1(
+      1,
+      0,
+      std::make_unique<shuffler::PermuteBasedShufflerFactory<std::pair<
+          typename util::SecBatchType<AttributionValue, 1>::type,
+          typename util::SecBatchType<bool, 1>::type>>>(
+          1,
+          0,
+          std::make_unique<permuter::AsWaksmanPermuterFactory<
+              std::pair<AttributionValue, bool>,
+              1>>(1, 0),
+          std::make_unique<engine::util::AesPrgFactory>()),
+      chunkSize);
+
+  compactorTest<AttributionValue>(factory0, factory1);
+}
+
+void sizeHidingCompactorTest(size_t batchSize, bool shouldRevealSize) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  ShiftBasedCompactorFactory<uint32_t, bool, 0> factory0(0, 1);
+  ShiftBasedCompactorFactory<uint32_t, bool, 1> factory1(1, 0);
+
+  std::vector<uint32_t> testData(batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    testData[i] = i + 1;
+  }
+  auto testLabel = util::generateRandomBinary(batchSize);
+  std::vector<uint32_t> expectedData;
+  for (size_t i = 0; i < batchSize; i++) {
+    if (testLabel.at(i)) {
+      expectedData.push_back(testData.at(i));
+    }
+  }
+
+  auto future0 = std::async(
+      task<uint32_t, 0>,
+      factory0.create(),
+      testData,
+      testLabel,
+      batchSize,
+      shouldRevealSize);
+  auto future1 = std::async(
+      task<uint32_t, 1>,
+      factory1.create(),
+      testData,
+      testLabel,
+      batchSize,
+      shouldRevealSize);
+  auto [rstData0, rstLabel0] = future0.get();
+  future1.get();
+
+  // the items labeled 1 come first and in order, the others are cleared.
+  auto expectedSize = shouldRevealSize ? expectedData.size() : batchSize;
+  ASSERT_EQ(rstData0.size(), expectedSize);
+  ASSERT_EQ(rstLabel0.size(), expectedSize);
+  for (size_t i = 0; i < expectedSize; i++) {
+    if (i < expectedData.size()) {
+      EXPECT_TRUE(rstLabel0.at(i));
+      EXPECT_EQ(rstData0.at(i), expectedData.at(i));
+    } else {
+      EXPECT_FALSE(rstLabel0.at(i));
+      EXPECT_EQ(rstData0.at(i), 0);
+    }
+  }
+}
+
+TEST(compactorTest, testShiftBasedCompactor) {
+  for (size_t batchSize : {1, 2, 11, 64, 1000}) {
+    sizeHidingCompactorTest(batchSize, false);
+    sizeHidingCompactorTest(batchSize, true);
+  }
+}
+
 } // namespace fbpcf::mpc_std_lib::compactor
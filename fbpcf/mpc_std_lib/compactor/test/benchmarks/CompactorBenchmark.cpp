@@ -9,6 +9,7 @@
 
 #include "common/init/Init.h"
 
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotHelper.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
 #include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
 #include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
@@ -16,10 +17,12 @@
 #include "fbpcf/mpc_std_lib/compactor/DummyCompactorFactory.h"
 #include "fbpcf/mpc_std_lib/compactor/ICompactor.h"
 #include "fbpcf/mpc_std_lib/compactor/ICompactorFactory.h"
+#include "fbpcf/mpc_std_lib/compactor/ShiftBasedCompactorFactory.h"
 #include "fbpcf/mpc_std_lib/compactor/ShuffleBasedCompactor.h"
 #include "fbpcf/mpc_std_lib/compactor/ShuffleBasedCompactorFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/shuffler/PermuteBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslationBasedShufflerFactory.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
@@ -36,11 +39,11 @@ class BaseCompactorBenchmark : public engine::util::NetworkedBenchmark {
     agentFactory0_ = std::move(agentFactory0);
     agentFactory1_ = std::move(agentFactory1);
 
-    std::vector<uint32_t> value(batchSize);
+    std::vector<uint32_t> value(batchSize_);
     std::iota(
         value.begin(), value.end(), 0); // assign unique values starting from 0.
 
-    auto label = util::generateRandomBinary(batchSize);
+    auto label = util::generateRandomBinary(batchSize_);
     value_ = value;
     label_ = label;
   }
@@ -58,8 +61,8 @@ class BaseCompactorBenchmark : public engine::util::NetworkedBenchmark {
         util::MpcAdapters<uint32_t, 0>::processSecretInputs(value_, 0);
     auto secLabel = util::MpcAdapters<bool, 0>::processSecretInputs(label_, 0);
 
-    auto [compactifiedValue, compactifiedLabel] =
-        compactor0_->compaction(secValue, secLabel, batchSize, true);
+    auto [compactifiedValue, compactifiedLabel] = compactor0_->compaction(
+        secValue, secLabel, batchSize_, shouldRevealSize_);
 
     auto rstLabel =
         util::MpcAdapters<bool, 0>::openToParty(compactifiedLabel, 0);
@@ -79,8 +82,8 @@ class BaseCompactorBenchmark : public engine::util::NetworkedBenchmark {
         util::MpcAdapters<uint32_t, 1>::processSecretInputs(value_, 0);
     auto secLabel = util::MpcAdapters<bool, 1>::processSecretInputs(label_, 0);
 
-    auto [compactifiedValue, compactifiedLabel] =
-        compactor1_->compaction(secValue, secLabel, batchSize, true);
+    auto [compactifiedValue, compactifiedLabel] = compactor1_->compaction(
+        secValue, secLabel, batchSize_, shouldRevealSize_);
 
     auto rstLabel =
         util::MpcAdapters<bool, 1>::openToParty(compactifiedLabel, 0);
@@ -96,6 +99,9 @@ class BaseCompactorBenchmark : public engine::util::NetworkedBenchmark {
 
   virtual void setCompactorFactory() = 0;
 
+  size_t batchSize_ = batchSize;
+  bool shouldRevealSize_ = true;
+
   std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
       agentFactory0_;
   std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
@@ -110,7 +116,6 @@ class BaseCompactorBenchmark : public engine::util::NetworkedBenchmark {
       typename util::SecBatchType<bool, 1>::type>>
       factory1_;
 
- private:
   std::unique_ptr<ICompactor<
       typename util::SecBatchType<uint32_t, 0>::type,
       typename util::SecBatchType<bool, 0>::type>>
@@ -120,6 +125,7 @@ class BaseCompactorBenchmark : public engine::util::NetworkedBenchmark {
       typename util::SecBatchType<bool, 1>::type>>
       compactor1_;
 
+ private:
   std::vector<uint32_t> value_;
   std::vector<bool> label_;
 };
@@ -159,6 +165,84 @@ BENCHMARK_COUNTERS(ShuffleBasedCompactor_Benchmark, counters) {
   ShuffleBasedCompactorBenchmark benchmark;
   benchmark.runBenchmark(counters);
 }
+
+class ShareTranslationBasedCompactorBenchmark : public BaseCompactorBenchmark {
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    shufflerFactory0_ = std::make_unique<
+        shuffler::ShareTranslationBasedShufflerFactory<PairType, 0>>(
+        0,
+        1,
+        *agentFactory0_,
+        engine::tuple_generator::oblivious_transfer::createFerretRcotFactory(),
+        std::make_unique<engine::util::AesPrgFactory>());
+    auto shuffler = shufflerFactory0_->create();
+    shuffler0_ = dynamic_cast<
+        shuffler::ShareTranslationBasedShuffler<PairType, 0>*>(shuffler.get());
+    compactor0_ = std::make_unique<ShuffleBasedCompactor<uint32_t, bool, 0>>(
+        0, 1, std::move(shuffler));
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    shufflerFactory1_ = std::make_unique<
+        shuffler::ShareTranslationBasedShufflerFactory<PairType, 1>>(
+        1,
+        0,
+        *agentFactory1_,
+        engine::tuple_generator::oblivious_transfer::createFerretRcotFactory(),
+        std::make_unique<engine::util::AesPrgFactory>());
+    compactor1_ = std::make_unique<ShuffleBasedCompactor<uint32_t, bool, 1>>(
+        1, 0, shufflerFactory1_->create());
+  }
+
+  // the shuffler talks to the other party on its own, not via the scheduler.
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] =
+        scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+    auto [shufflerSent, shufflerReceived] = shuffler0_->getTrafficStatistics();
+    return {sent + shufflerSent, received + shufflerReceived};
+  }
+
+  // the compactors are created directly in initSender() and initReceiver().
+  void setCompactorFactory() override {}
+
+ private:
+  using PairType = std::pair<uint32_t, bool>;
+
+  std::unique_ptr<shuffler::ShareTranslationBasedShufflerFactory<PairType, 0>>
+      shufflerFactory0_;
+  std::unique_ptr<shuffler::ShareTranslationBasedShufflerFactory<PairType, 1>>
+      shufflerFactory1_;
+  shuffler::ShareTranslationBasedShuffler<PairType, 0>* shuffler0_;
+};
+BENCHMARK_COUNTERS(ShareTranslationBasedCompactor_Benchmark, counters) {
+  ShareTranslationBasedCompactorBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class ShiftBasedCompactorBenchmark : public BaseCompactorBenchmark {
+ public:
+  explicit ShiftBasedCompactorBenchmark(size_t size) {
+    batchSize_ = size;
+    shouldRevealSize_ = false;
+  }
+
+ protected:
+  void setCompactorFactory() override {
+    factory0_ = std::make_unique<ShiftBasedCompactorFactory<uint32_t, bool, 0>>(
+        0, 1);
+    factory1_ = std::make_unique<ShiftBasedCompactorFactory<uint32_t, bool, 1>>(
+        1, 0);
+  }
+};
+BENCHMARK_COUNTERS(ShiftBasedCompactor_Benchmark, counters) {
+  ShiftBasedCompactorBenchmark benchmark(batchSize);
+  benchmark.runBenchmark(counters);
+}
 } // namespace fbpcf::mpc_std_lib::compactor
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+/*
+ * A group-by-sum obliviously groups a batch of secret rows by their keys and
+ * sums up the values of each group. Unlike adding the rows to a write-only
+ * ORAM with one slot per key, the cost only depends on the number of rows, so
+ * it suits large key domains.
+ */
+/**
+ * A type KeyT corresponds to a set of keys (i.e., a batch). Similarly, ValueT
+ * corresponds to a set of values and LabelT to a set of binary labels. The
+ * values are added as integers modulo 2^width, where width is the number of
+ * bits of a value.
+ */
+template <typename KeyT, typename ValueT, typename LabelT>
+class IGroupBySum {
+ public:
+  virtual ~IGroupBySum() = default;
+
+  /**
+   * Sum up the values of every distinct key.
+   * @param keys the keys to group by.
+   * @param values the values to sum, the i-th one belongs to the i-th key.
+   * @param size the size of the batch.
+   * @param shouldRevealSize whether it is okay to reveal the number of
+   * distinct keys.
+   * @return the distinct keys, their sums and the labels. If the size can be
+   * revealed, there is one row per distinct key and all the labels are 1.
+   * Otherwise there are size rows in the order of the keys and only the ones
+   * labeled 1 are groups, the keys and the sums of the others are 0.
+   */
+  virtual std::tuple<KeyT, ValueT, LabelT> groupBySum(
+      const KeyT& keys,
+      const ValueT& values,
+      size_t size,
+      bool shouldRevealSize) const = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::group_by
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/mpc_std_lib/group_by/IGroupBySum.h"
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+template <typename KeyT, typename ValueT, typename LabelT>
+class IGroupBySumFactory {
+ public:
+  virtual ~IGroupBySumFactory() = default;
+  virtual std::unique_ptr<IGroupBySum<KeyT, ValueT, LabelT>> create() = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::group_by
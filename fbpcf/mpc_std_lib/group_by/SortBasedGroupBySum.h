@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/compactor/ICompactor.h"
+#include "fbpcf/mpc_std_lib/group_by/IGroupBySum.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorter.h"
+#include "fbpcf/mpc_std_lib/util/SecretArithmetic.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+/*
+ * This group-by-sum sorts the rows by their keys, so that each group is a run
+ * of consecutive rows, and then computes the sums with a segmented prefix sum:
+ * a work-efficient (Blelloch) scan that restarts at the first row of every
+ * run. The last row of a run holds the sum of its group and, if the number of
+ * groups can be revealed, a compactor keeps only these rows. Apart from the
+ * sorter and the compactor, it takes O(n) additions in O(log n) rounds.
+ */
+/*
+ * We assume that there are two parties. In our implementation, a party with a
+ * smaller id is assigned to party0 and the other party is assigned to party1.
+ */
+template <typename KeyT, typename ValueT, int schedulerId>
+class SortBasedGroupBySum final
+    : public IGroupBySum<
+          typename util::SecBatchType<KeyT, schedulerId>::type,
+          typename util::SecBatchType<ValueT, schedulerId>::type,
+          typename util::SecBatchType<bool, schedulerId>::type> {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+ public:
+  using SecBatchKeyType = typename util::SecBatchType<KeyT, schedulerId>::type;
+  using SecBatchValueType =
+      typename util::SecBatchType<ValueT, schedulerId>::type;
+  using SecBatchLabelType =
+      typename util::SecBatchType<bool, schedulerId>::type;
+  using SecBatchRowType =
+      typename util::SecBatchType<std::pair<KeyT, ValueT>, schedulerId>::type;
+
+  SortBasedGroupBySum(
+      int myId,
+      int partnerId,
+      std::unique_ptr<sorter::ISorter<SecBatchKeyType, SecBatchValueType>>
+          sorter,
+      std::unique_ptr<
+          compactor::ICompactor<SecBatchRowType, SecBatchLabelType>> compactor)
+      : myId_(myId),
+        partnerId_(partnerId),
+        sorter_(std::move(sorter)),
+        compactor_(std::move(compactor)) {}
+
+  /**
+   * @inherit doc
+   */
+  std::tuple<SecBatchKeyType, SecBatchValueType, SecBatchLabelType> groupBySum(
+      const SecBatchKeyType& keys,
+      const SecBatchValueType& values,
+      size_t size,
+      bool shouldRevealSize) const override;
+
+ private:
+  // this party's shares of whether each row is the first one and whether it
+  // is the last one of its run, in a batch sorted by key.
+  std::pair<std::vector<bool>, std::vector<bool>> computeRunBoundaries(
+      const std::vector<std::vector<bool>>& keyShares) const;
+
+  // this party's shares of the inclusive prefix sums of the values, which
+  // restart at every row whose flag is 1.
+  std::vector<std::vector<bool>> computeSegmentedPrefixSums(
+      const std::vector<std::vector<bool>>& valueShares,
+      const std::vector<bool>& isFirstShares) const;
+
+  // this party's shares of a public value, party 0 holds the value.
+  bool getShareOfPublicBit(bool bit) const {
+    return myId_ < partnerId_ ? bit : false;
+  }
+
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<sorter::ISorter<SecBatchKeyType, SecBatchValueType>> sorter_;
+  std::unique_ptr<compactor::ICompactor<SecBatchRowType, SecBatchLabelType>>
+      compactor_;
+};
+
+} // namespace fbpcf::mpc_std_lib::group_by
+
+#include "fbpcf/mpc_std_lib/group_by/SortBasedGroupBySum_impl.h"
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/mpc_std_lib/compactor/ICompactorFactory.h"
+#include "fbpcf/mpc_std_lib/group_by/IGroupBySumFactory.h"
+#include "fbpcf/mpc_std_lib/group_by/SortBasedGroupBySum.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorterFactory.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+template <typename KeyT, typename ValueT, int schedulerId>
+class SortBasedGroupBySumFactory final
+    : public IGroupBySumFactory<
+          typename util::SecBatchType<KeyT, schedulerId>::type,
+          typename util::SecBatchType<ValueT, schedulerId>::type,
+          typename util::SecBatchType<bool, schedulerId>::type> {
+ public:
+  using SecBatchKeyType = typename util::SecBatchType<KeyT, schedulerId>::type;
+  using SecBatchValueType =
+      typename util::SecBatchType<ValueT, schedulerId>::type;
+  using SecBatchLabelType =
+      typename util::SecBatchType<bool, schedulerId>::type;
+  using SecBatchRowType =
+      typename util::SecBatchType<std::pair<KeyT, ValueT>, schedulerId>::type;
+
+  SortBasedGroupBySumFactory(
+      int myId,
+      int partnerId,
+      std::unique_ptr<
+          sorter::ISorterFactory<SecBatchKeyType, SecBatchValueType>>
+          sorterFactory,
+      std::unique_ptr<
+          compactor::ICompactorFactory<SecBatchRowType, SecBatchLabelType>>
+          compactorFactory)
+      : myId_(myId),
+        partnerId_(partnerId),
+        sorterFactory_(std::move(sorterFactory)),
+        compactorFactory_(std::move(compactorFactory)) {}
+
+  std::unique_ptr<
+      IGroupBySum<SecBatchKeyType, SecBatchValueType, SecBatchLabelType>>
+  create() override {
+    return std::make_unique<SortBasedGroupBySum<KeyT, ValueT, schedulerId>>(
+        myId_,
+        partnerId_,
+        sorterFactory_->create(),
+        compactorFactory_->create());
+  }
+
+ private:
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<sorter::ISorterFactory<SecBatchKeyType, SecBatchValueType>>
+      sorterFactory_;
+  std::unique_ptr<
+      compactor::ICompactorFactory<SecBatchRowType, SecBatchLabelType>>
+      compactorFactory_;
+};
+
+} // namespace fbpcf::mpc_std_lib::group_by
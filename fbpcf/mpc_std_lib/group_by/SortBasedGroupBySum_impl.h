@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+template <typename KeyT, typename ValueT, int schedulerId>
+std::tuple<
+    typename SortBasedGroupBySum<KeyT, ValueT, schedulerId>::SecBatchKeyType,
+    typename SortBasedGroupBySum<KeyT, ValueT, schedulerId>::SecBatchValueType,
+    typename SortBasedGroupBySum<KeyT, ValueT, schedulerId>::SecBatchLabelType>
+SortBasedGroupBySum<KeyT, ValueT, schedulerId>::groupBySum(
+    const SecBatchKeyType& keys,
+    const SecBatchValueType& values,
+    size_t size,
+    bool shouldRevealSize) const {
+  if (size == 0) {
+    throw std::invalid_argument("The batch can't be empty.");
+  }
+  auto [sortedKeys, sortedValues] = sorter_->sort(keys, values, size);
+  auto keyShares =
+      util::MpcAdapters<KeyT, schedulerId>::extractBatchSharedSecrets(
+          sortedKeys);
+  auto valueShares =
+      util::MpcAdapters<ValueT, schedulerId>::extractBatchSharedSecrets(
+          sortedValues);
+
+  auto [isFirstShares, isLastShares] = computeRunBoundaries(keyShares);
+  auto sumShares = computeSegmentedPrefixSums(valueShares, isFirstShares);
+  SecBit isLast((typename SecBit::ExtractedBit(std::move(isLastShares))));
+
+  if (shouldRevealSize) {
+    auto [groups, labels] = compactor_->compaction(
+        {util::MpcAdapters<KeyT, schedulerId>::recoverBatchSharedSecrets(
+             keyShares),
+         util::MpcAdapters<ValueT, schedulerId>::recoverBatchSharedSecrets(
+             sumShares)},
+        isLast,
+        size,
+        true);
+    return {groups.first, groups.second, labels};
+  }
+
+  // without compaction, the rows that don't end a run are cleared instead.
+  std::vector<SecBit> columns;
+  columns.reserve(keyShares.size() + sumShares.size());
+  for (auto& item : keyShares) {
+    columns.push_back(SecBit(typename SecBit::ExtractedBit(std::move(item))));
+  }
+  for (auto& item : sumShares) {
+    columns.push_back(SecBit(typename SecBit::ExtractedBit(std::move(item))));
+  }
+  auto cleared = isLast & columns;
+  for (size_t i = 0; i < keyShares.size(); i++) {
+    keyShares[i] = cleared.at(i).extractBit().getValue();
+  }
+  for (size_t i = 0; i < sumShares.size(); i++) {
+    sumShares[i] = cleared.at(keyShares.size() + i).extractBit().getValue();
+  }
+  return {
+      util::MpcAdapters<KeyT, schedulerId>::recoverBatchSharedSecrets(
+          keyShares),
+      util::MpcAdapters<ValueT, schedulerId>::recoverBatchSharedSecrets(
+          sumShares),
+      isLast};
+}
+
+template <typename KeyT, typename ValueT, int schedulerId>
+std::pair<std::vector<bool>, std::vector<bool>>
+SortBasedGroupBySum<KeyT, ValueT, schedulerId>::computeRunBoundaries(
+    const std::vector<std::vector<bool>>& keyShares) const {
+  auto size = keyShares.at(0).size();
+  std::vector<bool> isFirstShares(size, getShareOfPublicBit(true));
+  std::vector<bool> isLastShares(size, getShareOfPublicBit(true));
+  if (size < 2) {
+    return {isFirstShares, isLastShares};
+  }
+
+  // a row starts a run if its key differs from the previous one, i.e. if
+  // any bit of the two keys differs.
+  std::vector<SecBit> differences;
+  for (auto& column : keyShares) {
+    std::vector<bool> difference(size - 1);
+    for (size_t i = 0; i + 1 < size; i++) {
+      difference[i] = column.at(i) ^ column.at(i + 1);
+    }
+    differences.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(difference))));
+  }
+  while (differences.size() > 1) {
+    std::vector<SecBit> merged;
+    for (size_t i = 0; i + 1 < differences.size(); i += 2) {
+      merged.push_back(differences.at(i) | differences.at(i + 1));
+    }
+    if (differences.size() % 2 == 1) {
+      merged.push_back(differences.back());
+    }
+    differences = std::move(merged);
+  }
+
+  auto notEqualShares = differences.at(0).extractBit().getValue();
+  for (size_t i = 0; i + 1 < size; i++) {
+    isFirstShares[i + 1] = notEqualShares.at(i);
+    isLastShares[i] = notEqualShares.at(i);
+  }
+  return {isFirstShares, isLastShares};
+}
+
+template <typename KeyT, typename ValueT, int schedulerId>
+std::vector<std::vector<bool>>
+SortBasedGroupBySum<KeyT, ValueT, schedulerId>::computeSegmentedPrefixSums(
+    const std::vector<std::vector<bool>>& valueShares,
+    const std::vector<bool>& isFirstShares) const {
+  using Arithmetic = util::SecretArithmetic<schedulerId>;
+  auto size = isFirstShares.size();
+  auto width = valueShares.size();
+  size_t paddedSize = 1;
+  while (paddedSize < size) {
+    paddedSize <<= 1;
+  }
+  auto sums = valueShares;
+  for (auto& item : sums) {
+    item.resize(paddedSize, false);
+  }
+  auto flags = isFirstShares;
+  flags.resize(paddedSize, false);
+  auto originalFlags = flags;
+
+  // gather the values at the given positions into a batch.
+  auto gather = [&sums, width](const std::vector<uint32_t>& positions) {
+    std::vector<SecBit> rst;
+    rst.reserve(width);
+    for (size_t k = 0; k < width; k++) {
+      std::vector<bool> shares(positions.size());
+      for (size_t j = 0; j < positions.size(); j++) {
+        shares[j] = sums.at(k).at(positions.at(j));
+      }
+      rst.push_back(SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+    }
+    return rst;
+  };
+  auto gatherFlags = [](const std::vector<bool>& src,
+                        const std::vector<uint32_t>& positions) {
+    std::vector<bool> shares(positions.size());
+    for (size_t j = 0; j < positions.size(); j++) {
+      shares[j] = src.at(positions.at(j));
+    }
+    return SecBit(typename SecBit::ExtractedBit(std::move(shares)));
+  };
+  auto scatter = [&sums, width](
+                     const std::vector<uint32_t>& positions,
+                     const std::vector<SecBit>& src) {
+    for (size_t k = 0; k < width; k++) {
+      auto shares = src.at(k).extractBit().getValue();
+      for (size_t j = 0; j < positions.size(); j++) {
+        sums[k][positions.at(j)] = shares.at(j);
+      }
+    }
+  };
+  // rst = choice ? ifTrue : ifFalse, with a single composite AND.
+  auto mux = [width](
+                 const SecBit& choice,
+                 const std::vector<SecBit>& ifTrue,
+                 const std::vector<SecBit>& ifFalse) {
+    std::vector<SecBit> differences;
+    differences.reserve(width);
+    for (size_t k = 0; k < width; k++) {
+      differences.push_back(ifTrue.at(k) ^ ifFalse.at(k));
+    }
+    auto chosen = choice & differences;
+    for (size_t k = 0; k < width; k++) {
+      chosen[k] = chosen.at(k) ^ ifFalse.at(k);
+    }
+    return chosen;
+  };
+  auto getPositions = [paddedSize](size_t distance) {
+    std::vector<uint32_t> rights;
+    std::vector<uint32_t> lefts;
+    for (auto i = 2 * distance - 1; i < paddedSize; i += 2 * distance) {
+      rights.push_back(i);
+      lefts.push_back(i - distance);
+    }
+    return std::make_pair(std::move(lefts), std::move(rights));
+  };
+
+  // the up-sweep: a node keeps its own sum if a run starts inside it, or adds
+  // the sum of its left sibling otherwise.
+  for (size_t distance = 1; distance < paddedSize; distance <<= 1) {
+    auto [lefts, rights] = getPositions(distance);
+    auto left = gather(lefts);
+    auto right = gather(rights);
+    auto rightFlag = gatherFlags(flags, rights);
+    auto leftFlag = gatherFlags(flags, lefts);
+    scatter(rights, mux(rightFlag, right, Arithmetic::add(left, right)));
+    auto mergedFlags = (rightFlag | leftFlag).extractBit().getValue();
+    for (size_t j = 0; j < rights.size(); j++) {
+      flags[rights.at(j)] = mergedFlags.at(j);
+    }
+  }
+
+  // the down-sweep: a right child gets 0 if a run starts with it, the sum
+  // passed down to its left sibling if a run starts inside that sibling, or
+  // the sum of both otherwise. The flags of the left children are final.
+  for (auto& item : sums) {
+    item[paddedSize - 1] = false;
+  }
+  for (size_t distance = paddedSize / 2; distance > 0; distance >>= 1) {
+    auto [lefts, rights] = getPositions(distance);
+    auto left = gather(lefts);
+    auto right = gather(rights);
+    scatter(lefts, right);
+    std::vector<uint32_t> firstsOfRights(rights.size());
+    for (size_t j = 0; j < rights.size(); j++) {
+      firstsOfRights[j] = lefts.at(j) + 1;
+    }
+    auto passed =
+        mux(gatherFlags(flags, lefts), left, Arithmetic::add(left, right));
+    scatter(rights, !gatherFlags(originalFlags, firstsOfRights) & passed);
+  }
+
+  // the exclusive sums plus the values themselves.
+  std::vector<uint32_t> positions(size);
+  for (size_t i = 0; i < size; i++) {
+    positions[i] = i;
+  }
+  auto exclusiveSums = gather(positions);
+  std::vector<SecBit> values;
+  values.reserve(width);
+  for (auto& item : valueShares) {
+    values.push_back(SecBit(typename SecBit::ExtractedBit(item)));
+  }
+  auto inclusiveSums = Arithmetic::add(exclusiveSums, values);
+  std::vector<std::vector<bool>> rst(width);
+  for (size_t k = 0; k < width; k++) {
+    rst[k] = inclusiveSums.at(k).extractBit().getValue();
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::group_by
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/mpc_std_lib/compactor/ShuffleBasedCompactorFactory.h"
+#include "fbpcf/mpc_std_lib/group_by/IGroupBySumFactory.h"
+#include "fbpcf/mpc_std_lib/group_by/SortBasedGroupBySumFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/PermuteBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/BitonicSorterFactory.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+using RowType = std::pair<uint32_t, uint32_t>;
+
+template <int schedulerId>
+using GroupBySumFactory = IGroupBySumFactory<
+    typename util::SecBatchType<uint32_t, schedulerId>::type,
+    typename util::SecBatchType<uint32_t, schedulerId>::type,
+    typename util::SecBatchType<bool, schedulerId>::type>;
+
+template <int schedulerId>
+std::unique_ptr<GroupBySumFactory<schedulerId>> createGroupBySumFactory(
+    int myId,
+    int partnerId) {
+  return std::make_unique<
+      SortBasedGroupBySumFactory<uint32_t, uint32_t, schedulerId>>(
+      myId,
+      partnerId,
+      std::make_unique<
+          sorter::BitonicSorterFactory<uint32_t, uint32_t, schedulerId>>(),
+      std::make_unique<
+          compactor::ShuffleBasedCompactorFactory<RowType, bool, schedulerId>>(
+          myId,
+          partnerId,
+          std::make_unique<shuffler::PermuteBasedShufflerFactory<
+              typename util::SecBatchType<std::pair<RowType, bool>,
+                                          schedulerId>::type>>(
+              myId,
+              partnerId,
+              std::make_unique<permuter::AsWaksmanPermuterFactory<
+                  std::pair<RowType, bool>,
+                  schedulerId>>(myId, partnerId),
+              std::make_unique<engine::util::AesPrgFactory>())));
+}
+
+template <int schedulerId>
+std::tuple<std::vector<uint32_t>, std::vector<uint32_t>, std::vector<bool>>
+task(
+    std::unique_ptr<GroupBySumFactory<schedulerId>> factory,
+    const std::vector<uint32_t>& keys,
+    const std::vector<uint32_t>& values,
+    bool shouldRevealSize) {
+  auto groupBySum = factory->create();
+  auto [sumKeys, sums, labels] = groupBySum->groupBySum(
+      util::MpcAdapters<uint32_t, schedulerId>::processSecretInputs(keys, 0),
+      util::MpcAdapters<uint32_t, schedulerId>::processSecretInputs(values, 1),
+      keys.size(),
+      shouldRevealSize);
+  return {
+      util::MpcAdapters<uint32_t, schedulerId>::openToParty(sumKeys, 0),
+      util::MpcAdapters<uint32_t, schedulerId>::openToParty(sums, 0),
+      util::MpcAdapters<bool, schedulerId>::openToParty(labels, 0)};
+}
+
+void groupBySumTest(size_t size, uint32_t keyRange, bool shouldRevealSize) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint32_t> keyDist(0, keyRange - 1);
+  std::uniform_int_distribution<uint32_t> valueDist;
+  std::vector<uint32_t> keys(size);
+  std::vector<uint32_t> values(size);
+  std::map<uint32_t, uint32_t> expectedSums;
+  for (size_t i = 0; i < size; i++) {
+    keys[i] = keyDist(e);
+    values[i] = valueDist(e);
+    expectedSums[keys.at(i)] += values.at(i);
+  }
+
+  auto future0 = std::async(
+      task<0>,
+      createGroupBySumFactory<0>(0, 1),
+      keys,
+      values,
+      shouldRevealSize);
+  auto future1 = std::async(
+      task<1>,
+      createGroupBySumFactory<1>(1, 0),
+      keys,
+      values,
+      shouldRevealSize);
+  auto [rstKeys, rstSums, rstLabels] = future0.get();
+  future1.get();
+
+  if (shouldRevealSize) {
+    ASSERT_EQ(rstKeys.size(), expectedSums.size());
+  } else {
+    ASSERT_EQ(rstKeys.size(), size);
+  }
+  std::map<uint32_t, uint32_t> sums;
+  for (size_t i = 0; i < rstKeys.size(); i++) {
+    if (rstLabels.at(i)) {
+      EXPECT_EQ(sums.count(rstKeys.at(i)), 0);
+      sums[rstKeys.at(i)] = rstSums.at(i);
+    } else {
+      EXPECT_EQ(rstKeys.at(i), 0);
+      EXPECT_EQ(rstSums.at(i), 0);
+    }
+  }
+  EXPECT_EQ(sums, expectedSums);
+}
+
+class GroupBySumTestFixture
+    : public ::testing::TestWithParam<std::tuple<size_t, uint32_t, bool>> {};
+
+TEST_P(GroupBySumTestFixture, testSortBasedGroupBySum) {
+  auto [size, keyRange, shouldRevealSize] = GetParam();
+  groupBySumTest(size, keyRange, shouldRevealSize);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    GroupBySumTest,
+    GroupBySumTestFixture,
+    ::testing::Values(
+        std::make_tuple(1, 10, true),
+        std::make_tuple(2, 1, false),
+        std::make_tuple(13, 4, true),
+        std::make_tuple(64, 1, true),
+        std::make_tuple(100, 16, false),
+        std::make_tuple(200, 0xFFFFFFFF, true),
+        std::make_tuple(257, 30, true)));
+
+} // namespace fbpcf::mpc_std_lib::group_by
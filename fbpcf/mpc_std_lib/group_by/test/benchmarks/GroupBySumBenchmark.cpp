@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <random>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/mpc_std_lib/compactor/ShuffleBasedCompactorFactory.h"
+#include "fbpcf/mpc_std_lib/group_by/SortBasedGroupBySumFactory.h"
+#include "fbpcf/mpc_std_lib/oram/WriteOnlyOramFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/PermuteBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/BitonicSorterFactory.h"
+#include "fbpcf/mpc_std_lib/util/test/util.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::mpc_std_lib::group_by {
+
+const size_t kRows = 4096;
+
+template <int schedulerId>
+using GroupBySum = IGroupBySum<
+    typename util::SecBatchType<uint32_t, schedulerId>::type,
+    typename util::SecBatchType<uint32_t, schedulerId>::type,
+    typename util::SecBatchType<bool, schedulerId>::type>;
+
+class SortBasedGroupBySumBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  explicit SortBasedGroupBySumBenchmark(uint32_t keyRange)
+      : keyRange_(keyRange) {}
+
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint32_t> keyDist(0, keyRange_ - 1);
+    std::uniform_int_distribution<uint32_t> valueDist;
+    keys_ = std::vector<uint32_t>(kRows);
+    values_ = std::vector<uint32_t>(kRows);
+    for (size_t i = 0; i < kRows; i++) {
+      keys_[i] = keyDist(e);
+      values_[i] = valueDist(e);
+    }
+  }
+
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    groupBySum0_ = createFactory<0>(0, 1)->create();
+  }
+
+  void runSender() override {
+    groupBySum0_->groupBySum(
+        util::MpcAdapters<uint32_t, 0>::processSecretInputs(keys_, 0),
+        util::MpcAdapters<uint32_t, 0>::processSecretInputs(values_, 0),
+        kRows,
+        true);
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    groupBySum1_ = createFactory<1>(1, 0)->create();
+  }
+
+  void runReceiver() override {
+    groupBySum1_->groupBySum(
+        util::MpcAdapters<uint32_t, 1>::processSecretInputs(keys_, 0),
+        util::MpcAdapters<uint32_t, 1>::processSecretInputs(values_, 0),
+        kRows,
+        true);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+ private:
+  using RowType = std::pair<uint32_t, uint32_t>;
+
+  template <int schedulerId>
+  std::unique_ptr<SortBasedGroupBySumFactory<uint32_t, uint32_t, schedulerId>>
+  createFactory(int myId, int partnerId) {
+    return std::make_unique<
+        SortBasedGroupBySumFactory<uint32_t, uint32_t, schedulerId>>(
+        myId,
+        partnerId,
+        std::make_unique<
+            sorter::BitonicSorterFactory<uint32_t, uint32_t, schedulerId>>(),
+        std::make_unique<compactor::ShuffleBasedCompactorFactory<
+            RowType,
+            bool,
+            schedulerId>>(
+            myId,
+            partnerId,
+            std::make_unique<shuffler::PermuteBasedShufflerFactory<
+                typename util::SecBatchType<std::pair<RowType, bool>,
+                                            schedulerId>::type>>(
+                myId,
+                partnerId,
+                std::make_unique<permuter::AsWaksmanPermuterFactory<
+                    std::pair<RowType, bool>,
+                    schedulerId>>(myId, partnerId),
+                std::make_unique<engine::util::AesPrgFactory>())));
+  }
+
+  uint32_t keyRange_;
+  std::vector<uint32_t> keys_;
+  std::vector<uint32_t> values_;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::unique_ptr<GroupBySum<0>> groupBySum0_;
+  std::unique_ptr<GroupBySum<1>> groupBySum1_;
+};
+
+// the same aggregation with one write-only ORAM slot per key, as in Private
+// Lift. Reading the sums back is not included.
+class WriteOnlyOramGroupBySumBenchmark
+    : public engine::util::NetworkedBenchmark {
+ public:
+  explicit WriteOnlyOramGroupBySumBenchmark(uint32_t keyRange)
+      : keyRange_(keyRange) {}
+
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    auto [input0, input1, _] =
+        util::generateRandomValuesToAdd<uint32_t>(keyRange_, kRows);
+    input0_ = input0;
+    input1_ = input1;
+  }
+
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    oram0_ = oram::getSecureWriteOnlyOramFactory<uint32_t, kIndicatorWidth, 0>(
+                 true, 0, 1, *agentFactory0_)
+                 ->create(keyRange_);
+  }
+
+  void runSender() override {
+    oram0_->obliviousAddBatch(input0_.indexShares, input0_.valueShares);
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    oram1_ = oram::getSecureWriteOnlyOramFactory<uint32_t, kIndicatorWidth, 1>(
+                 false, 0, 1, *agentFactory1_)
+                 ->create(keyRange_);
+  }
+
+  void runReceiver() override {
+    oram1_->obliviousAddBatch(input1_.indexShares, input1_.valueShares);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto schedulerTraffic =
+        scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+    auto oramTraffic = oram0_->getTrafficStatistics();
+    return {
+        schedulerTraffic.first + oramTraffic.first,
+        schedulerTraffic.second + oramTraffic.second};
+  }
+
+ private:
+  static const int8_t kIndicatorWidth = 16;
+
+  uint32_t keyRange_;
+  util::WritingType input0_;
+  util::WritingType input1_;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::unique_ptr<oram::IWriteOnlyOram<uint32_t>> oram0_;
+  std::unique_ptr<oram::IWriteOnlyOram<uint32_t>> oram1_;
+};
+
+BENCHMARK_COUNTERS(SortBasedGroupBySum_1K_Keys_Benchmark, counters) {
+  SortBasedGroupBySumBenchmark benchmark(1 << 10);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(SortBasedGroupBySum_16K_Keys_Benchmark, counters) {
+  SortBasedGroupBySumBenchmark benchmark(1 << 14);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(WriteOnlyOramGroupBySum_1K_Keys_Benchmark, counters) {
+  WriteOnlyOramGroupBySumBenchmark benchmark(1 << 10);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(WriteOnlyOramGroupBySum_16K_Keys_Benchmark, counters) {
+  WriteOnlyOramGroupBySumBenchmark benchmark(1 << 14);
+  benchmark.runBenchmark(counters);
+}
+} // namespace fbpcf::mpc_std_lib::group_by
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOram.h"
+#include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * This is an implementation of Floram from paper 'Scaling ORAM for Secure
+ * Computation' by Jack Doerner and abhi shelat. Link to the paper:
+ * https://eprint.iacr.org/2017/827
+ *
+ * The memory is kept twice: each party holds XOR shares of it in a write-only
+ * memory, and both parties hold the same read-only copy, masked with the PRFs
+ * of both parties' keys. A read expands a single point array from the secret
+ * index to pick the masked value locally and only evaluates the two PRFs (AES)
+ * inside MPC to unmask it. A write applies the difference to the write-only
+ * memory locally with the same single point array, and remembers it in a
+ * stash that the following reads scan linearly. Once the stash is full, the
+ * read-only copy is refreshed from the write-only memory with new keys, which
+ * takes O(size) local AES and communication.
+ * Values are at most 128 bits.
+ */
+template <int schedulerId>
+class Floram final : public IReadWriteOram {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+  using ArrayType =
+      std::vector<std::pair<std::vector<bool>, std::vector<__m128i>>>;
+
+ public:
+  Floram(
+      bool amIParty0,
+      size_t size,
+      size_t width,
+      std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent,
+      std::unique_ptr<ISinglePointArrayGenerator> generator,
+      size_t stashCapacity);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::vector<bool>> obliviousReadBatch(
+      const std::vector<std::vector<bool>>& indexShares) override;
+
+  /**
+   * @inherit doc
+   */
+  void obliviousWriteBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares,
+      const std::vector<bool>& conditionShares) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    auto generatorTraffic = generator_->getTrafficStatistics();
+    auto oramTraffic = agent_->getTrafficStatistics();
+    return {
+        generatorTraffic.first + oramTraffic.first,
+        generatorTraffic.second + oramTraffic.second};
+  }
+
+  /**
+   * The stash capacity that balances the cost of refreshing against the cost
+   * of scanning the stash.
+   */
+  static size_t getDefaultStashCapacity(size_t size) {
+    return std::max<size_t>(1, std::ceil(std::sqrt(size)));
+  }
+
+ private:
+  // this party's shares of the values at the indexes, given the single point
+  // arrays of the indexes.
+  std::vector<std::vector<bool>> readWithArrays(
+      const std::vector<std::vector<bool>>& indexShares,
+      const ArrayType& arrays) const;
+
+  // this party's shares of PRF_k0(index) ^ PRF_k1(index).
+  std::vector<std::vector<bool>> generatePads(
+      const std::vector<std::vector<bool>>& indexShares) const;
+
+  // rebuild the read-only memory from the write-only memory with a new key.
+  void refresh();
+
+  // send this party's blocks and receive the other party's, only the first
+  // bytesPerBlock bytes of each block are transmitted.
+  std::vector<__m128i> exchange(
+      const std::vector<__m128i>& src,
+      size_t bytesPerBlock);
+
+  void checkIndexShares(
+      const std::vector<std::vector<bool>>& indexShares) const;
+
+  // The PRF input for an index is the index in the lower 64 bits of a block.
+  // The position of a block bit in the AES circuit, which takes the bytes in
+  // memory order, each from its most significant bit.
+  static size_t getAesPosition(size_t bit) {
+    return 8 * (bit / 8) + 7 - bit % 8;
+  }
+
+  bool amIParty0_;
+  size_t size_;
+  size_t width_;
+  size_t indexWidth_;
+  size_t stashCapacity_;
+  __m128i widthMask_;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent_;
+  std::unique_ptr<ISinglePointArrayGenerator> generator_;
+
+  // this party's shares of the memory.
+  std::vector<__m128i> writeOnlyMemory_;
+  // the memory at the last refresh, masked with both parties' PRFs. It is
+  // empty before the first access.
+  std::vector<__m128i> readOnlyMemory_;
+  // this party's current key, expanded as the input of the AES circuit.
+  std::vector<bool> expandedKey_;
+
+  // this party's shares of the indexes and the differences written since the
+  // last refresh, one batch for each bit.
+  std::vector<std::vector<bool>> stashIndexShares_;
+  std::vector<std::vector<bool>> stashValueShares_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
+
+#include "fbpcf/mpc_std_lib/oram/Floram_impl.h"
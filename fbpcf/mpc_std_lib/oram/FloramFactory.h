@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/mpc_std_lib/oram/Floram.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGeneratorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/ObliviousDeltaCalculatorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/SinglePointArrayGeneratorFactory.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+template <int schedulerId>
+class FloramFactory final : public IReadWriteOramFactory {
+ public:
+  /**
+   * @param width the number of bits of each value.
+   * @param stashCapacity how many writes to keep in the stash before
+   * refreshing, 0 means the default capacity for the size of the oram.
+   */
+  FloramFactory(
+      bool amIParty0,
+      int32_t peerId,
+      engine::communication::IPartyCommunicationAgentFactory& factory,
+      std::unique_ptr<ISinglePointArrayGeneratorFactory>
+          singlePointArrayFactory,
+      size_t width,
+      size_t stashCapacity = 0)
+      : amIParty0_(amIParty0),
+        peerId_(peerId),
+        factory_(factory),
+        singlePointArrayFactory_(std::move(singlePointArrayFactory)),
+        width_(width),
+        stashCapacity_(stashCapacity) {}
+
+  std::unique_ptr<IReadWriteOram> create(size_t size) override {
+    return std::make_unique<Floram<schedulerId>>(
+        amIParty0_,
+        size,
+        width_,
+        factory_.create(peerId_, "floram_traffic"),
+        singlePointArrayFactory_->create(),
+        stashCapacity_ == 0 ? Floram<schedulerId>::getDefaultStashCapacity(size)
+                            : stashCapacity_);
+  }
+
+ private:
+  bool amIParty0_;
+  int32_t peerId_;
+  engine::communication::IPartyCommunicationAgentFactory& factory_;
+  std::unique_ptr<ISinglePointArrayGeneratorFactory> singlePointArrayFactory_;
+  size_t width_;
+  size_t stashCapacity_;
+};
+
+template <int schedulerId>
+std::unique_ptr<IReadWriteOramFactory> getSecureFloramFactory(
+    bool amIParty0,
+    int32_t party0Id,
+    int32_t party1Id,
+    engine::communication::IPartyCommunicationAgentFactory& factory,
+    size_t width,
+    size_t stashCapacity = 0) {
+  return std::make_unique<FloramFactory<schedulerId>>(
+      amIParty0,
+      amIParty0 ? party1Id : party0Id,
+      factory,
+      std::make_unique<SinglePointArrayGeneratorFactory>(
+          amIParty0,
+          std::make_unique<ObliviousDeltaCalculatorFactory<schedulerId>>(
+              amIParty0, party0Id, party1Id)),
+      width,
+      stashCapacity);
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "fbpcf/engine/util/aes.h"
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/mpc_std_lib/oram/LinearReadWriteOram.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+template <int schedulerId>
+Floram<schedulerId>::Floram(
+    bool amIParty0,
+    size_t size,
+    size_t width,
+    std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent,
+    std::unique_ptr<ISinglePointArrayGenerator> generator,
+    size_t stashCapacity)
+    : amIParty0_(amIParty0),
+      size_(size),
+      width_(width),
+      indexWidth_(size < 2 ? 1 : std::ceil(std::log2(size))),
+      stashCapacity_(stashCapacity),
+      agent_(std::move(agent)),
+      generator_(std::move(generator)),
+      writeOnlyMemory_(size, _mm_set_epi64x(0, 0)),
+      stashIndexShares_(indexWidth_),
+      stashValueShares_(width) {
+  if (size == 0 || width == 0 || width > 128) {
+    throw std::invalid_argument(
+        "ORAM size can't be 0 and width must be between 1 and 128.");
+  }
+  if (stashCapacity == 0) {
+    throw std::invalid_argument("Stash capacity can't be 0.");
+  }
+  uint64_t low = width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+  uint64_t high = 0;
+  if (width == 128) {
+    high = ~uint64_t(0);
+  } else if (width > 64) {
+    high = (uint64_t(1) << (width - 64)) - 1;
+  }
+  widthMask_ = _mm_set_epi64x(high, low);
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> Floram<schedulerId>::obliviousReadBatch(
+    const std::vector<std::vector<bool>>& indexShares) {
+  checkIndexShares(indexShares);
+  if (readOnlyMemory_.empty()) {
+    refresh();
+  }
+  return readWithArrays(
+      indexShares, generator_->generateSinglePointArrays(indexShares, size_));
+}
+
+template <int schedulerId>
+void Floram<schedulerId>::obliviousWriteBatch(
+    const std::vector<std::vector<bool>>& indexShares,
+    const std::vector<std::vector<bool>>& valueShares,
+    const std::vector<bool>& conditionShares) {
+  checkIndexShares(indexShares);
+  auto batchSize = indexShares.at(0).size();
+  if (valueShares.size() != width_) {
+    throw std::runtime_error("Unexpected value width.");
+  }
+  for (auto& item : valueShares) {
+    if (item.size() != batchSize) {
+      throw std::runtime_error("Input size is inconsistent!");
+    }
+  }
+  if (conditionShares.size() != batchSize) {
+    throw std::runtime_error("Input size is inconsistent!");
+  }
+  if (readOnlyMemory_.empty()) {
+    refresh();
+  }
+
+  auto arrays = generator_->generateSinglePointArrays(indexShares, size_);
+  auto oldValueShares = readWithArrays(indexShares, arrays);
+
+  // the difference to apply is (new value ^ old value) if the condition holds
+  // and 0 otherwise.
+  SecBit condition((typename SecBit::ExtractedBit(conditionShares)));
+  std::vector<SecBit> differences;
+  differences.reserve(width_);
+  for (size_t k = 0; k < width_; k++) {
+    std::vector<bool> shares(batchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      shares[i] = valueShares.at(k).at(i) ^ oldValueShares.at(k).at(i);
+    }
+    differences.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+  }
+  auto masked = condition & differences;
+  std::vector<std::vector<bool>> differenceShares(
+      128, std::vector<bool>(batchSize, false));
+  for (size_t k = 0; k < width_; k++) {
+    differenceShares[k] = masked.at(k).extractBit().getValue();
+  }
+  auto differenceBlocks = util::convertFromBits(differenceShares);
+
+  // The keys of the two parties' single point arrays only differ at the
+  // index, so the XOR of all the keys is a share of that difference. Opening
+  // it XORed with the difference to write gives a correction that turns the
+  // keys into shares of the difference at the index and of 0 elsewhere.
+  std::vector<__m128i> corrections(batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    auto sum = _mm_set_epi64x(0, 0);
+    for (auto& key : arrays.at(i).second) {
+      sum = _mm_xor_si128(sum, key);
+    }
+    corrections[i] = _mm_and_si128(
+        _mm_xor_si128(sum, differenceBlocks.at(i)), widthMask_);
+  }
+  auto otherCorrections = exchange(corrections, (width_ + 7) / 8);
+  for (size_t i = 0; i < batchSize; i++) {
+    auto correction =
+        _mm_xor_si128(corrections.at(i), otherCorrections.at(i));
+    auto& [indicators, keys] = arrays.at(i);
+    for (size_t j = 0; j < size_; j++) {
+      auto change = indicators.at(j) ? _mm_xor_si128(keys.at(j), correction)
+                                     : keys.at(j);
+      writeOnlyMemory_[j] = _mm_xor_si128(
+          writeOnlyMemory_.at(j), _mm_and_si128(change, widthMask_));
+    }
+  }
+
+  // the read-only memory is stale at these indexes until the next refresh.
+  for (size_t k = 0; k < indexWidth_; k++) {
+    stashIndexShares_[k].insert(
+        stashIndexShares_[k].end(),
+        indexShares.at(k).begin(),
+        indexShares.at(k).end());
+  }
+  for (size_t k = 0; k < width_; k++) {
+    stashValueShares_[k].insert(
+        stashValueShares_[k].end(),
+        differenceShares.at(k).begin(),
+        differenceShares.at(k).end());
+  }
+  if (stashIndexShares_.at(0).size() >= stashCapacity_) {
+    refresh();
+  }
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> Floram<schedulerId>::readWithArrays(
+    const std::vector<std::vector<bool>>& indexShares,
+    const ArrayType& arrays) const {
+  auto batchSize = indexShares.at(0).size();
+
+  // the indicators are shares of the single point at the index, so the sum of
+  // the entries they pick is a share of the masked value at the index.
+  std::vector<__m128i> maskedValueShares(batchSize, _mm_set_epi64x(0, 0));
+  for (size_t i = 0; i < batchSize; i++) {
+    auto& indicators = arrays.at(i).first;
+    for (size_t j = 0; j < size_; j++) {
+      if (indicators.at(j)) {
+        maskedValueShares[i] =
+            _mm_xor_si128(maskedValueShares.at(i), readOnlyMemory_.at(j));
+      }
+    }
+  }
+  auto rst = util::convertToBits(maskedValueShares);
+  rst.erase(rst.begin() + width_, rst.end());
+
+  auto pads = generatePads(indexShares);
+  auto stashed = LinearReadWriteOram<schedulerId>::lookUpBatch(
+      indexShares, stashIndexShares_, stashValueShares_);
+  for (size_t k = 0; k < width_; k++) {
+    for (size_t i = 0; i < batchSize; i++) {
+      rst[k][i] = rst[k][i] ^ pads.at(k).at(i) ^ stashed.at(k).at(i);
+    }
+  }
+  return rst;
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> Floram<schedulerId>::generatePads(
+    const std::vector<std::vector<bool>>& indexShares) const {
+  auto batchSize = indexShares.at(0).size();
+
+  // Both PRFs are evaluated in a single batch, the first half of it with
+  // party 0's key and the second half with party 1's key.
+  std::vector<SecBit> plaintext(
+      128,
+      SecBit(typename SecBit::ExtractedBit(
+          std::vector<bool>(2 * batchSize, false))));
+  for (size_t k = 0; k < indexWidth_; k++) {
+    std::vector<bool> shares(indexShares.at(k));
+    shares.insert(
+        shares.end(), indexShares.at(k).begin(), indexShares.at(k).end());
+    plaintext[getAesPosition(k)] =
+        SecBit(typename SecBit::ExtractedBit(std::move(shares)));
+  }
+  std::vector<SecBit> key;
+  key.reserve(expandedKey_.size());
+  for (auto bit : expandedKey_) {
+    std::vector<bool> shares(2 * batchSize, false);
+    std::fill_n(
+        shares.begin() + (amIParty0_ ? 0 : batchSize), batchSize, bit);
+    key.push_back(SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+  }
+  auto ciphertext = aes_circuit::BatchedAesCircuit<SecBit>(2 * batchSize)
+                        .encrypt(plaintext, key);
+
+  std::vector<std::vector<bool>> rst(width_, std::vector<bool>(batchSize));
+  for (size_t k = 0; k < width_; k++) {
+    auto shares = ciphertext.at(getAesPosition(k)).extractBit().getValue();
+    for (size_t i = 0; i < batchSize; i++) {
+      rst[k][i] = shares.at(i) ^ shares.at(batchSize + i);
+    }
+  }
+  return rst;
+}
+
+template <int schedulerId>
+void Floram<schedulerId>::refresh() {
+  auto key = engine::util::getRandomM128iFromSystemNoise();
+  std::vector<__m128i> maskedMemory(size_);
+  for (size_t j = 0; j < size_; j++) {
+    maskedMemory[j] = _mm_set_epi64x(0, j);
+  }
+  engine::util::Aes(key).encryptInPlace(maskedMemory);
+  for (size_t j = 0; j < size_; j++) {
+    maskedMemory[j] = _mm_and_si128(
+        _mm_xor_si128(maskedMemory.at(j), writeOnlyMemory_.at(j)),
+        widthMask_);
+  }
+  auto otherMaskedMemory = exchange(maskedMemory, (width_ + 7) / 8);
+  readOnlyMemory_.resize(size_);
+  for (size_t j = 0; j < size_; j++) {
+    readOnlyMemory_[j] = _mm_and_si128(
+        _mm_xor_si128(maskedMemory.at(j), otherMaskedMemory.at(j)),
+        widthMask_);
+  }
+
+  auto roundKeys = engine::util::Aes::expandEncryptionKey(key);
+  expandedKey_.resize(
+      aes_circuit::IAesCircuit<SecBit>::kExpandedKeyWidth, false);
+  for (size_t r = 0; r < roundKeys.size(); r++) {
+    uint64_t words[2];
+    std::memcpy(words, &roundKeys.at(r), sizeof(words));
+    for (size_t k = 0; k < 128; k++) {
+      expandedKey_[128 * r + getAesPosition(k)] =
+          (words[k / 64] >> (k % 64)) & 1;
+    }
+  }
+
+  for (auto& item : stashIndexShares_) {
+    item.clear();
+  }
+  for (auto& item : stashValueShares_) {
+    item.clear();
+  }
+}
+
+template <int schedulerId>
+std::vector<__m128i> Floram<schedulerId>::exchange(
+    const std::vector<__m128i>& src,
+    size_t bytesPerBlock) {
+  std::vector<unsigned char> buffer(src.size() * bytesPerBlock);
+  for (size_t i = 0; i < src.size(); i++) {
+    std::memcpy(buffer.data() + i * bytesPerBlock, &src.at(i), bytesPerBlock);
+  }
+  // party 0 sends first so that neither party blocks on a full channel.
+  if (amIParty0_) {
+    agent_->send(buffer);
+    buffer = agent_->receive(buffer.size());
+  } else {
+    auto received = agent_->receive(buffer.size());
+    agent_->send(buffer);
+    buffer = std::move(received);
+  }
+  std::vector<__m128i> rst(src.size(), _mm_set_epi64x(0, 0));
+  for (size_t i = 0; i < src.size(); i++) {
+    std::memcpy(&rst.at(i), buffer.data() + i * bytesPerBlock, bytesPerBlock);
+  }
+  return rst;
+}
+
+template <int schedulerId>
+void Floram<schedulerId>::checkIndexShares(
+    const std::vector<std::vector<bool>>& indexShares) const {
+  if (indexShares.size() != indexWidth_) {
+    throw std::runtime_error("Unexpected index width.");
+  }
+  auto batchSize = indexShares.at(0).size();
+  if (batchSize == 0) {
+    throw std::runtime_error("Input cannot be empty");
+  }
+  for (auto& item : indexShares) {
+    if (item.size() != batchSize) {
+      throw std::runtime_error("Input size is inconsistent!");
+    }
+  }
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/*
+ * A read/write oram between 2 parties. Both the indexes and the values are
+ * XOR-secret-shared and every value has the same number of bits, which is
+ * fixed when the oram is created. All the values are 0 initially.
+ * The indexes must be smaller than the size of the oram and are represented
+ * by max(1, ceil(log2(size))) bits.
+ */
+class IReadWriteOram {
+ public:
+  virtual ~IReadWriteOram() = default;
+
+  /**
+   * Obliviously read a batch of XOR-secret-shared positions.
+   * @param indexShares this party's shares of the indexes, from share batches
+   * of less significant to share batches of more significant;
+   * @return this party's shares of the values, from share batches of less
+   * significant to share batches of more significant;
+   */
+  virtual std::vector<std::vector<bool>> obliviousReadBatch(
+      const std::vector<std::vector<bool>>& indexShares) = 0;
+
+  /**
+   * Obliviously overwrite a batch of XOR-secret-shared positions. The indexes
+   * within a batch must be distinct.
+   * @param indexShares this party's shares of the indexes, from share batches
+   * of less significant to share batches of more significant;
+   * @param valueShares this party's shares of the new values, from share
+   * batches of less significant to share batches of more significant;
+   * @param conditionShares this party's shares of whether to write, a
+   * position keeps its value if the condition is 0.
+   */
+  virtual void obliviousWriteBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares,
+      const std::vector<bool>& conditionShares) = 0;
+
+  /**
+   * Get the total amount of traffic transmitted.
+   * @return a pair of (sent, received) data in bytes.
+   */
+  virtual std::pair<uint64_t, uint64_t> getTrafficStatistics() const = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOram.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * A linear read/write ORAM compares the secret indexes with every position and
+ * obliviously picks (or updates) the one that matches. Its cost grows linearly
+ * with the size of the ORAM and the batch size, it is only competitive for
+ * very small ORAMs.
+ */
+template <int schedulerId>
+class LinearReadWriteOram final : public IReadWriteOram {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+ public:
+  LinearReadWriteOram(bool amIParty0, size_t size, size_t width);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::vector<bool>> obliviousReadBatch(
+      const std::vector<std::vector<bool>>& indexShares) override;
+
+  /**
+   * @inherit doc
+   */
+  void obliviousWriteBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares,
+      const std::vector<bool>& conditionShares) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    // this object itself doesn't generate any traffic. All the traffic are
+    // outsourced into the mpc game.
+    return {0, 0};
+  }
+
+  /**
+   * Look up a batch of secret indexes among a list of secret (index, value)
+   * candidates. Each output is the XOR of the values of all the candidates
+   * whose index matches.
+   * @param indexShares this party's shares of the indexes to look up.
+   * @param candidateIndexShares this party's shares of the candidate indexes.
+   * @param candidateValueShares this party's shares of the candidate values.
+   * @return this party's shares of the values found.
+   */
+  static std::vector<std::vector<bool>> lookUpBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& candidateIndexShares,
+      const std::vector<std::vector<bool>>& candidateValueShares);
+
+  /**
+   * Compare two batches of secret indexes element by element.
+   * @return whether the indexes are equal, inside MPC.
+   */
+  static SecBit equalBatch(
+      const std::vector<std::vector<bool>>& leftShares,
+      const std::vector<std::vector<bool>>& rightShares);
+
+ private:
+  // this party's shares of the public indexes of every position.
+  std::vector<std::vector<bool>> getPositionShares() const;
+
+  void checkIndexShares(
+      const std::vector<std::vector<bool>>& indexShares) const;
+
+  bool amIParty0_;
+  size_t size_;
+  size_t width_;
+  size_t indexWidth_;
+
+  // this party's shares of the memory, one batch for each bit.
+  std::vector<std::vector<bool>> memory_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
+
+#include "fbpcf/mpc_std_lib/oram/LinearReadWriteOram_impl.h"
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/LinearReadWriteOram.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+template <int schedulerId>
+class LinearReadWriteOramFactory final : public IReadWriteOramFactory {
+ public:
+  /**
+   * @param width the number of bits of each value.
+   */
+  LinearReadWriteOramFactory(bool amIParty0, size_t width)
+      : amIParty0_(amIParty0), width_(width) {}
+
+  std::unique_ptr<IReadWriteOram> create(size_t size) override {
+    return std::make_unique<LinearReadWriteOram<schedulerId>>(
+        amIParty0_, size, width_);
+  }
+
+ private:
+  bool amIParty0_;
+  size_t width_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::oram {
+
+template <int schedulerId>
+LinearReadWriteOram<schedulerId>::LinearReadWriteOram(
+    bool amIParty0,
+    size_t size,
+    size_t width)
+    : amIParty0_(amIParty0),
+      size_(size),
+      width_(width),
+      indexWidth_(size < 2 ? 1 : std::ceil(std::log2(size))),
+      memory_(width, std::vector<bool>(size, false)) {
+  if (size == 0 || width == 0) {
+    throw std::invalid_argument("ORAM size and width can't be 0.");
+  }
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>>
+LinearReadWriteOram<schedulerId>::obliviousReadBatch(
+    const std::vector<std::vector<bool>>& indexShares) {
+  checkIndexShares(indexShares);
+  return lookUpBatch(indexShares, getPositionShares(), memory_);
+}
+
+template <int schedulerId>
+void LinearReadWriteOram<schedulerId>::obliviousWriteBatch(
+    const std::vector<std::vector<bool>>& indexShares,
+    const std::vector<std::vector<bool>>& valueShares,
+    const std::vector<bool>& conditionShares) {
+  checkIndexShares(indexShares);
+  auto batchSize = indexShares.at(0).size();
+  if (valueShares.size() != width_) {
+    throw std::runtime_error("Unexpected value width.");
+  }
+  for (auto& item : valueShares) {
+    if (item.size() != batchSize) {
+      throw std::runtime_error("Input size is inconsistent!");
+    }
+  }
+  if (conditionShares.size() != batchSize) {
+    throw std::runtime_error("Input size is inconsistent!");
+  }
+
+  // the (i * size_ + j)-th element of the batch compares the i-th index with
+  // position j.
+  auto positionShares = getPositionShares();
+  std::vector<std::vector<bool>> left(
+      indexWidth_, std::vector<bool>(batchSize * size_));
+  std::vector<std::vector<bool>> right(
+      indexWidth_, std::vector<bool>(batchSize * size_));
+  for (size_t k = 0; k < indexWidth_; k++) {
+    for (size_t i = 0; i < batchSize; i++) {
+      for (size_t j = 0; j < size_; j++) {
+        left[k][i * size_ + j] = indexShares.at(k).at(i);
+        right[k][i * size_ + j] = positionShares.at(k).at(j);
+      }
+    }
+  }
+  std::vector<bool> conditions(batchSize * size_);
+  for (size_t i = 0; i < batchSize; i++) {
+    for (size_t j = 0; j < size_; j++) {
+      conditions[i * size_ + j] = conditionShares.at(i);
+    }
+  }
+  auto enabled = equalBatch(left, right) &
+      SecBit(typename SecBit::ExtractedBit(std::move(conditions)));
+
+  // a matching position is changed by the difference between the new value
+  // and its current value.
+  std::vector<SecBit> differences;
+  differences.reserve(width_);
+  for (size_t k = 0; k < width_; k++) {
+    std::vector<bool> shares(batchSize * size_);
+    for (size_t i = 0; i < batchSize; i++) {
+      for (size_t j = 0; j < size_; j++) {
+        shares[i * size_ + j] =
+            valueShares.at(k).at(i) ^ memory_.at(k).at(j);
+      }
+    }
+    differences.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+  }
+  auto changes = enabled & differences;
+  for (size_t k = 0; k < width_; k++) {
+    auto shares = changes.at(k).extractBit().getValue();
+    for (size_t i = 0; i < batchSize; i++) {
+      for (size_t j = 0; j < size_; j++) {
+        memory_[k][j] = memory_[k][j] ^ shares.at(i * size_ + j);
+      }
+    }
+  }
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> LinearReadWriteOram<schedulerId>::lookUpBatch(
+    const std::vector<std::vector<bool>>& indexShares,
+    const std::vector<std::vector<bool>>& candidateIndexShares,
+    const std::vector<std::vector<bool>>& candidateValueShares) {
+  auto indexWidth = indexShares.size();
+  auto batchSize = indexShares.at(0).size();
+  auto width = candidateValueShares.size();
+  auto candidates = candidateIndexShares.at(0).size();
+  std::vector<std::vector<bool>> rst(width, std::vector<bool>(batchSize));
+  if (candidates == 0) {
+    return rst;
+  }
+
+  // the (i * candidates + j)-th element of the batch compares the i-th index
+  // with the j-th candidate.
+  std::vector<std::vector<bool>> left(
+      indexWidth, std::vector<bool>(batchSize * candidates));
+  std::vector<std::vector<bool>> right(
+      indexWidth, std::vector<bool>(batchSize * candidates));
+  for (size_t k = 0; k < indexWidth; k++) {
+    for (size_t i = 0; i < batchSize; i++) {
+      for (size_t j = 0; j < candidates; j++) {
+        left[k][i * candidates + j] = indexShares.at(k).at(i);
+        right[k][i * candidates + j] = candidateIndexShares.at(k).at(j);
+      }
+    }
+  }
+  auto matched = equalBatch(left, right);
+
+  std::vector<SecBit> values;
+  values.reserve(width);
+  for (size_t k = 0; k < width; k++) {
+    std::vector<bool> shares(batchSize * candidates);
+    for (size_t i = 0; i < batchSize; i++) {
+      for (size_t j = 0; j < candidates; j++) {
+        shares[i * candidates + j] = candidateValueShares.at(k).at(j);
+      }
+    }
+    values.push_back(SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+  }
+  auto picked = matched & values;
+
+  // XOR is free on shares, so the sums are taken locally.
+  for (size_t k = 0; k < width; k++) {
+    auto shares = picked.at(k).extractBit().getValue();
+    for (size_t i = 0; i < batchSize; i++) {
+      bool sum = false;
+      for (size_t j = 0; j < candidates; j++) {
+        sum ^= shares.at(i * candidates + j);
+      }
+      rst[k][i] = sum;
+    }
+  }
+  return rst;
+}
+
+template <int schedulerId>
+typename LinearReadWriteOram<schedulerId>::SecBit
+LinearReadWriteOram<schedulerId>::equalBatch(
+    const std::vector<std::vector<bool>>& leftShares,
+    const std::vector<std::vector<bool>>& rightShares) {
+  std::vector<SecBit> bits;
+  bits.reserve(leftShares.size());
+  for (size_t k = 0; k < leftShares.size(); k++) {
+    auto batchSize = leftShares.at(k).size();
+    std::vector<bool> differenceShares(batchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      differenceShares[i] =
+          leftShares.at(k).at(i) ^ rightShares.at(k).at(i);
+    }
+    bits.push_back(
+        !SecBit(typename SecBit::ExtractedBit(std::move(differenceShares))));
+  }
+  // AND the bits pairwise to keep the depth logarithmic in the width.
+  while (bits.size() > 1) {
+    std::vector<SecBit> next;
+    next.reserve((bits.size() + 1) / 2);
+    for (size_t k = 0; k + 1 < bits.size(); k += 2) {
+      next.push_back(bits.at(k) & bits.at(k + 1));
+    }
+    if (bits.size() % 2 == 1) {
+      next.push_back(std::move(bits.back()));
+    }
+    bits = std::move(next);
+  }
+  return bits.at(0);
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>>
+LinearReadWriteOram<schedulerId>::getPositionShares() const {
+  // party 0 holds the public indexes and party 1 holds 0s.
+  std::vector<std::vector<bool>> rst(
+      indexWidth_, std::vector<bool>(size_, false));
+  if (amIParty0_) {
+    for (size_t k = 0; k < indexWidth_; k++) {
+      for (size_t j = 0; j < size_; j++) {
+        rst[k][j] = (j >> k) & 1;
+      }
+    }
+  }
+  return rst;
+}
+
+template <int schedulerId>
+void LinearReadWriteOram<schedulerId>::checkIndexShares(
+    const std::vector<std::vector<bool>>& indexShares) const {
+  if (indexShares.size() != indexWidth_) {
+    throw std::runtime_error("Unexpected index width.");
+  }
+  auto batchSize = indexShares.at(0).size();
+  if (batchSize == 0) {
+    throw std::runtime_error("Input cannot be empty");
+  }
+  for (auto& item : indexShares) {
+    if (item.size() != batchSize) {
+      throw std::runtime_error("Input size is inconsistent!");
+    }
+  }
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -7,8 +7,8 @@
 
 #include "fbpcf/mpc_std_lib/oram/SinglePointArrayGenerator.h"
 #include <algorithm>
-#include <cmath>
 #include <stdexcept>
+#include "fbpcf/engine/util/aes.h"
 #include "fbpcf/engine/util/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
 
@@ -33,65 +33,137 @@ SinglePointArrayGenerator::generateSinglePointArrays(
     throw std::invalid_argument("Empty input!");
   }
 
-  ArrayType rst(batchSize, {{firstShare_}, std::vector<__m128i>(1)});
+  // the length of the arrays after each layer. neededLength is the smallest
+  // integer such that neededLength << (width - 1 - i) >= length
+  std::vector<size_t> lengths(width);
+  size_t currentLength = 1;
+  for (size_t i = 0; i < width; i++) {
+    auto shift = width - 1 - i;
+    size_t neededLength =
+        (length >> shift) + ((length & (((uint64_t)1 << shift) - 1)) != 0);
+    currentLength = std::min(neededLength, 2 * currentLength);
+    lengths[i] = currentLength;
+  }
+
+  // the layers before the last one take turns to use two buffers, each large
+  // enough for all of them. The last layer is written into the output.
+  auto bufferSize =
+      batchSize * std::max<size_t>(width > 1 ? lengths.at(width - 2) : 1, 1);
+  std::vector<__m128i> keys(bufferSize);
+  std::vector<__m128i> nextKeys(width > 1 ? bufferSize : 0);
+  std::vector<uint8_t> flags(batchSize * std::max<size_t>(currentLength, 1));
+  std::vector<uint8_t> nextFlags(flags.size());
 
-  for (auto& item : rst) {
-    item.second[0] = engine::util::getRandomM128iFromSystemNoise();
+  // one seed from the system noise, the seed of each array is derived from it.
+  for (size_t i = 0; i < batchSize; i++) {
+    keys[i] = _mm_set_epi64x(0, i);
+    flags[i] = firstShare_;
   }
+  engine::util::Aes(engine::util::getRandomM128iFromSystemNoise())
+      .encryptInPlace(keys.data(), batchSize);
 
+  ArrayType rst(batchSize);
+  std::vector<__m128i*> children(batchSize);
+  currentLength = 1;
   for (size_t i = 0; i < width; i++) {
-    rst = expandArray(std::move(rst), indexShares.at(width - 1 - i));
-    // neededLength is the smallest integer such that neededLength << (width - 1
-    // - i) >= length
-    auto neededLength =
-        std::ceil(length * 1.0 / ((uint64_t)1 << (width - 1 - i)));
-    for (auto& item : rst) {
-      item.first.erase(item.first.begin() + neededLength, item.first.end());
-      item.second.erase(item.second.begin() + neededLength, item.second.end());
+    auto nextLength = lengths.at(i);
+    if (i + 1 < width) {
+      for (size_t j = 0; j < batchSize; j++) {
+        children[j] = nextKeys.data() + j * nextLength;
+      }
+    } else {
+      threadPool_.parallelFor(batchSize, [&](size_t j) {
+        rst[j].second = std::vector<__m128i>(nextLength);
+        children[j] = rst[j].second.data();
+      });
     }
+    expandLayer(
+        keys.data(),
+        flags.data(),
+        currentLength,
+        nextLength,
+        indexShares.at(width - 1 - i),
+        children,
+        nextFlags.data());
+    std::swap(keys, nextKeys);
+    std::swap(flags, nextFlags);
+    currentLength = nextLength;
   }
 
+  threadPool_.parallelFor(batchSize, [&](size_t i) {
+    auto begin = flags.begin() + i * currentLength;
+    rst[i].first = std::vector<bool>(begin, begin + currentLength);
+  });
   return rst;
 }
 
-ISinglePointArrayGenerator::ArrayType SinglePointArrayGenerator::expandArray(
-    ArrayType&& src,
-    const std::vector<bool>& indicatorShare) const {
-  size_t batchSize = src.size();
-  if (indicatorShare.size() != batchSize) {
+void SinglePointArrayGenerator::expandLayer(
+    const __m128i* keys,
+    const uint8_t* flags,
+    size_t currentLength,
+    size_t nextLength,
+    const std::vector<bool>& indicatorShare,
+    const std::vector<__m128i*>& nextKeys,
+    uint8_t* nextFlags) {
+  size_t batchSize = indicatorShare.size();
+  if (nextKeys.size() != batchSize) {
     throw std::invalid_argument("Inconsistent size.");
   }
-  ArrayType rst(batchSize);
 
-  std::vector<__m128i> delta0(batchSize, _mm_set_epi64x(0, 0));
-  std::vector<__m128i> delta1(batchSize, _mm_set_epi64x(0, 0));
+  std::vector<__m128i> delta0(batchSize);
+  std::vector<__m128i> delta1(batchSize);
+  // the parents whose children are all kept in the next layer.
+  auto keptParents = nextLength / 2;
 
-  for (size_t i = 0; i < batchSize; i++) {
-    rst[i].second = expander_->expand(std::move(src[i].second));
-    for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
-      delta0[i] = _mm_xor_si128(delta0.at(i), rst.at(i).second.at(j));
-      delta1[i] = _mm_xor_si128(delta1.at(i), rst.at(i).second.at(j + 1));
+  threadPool_.parallelFor(batchSize, [&](size_t i, size_t thread) {
+    auto parents = keys + i * currentLength;
+    auto children = nextKeys[i];
+    expander_->expand(parents, keptParents, children);
+
+    // the children of the other parents are mostly cut off, but the deltas
+    // need all of them.
+    auto& otherChildren = otherChildren_[thread];
+    otherChildren.resize(2 * (currentLength - keptParents));
+    expander_->expand(
+        parents + keptParents,
+        currentLength - keptParents,
+        otherChildren.data());
+    if (nextLength & 1) {
+      children[nextLength - 1] = otherChildren.at(0);
     }
-  }
+
+    auto d0 = _mm_set_epi64x(0, 0);
+    auto d1 = _mm_set_epi64x(0, 0);
+    for (size_t j = 0; j < 2 * keptParents; j += 2) {
+      d0 = _mm_xor_si128(d0, children[j]);
+      d1 = _mm_xor_si128(d1, children[j + 1]);
+    }
+    for (size_t j = 0; j < otherChildren.size(); j += 2) {
+      d0 = _mm_xor_si128(d0, otherChildren[j]);
+      d1 = _mm_xor_si128(d1, otherChildren[j + 1]);
+    }
+    delta0[i] = d0;
+    delta1[i] = d1;
+  });
+
   auto [delta, t0, t1] =
       obliviousDeltaCalculator_->calculateDelta(delta0, delta1, indicatorShare);
-  for (size_t i = 0; i < batchSize; i++) {
-    rst[i].first = std::vector<bool>(rst.at(i).second.size());
-
-    for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
-      rst[i].first[j] = engine::util::getLsb(rst.at(i).second.at(j));
-      rst[i].first[j + 1] = engine::util::getLsb(rst.at(i).second.at(j + 1));
-      if (src.at(i).first.at(j >> 1)) {
-        rst[i].first[j] = rst.at(i).first.at(j) ^ t0.at(i);
-        rst[i].first[j + 1] = rst.at(i).first.at(j + 1) ^ t1.at(i);
-
-        rst[i].second[j] = _mm_xor_si128(rst.at(i).second.at(j), delta.at(i));
-        rst[i].second[j + 1] =
-            _mm_xor_si128(rst.at(i).second.at(j + 1), delta.at(i));
-      }
+
+  threadPool_.parallelFor(batchSize, [&](size_t i) {
+    auto parentFlags = flags + i * currentLength;
+    auto children = nextKeys[i];
+    auto childFlags = nextFlags + i * nextLength;
+    uint8_t flagDelta[2] = {t0.at(i), t1.at(i)};
+    auto deltaMask = delta.at(i);
+    // branch-free, as the parent flags are random.
+    for (size_t j = 0; j < nextLength; j++) {
+      uint8_t parentFlag = parentFlags[j >> 1];
+      auto mask = _mm_set1_epi8(-static_cast<int8_t>(parentFlag));
+      childFlags[j] = (_mm_cvtsi128_si32(children[j]) & 1) ^
+          (flagDelta[j & 1] & parentFlag);
+      children[j] = _mm_xor_si128(children[j], _mm_and_si128(deltaMask, mask));
     }
-  }
-  return rst;
+  });
 }
 
 } // namespace fbpcf::mpc_std_lib::oram
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/util/ThreadPool.h"
 #include "fbpcf/engine/util/util.h"
 #include "fbpcf/mpc_std_lib/oram/IObliviousDeltaCalculator.h"
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
@@ -23,6 +24,9 @@ namespace fbpcf::mpc_std_lib::oram {
  * A single point array generator allow two parties jointly generate a pair of
  * single point array. The point position is shared by two parties.
  * This object uses an oblivious delta calculator as an underlying object.
+ * All the arrays in a batch are expanded together, one layer at a time, in a
+ * contiguous buffer per layer; the arrays of a layer can be expanded on
+ * several threads.
  */
 class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
  public:
@@ -30,9 +34,12 @@ class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
       bool firstShare /* which value to start with when generating the
                          array, the two parties must use different values*/
       ,
-      std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator)
+      std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator,
+      int numberOfThreads = 1)
       : firstShare_(firstShare),
-        obliviousDeltaCalculator_(std::move(obliviousDeltaCalculator)) {
+        obliviousDeltaCalculator_(std::move(obliviousDeltaCalculator)),
+        threadPool_(numberOfThreads),
+        otherChildren_(threadPool_.getNumberOfThreads()) {
     expander_ = std::make_unique<engine::util::Expander>(
         0 /* this index is not important, any PUBLIC CONSTANT works*/);
   }
@@ -50,12 +57,22 @@ class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
   }
 
  private:
-  ArrayType expandArray(
-      ArrayType&& src,
-      const std::vector<bool>& indicatorShare) const;
+  // The i-th array of a layer with length n takes the range [i * n, (i + 1) *
+  // n) of the keys and the flags; its children go to nextKeys[i].
+  void expandLayer(
+      const __m128i* keys,
+      const uint8_t* flags,
+      size_t currentLength,
+      size_t nextLength,
+      const std::vector<bool>& indicatorShare,
+      const std::vector<__m128i*>& nextKeys,
+      uint8_t* nextFlags);
 
   bool firstShare_;
   std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator_;
+  engine::util::ThreadPool threadPool_;
+  // scratch space for the children that are cut off, one per thread.
+  std::vector<std::vector<__m128i>> otherChildren_;
   std::unique_ptr<engine::util::Expander> expander_;
 };
 
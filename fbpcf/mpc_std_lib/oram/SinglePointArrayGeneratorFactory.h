@@ -8,6 +8,7 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/mpc_std_lib/oram/IObliviousDeltaCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGeneratorFactory.h"
@@ -21,18 +22,25 @@ class SinglePointArrayGeneratorFactory final
   SinglePointArrayGeneratorFactory(
       bool firstShare,
       std::unique_ptr<IObliviousDeltaCalculatorFactory>
-          obliviousCalculatrFactory)
+          obliviousCalculatrFactory,
+      int numberOfThreads = 1)
       : firstShare_(firstShare),
-        obliviousCalculatrFactory_(std::move(obliviousCalculatrFactory)) {}
+        obliviousCalculatrFactory_(std::move(obliviousCalculatrFactory)),
+        numberOfThreads_(numberOfThreads) {
+    if (numberOfThreads < 1) {
+      throw std::invalid_argument("Need at least one thread.");
+    }
+  }
 
   std::unique_ptr<ISinglePointArrayGenerator> create() override {
     return std::make_unique<SinglePointArrayGenerator>(
-        firstShare_, obliviousCalculatrFactory_->create());
+        firstShare_, obliviousCalculatrFactory_->create(), numberOfThreads_);
   }
 
  private:
   bool firstShare_;
   std::unique_ptr<IObliviousDeltaCalculatorFactory> obliviousCalculatrFactory_;
+  int numberOfThreads_;
 };
 
 } // namespace fbpcf::mpc_std_lib::oram
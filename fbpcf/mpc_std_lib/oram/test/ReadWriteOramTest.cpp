@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/mpc_std_lib/oram/FloramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/LinearReadWriteOramFactory.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+// a batch of secrets, one vector for each bit, and the two parties' shares.
+struct SharedBatch {
+  std::vector<std::vector<bool>> plaintext;
+  std::vector<std::vector<bool>> shares0;
+  std::vector<std::vector<bool>> shares1;
+};
+
+SharedBatch shareBatch(std::vector<std::vector<bool>>&& plaintext) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> dist(0, 1);
+  SharedBatch rst{std::move(plaintext), {}, {}};
+  for (auto& bits : rst.plaintext) {
+    std::vector<bool> shares0(bits.size());
+    std::vector<bool> shares1(bits.size());
+    for (size_t i = 0; i < bits.size(); i++) {
+      shares0[i] = dist(e);
+      shares1[i] = shares0[i] ^ bits[i];
+    }
+    rst.shares0.push_back(std::move(shares0));
+    rst.shares1.push_back(std::move(shares1));
+  }
+  return rst;
+}
+
+SharedBatch shareIndexes(const std::vector<size_t>& indexes, size_t oramSize) {
+  size_t indexWidth = std::max<size_t>(1, std::ceil(std::log2(oramSize)));
+  std::vector<std::vector<bool>> bits(
+      indexWidth, std::vector<bool>(indexes.size()));
+  for (size_t k = 0; k < indexWidth; k++) {
+    for (size_t i = 0; i < indexes.size(); i++) {
+      bits[k][i] = (indexes.at(i) >> k) & 1;
+    }
+  }
+  return shareBatch(std::move(bits));
+}
+
+struct Round {
+  SharedBatch writeIndexes;
+  SharedBatch writeValues;
+  SharedBatch conditions;
+  SharedBatch readIndexes;
+  std::vector<std::vector<bool>> expectedValues;
+};
+
+// every round writes a batch of distinct positions, then reads a batch of
+// positions that may repeat.
+std::vector<Round>
+generateRounds(size_t oramSize, size_t width, size_t rounds, size_t batchSize) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> bitDist(0, 1);
+  std::uniform_int_distribution<size_t> indexDist(0, oramSize - 1);
+
+  std::vector<std::vector<bool>> memory(
+      oramSize, std::vector<bool>(width, false));
+  std::vector<size_t> positions(oramSize);
+  for (size_t i = 0; i < oramSize; i++) {
+    positions[i] = i;
+  }
+
+  std::vector<Round> rst;
+  for (size_t r = 0; r < rounds; r++) {
+    std::shuffle(positions.begin(), positions.end(), e);
+    std::vector<size_t> writeIndexes(
+        positions.begin(),
+        positions.begin() + std::min(batchSize, oramSize));
+    std::vector<std::vector<bool>> values(
+        width, std::vector<bool>(writeIndexes.size()));
+    std::vector<bool> conditions(writeIndexes.size());
+    for (size_t i = 0; i < writeIndexes.size(); i++) {
+      conditions[i] = bitDist(e);
+      for (size_t k = 0; k < width; k++) {
+        values[k][i] = bitDist(e);
+        if (conditions[i]) {
+          memory[writeIndexes[i]][k] = values[k][i];
+        }
+      }
+    }
+
+    std::vector<size_t> readIndexes(batchSize);
+    std::vector<std::vector<bool>> expectedValues(
+        width, std::vector<bool>(batchSize));
+    for (size_t i = 0; i < batchSize; i++) {
+      readIndexes[i] = indexDist(e);
+      for (size_t k = 0; k < width; k++) {
+        expectedValues[k][i] = memory[readIndexes[i]][k];
+      }
+    }
+
+    rst.push_back(Round{
+        shareIndexes(writeIndexes, oramSize),
+        shareBatch(std::move(values)),
+        shareBatch({conditions}),
+        shareIndexes(readIndexes, oramSize),
+        std::move(expectedValues)});
+  }
+  return rst;
+}
+
+std::vector<std::vector<std::vector<bool>>> readWriteOramHelper(
+    std::unique_ptr<IReadWriteOramFactory> factory,
+    size_t oramSize,
+    const std::vector<Round>& rounds,
+    bool amIParty0) {
+  auto oram = factory->create(oramSize);
+  std::vector<std::vector<std::vector<bool>>> rst;
+  for (auto& round : rounds) {
+    oram->obliviousWriteBatch(
+        amIParty0 ? round.writeIndexes.shares0 : round.writeIndexes.shares1,
+        amIParty0 ? round.writeValues.shares0 : round.writeValues.shares1,
+        amIParty0 ? round.conditions.shares0.at(0)
+                  : round.conditions.shares1.at(0));
+    rst.push_back(oram->obliviousReadBatch(
+        amIParty0 ? round.readIndexes.shares0 : round.readIndexes.shares1));
+  }
+  return rst;
+}
+
+void testReadWriteOram(
+    std::unique_ptr<IReadWriteOramFactory> factory0,
+    std::unique_ptr<IReadWriteOramFactory> factory1,
+    size_t oramSize,
+    size_t width,
+    size_t batchSize) {
+  const size_t kRounds = 6;
+  auto rounds = generateRounds(oramSize, width, kRounds, batchSize);
+
+  auto future0 = std::async(
+      readWriteOramHelper,
+      std::move(factory0),
+      oramSize,
+      std::cref(rounds),
+      true);
+  auto future1 = std::async(
+      readWriteOramHelper,
+      std::move(factory1),
+      oramSize,
+      std::cref(rounds),
+      false);
+  auto result0 = future0.get();
+  auto result1 = future1.get();
+
+  ASSERT_EQ(result0.size(), kRounds);
+  ASSERT_EQ(result1.size(), kRounds);
+  for (size_t r = 0; r < kRounds; r++) {
+    ASSERT_EQ(result0.at(r).size(), width);
+    ASSERT_EQ(result1.at(r).size(), width);
+    for (size_t k = 0; k < width; k++) {
+      for (size_t i = 0; i < batchSize; i++) {
+        EXPECT_EQ(
+            result0.at(r).at(k).at(i) ^ result1.at(r).at(k).at(i),
+            rounds.at(r).expectedValues.at(k).at(i));
+      }
+    }
+  }
+}
+
+class FloramTestFixture : public ::testing::TestWithParam<
+                              std::tuple<size_t, size_t, size_t, size_t>> {};
+
+TEST_P(FloramTestFixture, testFloram) {
+  auto [oramSize, width, batchSize, stashCapacity] = GetParam();
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  // the AES circuit is much faster with the lazy scheduler, which merges the
+  // independent AND gates into fewer rounds.
+  setupRealBackendWithLazyScheduler<0, 1>(*factories[0], *factories[1]);
+
+  testReadWriteOram(
+      getSecureFloramFactory<0>(
+          true, 0, 1, *factories[0], width, stashCapacity),
+      getSecureFloramFactory<1>(
+          false, 0, 1, *factories[1], width, stashCapacity),
+      oramSize,
+      width,
+      batchSize);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ReadWriteOramTest,
+    FloramTestFixture,
+    ::testing::Values(
+        std::make_tuple(1, 8, 1, 0),
+        std::make_tuple(30, 32, 4, 0),
+        std::make_tuple(30, 1, 3, 100),
+        std::make_tuple(100, 64, 5, 7),
+        std::make_tuple(257, 100, 8, 0),
+        std::make_tuple(64, 128, 2, 1)));
+
+TEST(ReadWriteOramTest, testFloramInvalidInput) {
+  EXPECT_THROW(
+      Floram<0>(true, 10, 129, nullptr, nullptr, 1), std::invalid_argument);
+  EXPECT_THROW(
+      Floram<0>(true, 0, 8, nullptr, nullptr, 1), std::invalid_argument);
+  EXPECT_THROW(
+      Floram<0>(true, 10, 8, nullptr, nullptr, 0), std::invalid_argument);
+}
+
+TEST(ReadWriteOramTest, testLinearReadWriteOram) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*factories[0], *factories[1]);
+
+  testReadWriteOram(
+      std::make_unique<LinearReadWriteOramFactory<0>>(true, 20),
+      std::make_unique<LinearReadWriteOramFactory<1>>(false, 20),
+      30,
+      20,
+      4);
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
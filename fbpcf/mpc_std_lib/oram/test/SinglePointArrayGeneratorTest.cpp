@@ -132,4 +132,33 @@ TEST(
   testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
 }
 
+TEST(
+    SinglePointArrayGeneratorTest,
+    testMultiThreadedSinglePointArrayGeneratorWithObliviousDeltaCalculator) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*factories[0], *factories[1]);
+
+  int numberOfThreads = 4;
+  auto factory0 = std::make_unique<SinglePointArrayGeneratorFactory>(
+      true,
+      std::make_unique<ObliviousDeltaCalculatorFactory<0>>(true, 0, 1),
+      numberOfThreads);
+  auto factory1 = std::make_unique<SinglePointArrayGeneratorFactory>(
+      false,
+      std::make_unique<ObliviousDeltaCalculatorFactory<1>>(false, 0, 1),
+      numberOfThreads);
+  testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
+}
+
+TEST(SinglePointArrayGeneratorTest, testInvalidNumberOfThreads) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  EXPECT_THROW(
+      SinglePointArrayGeneratorFactory(
+          true,
+          std::make_unique<insecure::DummyObliviousDeltaCalculatorFactory>(
+              1, *factories[0]),
+          0),
+      std::invalid_argument);
+}
+
 } // namespace fbpcf::mpc_std_lib::oram
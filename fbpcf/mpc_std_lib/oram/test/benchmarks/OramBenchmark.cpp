@@ -6,16 +6,20 @@
  */
 
 #include <folly/Benchmark.h>
+#include <cmath>
+#include <random>
 
 #include "common/init/Init.h"
 
 #include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
 #include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
 #include "fbpcf/mpc_std_lib/oram/DifferenceCalculatorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/FloramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/IDifferenceCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
 #include "fbpcf/mpc_std_lib/oram/IWriteOnlyOram.h"
 #include "fbpcf/mpc_std_lib/oram/LinearOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/LinearReadWriteOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ObliviousDeltaCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/SinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/WriteOnlyOramFactory.h"
@@ -163,6 +167,11 @@ BENCHMARK_COUNTERS(ObliviousDeltaCalculator_Benchmark, counters) {
 class SinglePointArrayGeneratorBenchmark
     : public engine::util::NetworkedBenchmark {
  public:
+  explicit SinglePointArrayGeneratorBenchmark(
+      size_t batchSize = 128,
+      int numberOfThreads = 1)
+      : batchSize_(batchSize), numberOfThreads_(numberOfThreads) {}
+
   void setup() override {
     auto [agentFactory0, agentFactory1] =
         engine::util::getSocketAgentFactories();
@@ -170,13 +179,11 @@ class SinglePointArrayGeneratorBenchmark
     agentFactory1_ = std::move(agentFactory1);
 
     size_t width = std::ceil(std::log2(length_));
-    size_t batchSize = 128;
-
     party0Input_ =
-        std::vector<std::vector<bool>>(width, std::vector<bool>(batchSize));
+        std::vector<std::vector<bool>>(width, std::vector<bool>(batchSize_));
     party1Input_ =
-        std::vector<std::vector<bool>>(width, std::vector<bool>(batchSize));
-    for (size_t i = 0; i < batchSize; i++) {
+        std::vector<std::vector<bool>>(width, std::vector<bool>(batchSize_));
+    for (size_t i = 0; i < batchSize_; i++) {
       auto [share0, share1, _] =
           util::generateSharedRandomBoolVectorForSinglePointArrayGenerator(
               length_);
@@ -192,7 +199,9 @@ class SinglePointArrayGeneratorBenchmark
     scheduler::SchedulerKeeper<0>::setScheduler(
         scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
     SinglePointArrayGeneratorFactory factory(
-        true, std::make_unique<ObliviousDeltaCalculatorFactory<0>>(true, 0, 1));
+        true,
+        std::make_unique<ObliviousDeltaCalculatorFactory<0>>(true, 0, 1),
+        numberOfThreads_);
     sender_ = factory.create();
   }
 
@@ -205,7 +214,8 @@ class SinglePointArrayGeneratorBenchmark
         scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
     SinglePointArrayGeneratorFactory factory(
         false,
-        std::make_unique<ObliviousDeltaCalculatorFactory<1>>(false, 0, 1));
+        std::make_unique<ObliviousDeltaCalculatorFactory<1>>(false, 0, 1),
+        numberOfThreads_);
     receiver_ = factory.create();
   }
 
@@ -219,6 +229,8 @@ class SinglePointArrayGeneratorBenchmark
 
  private:
   size_t length_ = 16384;
+  size_t batchSize_;
+  int numberOfThreads_;
 
   std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
       agentFactory0_;
@@ -237,6 +249,18 @@ BENCHMARK_COUNTERS(SinglePointArrayGenerator_Benchmark, counters) {
   benchmark.runBenchmark(counters);
 }
 
+BENCHMARK_COUNTERS(SinglePointArrayGenerator_Batch1024_Benchmark, counters) {
+  SinglePointArrayGeneratorBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(
+    SinglePointArrayGenerator_Batch1024_4Threads_Benchmark,
+    counters) {
+  SinglePointArrayGeneratorBenchmark benchmark(1024, 4);
+  benchmark.runBenchmark(counters);
+}
+
 class BaseWriteOnlyOramBenchmark : public engine::util::NetworkedBenchmark {
  public:
   void setup() override {
@@ -408,6 +432,186 @@ BENCHMARK_COUNTERS(LinearOramSecretRead_Benchmark, counters) {
   LinearOramSecretReadBenchmark benchmark;
   benchmark.runBenchmark(counters);
 }
+
+class BaseReadWriteOramBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint8_t> dist(0, 1);
+
+    // the writes of a batch must go to distinct positions.
+    size_t indexWidth = std::ceil(std::log2(oramSize_));
+    indexShares0_.resize(indexWidth, std::vector<bool>(batchSize_));
+    indexShares1_.resize(indexWidth, std::vector<bool>(batchSize_));
+    for (size_t k = 0; k < indexWidth; k++) {
+      for (size_t i = 0; i < batchSize_; i++) {
+        auto index = i * (oramSize_ / batchSize_);
+        indexShares0_[k][i] = dist(e);
+        indexShares1_[k][i] = indexShares0_[k][i] ^ ((index >> k) & 1);
+      }
+    }
+    valueShares0_.resize(width_, std::vector<bool>(batchSize_));
+    valueShares1_.resize(width_, std::vector<bool>(batchSize_));
+    for (size_t k = 0; k < width_; k++) {
+      for (size_t i = 0; i < batchSize_; i++) {
+        valueShares0_[k][i] = dist(e);
+        valueShares1_[k][i] = dist(e);
+      }
+    }
+  }
+
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    auto factory = getOramFactory(true);
+    sender_ = factory->create(oramSize_);
+  }
+
+  void runSender() override {
+    runMethod(sender_, indexShares0_, valueShares0_);
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    auto factory = getOramFactory(false);
+    receiver_ = factory->create(oramSize_);
+  }
+
+  void runReceiver() override {
+    runMethod(receiver_, indexShares1_, valueShares1_);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto schedulerTraffic =
+        scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+    auto oramTraffic = sender_->getTrafficStatistics();
+    return {
+        schedulerTraffic.first + oramTraffic.first,
+        schedulerTraffic.second + oramTraffic.second};
+  }
+
+  virtual std::unique_ptr<IReadWriteOramFactory> getOramFactory(
+      bool amIParty0) = 0;
+
+  virtual void runMethod(
+      std::unique_ptr<IReadWriteOram>& oram,
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares) = 0;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  size_t oramSize_ = 4096;
+  size_t batchSize_ = 64;
+  size_t width_ = 32;
+  // run several batches in a row, so that the refreshes of Floram are
+  // amortized as they would be in practice.
+  size_t batches_ = 4;
+
+ private:
+  std::unique_ptr<IReadWriteOram> sender_;
+  std::unique_ptr<IReadWriteOram> receiver_;
+
+  std::vector<std::vector<bool>> indexShares0_;
+  std::vector<std::vector<bool>> indexShares1_;
+  std::vector<std::vector<bool>> valueShares0_;
+  std::vector<std::vector<bool>> valueShares1_;
+};
+
+class ObliviousReadBatchBenchmark
+    : virtual public BaseReadWriteOramBenchmark {
+ protected:
+  void runMethod(
+      std::unique_ptr<IReadWriteOram>& oram,
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>&) override {
+    for (size_t i = 0; i < batches_; i++) {
+      oram->obliviousReadBatch(indexShares);
+    }
+  }
+};
+
+class ObliviousWriteBatchBenchmark
+    : virtual public BaseReadWriteOramBenchmark {
+ protected:
+  void runMethod(
+      std::unique_ptr<IReadWriteOram>& oram,
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares) override {
+    std::vector<bool> conditionShares(batchSize_, false);
+    for (size_t i = 0; i < batches_; i++) {
+      oram->obliviousWriteBatch(indexShares, valueShares, conditionShares);
+    }
+  }
+};
+
+class FloramBenchmark : virtual public BaseReadWriteOramBenchmark {
+ protected:
+  std::unique_ptr<IReadWriteOramFactory> getOramFactory(
+      bool amIParty0) override {
+    return amIParty0
+        ? getSecureFloramFactory<0>(true, 0, 1, *agentFactory0_, width_)
+        : getSecureFloramFactory<1>(false, 0, 1, *agentFactory1_, width_);
+  }
+};
+
+class FloramObliviousReadBatchBenchmark : public FloramBenchmark,
+                                          public ObliviousReadBatchBenchmark {
+};
+
+BENCHMARK_COUNTERS(FloramObliviousReadBatch_Benchmark, counters) {
+  FloramObliviousReadBatchBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class FloramObliviousWriteBatchBenchmark
+    : public FloramBenchmark,
+      public ObliviousWriteBatchBenchmark {};
+
+BENCHMARK_COUNTERS(FloramObliviousWriteBatch_Benchmark, counters) {
+  FloramObliviousWriteBatchBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class LinearReadWriteOramBenchmark
+    : virtual public BaseReadWriteOramBenchmark {
+ protected:
+  std::unique_ptr<IReadWriteOramFactory> getOramFactory(
+      bool amIParty0) override {
+    return amIParty0
+        ? std::unique_ptr<IReadWriteOramFactory>(
+              std::make_unique<LinearReadWriteOramFactory<0>>(true, width_))
+        : std::make_unique<LinearReadWriteOramFactory<1>>(false, width_);
+  }
+};
+
+class LinearReadWriteOramObliviousReadBatchBenchmark
+    : public LinearReadWriteOramBenchmark,
+      public ObliviousReadBatchBenchmark {};
+
+BENCHMARK_COUNTERS(LinearReadWriteOramObliviousReadBatch_Benchmark, counters) {
+  LinearReadWriteOramObliviousReadBatchBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class LinearReadWriteOramObliviousWriteBatchBenchmark
+    : public LinearReadWriteOramBenchmark,
+      public ObliviousWriteBatchBenchmark {};
+
+BENCHMARK_COUNTERS(LinearReadWriteOramObliviousWriteBatch_Benchmark, counters) {
+  LinearReadWriteOramObliviousWriteBatchBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
 } // namespace fbpcf::mpc_std_lib::oram
 
 int main(int argc, char* argv[]) {
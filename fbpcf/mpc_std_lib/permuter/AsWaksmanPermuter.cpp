@@ -7,6 +7,8 @@
 
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
 
+#include <stdexcept>
+
 namespace fbpcf::mpc_std_lib::permuter {
 
 void AsWaksmanParameterCalculator::compute() {
@@ -58,4 +60,91 @@ uint32_t AsWaksmanParameterCalculator::fillIntoSecondHalf(
   return findDualIndex(dualIndexAfterPermute);
 }
 
+namespace {
+
+void routeSwitches(
+    uint32_t offset,
+    size_t size,
+    const std::vector<uint32_t>* order,
+    size_t level,
+    std::vector<std::vector<AsWaksmanSwitch>>& inputLevels,
+    std::vector<std::vector<AsWaksmanSwitch>>& outputLevels) {
+  if (size <= 1) {
+    return;
+  }
+  if (inputLevels.size() <= level) {
+    inputLevels.resize(level + 1);
+    outputLevels.resize(level + 1);
+  }
+  if (size == 2) {
+    inputLevels[level].push_back(
+        {offset, offset + 1, order != nullptr && order->at(0) == 1});
+    return;
+  }
+
+  // the same network as AsWaksmanPermuter::permute
+  auto half = size / 2;
+  std::vector<bool> firstSwapConditions(half);
+  std::vector<bool> secondSwapConditions((size - 1) / 2);
+  std::vector<uint32_t> firstSubPermuteOrder;
+  std::vector<uint32_t> secondSubPermuteOrder;
+  if (order != nullptr) {
+    AsWaksmanParameterCalculator calculator(*order);
+    firstSwapConditions = calculator.getFirstSwapConditions();
+    secondSwapConditions = calculator.getSecondSwapConditions();
+    firstSubPermuteOrder = calculator.getFirstSubPermuteOrder();
+    secondSubPermuteOrder = calculator.getSecondSubPermuteOrder();
+  }
+
+  for (uint32_t i = 0; i < half; i++) {
+    inputLevels[level].push_back(
+        {offset + i, offset + half + i, firstSwapConditions.at(i)});
+  }
+  routeSwitches(
+      offset,
+      half,
+      order == nullptr ? nullptr : &firstSubPermuteOrder,
+      level + 1,
+      inputLevels,
+      outputLevels);
+  routeSwitches(
+      offset + half,
+      size - half,
+      order == nullptr ? nullptr : &secondSubPermuteOrder,
+      level + 1,
+      inputLevels,
+      outputLevels);
+  for (uint32_t i = 0; i < secondSwapConditions.size(); i++) {
+    outputLevels[level].push_back(
+        {offset + i, offset + half + i, secondSwapConditions.at(i)});
+  }
+}
+
+} // namespace
+
+std::vector<std::vector<AsWaksmanSwitch>> routeAsWaksmanNetwork(
+    size_t size,
+    const std::vector<uint32_t>* order) {
+  if (order != nullptr && order->size() != size) {
+    throw std::invalid_argument("Inconsistent size.");
+  }
+  std::vector<std::vector<AsWaksmanSwitch>> inputLevels;
+  std::vector<std::vector<AsWaksmanSwitch>> outputLevels;
+  routeSwitches(0, size, order, 0, inputLevels, outputLevels);
+
+  std::vector<std::vector<AsWaksmanSwitch>> rst;
+  for (auto& level : inputLevels) {
+    if (!level.empty()) {
+      rst.push_back(std::move(level));
+    }
+  }
+  for (auto level = outputLevels.rbegin(); level != outputLevels.rend();
+       level++) {
+    if (!level->empty()) {
+      rst.push_back(std::move(*level));
+    }
+  }
+  return rst;
+}
+
 } // namespace fbpcf::mpc_std_lib::permuter
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
 
 #include "fbpcf/mpc_std_lib/util/util.h"
@@ -145,6 +148,29 @@ class AsWaksmanParameterCalculator {
   std::vector<uint32_t> secondSubPermuteOrder_;
 };
 
+/**
+ * A switch of the AS-Waksman network, it swaps the two elements at the given
+ * positions if swap is true.
+ */
+struct AsWaksmanSwitch {
+  uint32_t first;
+  uint32_t second;
+  bool swap;
+};
+
+/**
+ * Lay out the AS-Waksman network on size elements as levels of switches. The
+ * switches in a level touch distinct elements and can be applied at once. The
+ * levels are in the order to apply them: the input side of the recursion from
+ * the outermost level inwards, then the output side coming back out. The
+ * switches are set with AsWaksmanParameterCalculator to realize the order;
+ * without an order, all of them are set to false, which is enough for the
+ * party that doesn't know the order.
+ */
+std::vector<std::vector<AsWaksmanSwitch>> routeAsWaksmanNetwork(
+    size_t size,
+    const std::vector<uint32_t>* order);
+
 } // namespace fbpcf::mpc_std_lib::permuter
 
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter_impl.h"
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
+#include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+/**
+ * This permuter runs the same AS-Waksman network as AsWaksmanPermuter, but
+ * not recursively. The party with the order routes the whole network in
+ * plaintext up front, then the network is evaluated level by level, with one
+ * batched oblivious swap over all the subnetworks per level. There are
+ * 2 * ceil(log2(size)) - 1 levels at most; the elements of a level are gathered
+ * from and scattered back to the shares directly, without any frontend
+ * batching or unbatching.
+ **/
+template <typename T, int schedulerId>
+class IterativeAsWaksmanPermuter final
+    : public IPermuter<typename util::SecBatchType<T, schedulerId>::type> {
+ public:
+  using SecBatchType = typename util::SecBatchType<T, schedulerId>::type;
+  IterativeAsWaksmanPermuter(int myId, int partnerId)
+      : myId_(myId), partnerId_(partnerId) {}
+
+  SecBatchType permute(const SecBatchType& src, size_t size) const override;
+
+  SecBatchType permute(
+      const SecBatchType& src,
+      size_t size,
+      const std::vector<uint32_t>& order) const override;
+
+ private:
+  SecBatchType applyNetwork(
+      const SecBatchType& src,
+      const std::vector<std::vector<AsWaksmanSwitch>>& levels,
+      int conditionOwner) const;
+
+  int myId_;
+  int partnerId_;
+};
+
+} // namespace fbpcf::mpc_std_lib::permuter
+
+#include "fbpcf/mpc_std_lib/permuter/IterativeAsWaksmanPermuter_impl.h"
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+template <typename T, int schedulerId>
+typename IterativeAsWaksmanPermuter<T, schedulerId>::SecBatchType
+IterativeAsWaksmanPermuter<T, schedulerId>::permute(
+    const SecBatchType& src,
+    size_t size) const {
+  if (size <= 1) {
+    return src;
+  }
+  return applyNetwork(src, routeAsWaksmanNetwork(size, nullptr), partnerId_);
+}
+
+template <typename T, int schedulerId>
+typename IterativeAsWaksmanPermuter<T, schedulerId>::SecBatchType
+IterativeAsWaksmanPermuter<T, schedulerId>::permute(
+    const SecBatchType& src,
+    size_t size,
+    const std::vector<uint32_t>& order) const {
+  if (size <= 1) {
+    return src;
+  }
+  return applyNetwork(src, routeAsWaksmanNetwork(size, &order), myId_);
+}
+
+template <typename T, int schedulerId>
+typename IterativeAsWaksmanPermuter<T, schedulerId>::SecBatchType
+IterativeAsWaksmanPermuter<T, schedulerId>::applyNetwork(
+    const SecBatchType& src,
+    const std::vector<std::vector<AsWaksmanSwitch>>& levels,
+    int conditionOwner) const {
+  auto shares =
+      util::MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(src);
+  auto width = shares.size();
+
+  for (auto& level : levels) {
+    std::vector<std::vector<bool>> firstShares(
+        width, std::vector<bool>(level.size()));
+    std::vector<std::vector<bool>> secondShares(
+        width, std::vector<bool>(level.size()));
+    std::vector<bool> swapConditions(level.size());
+    for (size_t i = 0; i < width; i++) {
+      for (size_t j = 0; j < level.size(); j++) {
+        firstShares[i][j] = shares[i][level[j].first];
+        secondShares[i][j] = shares[i][level[j].second];
+      }
+    }
+    for (size_t j = 0; j < level.size(); j++) {
+      swapConditions[j] = level[j].swap;
+    }
+
+    auto [first, second] = util::MpcAdapters<T, schedulerId>::obliviousSwap(
+        util::MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(
+            firstShares),
+        util::MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(
+            secondShares),
+        frontend::Bit<true, schedulerId, true>(swapConditions, conditionOwner));
+
+    firstShares =
+        util::MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(first);
+    secondShares =
+        util::MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(second);
+    for (size_t i = 0; i < width; i++) {
+      for (size_t j = 0; j < level.size(); j++) {
+        shares[i][level[j].first] = firstShares[i][j];
+        shares[i][level[j].second] = secondShares[i][j];
+      }
+    }
+  }
+  return util::MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(shares);
+}
+
+} // namespace fbpcf::mpc_std_lib::permuter
@@ -17,6 +17,7 @@
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/DummyPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/IterativeAsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
@@ -98,6 +99,13 @@ TEST(permuterTest, testAsWaksmanPermuter) {
   permuterTest(factory0, factory1);
 }
 
+TEST(permuterTest, testIterativeAsWaksmanPermuter) {
+  IterativeAsWaksmanPermuterFactory<std::vector<bool>, 0> factory0(0, 1);
+  IterativeAsWaksmanPermuterFactory<std::vector<bool>, 1> factory1(1, 0);
+
+  permuterTest(factory0, factory1);
+}
+
 void testAsWaksmanParameter() {
   std::random_device rd;
   std::mt19937_64 e(rd());
@@ -164,4 +172,44 @@ TEST(AsWaksmanParameterTest, testAsWaksmanParameterCalculator) {
   }
 }
 
+TEST(AsWaksmanParameterTest, testRouteAsWaksmanNetwork) {
+  for (size_t size = 1; size < 70; size++) {
+    auto order = util::generateRandomPermutation(size);
+    auto levels = routeAsWaksmanNetwork(size, &order);
+    auto depth = static_cast<size_t>(std::ceil(std::log2(size)));
+    EXPECT_LE(levels.size(), depth == 0 ? 0 : 2 * depth - 1);
+
+    std::vector<uint32_t> testData(size);
+    for (size_t i = 0; i < size; i++) {
+      testData[i] = i;
+    }
+    for (auto& level : levels) {
+      std::vector<bool> touched(size);
+      for (auto& item : level) {
+        // the switches in a level must touch distinct elements.
+        ASSERT_FALSE(touched.at(item.first));
+        ASSERT_FALSE(touched.at(item.second));
+        touched[item.first] = true;
+        touched[item.second] = true;
+        if (item.swap) {
+          std::swap(testData[item.first], testData[item.second]);
+        }
+      }
+    }
+    testVectorEq(testData, order);
+
+    // the topology doesn't depend on the order.
+    auto topology = routeAsWaksmanNetwork(size, nullptr);
+    ASSERT_EQ(topology.size(), levels.size());
+    for (size_t i = 0; i < levels.size(); i++) {
+      ASSERT_EQ(topology.at(i).size(), levels.at(i).size());
+      for (size_t j = 0; j < levels.at(i).size(); j++) {
+        EXPECT_EQ(topology.at(i).at(j).first, levels.at(i).at(j).first);
+        EXPECT_EQ(topology.at(i).at(j).second, levels.at(i).at(j).second);
+        EXPECT_FALSE(topology.at(i).at(j).swap);
+      }
+    }
+  }
+}
+
 } // namespace fbpcf::mpc_std_lib::permuter
@@ -17,6 +17,7 @@
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/DummyPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/IterativeAsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
@@ -115,4 +116,12 @@ TEST(permuterTestBit, testAsWaksmanPermuter) {
   permuterTestWithLazyScheduler(factory0, factory1);
 }
 
+TEST(permuterTestBit, testIterativeAsWaksmanPermuter) {
+  IterativeAsWaksmanPermuterFactory<bool, 0> factory0(0, 1);
+  IterativeAsWaksmanPermuterFactory<bool, 1> factory1(1, 0);
+
+  permuterTestWithEagerScheduler(factory0, factory1);
+  permuterTestWithLazyScheduler(factory0, factory1);
+}
+
 } // namespace fbpcf::mpc_std_lib::permuter
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <random>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
+#include "fbpcf/mpc_std_lib/permuter/IterativeAsWaksmanPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/util/test/util.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+class BasePermuterBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  explicit BasePermuterBenchmark(size_t batchSize) : batchSize_(batchSize) {}
+
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint32_t> dist;
+    values_ = std::vector<uint32_t>(batchSize_);
+    for (auto& item : values_) {
+      item = dist(e);
+    }
+    order_ = util::generateRandomPermutation(batchSize_);
+  }
+
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    permuter0_ = createPermuter0();
+  }
+
+  void runSender() override {
+    auto permuted = permuter0_->permute(
+        util::MpcAdapters<uint32_t, 0>::processSecretInputs(values_, 0),
+        batchSize_,
+        order_);
+    util::MpcAdapters<uint32_t, 0>::openToParty(permuted, 0);
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    permuter1_ = createPermuter1();
+  }
+
+  void runReceiver() override {
+    auto permuted = permuter1_->permute(
+        util::MpcAdapters<uint32_t, 1>::processSecretInputs(values_, 0),
+        batchSize_);
+    util::MpcAdapters<uint32_t, 1>::openToParty(permuted, 0);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  virtual std::unique_ptr<
+      IPermuter<typename util::SecBatchType<uint32_t, 0>::type>>
+  createPermuter0() = 0;
+  virtual std::unique_ptr<
+      IPermuter<typename util::SecBatchType<uint32_t, 1>::type>>
+  createPermuter1() = 0;
+
+ private:
+  size_t batchSize_;
+  std::vector<uint32_t> values_;
+  std::vector<uint32_t> order_;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::unique_ptr<IPermuter<typename util::SecBatchType<uint32_t, 0>::type>>
+      permuter0_;
+  std::unique_ptr<IPermuter<typename util::SecBatchType<uint32_t, 1>::type>>
+      permuter1_;
+};
+
+class AsWaksmanPermuterBenchmark : public BasePermuterBenchmark {
+ public:
+  using BasePermuterBenchmark::BasePermuterBenchmark;
+
+ protected:
+  std::unique_ptr<IPermuter<typename util::SecBatchType<uint32_t, 0>::type>>
+  createPermuter0() override {
+    return AsWaksmanPermuterFactory<uint32_t, 0>(0, 1).create();
+  }
+
+  std::unique_ptr<IPermuter<typename util::SecBatchType<uint32_t, 1>::type>>
+  createPermuter1() override {
+    return AsWaksmanPermuterFactory<uint32_t, 1>(1, 0).create();
+  }
+};
+
+class IterativeAsWaksmanPermuterBenchmark : public BasePermuterBenchmark {
+ public:
+  using BasePermuterBenchmark::BasePermuterBenchmark;
+
+ protected:
+  std::unique_ptr<IPermuter<typename util::SecBatchType<uint32_t, 0>::type>>
+  createPermuter0() override {
+    return IterativeAsWaksmanPermuterFactory<uint32_t, 0>(0, 1).create();
+  }
+
+  std::unique_ptr<IPermuter<typename util::SecBatchType<uint32_t, 1>::type>>
+  createPermuter1() override {
+    return IterativeAsWaksmanPermuterFactory<uint32_t, 1>(1, 0).create();
+  }
+};
+
+BENCHMARK_COUNTERS(AsWaksmanPermuter_Benchmark, counters) {
+  AsWaksmanPermuterBenchmark benchmark(10000);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(IterativeAsWaksmanPermuter_Benchmark, counters) {
+  IterativeAsWaksmanPermuterBenchmark benchmark(10000);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(AsWaksmanPermuter_1M_Benchmark, counters) {
+  AsWaksmanPermuterBenchmark benchmark(1000000);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(IterativeAsWaksmanPermuter_1M_Benchmark, counters) {
+  IterativeAsWaksmanPermuterBenchmark benchmark(1000000);
+  benchmark.runBenchmark(counters);
+}
+} // namespace fbpcf::mpc_std_lib::permuter
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
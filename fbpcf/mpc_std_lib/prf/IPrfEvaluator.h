@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace fbpcf::mpc_std_lib::prf {
+
+/*
+ * A PRF evaluator computes a pseudorandom function at a conceptual-bit level,
+ * like the AES circuit. The bit type can be either bool or any MPC Bit type;
+ * with batch MPC bits, each bit holds the same bit of a batch of inputs.
+ */
+template <typename BitType>
+class IPrfEvaluator {
+ public:
+  static constexpr size_t kInputWidth = 128;
+  static constexpr size_t kKeyWidth = 128;
+  static constexpr size_t kOutputWidth = 128;
+
+  virtual ~IPrfEvaluator() = default;
+
+  /**
+   * Whether the PRF is claimed secure when the other party chooses many
+   * inputs evaluated under one key, as in an oblivious PRF.
+   */
+  virtual bool isSecureForManyInputsPerKey() const = 0;
+
+  /**
+   * Evaluate the PRF on the input under the key.
+   * @param input the input inside MPC. It must be kInputWidth bits.
+   * @param key the key inside MPC. It must be kKeyWidth bits.
+   * @return the kOutputWidth bits of the output inside MPC.
+   */
+  std::vector<BitType> evaluate(
+      const std::vector<BitType>& input,
+      const std::vector<BitType>& key) const {
+    if (input.size() != kInputWidth) {
+      throw std::runtime_error("PRF input must be 128 bits.");
+    }
+    if (key.size() != kKeyWidth) {
+      throw std::runtime_error("PRF key must be 128 bits.");
+    }
+    return evaluate_impl(input, key);
+  }
+
+ private:
+  virtual std::vector<BitType> evaluate_impl(
+      const std::vector<BitType>& input,
+      const std::vector<BitType>& key) const = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::prf
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/mpc_std_lib/prf/IPrfEvaluator.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+template <typename BitType>
+class IPrfEvaluatorFactory {
+ public:
+  virtual ~IPrfEvaluatorFactory() = default;
+  virtual std::unique_ptr<IPrfEvaluator<BitType>> create() = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::prf
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/mpc_std_lib/prf/LowMcConstants.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "fbpcf/engine/util/AesPrg.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+namespace {
+
+std::vector<LowMcConstants::Row> generateRows(
+    engine::util::AesPrg& prg,
+    size_t size) {
+  std::vector<__m128i> blocks(size);
+  prg.getRandomDataInPlace(blocks);
+  std::vector<LowMcConstants::Row> rst(size);
+  std::memcpy(rst.data(), blocks.data(), size * sizeof(__m128i));
+  return rst;
+}
+
+// draw random matrices until an invertible one comes up.
+LowMcConstants::Matrix generateInvertibleMatrix(engine::util::AesPrg& prg) {
+  LowMcConstants::Matrix rst;
+  do {
+    auto rows = generateRows(prg, rst.size());
+    std::copy(rows.begin(), rows.end(), rst.begin());
+  } while (LowMcConstants::getRank(rst) < LowMcConstants::kBlockWidth);
+  return rst;
+}
+
+} // namespace
+
+LowMcConstants::LowMcConstants() {
+  // any fixed seed works, as long as all the parties use the same one.
+  engine::util::AesPrg prg(_mm_set_epi64x(0x4c6f774d43, 0x5072664576616c));
+  for (size_t i = 0; i < kRounds; i++) {
+    linearLayers_.push_back(generateInvertibleMatrix(prg));
+    roundConstants_.push_back(generateRows(prg, 1).at(0));
+  }
+  for (size_t i = 0; i <= kRounds; i++) {
+    keyMatrices_.push_back(generateInvertibleMatrix(prg));
+  }
+}
+
+size_t LowMcConstants::getRank(Matrix matrix) {
+  size_t rank = 0;
+  for (size_t j = 0; j < kBlockWidth && rank < kBlockWidth; j++) {
+    size_t pivot = rank;
+    while (pivot < kBlockWidth && !getBit(matrix[pivot], j)) {
+      pivot++;
+    }
+    if (pivot == kBlockWidth) {
+      continue;
+    }
+    std::swap(matrix[pivot], matrix[rank]);
+    for (size_t i = 0; i < kBlockWidth; i++) {
+      if (i != rank && getBit(matrix[i], j)) {
+        matrix[i][0] ^= matrix[rank][0];
+        matrix[i][1] ^= matrix[rank][1];
+      }
+    }
+    rank++;
+  }
+  return rank;
+}
+
+} // namespace fbpcf::mpc_std_lib::prf
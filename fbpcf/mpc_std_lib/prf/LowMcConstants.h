@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fbpcf::mpc_std_lib::prf {
+
+/**
+ * The public constants of a LowMC instance with 128-bit blocks and keys: the
+ * linear layers, round constants and key matrices of every round. They are
+ * generated from a fixed seed, so all the parties get the same ones.
+ *
+ * These are not the constants of the LowMC reference implementation, which
+ * come from its Grain LFSR: they are drawn from an AES-based PRG instead, so
+ * no published test vector applies to them. The block width, key width,
+ * number of S-boxes and number of rounds are those of the Picnic L1 instance
+ * LowMC-128-128-10-20 (The Picnic Signature Scheme Design Document), which
+ * only claims 128-bit security against an attacker who sees a single
+ * plaintext/ciphertext pair under a key. It makes no claim when one key
+ * encrypts many chosen inputs.
+ */
+class LowMcConstants {
+ public:
+  static constexpr size_t kBlockWidth = 128;
+  static constexpr size_t kRounds = 20;
+  static constexpr size_t kSBoxes = 10;
+
+  // a row of a matrix (or a vector), the j-th bit being the (j % 64)-th bit of
+  // the (j / 64)-th word.
+  using Row = std::array<uint64_t, 2>;
+  using Matrix = std::array<Row, kBlockWidth>;
+
+  LowMcConstants();
+
+  // the linear layer of the round-th round, round = 1, ..., kRounds.
+  const Matrix& getLinearLayer(size_t round) const {
+    return linearLayers_.at(round - 1);
+  }
+
+  // the constant of the round-th round, round = 1, ..., kRounds.
+  const Row& getRoundConstant(size_t round) const {
+    return roundConstants_.at(round - 1);
+  }
+
+  // the key matrix of the round-th round key, round = 0, ..., kRounds.
+  const Matrix& getKeyMatrix(size_t round) const {
+    return keyMatrices_.at(round);
+  }
+
+  static bool getBit(const Row& row, size_t j) {
+    return (row[j >> 6] >> (j & 63)) & 1;
+  }
+
+  static size_t getRank(Matrix matrix);
+
+ private:
+  std::vector<Matrix> linearLayers_;
+  std::vector<Row> roundConstants_;
+  std::vector<Matrix> keyMatrices_;
+};
+
+} // namespace fbpcf::mpc_std_lib::prf
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "fbpcf/mpc_std_lib/prf/IPrfEvaluator.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcConstants.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+/**
+ * This evaluator uses LowMC as the PRF, a block cipher designed for MPC. Read
+ * more about it: Albrecht, M. et al. Ciphers for MPC and FHE. EUROCRYPT 2015.
+ * The instance here has 128-bit blocks and keys and 20 rounds of 10 3-bit
+ * S-boxes: 600 AND gates in 20 layers per block, where AES takes 5440 AND
+ * gates in 40 layers. The rest of each round is linear and free; with secret
+ * batch MPC bits, the linear layers are computed on the local shares.
+ *
+ * The parameters only target an attacker with a single input/output pair per
+ * key, see LowMcConstants, so it isn't secure for many inputs per key.
+ */
+template <typename BitType>
+class LowMcPrfEvaluator final : public IPrfEvaluator<BitType> {
+ public:
+  using IPrfEvaluator<BitType>::evaluate;
+
+  bool isSecureForManyInputsPerKey() const override {
+    return false;
+  }
+
+  /**
+   * Expand the key into the round keys and keep them for the following
+   * evaluate(input) calls.
+   * @param key the key inside MPC. It must be kKeyWidth bits.
+   */
+  void cacheKey(const std::vector<BitType>& key);
+
+  /**
+   * Evaluate the PRF on the input under the cached key.
+   * @param input the input inside MPC. It must be kInputWidth bits.
+   * @return the kOutputWidth bits of the output inside MPC.
+   */
+  std::vector<BitType> evaluate(const std::vector<BitType>& input) const;
+
+ private:
+  using StateType = std::array<BitType, LowMcConstants::kBlockWidth>;
+
+  std::vector<BitType> evaluate_impl(
+      const std::vector<BitType>& input,
+      const std::vector<BitType>& key) const override;
+
+  std::vector<StateType> expandKey(const std::vector<BitType>& key) const;
+
+  std::vector<BitType> encrypt(
+      const std::vector<BitType>& input,
+      const std::vector<StateType>& roundKeys) const;
+
+  void sBoxLayerInPlace(StateType& state) const;
+
+  template <typename VectorType>
+  StateType multiply(
+      const LowMcConstants::Matrix& matrix,
+      const VectorType& src) const;
+
+  template <typename VectorType>
+  StateType multiplyShares(
+      const LowMcConstants::Matrix& matrix,
+      const VectorType& src) const;
+
+  LowMcConstants constants_;
+  std::vector<StateType> cachedRoundKeys_;
+};
+
+} // namespace fbpcf::mpc_std_lib::prf
+
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluator_impl.h"
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/mpc_std_lib/prf/IPrfEvaluatorFactory.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluator.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+template <typename BitType>
+class LowMcPrfEvaluatorFactory final : public IPrfEvaluatorFactory<BitType> {
+ public:
+  std::unique_ptr<IPrfEvaluator<BitType>> create() override {
+    return std::make_unique<LowMcPrfEvaluator<BitType>>();
+  }
+};
+
+} // namespace fbpcf::mpc_std_lib::prf
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluator.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+namespace detail {
+
+template <typename BitType>
+struct IsSecretBatchBit : std::false_type {};
+
+template <int schedulerId>
+struct IsSecretBatchBit<frontend::Bit<true, schedulerId, true>>
+    : std::true_type {};
+
+} // namespace detail
+
+template <typename BitType>
+void LowMcPrfEvaluator<BitType>::cacheKey(const std::vector<BitType>& key) {
+  if (key.size() != IPrfEvaluator<BitType>::kKeyWidth) {
+    throw std::runtime_error("PRF key must be 128 bits.");
+  }
+  cachedRoundKeys_ = expandKey(key);
+}
+
+template <typename BitType>
+std::vector<BitType> LowMcPrfEvaluator<BitType>::evaluate(
+    const std::vector<BitType>& input) const {
+  if (input.size() != IPrfEvaluator<BitType>::kInputWidth) {
+    throw std::runtime_error("PRF input must be 128 bits.");
+  }
+  if (cachedRoundKeys_.empty()) {
+    throw std::runtime_error("No PRF key is cached.");
+  }
+  return encrypt(input, cachedRoundKeys_);
+}
+
+template <typename BitType>
+std::vector<BitType> LowMcPrfEvaluator<BitType>::evaluate_impl(
+    const std::vector<BitType>& input,
+    const std::vector<BitType>& key) const {
+  return encrypt(input, expandKey(key));
+}
+
+template <typename BitType>
+std::vector<typename LowMcPrfEvaluator<BitType>::StateType>
+LowMcPrfEvaluator<BitType>::expandKey(const std::vector<BitType>& key) const {
+  std::vector<StateType> rst;
+  rst.reserve(LowMcConstants::kRounds + 1);
+  for (size_t round = 0; round <= LowMcConstants::kRounds; round++) {
+    rst.push_back(multiply(constants_.getKeyMatrix(round), key));
+  }
+  return rst;
+}
+
+template <typename BitType>
+std::vector<BitType> LowMcPrfEvaluator<BitType>::encrypt(
+    const std::vector<BitType>& input,
+    const std::vector<StateType>& roundKeys) const {
+  StateType state;
+  for (size_t j = 0; j < LowMcConstants::kBlockWidth; j++) {
+    state[j] = input.at(j) ^ roundKeys.at(0)[j];
+  }
+  for (size_t round = 1; round <= LowMcConstants::kRounds; round++) {
+    sBoxLayerInPlace(state);
+    state = multiply(constants_.getLinearLayer(round), state);
+    auto& roundConstant = constants_.getRoundConstant(round);
+    for (size_t j = 0; j < LowMcConstants::kBlockWidth; j++) {
+      if (LowMcConstants::getBit(roundConstant, j)) {
+        state[j] = !(state[j] ^ roundKeys.at(round)[j]);
+      } else {
+        state[j] = state[j] ^ roundKeys.at(round)[j];
+      }
+    }
+  }
+  return std::vector<BitType>(state.begin(), state.end());
+}
+
+// Each S-box maps the bits (a, b, c) = (3i + 2, 3i + 1, 3i) to
+// (a ^ bc, a ^ b ^ ca, a ^ b ^ c ^ ab), the rest of the state is unchanged.
+template <typename BitType>
+void LowMcPrfEvaluator<BitType>::sBoxLayerInPlace(StateType& state) const {
+  for (size_t i = 0; i < LowMcConstants::kSBoxes; i++) {
+    auto& a = state[3 * i + 2];
+    auto& b = state[3 * i + 1];
+    auto& c = state[3 * i];
+    auto ab = a & b;
+    auto bc = b & c;
+    auto ca = c & a;
+    auto aXorB = a ^ b;
+    c = aXorB ^ c ^ ab;
+    b = aXorB ^ ca;
+    a = a ^ bc;
+  }
+}
+
+template <typename BitType>
+template <typename VectorType>
+typename LowMcPrfEvaluator<BitType>::StateType
+LowMcPrfEvaluator<BitType>::multiply(
+    const LowMcConstants::Matrix& matrix,
+    const VectorType& src) const {
+  if constexpr (detail::IsSecretBatchBit<BitType>::value) {
+    return multiplyShares(matrix, src);
+  } else {
+    StateType rst;
+    for (size_t i = 0; i < LowMcConstants::kBlockWidth; i++) {
+      // the matrices are invertible, so no row is empty.
+      bool isEmpty = true;
+      for (size_t j = 0; j < LowMcConstants::kBlockWidth; j++) {
+        if (!LowMcConstants::getBit(matrix[i], j)) {
+          continue;
+        }
+        if (isEmpty) {
+          rst[i] = src[j];
+          isEmpty = false;
+        } else {
+          rst[i] = rst[i] ^ src[j];
+        }
+      }
+    }
+    return rst;
+  }
+}
+
+// XOR shares are linear, so each party multiplies its own shares, packed 64
+// values per word, instead of issuing one XOR gate per term.
+template <typename BitType>
+template <typename VectorType>
+typename LowMcPrfEvaluator<BitType>::StateType
+LowMcPrfEvaluator<BitType>::multiplyShares(
+    const LowMcConstants::Matrix& matrix,
+    const VectorType& src) const {
+  std::vector<std::vector<uint64_t>> words(LowMcConstants::kBlockWidth);
+  size_t batchSize = 0;
+  for (size_t j = 0; j < LowMcConstants::kBlockWidth; j++) {
+    auto shares = src[j].extractBit().getValue();
+    batchSize = shares.size();
+    words[j].resize((batchSize + 63) >> 6, 0);
+    for (size_t k = 0; k < batchSize; k++) {
+      words[j][k >> 6] |= static_cast<uint64_t>(shares[k]) << (k & 63);
+    }
+  }
+
+  StateType rst;
+  std::vector<uint64_t> sum((batchSize + 63) >> 6);
+  for (size_t i = 0; i < LowMcConstants::kBlockWidth; i++) {
+    std::fill(sum.begin(), sum.end(), 0);
+    for (size_t j = 0; j < LowMcConstants::kBlockWidth; j++) {
+      if (LowMcConstants::getBit(matrix[i], j)) {
+        for (size_t w = 0; w < sum.size(); w++) {
+          sum[w] ^= words[j][w];
+        }
+      }
+    }
+    std::vector<bool> shares(batchSize);
+    for (size_t k = 0; k < batchSize; k++) {
+      shares[k] = (sum[k >> 6] >> (k & 63)) & 1;
+    }
+    rst[i] = BitType(typename BitType::ExtractedBit(shares));
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::prf
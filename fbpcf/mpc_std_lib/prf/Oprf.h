@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/prf/IPrfEvaluator.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+/**
+ * An oblivious PRF: one party holds the key and the other one a batch of
+ * inputs, only the latter learns the PRF values, and neither of them learns
+ * the other one's private input. The key and the inputs enter the circuit as
+ * shares whose other half is zero, so there is no communication other than
+ * the evaluation of the PRF itself.
+ *
+ * The input holder gets the PRF values of as many inputs of its choice as it
+ * wants under one key, so the PRF must be secure in that setting. An
+ * evaluator that doesn't claim it, like LowMcPrfEvaluator, is rejected unless
+ * the caller explicitly accepts it, e.g. in tests and benchmarks.
+ */
+template <int schedulerId>
+class Oprf {
+ public:
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+  /**
+   * @param allowInsecureEvaluator whether to accept an evaluator that isn't
+   * claimed secure for many inputs per key.
+   */
+  Oprf(
+      int myId,
+      int partnerId,
+      std::unique_ptr<IPrfEvaluator<SecBit>> evaluator,
+      bool allowInsecureEvaluator = false)
+      : myId_(myId), partnerId_(partnerId), evaluator_(std::move(evaluator)) {
+    if (!allowInsecureEvaluator && !evaluator_->isSecureForManyInputsPerKey()) {
+      throw std::invalid_argument(
+          "The PRF isn't claimed secure for many inputs per key, which an "
+          "oblivious PRF needs.");
+    }
+  }
+
+  /**
+   * The key holder's side of the evaluation.
+   * @param key the PRF key.
+   * @param batchSize the number of inputs of the other party.
+   */
+  void evaluate(__m128i key, size_t batchSize) const;
+
+  /**
+   * The input holder's side of the evaluation.
+   * @param inputs the PRF inputs.
+   * @return the PRF values of the inputs under the other party's key.
+   */
+  std::vector<__m128i> evaluate(const std::vector<__m128i>& inputs) const;
+
+ private:
+  // the i-th bit of the j-th block goes to the j-th value of the i-th bit.
+  static std::vector<std::vector<bool>> transpose(
+      const std::vector<__m128i>& blocks);
+
+  static std::vector<SecBit> processPrivateInputs(
+      const std::vector<std::vector<bool>>& shares);
+
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<IPrfEvaluator<SecBit>> evaluator_;
+};
+
+} // namespace fbpcf::mpc_std_lib::prf
+
+#include "fbpcf/mpc_std_lib/prf/Oprf_impl.h"
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/mpc_std_lib/prf/Oprf.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+template <int schedulerId>
+void Oprf<schedulerId>::evaluate(__m128i key, size_t batchSize) const {
+  if (batchSize == 0) {
+    throw std::invalid_argument("Empty input!");
+  }
+  std::vector<std::vector<bool>> noInputs(
+      IPrfEvaluator<SecBit>::kInputWidth, std::vector<bool>(batchSize, false));
+  auto output = evaluator_->evaluate(
+      processPrivateInputs(noInputs),
+      processPrivateInputs(transpose(std::vector<__m128i>(batchSize, key))));
+
+  std::vector<frontend::Bit<false, schedulerId, true>> opened;
+  opened.reserve(output.size());
+  for (auto& bit : output) {
+    opened.push_back(bit.openToParty(partnerId_));
+  }
+  for (auto& bit : opened) {
+    bit.getValue();
+  }
+}
+
+template <int schedulerId>
+std::vector<__m128i> Oprf<schedulerId>::evaluate(
+    const std::vector<__m128i>& inputs) const {
+  if (inputs.empty()) {
+    throw std::invalid_argument("Empty input!");
+  }
+  std::vector<std::vector<bool>> noKey(
+      IPrfEvaluator<SecBit>::kKeyWidth,
+      std::vector<bool>(inputs.size(), false));
+  auto output = evaluator_->evaluate(
+      processPrivateInputs(transpose(inputs)), processPrivateInputs(noKey));
+
+  std::vector<frontend::Bit<false, schedulerId, true>> opened;
+  opened.reserve(output.size());
+  for (auto& bit : output) {
+    opened.push_back(bit.openToParty(myId_));
+  }
+  std::vector<uint64_t> words(2 * inputs.size(), 0);
+  for (size_t i = 0; i < opened.size(); i++) {
+    auto values = opened[i].getValue();
+    for (size_t j = 0; j < inputs.size(); j++) {
+      words[2 * j + (i >> 6)] |= static_cast<uint64_t>(values.at(j))
+          << (i & 63);
+    }
+  }
+  std::vector<__m128i> rst(inputs.size());
+  std::memcpy(rst.data(), words.data(), rst.size() * sizeof(__m128i));
+  return rst;
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> Oprf<schedulerId>::transpose(
+    const std::vector<__m128i>& blocks) {
+  std::vector<std::vector<bool>> rst(128, std::vector<bool>(blocks.size()));
+  uint64_t words[2];
+  for (size_t j = 0; j < blocks.size(); j++) {
+    std::memcpy(words, &blocks[j], sizeof(words));
+    for (size_t i = 0; i < 128; i++) {
+      rst[i][j] = (words[i >> 6] >> (i & 63)) & 1;
+    }
+  }
+  return rst;
+}
+
+// The private inputs are fed as shares directly, the party not holding them
+// provides zero shares.
+template <int schedulerId>
+std::vector<typename Oprf<schedulerId>::SecBit>
+Oprf<schedulerId>::processPrivateInputs(
+    const std::vector<std::vector<bool>>& shares) {
+  std::vector<SecBit> rst;
+  rst.reserve(shares.size());
+  for (auto& share : shares) {
+    rst.push_back(SecBit(typename SecBit::ExtractedBit(share)));
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::prf
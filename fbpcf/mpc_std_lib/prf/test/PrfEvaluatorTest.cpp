@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <random>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcConstants.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluator.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluatorFactory.h"
+#include "fbpcf/mpc_std_lib/prf/Oprf.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+using Row = LowMcConstants::Row;
+
+Row generateRandomRow() {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist;
+  return {dist(e), dist(e)};
+}
+
+std::vector<bool> rowToBits(const Row& row) {
+  std::vector<bool> rst(LowMcConstants::kBlockWidth);
+  for (size_t j = 0; j < rst.size(); j++) {
+    rst[j] = LowMcConstants::getBit(row, j);
+  }
+  return rst;
+}
+
+Row multiply(const LowMcConstants::Matrix& matrix, const Row& src) {
+  Row rst = {0, 0};
+  for (size_t i = 0; i < LowMcConstants::kBlockWidth; i++) {
+    uint64_t parity = __builtin_parityll(matrix[i][0] & src[0]) ^
+        __builtin_parityll(matrix[i][1] & src[1]);
+    rst[i >> 6] |= parity << (i & 63);
+  }
+  return rst;
+}
+
+// a straightforward plaintext LowMC on 128-bit rows.
+Row referenceLowMc(const Row& input, const Row& key) {
+  LowMcConstants constants;
+  auto roundKey = multiply(constants.getKeyMatrix(0), key);
+  Row state = {input[0] ^ roundKey[0], input[1] ^ roundKey[1]};
+  for (size_t round = 1; round <= LowMcConstants::kRounds; round++) {
+    auto bits = rowToBits(state);
+    for (size_t i = 0; i < LowMcConstants::kSBoxes; i++) {
+      bool a = bits[3 * i + 2];
+      bool b = bits[3 * i + 1];
+      bool c = bits[3 * i];
+      bits[3 * i + 2] = a ^ (b & c);
+      bits[3 * i + 1] = a ^ b ^ (a & c);
+      bits[3 * i] = a ^ b ^ c ^ (a & b);
+    }
+    state = {0, 0};
+    for (size_t j = 0; j < bits.size(); j++) {
+      state[j >> 6] |= static_cast<uint64_t>(bits[j]) << (j & 63);
+    }
+    state = multiply(constants.getLinearLayer(round), state);
+    roundKey = multiply(constants.getKeyMatrix(round), key);
+    auto& roundConstant = constants.getRoundConstant(round);
+    for (size_t k = 0; k < 2; k++) {
+      state[k] ^= roundConstant[k] ^ roundKey[k];
+    }
+  }
+  return state;
+}
+
+TEST(LowMcConstantsTest, testMatricesAreInvertible) {
+  LowMcConstants constants;
+  for (size_t round = 1; round <= LowMcConstants::kRounds; round++) {
+    EXPECT_EQ(
+        LowMcConstants::getRank(constants.getLinearLayer(round)),
+        LowMcConstants::kBlockWidth);
+  }
+  for (size_t round = 0; round <= LowMcConstants::kRounds; round++) {
+    EXPECT_EQ(
+        LowMcConstants::getRank(constants.getKeyMatrix(round)),
+        LowMcConstants::kBlockWidth);
+  }
+  LowMcConstants::Matrix singular = constants.getLinearLayer(1);
+  singular[5] = singular[3];
+  EXPECT_EQ(LowMcConstants::getRank(singular), LowMcConstants::kBlockWidth - 1);
+}
+
+TEST(PrfEvaluatorTest, testLowMcInPlaintext) {
+  LowMcPrfEvaluator<bool> evaluator;
+  auto key = generateRandomRow();
+  evaluator.cacheKey(rowToBits(key));
+  for (int i = 0; i < 5; i++) {
+    auto input = generateRandomRow();
+    auto expected = rowToBits(referenceLowMc(input, key));
+    testVectorEq(
+        evaluator.evaluate(rowToBits(input), rowToBits(key)), expected);
+    testVectorEq(evaluator.evaluate(rowToBits(input)), expected);
+  }
+}
+
+TEST(PrfEvaluatorTest, testInvalidInput) {
+  LowMcPrfEvaluator<bool> evaluator;
+  std::vector<bool> bits(LowMcConstants::kBlockWidth);
+  EXPECT_THROW(evaluator.evaluate(bits), std::runtime_error);
+  EXPECT_THROW(
+      evaluator.evaluate(std::vector<bool>(127), bits), std::runtime_error);
+  EXPECT_THROW(
+      evaluator.evaluate(bits, std::vector<bool>(129)), std::runtime_error);
+  EXPECT_THROW(evaluator.cacheKey(std::vector<bool>(1)), std::runtime_error);
+}
+
+// party 0 provides the inputs and party 1 the keys, one key per input.
+template <int schedulerId>
+std::vector<std::vector<bool>> lowMcTask(
+    const std::vector<std::vector<bool>>& inputs,
+    const std::vector<std::vector<bool>>& keys) {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+  std::vector<SecBit> secInputs;
+  for (auto& bits : inputs) {
+    secInputs.push_back(SecBit(bits, 0));
+  }
+  std::vector<SecBit> secKeys;
+  for (auto& bits : keys) {
+    secKeys.push_back(SecBit(bits, 1));
+  }
+  auto evaluator = LowMcPrfEvaluatorFactory<SecBit>().create();
+  auto output = evaluator->evaluate(secInputs, secKeys);
+  std::vector<std::vector<bool>> rst;
+  for (auto& bit : output) {
+    rst.push_back(bit.openToParty(0).getValue());
+  }
+  return rst;
+}
+
+std::vector<std::vector<bool>> transpose(const std::vector<Row>& rows) {
+  std::vector<std::vector<bool>> rst(
+      LowMcConstants::kBlockWidth, std::vector<bool>(rows.size()));
+  for (size_t j = 0; j < rows.size(); j++) {
+    for (size_t i = 0; i < LowMcConstants::kBlockWidth; i++) {
+      rst[i][j] = LowMcConstants::getBit(rows[j], i);
+    }
+  }
+  return rst;
+}
+
+TEST(PrfEvaluatorTest, testLowMcInMpc) {
+  const size_t kBatchSize = 17;
+  std::vector<Row> inputs(kBatchSize);
+  std::vector<Row> keys(kBatchSize);
+  std::vector<Row> expected(kBatchSize);
+  for (size_t i = 0; i < kBatchSize; i++) {
+    inputs[i] = generateRandomRow();
+    keys[i] = generateRandomRow();
+    expected[i] = referenceLowMc(inputs[i], keys[i]);
+  }
+
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  auto future0 = std::async(lowMcTask<0>, transpose(inputs), transpose(keys));
+  auto future1 = std::async(lowMcTask<1>, transpose(inputs), transpose(keys));
+  auto rst = future0.get();
+  future1.get();
+
+  auto expectedBits = transpose(expected);
+  ASSERT_EQ(rst.size(), expectedBits.size());
+  for (size_t i = 0; i < rst.size(); i++) {
+    testVectorEq(rst.at(i), expectedBits.at(i));
+  }
+}
+
+TEST(PrfEvaluatorTest, testOprfRejectsLowMcByDefault) {
+  EXPECT_THROW(
+      Oprf<0>(
+          0,
+          1,
+          LowMcPrfEvaluatorFactory<frontend::Bit<true, 0, true>>().create()),
+      std::invalid_argument);
+}
+
+TEST(PrfEvaluatorTest, testOprf) {
+  const size_t kBatchSize = 33;
+  auto key = generateRandomRow();
+  __m128i keyBlock;
+  std::memcpy(&keyBlock, key.data(), sizeof(keyBlock));
+  std::vector<__m128i> inputs(kBatchSize);
+  std::vector<Row> expected(kBatchSize);
+  for (size_t i = 0; i < kBatchSize; i++) {
+    auto input = generateRandomRow();
+    std::memcpy(&inputs[i], input.data(), sizeof(__m128i));
+    expected[i] = referenceLowMc(input, key);
+  }
+
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  // LowMC isn't claimed secure for many inputs per key, which only matters
+  // for the security, not the correctness tested here.
+  auto keyHolderTask = [&keyBlock]() {
+    Oprf<0> oprf(
+        0,
+        1,
+        LowMcPrfEvaluatorFactory<frontend::Bit<true, 0, true>>().create(),
+        true);
+    oprf.evaluate(keyBlock, kBatchSize);
+  };
+  auto inputHolderTask = [&inputs]() {
+    Oprf<1> oprf(
+        1,
+        0,
+        LowMcPrfEvaluatorFactory<frontend::Bit<true, 1, true>>().create(),
+        true);
+    return oprf.evaluate(inputs);
+  };
+  auto future0 = std::async(keyHolderTask);
+  auto future1 = std::async(inputHolderTask);
+  future0.get();
+  auto rst = future1.get();
+
+  ASSERT_EQ(rst.size(), kBatchSize);
+  for (size_t i = 0; i < kBatchSize; i++) {
+    Row row;
+    std::memcpy(row.data(), &rst[i], sizeof(__m128i));
+    EXPECT_EQ(row, expected[i]);
+  }
+}
+
+} // namespace fbpcf::mpc_std_lib::prf
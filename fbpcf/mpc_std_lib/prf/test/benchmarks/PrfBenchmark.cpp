@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BatchedAesCircuit.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluator.h"
+#include "fbpcf/mpc_std_lib/prf/LowMcPrfEvaluatorFactory.h"
+#include "fbpcf/mpc_std_lib/prf/Oprf.h"
+#include "fbpcf/mpc_std_lib/util/test/benchmarks/AndCountingBit.h"
+#include "fbpcf/mpc_std_lib/util/test/benchmarks/TwoPartyMpcBenchmark.h"
+
+namespace fbpcf::mpc_std_lib::prf {
+
+const size_t kCountingBatchSize = 1024;
+
+BENCHMARK_COUNTERS(LowMcPrfEvaluator_AndCount, counters) {
+  std::vector<util::AndCountingBit> input(
+      IPrfEvaluator<util::AndCountingBit>::kInputWidth,
+      util::AndCountingBit(kCountingBatchSize));
+  std::vector<util::AndCountingBit> key(
+      IPrfEvaluator<util::AndCountingBit>::kKeyWidth,
+      util::AndCountingBit(kCountingBatchSize));
+  util::AndCountingBit::resetCounters();
+  LowMcPrfEvaluator<util::AndCountingBit>().evaluate(input, key);
+  util::AndCountingBit::reportCounters(counters, kCountingBatchSize);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_AndCount, counters) {
+  std::vector<util::AndCountingBit> plaintext(
+      128, util::AndCountingBit(kCountingBatchSize));
+  std::vector<util::AndCountingBit> key(
+      aes_circuit::IAesCircuit<util::AndCountingBit>::kExpandedKeyWidth,
+      util::AndCountingBit(kCountingBatchSize));
+  util::AndCountingBit::resetCounters();
+  aes_circuit::BatchedAesCircuit<util::AndCountingBit>(kCountingBatchSize)
+      .encrypt(plaintext, key);
+  util::AndCountingBit::reportCounters(counters, kCountingBatchSize);
+}
+
+/**
+ * Party 0 provides the inputs and party 1 the key, and the outputs are opened
+ * to party 0.
+ */
+class BasePrfBenchmark : public util::TwoPartyMpcBenchmark {
+ public:
+  explicit BasePrfBenchmark(size_t batchSize) : batchSize_(batchSize) {}
+
+  void setup() override {
+    util::TwoPartyMpcBenchmark::setup();
+    input_ = generateRandomBatches(128, batchSize_);
+    key_ = generateRandomConstantBatches(getKeyWidth(), batchSize_);
+  }
+
+ protected:
+  void runParty0() override {
+    openToParty0<0>(
+        runPrf0(processInputs<0>(input_, 0), processInputs<0>(key_, 1)));
+  }
+
+  void runParty1() override {
+    openToParty0<1>(
+        runPrf1(processInputs<1>(input_, 0), processInputs<1>(key_, 1)));
+  }
+
+  virtual size_t getKeyWidth() const = 0;
+
+  virtual std::vector<SecBit<0>> runPrf0(
+      const std::vector<SecBit<0>>& input,
+      const std::vector<SecBit<0>>& key) = 0;
+  virtual std::vector<SecBit<1>> runPrf1(
+      const std::vector<SecBit<1>>& input,
+      const std::vector<SecBit<1>>& key) = 0;
+
+  size_t batchSize_;
+
+ private:
+  std::vector<std::vector<bool>> input_;
+  std::vector<std::vector<bool>> key_;
+};
+
+class LowMcPrfEvaluatorBenchmark : public BasePrfBenchmark {
+ public:
+  using BasePrfBenchmark::BasePrfBenchmark;
+
+ protected:
+  size_t getKeyWidth() const override {
+    return IPrfEvaluator<bool>::kKeyWidth;
+  }
+
+  std::vector<SecBit<0>> runPrf0(
+      const std::vector<SecBit<0>>& input,
+      const std::vector<SecBit<0>>& key) override {
+    return LowMcPrfEvaluatorFactory<SecBit<0>>().create()->evaluate(input, key);
+  }
+
+  std::vector<SecBit<1>> runPrf1(
+      const std::vector<SecBit<1>>& input,
+      const std::vector<SecBit<1>>& key) override {
+    return LowMcPrfEvaluatorFactory<SecBit<1>>().create()->evaluate(input, key);
+  }
+};
+
+// AES takes the expanded key, as there is no key expansion inside MPC.
+class BatchedAesCircuitBenchmark : public BasePrfBenchmark {
+ public:
+  using BasePrfBenchmark::BasePrfBenchmark;
+
+ protected:
+  size_t getKeyWidth() const override {
+    return aes_circuit::IAesCircuit<bool>::kExpandedKeyWidth;
+  }
+
+  std::vector<SecBit<0>> runPrf0(
+      const std::vector<SecBit<0>>& input,
+      const std::vector<SecBit<0>>& key) override {
+    return aes_circuit::BatchedAesCircuit<SecBit<0>>(batchSize_)
+        .encrypt(input, key);
+  }
+
+  std::vector<SecBit<1>> runPrf1(
+      const std::vector<SecBit<1>>& input,
+      const std::vector<SecBit<1>>& key) override {
+    return aes_circuit::BatchedAesCircuit<SecBit<1>>(batchSize_)
+        .encrypt(input, key);
+  }
+};
+
+// LowMC isn't claimed secure for many inputs per key, this only measures the
+// cost of the evaluation.
+class OprfBenchmark : public util::TwoPartyMpcBenchmark {
+ public:
+  explicit OprfBenchmark(size_t batchSize) : batchSize_(batchSize) {}
+
+  void setup() override {
+    util::TwoPartyMpcBenchmark::setup();
+    key_ = engine::util::getRandomM128iFromSystemNoise();
+    inputs_ = std::vector<__m128i>(batchSize_);
+    for (auto& item : inputs_) {
+      item = engine::util::getRandomM128iFromSystemNoise();
+    }
+  }
+
+ protected:
+  void initParty0() override {
+    oprf0_ = std::make_unique<Oprf<0>>(
+        0, 1, LowMcPrfEvaluatorFactory<SecBit<0>>().create(), true);
+  }
+
+  void runParty0() override {
+    oprf0_->evaluate(key_, batchSize_);
+  }
+
+  void initParty1() override {
+    oprf1_ = std::make_unique<Oprf<1>>(
+        1, 0, LowMcPrfEvaluatorFactory<SecBit<1>>().create(), true);
+  }
+
+  void runParty1() override {
+    oprf1_->evaluate(inputs_);
+  }
+
+ private:
+  size_t batchSize_;
+  __m128i key_;
+  std::vector<__m128i> inputs_;
+
+  std::unique_ptr<Oprf<0>> oprf0_;
+  std::unique_ptr<Oprf<1>> oprf1_;
+};
+
+BENCHMARK_COUNTERS(LowMcPrfEvaluator_Benchmark, counters) {
+  LowMcPrfEvaluatorBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_Benchmark, counters) {
+  BatchedAesCircuitBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(Oprf_Benchmark, counters) {
+  OprfBenchmark benchmark(1024);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(LowMcPrfEvaluator_16K_Benchmark, counters) {
+  LowMcPrfEvaluatorBenchmark benchmark(16384);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BatchedAesCircuit_16K_Benchmark, counters) {
+  BatchedAesCircuitBenchmark benchmark(16384);
+  benchmark.runBenchmark(counters);
+}
+} // namespace fbpcf::mpc_std_lib::prf
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/engine/util/IPrg.h"
+#include "fbpcf/mpc_std_lib/shuffler/IShuffler.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslator.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+/**
+ * This shuffler works on the XOR shares of the values directly: both parties
+ * permute the shares with a share translator, each to a random order of its
+ * own. Unlike PermuteBasedShuffler, there are no AND gates to evaluate; the
+ * cost is mostly local AES and the communication doesn't grow with the number
+ * of levels of the switching network times the width of the values.
+ */
+template <typename T, int schedulerId>
+class ShareTranslationBasedShuffler final
+    : public IShuffler<typename util::SecBatchType<T, schedulerId>::type> {
+ public:
+  using SecBatchType = typename util::SecBatchType<T, schedulerId>::type;
+
+  ShareTranslationBasedShuffler(
+      int myId,
+      int partnerId,
+      std::unique_ptr<ShareTranslator> translator,
+      std::unique_ptr<engine::util::IPrg> prg)
+      : myId_(myId),
+        partnerId_(partnerId),
+        translator_(std::move(translator)),
+        prg_(std::move(prg)) {}
+
+  SecBatchType shuffle(const SecBatchType& src, size_t size) const override {
+    auto shares =
+        util::MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(src);
+    auto width = shares.size();
+    auto rows = packRows(shares, size);
+    auto myRandomPermutation = generateRandomPermutation(size);
+    if (myId_ < partnerId_) {
+      rows = translator_->permute(rows, width, myRandomPermutation);
+      rows = translator_->permute(rows, size, width);
+    } else {
+      rows = translator_->permute(rows, size, width);
+      rows = translator_->permute(rows, width, myRandomPermutation);
+    }
+    return util::MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(
+        unpackRows(rows, width, size));
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const {
+    return translator_->getTrafficStatistics();
+  }
+
+ private:
+  // the i-th row holds the i-th bit of every vector.
+  static std::vector<__m128i> packRows(
+      const std::vector<std::vector<bool>>& shares,
+      size_t size) {
+    auto blocksPerRow = ShareTranslator::getBlocksPerRow(shares.size());
+    std::vector<__m128i> rst(size * blocksPerRow, _mm_set_epi64x(0, 0));
+    std::vector<uint64_t> words(2 * blocksPerRow);
+    for (size_t i = 0; i < shares.size(); i++) {
+      if (shares[i].size() != size) {
+        throw std::invalid_argument("Inconsistent size.");
+      }
+    }
+    for (size_t j = 0; j < size; j++) {
+      std::fill(words.begin(), words.end(), 0);
+      for (size_t i = 0; i < shares.size(); i++) {
+        words[i >> 6] |= static_cast<uint64_t>(shares[i][j]) << (i & 63);
+      }
+      std::memcpy(
+          rst.data() + j * blocksPerRow,
+          words.data(),
+          blocksPerRow * sizeof(__m128i));
+    }
+    return rst;
+  }
+
+  static std::vector<std::vector<bool>>
+  unpackRows(const std::vector<__m128i>& rows, size_t width, size_t size) {
+    auto blocksPerRow = ShareTranslator::getBlocksPerRow(width);
+    std::vector<std::vector<bool>> rst(width, std::vector<bool>(size));
+    std::vector<uint64_t> words(2 * blocksPerRow);
+    for (size_t j = 0; j < size; j++) {
+      std::memcpy(
+          words.data(),
+          rows.data() + j * blocksPerRow,
+          blocksPerRow * sizeof(__m128i));
+      for (size_t i = 0; i < width; i++) {
+        rst[i][j] = (words[i >> 6] >> (i & 63)) & 1;
+      }
+    }
+    return rst;
+  }
+
+  std::vector<uint32_t> generateRandomPermutation(size_t size) const {
+    std::vector<uint32_t> rst(size);
+    for (size_t i = 0; i < size; i++) {
+      rst[i] = i;
+    }
+    auto randomNumbers = prg_->getRandomUInt64(size);
+    for (size_t i = size; i > 0; i--) {
+      auto position = randomNumbers.at(i - 1) % i;
+      std::swap(rst[position], rst[i - 1]);
+    }
+    return rst;
+  }
+
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<ShareTranslator> translator_;
+  std::unique_ptr<engine::util::IPrg> prg_;
+};
+
+} // namespace fbpcf::mpc_std_lib::shuffler
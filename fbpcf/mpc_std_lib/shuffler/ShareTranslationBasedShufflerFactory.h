@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/util/IPrgFactory.h"
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/mpc_std_lib/shuffler/IShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslationBasedShuffler.h"
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+template <typename T, int schedulerId>
+class ShareTranslationBasedShufflerFactory final
+    : public IShufflerFactory<
+          typename util::SecBatchType<T, schedulerId>::type> {
+ public:
+  using SecBatchType = typename util::SecBatchType<T, schedulerId>::type;
+
+  ShareTranslationBasedShufflerFactory(
+      int myId,
+      int partnerId,
+      engine::communication::IPartyCommunicationAgentFactory& agentFactory,
+      std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                          IRandomCorrelatedObliviousTransferFactory>
+          rcotFactory,
+      std::unique_ptr<engine::util::IPrgFactory> prgFactory,
+      size_t levelsPerLayer = ShareTranslator::kDefaultLevelsPerLayer)
+      : myId_(myId),
+        partnerId_(partnerId),
+        agentFactory_(agentFactory),
+        rcotFactory_(std::move(rcotFactory)),
+        prgFactory_(std::move(prgFactory)),
+        levelsPerLayer_(levelsPerLayer) {}
+
+  /**
+   * The other party needs to call create() at the same time, as the rcots are
+   * initialized here.
+   */
+  std::unique_ptr<IShuffler<SecBatchType>> create() override {
+    __m128i delta = engine::util::getRandomM128iFromSystemNoise();
+    engine::util::setLsbTo1(delta);
+
+    std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                        IRandomCorrelatedObliviousTransfer>
+        senderRcot;
+    std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                        IRandomCorrelatedObliviousTransfer>
+        receiverRcot;
+    if (partnerId_ < myId_) {
+      senderRcot = rcotFactory_->create(
+          delta, agentFactory_.create(partnerId_, "rcot_sender_traffic"));
+      receiverRcot = rcotFactory_->create(
+          agentFactory_.create(partnerId_, "rcot_receiver_traffic"));
+    } else {
+      receiverRcot = rcotFactory_->create(
+          agentFactory_.create(partnerId_, "rcot_receiver_traffic"));
+      senderRcot = rcotFactory_->create(
+          delta, agentFactory_.create(partnerId_, "rcot_sender_traffic"));
+    }
+
+    return std::make_unique<ShareTranslationBasedShuffler<T, schedulerId>>(
+        myId_,
+        partnerId_,
+        std::make_unique<ShareTranslator>(
+            agentFactory_.create(partnerId_, "share_translation_traffic"),
+            delta,
+            std::move(senderRcot),
+            std::move(receiverRcot),
+            levelsPerLayer_),
+        prgFactory_->create(engine::util::getRandomM128iFromSystemNoise()));
+  }
+
+ private:
+  int myId_;
+  int partnerId_;
+  engine::communication::IPartyCommunicationAgentFactory& agentFactory_;
+  std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                      IRandomCorrelatedObliviousTransferFactory>
+      rcotFactory_;
+  std::unique_ptr<engine::util::IPrgFactory> prgFactory_;
+  size_t levelsPerLayer_;
+};
+
+} // namespace fbpcf::mpc_std_lib::shuffler
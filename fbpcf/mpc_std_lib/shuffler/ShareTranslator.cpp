@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+ShareTranslator::ShareTranslator(
+    std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent,
+    __m128i delta,
+    std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                        IRandomCorrelatedObliviousTransfer> senderRcot,
+    std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                        IRandomCorrelatedObliviousTransfer> receiverRcot,
+    size_t levelsPerLayer)
+    : agent_(std::move(agent)),
+      delta_(delta),
+      senderRcot_(std::move(senderRcot)),
+      receiverRcot_(std::move(receiverRcot)),
+      levelsPerLayer_(levelsPerLayer),
+      prg_(engine::util::getRandomM128iFromSystemNoise()),
+      hashFromAes_(engine::util::Aes::getFixedKey()),
+      expanderIndex_(0),
+      hashIndex_(0) {
+  if (levelsPerLayer_ == 0) {
+    throw std::invalid_argument("A layer needs at least one level.");
+  }
+}
+
+std::vector<__m128i> ShareTranslator::permute(
+    const std::vector<__m128i>& shares,
+    size_t width,
+    const std::vector<uint32_t>& order) {
+  auto size = order.size();
+  auto blocksPerRow = getBlocksPerRow(width);
+  auto bytesPerRow = (width + 7) / 8;
+  if (shares.size() != size * blocksPerRow) {
+    throw std::invalid_argument("Inconsistent size.");
+  }
+  auto layers = buildLayers(size, &order);
+
+  // delta = layer(delta ^ (b ^ a')) ^ delta', one layer after another.
+  auto delta = translateLayer(layers.at(0), size, blocksPerRow);
+  for (size_t k = 1; k < layers.size(); k++) {
+    auto layerDelta = translateLayer(layers.at(k), size, blocksPerRow);
+    auto masked = receiveRows(size, blocksPerRow, bytesPerRow);
+    const auto& layerOrder = layers.at(k).order;
+    for (size_t i = 0; i < size; i++) {
+      auto src = layerOrder.at(i) * blocksPerRow;
+      for (size_t j = 0; j < blocksPerRow; j++) {
+        layerDelta[i * blocksPerRow + j] = _mm_xor_si128(
+            layerDelta[i * blocksPerRow + j],
+            _mm_xor_si128(delta[src + j], masked[src + j]));
+      }
+    }
+    delta = std::move(layerDelta);
+  }
+
+  // the other party's shares masked with a
+  auto masked = receiveRows(size, blocksPerRow, bytesPerRow);
+  std::vector<__m128i> rst(size * blocksPerRow);
+  for (size_t i = 0; i < size; i++) {
+    auto src = order.at(i) * blocksPerRow;
+    for (size_t j = 0; j < blocksPerRow; j++) {
+      rst[i * blocksPerRow + j] = _mm_xor_si128(
+          _mm_xor_si128(shares[src + j], masked[src + j]),
+          delta[i * blocksPerRow + j]);
+    }
+  }
+  return rst;
+}
+
+std::vector<__m128i> ShareTranslator::permute(
+    const std::vector<__m128i>& shares,
+    size_t size,
+    size_t width) {
+  auto blocksPerRow = getBlocksPerRow(width);
+  auto bytesPerRow = (width + 7) / 8;
+  if (shares.size() != size * blocksPerRow) {
+    throw std::invalid_argument("Inconsistent size.");
+  }
+  auto layers = buildLayers(size, nullptr);
+
+  auto [a, b] = translateLayer(layers.at(0).blocks, size, blocksPerRow);
+  for (size_t k = 1; k < layers.size(); k++) {
+    auto [layerA, layerB] =
+        translateLayer(layers.at(k).blocks, size, blocksPerRow);
+    for (size_t i = 0; i < b.size(); i++) {
+      b[i] = _mm_xor_si128(b[i], layerA[i]);
+    }
+    sendRows(b, size, blocksPerRow, bytesPerRow);
+    b = std::move(layerB);
+  }
+
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = _mm_xor_si128(a[i], shares[i]);
+  }
+  sendRows(a, size, blocksPerRow, bytesPerRow);
+  return std::move(b);
+}
+
+std::pair<uint64_t, uint64_t> ShareTranslator::getTrafficStatistics() const {
+  auto rst = agent_->getTrafficStatistics();
+  for (auto rcot : {senderRcot_.get(), receiverRcot_.get()}) {
+    auto [sent, received] = rcot->getTrafficStatistics();
+    rst.first += sent;
+    rst.second += received;
+  }
+  return rst;
+}
+
+std::vector<ShareTranslator::Layer> ShareTranslator::buildLayers(
+    size_t size,
+    const std::vector<uint32_t>* order) const {
+  auto levels = permuter::routeAsWaksmanNetwork(size, order);
+
+  std::vector<Layer> rst;
+  size_t start = 0;
+  do {
+    auto end = std::min(start + levelsPerLayer_, levels.size());
+
+    // the elements connected by the switches of the layer form a block.
+    std::vector<uint32_t> parent(size);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t i) {
+      while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    };
+    for (auto l = start; l < end; l++) {
+      for (auto& item : levels.at(l)) {
+        parent[find(item.first)] = find(item.second);
+      }
+    }
+
+    Layer layer;
+    std::vector<uint32_t> blockIndex(size, static_cast<uint32_t>(-1));
+    for (uint32_t i = 0; i < size; i++) {
+      auto root = find(i);
+      if (blockIndex[root] == static_cast<uint32_t>(-1)) {
+        blockIndex[root] = layer.blocks.size();
+        layer.blocks.emplace_back();
+      }
+      layer.blocks[blockIndex[root]].push_back(i);
+    }
+
+    if (order != nullptr) {
+      layer.order.resize(size);
+      std::iota(layer.order.begin(), layer.order.end(), 0);
+      for (auto l = start; l < end; l++) {
+        for (auto& item : levels.at(l)) {
+          if (item.swap) {
+            std::swap(layer.order[item.first], layer.order[item.second]);
+          }
+        }
+      }
+    }
+    rst.push_back(std::move(layer));
+    start = end;
+  } while (start < levels.size());
+  return rst;
+}
+
+/*
+ * In a block of m elements, the other party generates a m x m matrix M and
+ * sets a[j] = sum_i M[i][j], b[i] = sum_j M[i][j]. This party learns every
+ * entry but M[i][order[i]] with a punctured GGM tree per row, which is
+ * enough for delta[i] = a[order[i]] ^ b[i], as M[i][order[i]] cancels out.
+ */
+std::vector<__m128i> ShareTranslator::translateLayer(
+    const Layer& layer,
+    size_t size,
+    size_t blocksPerRow) {
+  std::vector<__m128i> rst(size * blocksPerRow, _mm_set_epi64x(0, 0));
+  auto depth = getDepth(layer.blocks);
+  if (depth == 0) {
+    return rst;
+  }
+
+  std::vector<uint32_t> column(size);
+  for (auto& block : layer.blocks) {
+    for (uint32_t j = 0; j < block.size(); j++) {
+      column[block[j]] = j;
+    }
+  }
+
+  for (auto& batch : getBatches(layer.blocks, depth)) {
+    std::vector<uint32_t> punctured;
+    for (auto b : batch) {
+      for (auto i : layer.blocks.at(b)) {
+        punctured.push_back(column.at(layer.order.at(i)));
+      }
+    }
+    auto rows = punctured.size();
+
+    // derandomize the cots: the choice at each level is the side that is not
+    // on the path to the punctured leaf.
+    auto cot = receiverRcot_->rcot(rows * depth);
+    std::vector<bool> flips(rows * depth);
+    for (size_t t = 0; t < rows; t++) {
+      for (size_t l = 0; l < depth; l++) {
+        bool choice = !((punctured[t] >> (depth - 1 - l)) & 1);
+        flips[t * depth + l] =
+            engine::util::getLsb(cot[t * depth + l]) ^ choice;
+      }
+    }
+    agent_->sendBool(flips);
+    auto masks = agent_->receiveT<__m128i>(2 * rows * depth);
+
+    for (size_t j = 0; j < cot.size(); j++) {
+      cot[j] = _mm_xor_si128(cot[j], _mm_set_epi64x(hashIndex_ + j, 0));
+    }
+    hashFromAes_.inPlaceHash(cot.data(), cot.size());
+    hashIndex_ += cot.size();
+
+    engine::util::Expander expander(expanderIndex_++);
+    std::vector<__m128i> nodes(rows, _mm_set_epi64x(0, 0));
+    std::vector<uint32_t> path(rows, 0);
+    for (size_t l = 0; l < depth; l++) {
+      nodes = expander.expand(std::move(nodes));
+      size_t width = 2 << l;
+      for (size_t t = 0; t < rows; t++) {
+        auto tree = nodes.data() + t * width;
+        bool onPath = (punctured[t] >> (depth - 1 - l)) & 1;
+        size_t positionToFix = 2 * path[t] + !onPath;
+        auto sum = _mm_xor_si128(
+            masks[2 * (t * depth + l) + !onPath], cot[t * depth + l]);
+        for (size_t j = !onPath; j < width; j += 2) {
+          if (j != positionToFix) {
+            sum = _mm_xor_si128(sum, tree[j]);
+          }
+        }
+        tree[positionToFix] = sum;
+        path[t] = 2 * path[t] + onPath;
+      }
+    }
+    auto leaves = expandLeaves(std::move(nodes), blocksPerRow);
+
+    size_t t = 0;
+    std::vector<__m128i> columnSums;
+    for (auto b : batch) {
+      auto& block = layer.blocks.at(b);
+      columnSums.assign(block.size() * blocksPerRow, _mm_set_epi64x(0, 0));
+      for (size_t i = 0; i < block.size(); i++) {
+        auto row = leaves.data() + ((t + i) << depth) * blocksPerRow;
+        auto dst = rst.data() + block[i] * blocksPerRow;
+        for (size_t j = 0; j < block.size(); j++) {
+          if (j == punctured[t + i]) {
+            continue;
+          }
+          for (size_t k = 0; k < blocksPerRow; k++) {
+            auto entry = row[j * blocksPerRow + k];
+            dst[k] = _mm_xor_si128(dst[k], entry);
+            columnSums[j * blocksPerRow + k] =
+                _mm_xor_si128(columnSums[j * blocksPerRow + k], entry);
+          }
+        }
+      }
+      for (size_t i = 0; i < block.size(); i++) {
+        auto dst = rst.data() + block[i] * blocksPerRow;
+        auto src = columnSums.data() + punctured[t + i] * blocksPerRow;
+        for (size_t k = 0; k < blocksPerRow; k++) {
+          dst[k] = _mm_xor_si128(dst[k], src[k]);
+        }
+      }
+      t += block.size();
+    }
+  }
+  return rst;
+}
+
+std::pair<std::vector<__m128i>, std::vector<__m128i>>
+ShareTranslator::translateLayer(
+    const std::vector<std::vector<uint32_t>>& blocks,
+    size_t size,
+    size_t blocksPerRow) {
+  std::vector<__m128i> a(size * blocksPerRow);
+  std::vector<__m128i> b(size * blocksPerRow, _mm_set_epi64x(0, 0));
+
+  // a single element stays where it is, any random a = b works.
+  std::vector<__m128i> randomRow(blocksPerRow);
+  for (auto& block : blocks) {
+    if (block.size() == 1) {
+      prg_.getRandomDataInPlace(randomRow);
+      std::copy(
+          randomRow.begin(),
+          randomRow.end(),
+          a.begin() + block[0] * blocksPerRow);
+      std::copy(
+          randomRow.begin(),
+          randomRow.end(),
+          b.begin() + block[0] * blocksPerRow);
+    }
+  }
+  auto depth = getDepth(blocks);
+  if (depth == 0) {
+    return {std::move(a), std::move(b)};
+  }
+
+  for (auto& batch : getBatches(blocks, depth)) {
+    size_t rows = 0;
+    for (auto index : batch) {
+      rows += blocks.at(index).size();
+    }
+
+    auto cot = senderRcot_->rcot(rows * depth);
+    auto flips = agent_->receiveBool(rows * depth);
+
+    engine::util::Expander expander(expanderIndex_++);
+    std::vector<__m128i> nodes(rows);
+    prg_.getRandomDataInPlace(nodes);
+    // the xor of the left and the right children of each level
+    std::vector<__m128i> masks(2 * rows * depth, _mm_set_epi64x(0, 0));
+    for (size_t l = 0; l < depth; l++) {
+      nodes = expander.expand(std::move(nodes));
+      size_t width = 2 << l;
+      for (size_t t = 0; t < rows; t++) {
+        auto tree = nodes.data() + t * width;
+        auto mask = masks.data() + 2 * (t * depth + l);
+        for (size_t j = 0; j < width; j += 2) {
+          mask[0] = _mm_xor_si128(mask[0], tree[j]);
+          mask[1] = _mm_xor_si128(mask[1], tree[j + 1]);
+        }
+      }
+    }
+
+    // the receiver can only unmask the side it chose
+    std::vector<__m128i> keys(2 * rows * depth);
+    for (size_t j = 0; j < cot.size(); j++) {
+      auto tweak = _mm_set_epi64x(hashIndex_ + j, 0);
+      auto key = _mm_xor_si128(cot[j], tweak);
+      keys[2 * j + flips[j]] = key;
+      keys[2 * j + !flips[j]] = _mm_xor_si128(key, delta_);
+    }
+    hashFromAes_.inPlaceHash(keys.data(), keys.size());
+    hashIndex_ += cot.size();
+    for (size_t j = 0; j < masks.size(); j++) {
+      masks[j] = _mm_xor_si128(masks[j], keys[j]);
+    }
+    agent_->sendT<__m128i>(masks);
+
+    auto leaves = expandLeaves(std::move(nodes), blocksPerRow);
+
+    size_t t = 0;
+    for (auto index : batch) {
+      auto& block = blocks.at(index);
+      for (size_t i = 0; i < block.size(); i++) {
+        auto row = leaves.data() + ((t + i) << depth) * blocksPerRow;
+        auto dst = b.data() + block[i] * blocksPerRow;
+        for (size_t j = 0; j < block.size(); j++) {
+          for (size_t k = 0; k < blocksPerRow; k++) {
+            dst[k] = _mm_xor_si128(dst[k], row[j * blocksPerRow + k]);
+          }
+        }
+      }
+      for (size_t j = 0; j < block.size(); j++) {
+        auto dst = a.data() + block[j] * blocksPerRow;
+        for (size_t k = 0; k < blocksPerRow; k++) {
+          auto sum = _mm_set_epi64x(0, 0);
+          for (size_t i = 0; i < block.size(); i++) {
+            sum = _mm_xor_si128(
+                sum,
+                leaves[(((t + i) << depth) + j) * blocksPerRow + k]);
+          }
+          dst[k] = sum;
+        }
+      }
+      t += block.size();
+    }
+  }
+  return {std::move(a), std::move(b)};
+}
+
+size_t ShareTranslator::getDepth(
+    const std::vector<std::vector<uint32_t>>& blocks) {
+  size_t maxSize = 1;
+  for (auto& block : blocks) {
+    maxSize = std::max(maxSize, block.size());
+  }
+  size_t depth = 0;
+  while (((size_t)1 << depth) < maxSize) {
+    depth++;
+  }
+  return depth;
+}
+
+std::vector<std::vector<size_t>> ShareTranslator::getBatches(
+    const std::vector<std::vector<uint32_t>>& blocks,
+    size_t depth) {
+  std::vector<std::vector<size_t>> rst;
+  size_t leaves = kMaxLeavesPerBatch;
+  for (size_t i = 0; i < blocks.size(); i++) {
+    if (blocks[i].size() == 1) {
+      continue;
+    }
+    if (leaves >= kMaxLeavesPerBatch) {
+      rst.emplace_back();
+      leaves = 0;
+    }
+    rst.back().push_back(i);
+    leaves += blocks[i].size() << depth;
+  }
+  return rst;
+}
+
+std::vector<__m128i> ShareTranslator::expandLeaves(
+    std::vector<__m128i>&& leaves,
+    size_t blocksPerRow) const {
+  if (blocksPerRow == 1) {
+    return std::move(leaves);
+  }
+  // the leaf itself, followed by the hashes of the leaf and a counter.
+  std::vector<__m128i> rst(leaves.size() * blocksPerRow);
+  for (size_t i = 0; i < leaves.size(); i++) {
+    for (size_t k = 0; k < blocksPerRow; k++) {
+      rst[i * blocksPerRow + k] =
+          _mm_xor_si128(leaves[i], _mm_set_epi64x(0, k));
+    }
+  }
+  hashFromAes_.inPlaceHash(rst.data(), rst.size());
+  for (size_t i = 0; i < leaves.size(); i++) {
+    rst[i * blocksPerRow] = leaves[i];
+  }
+  return rst;
+}
+
+void ShareTranslator::sendRows(
+    const std::vector<__m128i>& rows,
+    size_t size,
+    size_t blocksPerRow,
+    size_t bytesPerRow) {
+  std::vector<unsigned char> data(size * bytesPerRow);
+  for (size_t i = 0; i < size; i++) {
+    std::memcpy(
+        data.data() + i * bytesPerRow,
+        rows.data() + i * blocksPerRow,
+        bytesPerRow);
+  }
+  agent_->send(data);
+}
+
+std::vector<__m128i> ShareTranslator::receiveRows(
+    size_t size,
+    size_t blocksPerRow,
+    size_t bytesPerRow) {
+  auto data = agent_->receive(size * bytesPerRow);
+  std::vector<__m128i> rst(size * blocksPerRow, _mm_set_epi64x(0, 0));
+  for (size_t i = 0; i < size; i++) {
+    std::memcpy(
+        rst.data() + i * blocksPerRow,
+        data.data() + i * bytesPerRow,
+        bytesPerRow);
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::shuffler
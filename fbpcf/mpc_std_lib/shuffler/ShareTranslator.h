@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IRandomCorrelatedObliviousTransfer.h"
+#include "fbpcf/engine/util/AesPrg.h"
+#include "fbpcf/engine/util/aes.h"
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+/**
+ * This object permutes rows of XOR-shared bits between two parties, to an
+ * order known to one of them only. It is an implementation of the share
+ * translation from paper 'Secret-Shared Shuffle' by Melissa Chase, Esha Ghosh
+ * and Oxana Poburinnaya. Link to the paper:
+ * https://eprint.iacr.org/2019/1340.pdf
+ *
+ * The party providing the order, pi, gets delta and the other party gets
+ * (a, b) such that b[i] = a[pi[i]] ^ delta[i]. Then it only takes the other
+ * party sending its shares masked with a to permute them. The correlation is
+ * built along an AS-Waksman network whose levels are merged into layers of
+ * small independent blocks; each block is translated with punctured GGM trees
+ * and all the work is local AES apart from the base COTs, a single message
+ * each way per layer and one row of masked values per layer and element.
+ */
+class ShareTranslator {
+ public:
+  static const size_t kDefaultLevelsPerLayer = 4;
+
+  /**
+   * @param delta the delta of the sender rcot.
+   * @param senderRcot the rcot to use when the other party provides the order.
+   * @param receiverRcot the rcot to use when this party provides the order.
+   * @param levelsPerLayer how many levels of the switching network are merged
+   * into a layer, every element then costs 2^levelsPerLayer leaves per layer.
+   */
+  ShareTranslator(
+      std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent,
+      __m128i delta,
+      std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                          IRandomCorrelatedObliviousTransfer> senderRcot,
+      std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                          IRandomCorrelatedObliviousTransfer> receiverRcot,
+      size_t levelsPerLayer = kDefaultLevelsPerLayer);
+
+  /**
+   * Permute secret-shared rows to the provided order, the other party needs
+   * to call the other permute() at the same time.
+   * @param shares this party's shares, each row takes ceil(width / 128)
+   * consecutive __m128i.
+   * @param width the number of meaningful bits in each row.
+   * @param order the i-th output row is the order[i]-th input row.
+   * @return this party's shares of the permuted rows. Only the first width
+   * bits of each row are meaningful.
+   */
+  std::vector<__m128i> permute(
+      const std::vector<__m128i>& shares,
+      size_t width,
+      const std::vector<uint32_t>& order);
+
+  /**
+   * Permute secret-shared rows to the order the other party provides.
+   * @param shares this party's shares, each row takes ceil(width / 128)
+   * consecutive __m128i.
+   * @param size the number of rows.
+   * @param width the number of meaningful bits in each row.
+   * @return this party's shares of the permuted rows.
+   */
+  std::vector<__m128i>
+  permute(const std::vector<__m128i>& shares, size_t size, size_t width);
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const;
+
+  static size_t getBlocksPerRow(size_t width) {
+    return (width + 127) / 128;
+  }
+
+ private:
+  static const size_t kMaxLeavesPerBatch = 1 << 20;
+
+  // a layer permutes every block among itself.
+  struct Layer {
+    std::vector<std::vector<uint32_t>> blocks;
+    // order[i] is the input position of the i-th output. Only known to the
+    // party providing the order.
+    std::vector<uint32_t> order;
+  };
+
+  /**
+   * Build the layers of a network that permutes size elements. Without an
+   * order, only the topology is built, which is all the other party needs.
+   */
+  std::vector<Layer> buildLayers(
+      size_t size,
+      const std::vector<uint32_t>* order) const;
+
+  // delta of the layer, for the party providing the order.
+  std::vector<__m128i>
+  translateLayer(const Layer& layer, size_t size, size_t blocksPerRow);
+
+  // (a, b) of the layer, for the other party.
+  std::pair<std::vector<__m128i>, std::vector<__m128i>> translateLayer(
+      const std::vector<std::vector<uint32_t>>& blocks,
+      size_t size,
+      size_t blocksPerRow);
+
+  // the depth of the GGM trees, enough for the largest block.
+  static size_t getDepth(const std::vector<std::vector<uint32_t>>& blocks);
+
+  // split the blocks of more than one element into batches that are
+  // translated together, so that the leaves of a batch fit in memory.
+  static std::vector<std::vector<size_t>> getBatches(
+      const std::vector<std::vector<uint32_t>>& blocks,
+      size_t depth);
+
+  // expand every leaf to a row of blocksPerRow __m128i.
+  std::vector<__m128i> expandLeaves(
+      std::vector<__m128i>&& leaves,
+      size_t blocksPerRow) const;
+
+  void sendRows(
+      const std::vector<__m128i>& rows,
+      size_t size,
+      size_t blocksPerRow,
+      size_t bytesPerRow);
+  std::vector<__m128i>
+  receiveRows(size_t size, size_t blocksPerRow, size_t bytesPerRow);
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent_;
+  __m128i delta_;
+  std::unique_ptr<
+      engine::tuple_generator::oblivious_transfer::
+          IRandomCorrelatedObliviousTransfer>
+      senderRcot_;
+  std::unique_ptr<
+      engine::tuple_generator::oblivious_transfer::
+          IRandomCorrelatedObliviousTransfer>
+      receiverRcot_;
+  size_t levelsPerLayer_;
+
+  engine::util::AesPrg prg_;
+  engine::util::Aes hashFromAes_;
+
+  // both parties advance these the same way, so that every tree and every
+  // hash gets its own index.
+  int64_t expanderIndex_;
+  uint64_t hashIndex_;
+};
+
+} // namespace fbpcf::mpc_std_lib::shuffler
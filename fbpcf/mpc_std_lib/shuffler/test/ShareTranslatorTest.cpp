@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <random>
+#include <tuple>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/DummyBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/util/util.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslator.h"
+#include "fbpcf/mpc_std_lib/util/test/util.h"
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+std::unique_ptr<ShareTranslator> createShareTranslator(
+    engine::communication::IPartyCommunicationAgentFactory& agentFactory,
+    int myId,
+    size_t levelsPerLayer) {
+  engine::tuple_generator::oblivious_transfer::
+      IknpShRandomCorrelatedObliviousTransferFactory rcotFactory(
+          std::make_unique<engine::tuple_generator::oblivious_transfer::
+                               insecure::DummyBaseObliviousTransferFactory>());
+  __m128i delta = engine::util::getRandomM128iFromSystemNoise();
+  engine::util::setLsbTo1(delta);
+  auto partnerId = 1 - myId;
+  std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                      IRandomCorrelatedObliviousTransfer>
+      senderRcot;
+  std::unique_ptr<engine::tuple_generator::oblivious_transfer::
+                      IRandomCorrelatedObliviousTransfer>
+      receiverRcot;
+  if (partnerId < myId) {
+    senderRcot = rcotFactory.create(
+        delta, agentFactory.create(partnerId, "rcot_sender_traffic"));
+    receiverRcot = rcotFactory.create(
+        agentFactory.create(partnerId, "rcot_receiver_traffic"));
+  } else {
+    receiverRcot = rcotFactory.create(
+        agentFactory.create(partnerId, "rcot_receiver_traffic"));
+    senderRcot = rcotFactory.create(
+        delta, agentFactory.create(partnerId, "rcot_sender_traffic"));
+  }
+  return std::make_unique<ShareTranslator>(
+      agentFactory.create(partnerId, "share_translation_traffic"),
+      delta,
+      std::move(senderRcot),
+      std::move(receiverRcot),
+      levelsPerLayer);
+}
+
+std::vector<__m128i> generateRandomRows(size_t size) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> dist;
+  std::vector<__m128i> rst(size);
+  for (auto& item : rst) {
+    item = _mm_set_epi64x(dist(e), dist(e));
+  }
+  return rst;
+}
+
+// compare the first width bits of two rows
+void expectSameRow(
+    const __m128i* row0,
+    const __m128i* row1,
+    size_t width,
+    size_t blocksPerRow) {
+  std::vector<uint64_t> words0(2 * blocksPerRow);
+  std::vector<uint64_t> words1(2 * blocksPerRow);
+  memcpy(words0.data(), row0, blocksPerRow * sizeof(__m128i));
+  memcpy(words1.data(), row1, blocksPerRow * sizeof(__m128i));
+  for (size_t i = 0; i < width; i++) {
+    EXPECT_EQ(
+        (words0[i >> 6] >> (i & 63)) & 1, (words1[i >> 6] >> (i & 63)) & 1);
+  }
+}
+
+void testShareTranslator(size_t size, size_t width, size_t levelsPerLayer) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  auto blocksPerRow = ShareTranslator::getBlocksPerRow(width);
+  auto shares0 = generateRandomRows(size * blocksPerRow);
+  auto shares1 = generateRandomRows(size * blocksPerRow);
+  auto order = util::generateRandomPermutation(size);
+  const int kRounds = 2;
+
+  // party 0 provides the order in the first round and party 1 in the second.
+  auto task = [&](int myId) {
+    auto translator =
+        createShareTranslator(*agentFactories.at(myId), myId, levelsPerLayer);
+    auto rst = myId == 0 ? shares0 : shares1;
+    for (int i = 0; i < kRounds; i++) {
+      if (i % 2 == myId) {
+        rst = translator->permute(rst, width, order);
+      } else {
+        rst = translator->permute(rst, size, width);
+      }
+      EXPECT_EQ(rst.size(), size * blocksPerRow);
+    }
+    return rst;
+  };
+
+  auto future0 = std::async(task, 0);
+  auto future1 = std::async(task, 1);
+  auto rst0 = future0.get();
+  auto rst1 = future1.get();
+
+  for (size_t i = 0; i < size; i++) {
+    auto expected = order.at(order.at(i));
+    std::vector<__m128i> expectedRow(blocksPerRow);
+    std::vector<__m128i> actualRow(blocksPerRow);
+    for (size_t j = 0; j < blocksPerRow; j++) {
+      expectedRow[j] = _mm_xor_si128(
+          shares0.at(expected * blocksPerRow + j),
+          shares1.at(expected * blocksPerRow + j));
+      actualRow[j] = _mm_xor_si128(
+          rst0.at(i * blocksPerRow + j), rst1.at(i * blocksPerRow + j));
+    }
+    expectSameRow(expectedRow.data(), actualRow.data(), width, blocksPerRow);
+  }
+}
+
+class ShareTranslatorTestFixture
+    : public ::testing::TestWithParam<std::tuple<size_t, size_t, size_t>> {};
+
+TEST_P(ShareTranslatorTestFixture, testPermute) {
+  auto [size, width, levelsPerLayer] = GetParam();
+  testShareTranslator(size, width, levelsPerLayer);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ShareTranslatorTest,
+    ShareTranslatorTestFixture,
+    ::testing::Values(
+        std::make_tuple(1, 33, 4),
+        std::make_tuple(2, 1, 4),
+        std::make_tuple(3, 33, 1),
+        std::make_tuple(17, 33, 4),
+        std::make_tuple(17, 200, 3),
+        std::make_tuple(1000, 33, 4),
+        std::make_tuple(1000, 300, 10),
+        std::make_tuple(1025, 8, 2)));
+
+TEST(ShareTranslatorTest, testInvalidInput) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  EXPECT_THROW(
+      ShareTranslator(
+          agentFactories.at(0)->create(1, "share_translation_traffic"),
+          _mm_set_epi64x(0, 1),
+          nullptr,
+          nullptr,
+          0),
+      std::invalid_argument);
+}
+
+} // namespace fbpcf::mpc_std_lib::shuffler
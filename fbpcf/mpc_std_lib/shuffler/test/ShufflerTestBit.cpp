@@ -14,11 +14,14 @@
 #include <unordered_map>
 
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/DummyBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/DummyPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/shuffler/NonShufflerFactory.h"
 #include "fbpcf/mpc_std_lib/shuffler/PermuteBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslationBasedShufflerFactory.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
@@ -41,8 +44,11 @@ void shufflerTest(
     IShufflerFactory<frontend::Bit<true, 1, true>>& shufflerFactory1) {
   auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
   setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
-  auto shuffler0 = shufflerFactory0.create();
+  // some shufflers set up their own correlations when created.
+  auto shufflerFuture0 =
+      std::async([&shufflerFactory0]() { return shufflerFactory0.create(); });
   auto shuffler1 = shufflerFactory1.create();
+  auto shuffler0 = shufflerFuture0.get();
   size_t size = 16;
   auto data = util::generateRandomBinary(size);
 
@@ -108,4 +114,28 @@ TEST(shufflerTestBit, testPermuteBasedShufflerWithAsWaksmanPermuter) {
   shufflerTest(factory0, factory1);
 }
 
+TEST(shufflerTestBit, testShareTranslationBasedShuffler) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  ShareTranslationBasedShufflerFactory<bool, 0> factory0(
+      0,
+      1,
+      *agentFactories[0],
+      std::make_unique<engine::tuple_generator::oblivious_transfer::
+                           IknpShRandomCorrelatedObliviousTransferFactory>(
+          std::make_unique<engine::tuple_generator::oblivious_transfer::
+                               insecure::DummyBaseObliviousTransferFactory>()),
+      std::make_unique<engine::util::AesPrgFactory>());
+  ShareTranslationBasedShufflerFactory<bool, 1> factory1(
+      1,
+      0,
+      *agentFactories[1],
+      std::make_unique<engine::tuple_generator::oblivious_transfer::
+                           IknpShRandomCorrelatedObliviousTransferFactory>(
+          std::make_unique<engine::tuple_generator::oblivious_transfer::
+                               insecure::DummyBaseObliviousTransferFactory>()),
+      std::make_unique<engine::util::AesPrgFactory>());
+
+  shufflerTest(factory0, factory1);
+}
+
 } // namespace fbpcf::mpc_std_lib::shuffler
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorter.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+/*
+ * This sorter runs a bitonic sorting network. All the comparators of a stage
+ * are independent, so each stage is evaluated as a single batch: one batched
+ * comparison of the keys and one composite AND that swaps the keys and the
+ * payloads. The network takes O(n log^2 n) comparators in O(log^2 n) stages.
+ * Sizes that are not a power of 2 are handled as if they were padded with
+ * maximal keys, so the comparators involving the padding are simply skipped.
+ * This sorter is not stable.
+ */
+template <typename KeyT, typename ValueT, int schedulerId>
+class BitonicSorter final
+    : public ISorter<
+          typename util::SecBatchType<KeyT, schedulerId>::type,
+          typename util::SecBatchType<ValueT, schedulerId>::type> {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+ public:
+  using SecBatchKeyType = typename util::SecBatchType<KeyT, schedulerId>::type;
+  using SecBatchValueType =
+      typename util::SecBatchType<ValueT, schedulerId>::type;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<SecBatchKeyType, SecBatchValueType> sort(
+      const SecBatchKeyType& keys,
+      const SecBatchValueType& values,
+      size_t size) const override;
+
+ private:
+  // compare the keys of every pair and swap the pair if the first key is the
+  // larger one.
+  void compareAndSwap(
+      std::vector<std::vector<bool>>& keyShares,
+      std::vector<std::vector<bool>>& valueShares,
+      const std::vector<std::pair<uint32_t, uint32_t>>& pairs) const;
+
+  // whether left > right, the bits are from less significant to more
+  // significant.
+  SecBit greaterThan(
+      const std::vector<SecBit>& left,
+      const std::vector<SecBit>& right) const;
+};
+
+} // namespace fbpcf::mpc_std_lib::sorter
+
+#include "fbpcf/mpc_std_lib/sorter/BitonicSorter_impl.h"
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/mpc_std_lib/sorter/BitonicSorter.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorterFactory.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+template <typename KeyT, typename ValueT, int schedulerId>
+class BitonicSorterFactory final
+    : public ISorterFactory<
+          typename util::SecBatchType<KeyT, schedulerId>::type,
+          typename util::SecBatchType<ValueT, schedulerId>::type> {
+ public:
+  using SecBatchKeyType = typename util::SecBatchType<KeyT, schedulerId>::type;
+  using SecBatchValueType =
+      typename util::SecBatchType<ValueT, schedulerId>::type;
+
+  std::unique_ptr<ISorter<SecBatchKeyType, SecBatchValueType>> create()
+      override {
+    return std::make_unique<BitonicSorter<KeyT, ValueT, schedulerId>>();
+  }
+};
+
+} // namespace fbpcf::mpc_std_lib::sorter
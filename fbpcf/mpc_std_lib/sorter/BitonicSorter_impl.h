@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+template <typename KeyT, typename ValueT, int schedulerId>
+std::pair<
+    typename BitonicSorter<KeyT, ValueT, schedulerId>::SecBatchKeyType,
+    typename BitonicSorter<KeyT, ValueT, schedulerId>::SecBatchValueType>
+BitonicSorter<KeyT, ValueT, schedulerId>::sort(
+    const SecBatchKeyType& keys,
+    const SecBatchValueType& values,
+    size_t size) const {
+  auto keyShares =
+      util::MpcAdapters<KeyT, schedulerId>::extractBatchSharedSecrets(keys);
+  auto valueShares =
+      util::MpcAdapters<ValueT, schedulerId>::extractBatchSharedSecrets(
+          values);
+  for (auto& item : keyShares) {
+    if (item.size() != size) {
+      throw std::invalid_argument("Inconsistent size.");
+    }
+  }
+  for (auto& item : valueShares) {
+    if (item.size() != size) {
+      throw std::invalid_argument("Inconsistent size.");
+    }
+  }
+
+  size_t paddedSize = 1;
+  while (paddedSize < size) {
+    paddedSize <<= 1;
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  // Each round merges sorted blocks of p elements into sorted blocks of 2p
+  // elements. The first stage compares mirrored positions, so that all the
+  // comparators of the network put the smaller key first.
+  for (size_t p = 1; p < paddedSize; p <<= 1) {
+    pairs.clear();
+    for (size_t block = 0; block < paddedSize; block += 2 * p) {
+      for (size_t i = 0; i < p; i++) {
+        if (block + 2 * p - 1 - i < size) {
+          pairs.push_back({block + i, block + 2 * p - 1 - i});
+        }
+      }
+    }
+    compareAndSwap(keyShares, valueShares, pairs);
+
+    for (size_t q = p / 2; q > 0; q >>= 1) {
+      pairs.clear();
+      for (size_t i = 0; i + q < size; i++) {
+        if ((i & q) == 0) {
+          pairs.push_back({i, i + q});
+        }
+      }
+      compareAndSwap(keyShares, valueShares, pairs);
+    }
+  }
+
+  return {
+      util::MpcAdapters<KeyT, schedulerId>::recoverBatchSharedSecrets(
+          keyShares),
+      util::MpcAdapters<ValueT, schedulerId>::recoverBatchSharedSecrets(
+          valueShares)};
+}
+
+template <typename KeyT, typename ValueT, int schedulerId>
+void BitonicSorter<KeyT, ValueT, schedulerId>::compareAndSwap(
+    std::vector<std::vector<bool>>& keyShares,
+    std::vector<std::vector<bool>>& valueShares,
+    const std::vector<std::pair<uint32_t, uint32_t>>& pairs) const {
+  if (pairs.empty()) {
+    return;
+  }
+  auto batchSize = pairs.size();
+
+  // gather the two sides of the comparators into batches, the differences
+  // between the two sides are what a swap XORs into both of them.
+  std::vector<SecBit> leftKeys;
+  std::vector<SecBit> rightKeys;
+  std::vector<SecBit> differences;
+  leftKeys.reserve(keyShares.size());
+  rightKeys.reserve(keyShares.size());
+  differences.reserve(keyShares.size() + valueShares.size());
+  auto gather = [&pairs, batchSize](const std::vector<bool>& shares) {
+    std::vector<bool> left(batchSize);
+    std::vector<bool> right(batchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      left[i] = shares.at(pairs.at(i).first);
+      right[i] = shares.at(pairs.at(i).second);
+    }
+    return std::make_pair(std::move(left), std::move(right));
+  };
+  for (auto& column : keyShares) {
+    auto [left, right] = gather(column);
+    std::vector<bool> difference(batchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      difference[i] = left.at(i) ^ right.at(i);
+    }
+    leftKeys.push_back(SecBit(typename SecBit::ExtractedBit(std::move(left))));
+    rightKeys.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(right))));
+    differences.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(difference))));
+  }
+  for (auto& column : valueShares) {
+    auto [left, right] = gather(column);
+    std::vector<bool> difference(batchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      difference[i] = left.at(i) ^ right.at(i);
+    }
+    differences.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(difference))));
+  }
+
+  auto swaps = greaterThan(leftKeys, rightKeys) & differences;
+
+  auto scatter = [&pairs, batchSize](
+                     std::vector<bool>& shares, const SecBit& swap) {
+    auto swapShares = swap.extractBit().getValue();
+    for (size_t i = 0; i < batchSize; i++) {
+      shares[pairs.at(i).first] = shares[pairs.at(i).first] ^ swapShares.at(i);
+      shares[pairs.at(i).second] =
+          shares[pairs.at(i).second] ^ swapShares.at(i);
+    }
+  };
+  for (size_t i = 0; i < keyShares.size(); i++) {
+    scatter(keyShares[i], swaps.at(i));
+  }
+  for (size_t i = 0; i < valueShares.size(); i++) {
+    scatter(valueShares[i], swaps.at(keyShares.size() + i));
+  }
+}
+
+template <typename KeyT, typename ValueT, int schedulerId>
+typename BitonicSorter<KeyT, ValueT, schedulerId>::SecBit
+BitonicSorter<KeyT, ValueT, schedulerId>::greaterThan(
+    const std::vector<SecBit>& left,
+    const std::vector<SecBit>& right) const {
+  // every range of bits has a greater flag and an equal flag. Two adjacent
+  // ranges combine as greater = greaterHigh ^ (equalHigh & greaterLow) and
+  // equal = equalHigh & equalLow (greaterHigh and equalHigh are never both
+  // set), so a tree of log(width) levels of ANDs compares the whole keys.
+  std::vector<SecBit> greater;
+  std::vector<SecBit> equal;
+  for (size_t i = 0; i < left.size(); i++) {
+    greater.push_back(left.at(i) & !right.at(i));
+    equal.push_back(!(left.at(i) ^ right.at(i)));
+  }
+  while (greater.size() > 1) {
+    std::vector<SecBit> nextGreater;
+    std::vector<SecBit> nextEqual;
+    for (size_t i = 0; i + 1 < greater.size(); i += 2) {
+      nextGreater.push_back(
+          greater.at(i + 1) ^ (equal.at(i + 1) & greater.at(i)));
+      nextEqual.push_back(equal.at(i + 1) & equal.at(i));
+    }
+    if (greater.size() % 2 == 1) {
+      nextGreater.push_back(greater.back());
+      nextEqual.push_back(equal.back());
+    }
+    greater = std::move(nextGreater);
+    equal = std::move(nextEqual);
+  }
+  return greater.at(0);
+}
+
+} // namespace fbpcf::mpc_std_lib::sorter
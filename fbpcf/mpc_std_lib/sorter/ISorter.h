@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+/*
+ * A sorter obliviously sorts a batch of secret keys in ascending order and
+ * moves a secret payload along with them. Keys are compared as unsigned
+ * integers of their bits, e.g. a uint32_t key is ordered as a uint32_t.
+ */
+/**
+ * A type KeyT corresponds to a set of keys (i.e., a batch) to be sorted.
+ * Similarly, a type ValueT corresponds to a set of payloads (i.e., a batch).
+ */
+template <typename KeyT, typename ValueT>
+class ISorter {
+ public:
+  virtual ~ISorter() = default;
+
+  /**
+   * Sort a batch of secret keys and their payloads.
+   * @param keys the keys to sort by.
+   * @param values the payloads, the i-th one belongs to the i-th key.
+   * @param size the size of the batch.
+   * @return the sorted keys and the payloads in the same order.
+   */
+  virtual std::pair<KeyT, ValueT>
+  sort(const KeyT& keys, const ValueT& values, size_t size) const = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::sorter
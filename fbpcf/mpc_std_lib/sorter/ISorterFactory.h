@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/mpc_std_lib/sorter/ISorter.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+template <typename KeyT, typename ValueT>
+class ISorterFactory {
+ public:
+  virtual ~ISorterFactory() = default;
+  virtual std::unique_ptr<ISorter<KeyT, ValueT>> create() = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::sorter
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/shuffler/IShuffler.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorter.h"
+#include "fbpcf/mpc_std_lib/util/SecretArithmetic.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+/*
+ * This sorter is an implementation of the radix sort from paper 'Oblivious
+ * Radix Sort: An Efficient Sorting Algorithm for Practical Secure Multi-party
+ * Computation' by Koki Hamada, Dai Ikarashi, Koji Chida and Katsumi Takahashi.
+ * Link to the paper: https://eprint.iacr.org/2014/121
+ *
+ * It runs a stable partition for every bit of the keys, from the least
+ * significant one. A partition computes the destination of every row inside
+ * MPC with a prefix sum, shuffles the rows along with their destinations and
+ * then reveals the destinations: after the shuffle they are a uniformly random
+ * permutation, so the rows can be moved locally. The cost is linear in the
+ * number of rows for each bit of the keys, and the payloads are only touched
+ * by the shuffler. This sorter is stable.
+ */
+/*
+ * We assume that there are two parties. In our implementation, a party with a
+ * smaller id is assigned to party0 and the other party is assigned to party1.
+ */
+template <typename KeyT, typename ValueT, int schedulerId>
+class RadixSorter final
+    : public ISorter<
+          typename util::SecBatchType<KeyT, schedulerId>::type,
+          typename util::SecBatchType<ValueT, schedulerId>::type> {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+ public:
+  using SecBatchKeyType = typename util::SecBatchType<KeyT, schedulerId>::type;
+  using SecBatchValueType =
+      typename util::SecBatchType<ValueT, schedulerId>::type;
+  using SecBatchRowType =
+      typename util::SecBatchType<std::vector<bool>, schedulerId>::type;
+
+  RadixSorter(
+      int myId,
+      int partnerId,
+      std::unique_ptr<shuffler::IShuffler<SecBatchRowType>> shuffler)
+      : myId_(myId), partnerId_(partnerId), shuffler_(std::move(shuffler)) {}
+
+  /**
+   * @inherit doc
+   */
+  std::pair<SecBatchKeyType, SecBatchValueType> sort(
+      const SecBatchKeyType& keys,
+      const SecBatchValueType& values,
+      size_t size) const override;
+
+ private:
+  // this party's shares of where each row goes in a stable partition by the
+  // given bit, the rows whose bit is 0 coming first.
+  std::vector<std::vector<bool>> computeDestinations(
+      const std::vector<bool>& bitShares,
+      size_t countWidth) const;
+
+  // this party's shares of a public value, party 0 holds the value.
+  bool getShareOfPublicBit(bool bit) const {
+    return myId_ < partnerId_ ? bit : false;
+  }
+
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<shuffler::IShuffler<SecBatchRowType>> shuffler_;
+};
+
+} // namespace fbpcf::mpc_std_lib::sorter
+
+#include "fbpcf/mpc_std_lib/sorter/RadixSorter_impl.h"
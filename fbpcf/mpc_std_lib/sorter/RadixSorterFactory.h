@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/mpc_std_lib/shuffler/IShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorterFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/RadixSorter.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+template <typename KeyT, typename ValueT, int schedulerId>
+class RadixSorterFactory final
+    : public ISorterFactory<
+          typename util::SecBatchType<KeyT, schedulerId>::type,
+          typename util::SecBatchType<ValueT, schedulerId>::type> {
+ public:
+  using SecBatchKeyType = typename util::SecBatchType<KeyT, schedulerId>::type;
+  using SecBatchValueType =
+      typename util::SecBatchType<ValueT, schedulerId>::type;
+  using SecBatchRowType =
+      typename util::SecBatchType<std::vector<bool>, schedulerId>::type;
+
+  /**
+   * @param shufflerFactory the shufflers it creates need to shuffle rows of
+   * any width.
+   */
+  RadixSorterFactory(
+      int myId,
+      int partnerId,
+      std::unique_ptr<shuffler::IShufflerFactory<SecBatchRowType>>
+          shufflerFactory)
+      : myId_(myId),
+        partnerId_(partnerId),
+        shufflerFactory_(std::move(shufflerFactory)) {}
+
+  std::unique_ptr<ISorter<SecBatchKeyType, SecBatchValueType>> create()
+      override {
+    return std::make_unique<RadixSorter<KeyT, ValueT, schedulerId>>(
+        myId_, partnerId_, shufflerFactory_->create());
+  }
+
+ private:
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<shuffler::IShufflerFactory<SecBatchRowType>>
+      shufflerFactory_;
+};
+
+} // namespace fbpcf::mpc_std_lib::sorter
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+template <typename KeyT, typename ValueT, int schedulerId>
+std::pair<
+    typename RadixSorter<KeyT, ValueT, schedulerId>::SecBatchKeyType,
+    typename RadixSorter<KeyT, ValueT, schedulerId>::SecBatchValueType>
+RadixSorter<KeyT, ValueT, schedulerId>::sort(
+    const SecBatchKeyType& keys,
+    const SecBatchValueType& values,
+    size_t size) const {
+  auto keyShares =
+      util::MpcAdapters<KeyT, schedulerId>::extractBatchSharedSecrets(keys);
+  auto valueShares =
+      util::MpcAdapters<ValueT, schedulerId>::extractBatchSharedSecrets(
+          values);
+  for (auto& item : keyShares) {
+    if (item.size() != size) {
+      throw std::invalid_argument("Inconsistent size.");
+    }
+  }
+  for (auto& item : valueShares) {
+    if (item.size() != size) {
+      throw std::invalid_argument("Inconsistent size.");
+    }
+  }
+  if (size < 2) {
+    return {keys, values};
+  }
+
+  auto party0 = (myId_ < partnerId_) ? myId_ : partnerId_;
+  auto party1 = (myId_ < partnerId_) ? partnerId_ : myId_;
+  auto keyWidth = keyShares.size();
+  auto valueWidth = valueShares.size();
+  // wide enough for any count of rows.
+  size_t countWidth = std::ceil(std::log2(size + 1));
+
+  for (size_t bit = 0; bit < keyWidth; bit++) {
+    auto destinations = computeDestinations(keyShares.at(bit), countWidth);
+
+    // shuffle the rows together with their destinations.
+    std::vector<std::vector<bool>> rows;
+    rows.reserve(keyWidth + valueWidth + countWidth);
+    for (auto& item : keyShares) {
+      rows.push_back(std::move(item));
+    }
+    for (auto& item : valueShares) {
+      rows.push_back(std::move(item));
+    }
+    for (auto& item : destinations) {
+      rows.push_back(std::move(item));
+    }
+    auto shuffled = util::MpcAdapters<std::vector<bool>, schedulerId>::
+        extractBatchSharedSecrets(shuffler_->shuffle(
+            util::MpcAdapters<std::vector<bool>, schedulerId>::
+                recoverBatchSharedSecrets(rows),
+            size));
+
+    // the shuffled destinations are a random permutation, revealing them
+    // tells nothing about the keys.
+    std::vector<uint32_t> order(size, 0);
+    for (size_t k = 0; k < countWidth; k++) {
+      SecBit destinationBit(typename SecBit::ExtractedBit(
+          std::move(shuffled[keyWidth + valueWidth + k])));
+      auto revealed0 = destinationBit.openToParty(party0);
+      auto revealed1 = destinationBit.openToParty(party1);
+      auto revealed =
+          (myId_ == party0) ? revealed0.getValue() : revealed1.getValue();
+      for (size_t i = 0; i < size; i++) {
+        order[i] |= static_cast<uint32_t>(revealed.at(i)) << k;
+      }
+    }
+    for (auto position : order) {
+      if (position >= size) {
+        throw std::runtime_error("Unexpected destination.");
+      }
+    }
+
+    auto move = [&order, size](const std::vector<bool>& src) {
+      std::vector<bool> rst(size);
+      for (size_t i = 0; i < size; i++) {
+        rst[order.at(i)] = src.at(i);
+      }
+      return rst;
+    };
+    for (size_t i = 0; i < keyWidth; i++) {
+      keyShares[i] = move(shuffled.at(i));
+    }
+    for (size_t i = 0; i < valueWidth; i++) {
+      valueShares[i] = move(shuffled.at(keyWidth + i));
+    }
+  }
+
+  return {
+      util::MpcAdapters<KeyT, schedulerId>::recoverBatchSharedSecrets(
+          keyShares),
+      util::MpcAdapters<ValueT, schedulerId>::recoverBatchSharedSecrets(
+          valueShares)};
+}
+
+template <typename KeyT, typename ValueT, int schedulerId>
+std::vector<std::vector<bool>>
+RadixSorter<KeyT, ValueT, schedulerId>::computeDestinations(
+    const std::vector<bool>& bitShares,
+    size_t countWidth) const {
+  auto size = bitShares.size();
+  SecBit bit((typename SecBit::ExtractedBit(bitShares)));
+
+  std::vector<std::vector<bool>> counts(
+      countWidth, std::vector<bool>(size, false));
+  counts[0] = (!bit).extractBit().getValue();
+  auto [zerosBeforeShares, totalShares] =
+      util::SecretArithmetic<schedulerId>::computeExclusivePrefixSums(
+          std::move(counts));
+
+  // A row whose bit is 0 goes after the 0s before it, and a row whose bit is 1
+  // goes after all the 0s and the 1s before it. The number of 1s before the
+  // i-th row is i - (the number of 0s before it) = i + ~zeros + 1.
+  std::vector<SecBit> zerosBefore;
+  std::vector<SecBit> notZerosBefore;
+  std::vector<SecBit> indexes;
+  std::vector<SecBit> totals;
+  for (size_t k = 0; k < countWidth; k++) {
+    zerosBefore.push_back(SecBit(
+        typename SecBit::ExtractedBit(std::move(zerosBeforeShares[k]))));
+    notZerosBefore.push_back(!zerosBefore.back());
+    std::vector<bool> indexShares(size);
+    for (size_t i = 0; i < size; i++) {
+      indexShares[i] = getShareOfPublicBit((i >> k) & 1);
+    }
+    indexes.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(indexShares))));
+    totals.push_back(SecBit(typename SecBit::ExtractedBit(
+        std::vector<bool>(size, totalShares.at(k)))));
+  }
+  SecBit one(typename SecBit::ExtractedBit(
+      std::vector<bool>(size, getShareOfPublicBit(true))));
+  auto onesBefore =
+      util::SecretArithmetic<schedulerId>::add(indexes, notZerosBefore, one);
+  auto alternatives =
+      util::SecretArithmetic<schedulerId>::add(totals, onesBefore);
+
+  std::vector<SecBit> differences;
+  for (size_t k = 0; k < countWidth; k++) {
+    differences.push_back(alternatives.at(k) ^ zerosBefore.at(k));
+  }
+  auto chosen = bit & differences;
+  std::vector<std::vector<bool>> rst(countWidth);
+  for (size_t k = 0; k < countWidth; k++) {
+    rst[k] = (zerosBefore.at(k) ^ chosen.at(k)).extractBit().getValue();
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::sorter
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <random>
+#include <tuple>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/DummyBaseObliviousTransferFactory.h"
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/IknpShRandomCorrelatedObliviousTransferFactory.h"
+#include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslationBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/BitonicSorterFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorterFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/RadixSorterFactory.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+template <int schedulerId>
+using SorterFactory = ISorterFactory<
+    typename util::SecBatchType<uint32_t, schedulerId>::type,
+    typename util::SecBatchType<uint32_t, schedulerId>::type>;
+
+// keys in a small range so that there are many duplicates, and the indexes of
+// the rows as payloads.
+std::pair<std::vector<uint32_t>, std::vector<uint32_t>> generateData(
+    size_t size,
+    uint32_t keyRange) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint32_t> dist(0, keyRange - 1);
+  std::vector<uint32_t> keys(size);
+  std::vector<uint32_t> values(size);
+  for (size_t i = 0; i < size; i++) {
+    keys[i] = dist(e);
+    values[i] = i;
+  }
+  return {keys, values};
+}
+
+template <int schedulerId>
+std::pair<std::vector<uint32_t>, std::vector<uint32_t>> task(
+    SorterFactory<schedulerId>& factory,
+    const std::vector<uint32_t>& keys,
+    const std::vector<uint32_t>& values) {
+  auto sorter = factory.create();
+  auto secKeys =
+      util::MpcAdapters<uint32_t, schedulerId>::processSecretInputs(keys, 0);
+  auto secValues =
+      util::MpcAdapters<uint32_t, schedulerId>::processSecretInputs(
+          values, 1);
+  auto [sortedKeys, sortedValues] =
+      sorter->sort(secKeys, secValues, keys.size());
+  return {
+      util::MpcAdapters<uint32_t, schedulerId>::openToParty(sortedKeys, 0),
+      util::MpcAdapters<uint32_t, schedulerId>::openToParty(sortedValues, 0)};
+}
+
+void sorterTest(
+    SorterFactory<0>& factory0,
+    SorterFactory<1>& factory1,
+    size_t size,
+    uint32_t keyRange,
+    bool isStable) {
+  auto [keys, values] = generateData(size, keyRange);
+
+  auto future0 = std::async(task<0>, std::ref(factory0), keys, values);
+  auto future1 = std::async(task<1>, std::ref(factory1), keys, values);
+  auto [sortedKeys, sortedValues] = future0.get();
+  future1.get();
+
+  ASSERT_EQ(sortedKeys.size(), size);
+  ASSERT_EQ(sortedValues.size(), size);
+  std::vector<bool> seen(size, false);
+  for (size_t i = 0; i < size; i++) {
+    // the payloads are the original positions of the rows
+    auto position = sortedValues.at(i);
+    ASSERT_LT(position, size);
+    EXPECT_FALSE(seen.at(position));
+    seen[position] = true;
+    EXPECT_EQ(sortedKeys.at(i), keys.at(position));
+    if (i > 0) {
+      EXPECT_LE(sortedKeys.at(i - 1), sortedKeys.at(i));
+      if (isStable && sortedKeys.at(i - 1) == sortedKeys.at(i)) {
+        EXPECT_LT(sortedValues.at(i - 1), position);
+      }
+    }
+  }
+}
+
+class SorterTestFixture
+    : public ::testing::TestWithParam<std::tuple<size_t, uint32_t>> {};
+
+TEST_P(SorterTestFixture, testBitonicSorter) {
+  auto [size, keyRange] = GetParam();
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  BitonicSorterFactory<uint32_t, uint32_t, 0> factory0;
+  BitonicSorterFactory<uint32_t, uint32_t, 1> factory1;
+  sorterTest(factory0, factory1, size, keyRange, false);
+}
+
+TEST_P(SorterTestFixture, testRadixSorter) {
+  auto [size, keyRange] = GetParam();
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  RadixSorterFactory<uint32_t, uint32_t, 0> factory0(
+      0,
+      1,
+      std::make_unique<
+          shuffler::ShareTranslationBasedShufflerFactory<std::vector<bool>, 0>>(
+          0,
+          1,
+          *agentFactories[0],
+          std::make_unique<engine::tuple_generator::oblivious_transfer::
+                               IknpShRandomCorrelatedObliviousTransferFactory>(
+              std::make_unique<
+                  engine::tuple_generator::oblivious_transfer::insecure::
+                      DummyBaseObliviousTransferFactory>()),
+          std::make_unique<engine::util::AesPrgFactory>()));
+  RadixSorterFactory<uint32_t, uint32_t, 1> factory1(
+      1,
+      0,
+      std::make_unique<
+          shuffler::ShareTranslationBasedShufflerFactory<std::vector<bool>, 1>>(
+          1,
+          0,
+          *agentFactories[1],
+          std::make_unique<engine::tuple_generator::oblivious_transfer::
+                               IknpShRandomCorrelatedObliviousTransferFactory>(
+              std::make_unique<
+                  engine::tuple_generator::oblivious_transfer::insecure::
+                      DummyBaseObliviousTransferFactory>()),
+          std::make_unique<engine::util::AesPrgFactory>()));
+  sorterTest(factory0, factory1, size, keyRange, true);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SorterTest,
+    SorterTestFixture,
+    ::testing::Values(
+        std::make_tuple(1, 10),
+        std::make_tuple(2, 2),
+        std::make_tuple(13, 4),
+        std::make_tuple(64, 1000),
+        std::make_tuple(100, 16),
+        std::make_tuple(257, 0xFFFFFFFF)));
+
+} // namespace fbpcf::mpc_std_lib::sorter
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <random>
+
+#include "common/init/Init.h"
+
+#include "fbpcf/engine/tuple_generator/oblivious_transfer/RcotHelper.h"
+#include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/mpc_std_lib/shuffler/ShareTranslationBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/BitonicSorterFactory.h"
+#include "fbpcf/mpc_std_lib/sorter/ISorter.h"
+#include "fbpcf/mpc_std_lib/sorter/RadixSorter.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::mpc_std_lib::sorter {
+
+class BaseSorterBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  explicit BaseSorterBenchmark(size_t batchSize) : batchSize_(batchSize) {}
+
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint32_t> dist;
+    keys_ = std::vector<uint32_t>(batchSize_);
+    values_ = std::vector<uint32_t>(batchSize_);
+    for (auto& item : keys_) {
+      item = dist(e);
+    }
+    for (auto& item : values_) {
+      item = dist(e);
+    }
+  }
+
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    sorter0_ = createSorter0();
+  }
+
+  void runSender() override {
+    auto [sortedKeys, sortedValues] = sorter0_->sort(
+        util::MpcAdapters<uint32_t, 0>::processSecretInputs(keys_, 0),
+        util::MpcAdapters<uint32_t, 0>::processSecretInputs(values_, 0),
+        batchSize_);
+    util::MpcAdapters<uint32_t, 0>::openToParty(sortedKeys, 0);
+    util::MpcAdapters<uint32_t, 0>::openToParty(sortedValues, 0);
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    sorter1_ = createSorter1();
+  }
+
+  void runReceiver() override {
+    auto [sortedKeys, sortedValues] = sorter1_->sort(
+        util::MpcAdapters<uint32_t, 1>::processSecretInputs(keys_, 0),
+        util::MpcAdapters<uint32_t, 1>::processSecretInputs(values_, 0),
+        batchSize_);
+    util::MpcAdapters<uint32_t, 1>::openToParty(sortedKeys, 0);
+    util::MpcAdapters<uint32_t, 1>::openToParty(sortedValues, 0);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  virtual std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 0>::type,
+      typename util::SecBatchType<uint32_t, 0>::type>>
+  createSorter0() = 0;
+  virtual std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 1>::type,
+      typename util::SecBatchType<uint32_t, 1>::type>>
+  createSorter1() = 0;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+ private:
+  size_t batchSize_;
+  std::vector<uint32_t> keys_;
+  std::vector<uint32_t> values_;
+
+  std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 0>::type,
+      typename util::SecBatchType<uint32_t, 0>::type>>
+      sorter0_;
+  std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 1>::type,
+      typename util::SecBatchType<uint32_t, 1>::type>>
+      sorter1_;
+};
+
+class BitonicSorterBenchmark : public BaseSorterBenchmark {
+ public:
+  using BaseSorterBenchmark::BaseSorterBenchmark;
+
+ protected:
+  std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 0>::type,
+      typename util::SecBatchType<uint32_t, 0>::type>>
+  createSorter0() override {
+    return BitonicSorterFactory<uint32_t, uint32_t, 0>().create();
+  }
+
+  std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 1>::type,
+      typename util::SecBatchType<uint32_t, 1>::type>>
+  createSorter1() override {
+    return BitonicSorterFactory<uint32_t, uint32_t, 1>().create();
+  }
+};
+
+class RadixSorterBenchmark : public BaseSorterBenchmark {
+ public:
+  using BaseSorterBenchmark::BaseSorterBenchmark;
+
+ protected:
+  std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 0>::type,
+      typename util::SecBatchType<uint32_t, 0>::type>>
+  createSorter0() override {
+    shufflerFactory0_ = std::make_unique<
+        shuffler::ShareTranslationBasedShufflerFactory<std::vector<bool>, 0>>(
+        0,
+        1,
+        *agentFactory0_,
+        engine::tuple_generator::oblivious_transfer::createFerretRcotFactory(),
+        std::make_unique<engine::util::AesPrgFactory>());
+    auto shuffler = shufflerFactory0_->create();
+    shuffler0_ = dynamic_cast<
+        shuffler::ShareTranslationBasedShuffler<std::vector<bool>, 0>*>(
+        shuffler.get());
+    return std::make_unique<RadixSorter<uint32_t, uint32_t, 0>>(
+        0, 1, std::move(shuffler));
+  }
+
+  std::unique_ptr<ISorter<
+      typename util::SecBatchType<uint32_t, 1>::type,
+      typename util::SecBatchType<uint32_t, 1>::type>>
+  createSorter1() override {
+    shufflerFactory1_ = std::make_unique<
+        shuffler::ShareTranslationBasedShufflerFactory<std::vector<bool>, 1>>(
+        1,
+        0,
+        *agentFactory1_,
+        engine::tuple_generator::oblivious_transfer::createFerretRcotFactory(),
+        std::make_unique<engine::util::AesPrgFactory>());
+    return std::make_unique<RadixSorter<uint32_t, uint32_t, 1>>(
+        1, 0, shufflerFactory1_->create());
+  }
+
+  // the shuffler talks to the other party on its own, not via the scheduler.
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    auto [sent, received] =
+        scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+    auto [shufflerSent, shufflerReceived] = shuffler0_->getTrafficStatistics();
+    return {sent + shufflerSent, received + shufflerReceived};
+  }
+
+ private:
+  std::unique_ptr<
+      shuffler::ShareTranslationBasedShufflerFactory<std::vector<bool>, 0>>
+      shufflerFactory0_;
+  std::unique_ptr<
+      shuffler::ShareTranslationBasedShufflerFactory<std::vector<bool>, 1>>
+      shufflerFactory1_;
+  shuffler::ShareTranslationBasedShuffler<std::vector<bool>, 0>* shuffler0_;
+};
+
+BENCHMARK_COUNTERS(BitonicSorter_1M_Benchmark, counters) {
+  BitonicSorterBenchmark benchmark(1000000);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(BitonicSorter_10M_Benchmark, counters) {
+  BitonicSorterBenchmark benchmark(10000000);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(RadixSorter_1M_Benchmark, counters) {
+  RadixSorterBenchmark benchmark(1000000);
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(RadixSorter_10M_Benchmark, counters) {
+  RadixSorterBenchmark benchmark(10000000);
+  benchmark.runBenchmark(counters);
+}
+} // namespace fbpcf::mpc_std_lib::sorter
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
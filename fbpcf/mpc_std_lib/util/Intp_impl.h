@@ -204,6 +204,11 @@ class MpcAdapters<Intp<isSigned, width>, schedulerId> {
     return SecBatchType(std::move(rst));
   }
 
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    return src.extractIntShare().getBooleanShares();
+  }
+
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
       const SecBatchType& src2,
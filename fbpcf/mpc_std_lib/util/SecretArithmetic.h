@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+
+namespace fbpcf::mpc_std_lib::util {
+
+/*
+ * Batched arithmetic on XOR-shared unsigned integers, stored as one secret bit
+ * (or one vector of this party's shares) per bit of the integers, from less
+ * significant to more significant.
+ */
+template <int schedulerId>
+class SecretArithmetic {
+ public:
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+  /**
+   * The batched sum of two integers of the same width, modulo 2^width.
+   * @param carry the carry into the least significant bit.
+   */
+  static std::vector<SecBit> add(
+      const std::vector<SecBit>& left,
+      const std::vector<SecBit>& right,
+      SecBit carry) {
+    std::vector<SecBit> rst;
+    rst.reserve(left.size());
+    for (size_t k = 0; k < left.size(); k++) {
+      rst.push_back(left.at(k) ^ right.at(k) ^ carry);
+      if (k + 1 < left.size()) {
+        // the majority of the three bits
+        carry = carry ^ ((left.at(k) ^ carry) & (right.at(k) ^ carry));
+      }
+    }
+    return rst;
+  }
+
+  // the same as above, without a carry into the least significant bit.
+  static std::vector<SecBit> add(
+      const std::vector<SecBit>& left,
+      const std::vector<SecBit>& right) {
+    std::vector<SecBit> rst;
+    rst.reserve(left.size());
+    if (left.empty()) {
+      return rst;
+    }
+    rst.push_back(left.at(0) ^ right.at(0));
+    if (left.size() > 1) {
+      auto carry = left.at(0) & right.at(0);
+      for (size_t k = 1; k < left.size(); k++) {
+        rst.push_back(left.at(k) ^ right.at(k) ^ carry);
+        if (k + 1 < left.size()) {
+          carry = carry ^ ((left.at(k) ^ carry) & (right.at(k) ^ carry));
+        }
+      }
+    }
+    return rst;
+  }
+
+  /**
+   * The exclusive prefix sums of a batch of integers, with a work-efficient
+   * (Blelloch) scan: O(n) additions in O(log n) levels. Each level is one
+   * batched ripple-carry addition, whose rounds grow with the width of the
+   * integers.
+   * @param shares this party's shares of the integers, they need to be wide
+   * enough for the total.
+   * @return this party's shares of the prefix sums and of the total.
+   */
+  static std::pair<std::vector<std::vector<bool>>, std::vector<bool>>
+  computeExclusivePrefixSums(std::vector<std::vector<bool>>&& shares) {
+    auto size = shares.at(0).size();
+    auto width = shares.size();
+    size_t paddedSize = 1;
+    while (paddedSize < size) {
+      paddedSize <<= 1;
+    }
+    for (auto& item : shares) {
+      item.resize(paddedSize, false);
+    }
+
+    // x[i] += x[i - distance] for every i = 2 * distance - 1 (mod 2 *
+    // distance), all in one batch.
+    auto addToTargets = [&shares, width, paddedSize](size_t distance) {
+      std::vector<uint32_t> targets;
+      for (auto i = 2 * distance - 1; i < paddedSize; i += 2 * distance) {
+        targets.push_back(i);
+      }
+      std::vector<SecBit> left;
+      std::vector<SecBit> right;
+      for (size_t k = 0; k < width; k++) {
+        std::vector<bool> leftShares(targets.size());
+        std::vector<bool> rightShares(targets.size());
+        for (size_t j = 0; j < targets.size(); j++) {
+          leftShares[j] = shares.at(k).at(targets.at(j));
+          rightShares[j] = shares.at(k).at(targets.at(j) - distance);
+        }
+        left.push_back(
+            SecBit(typename SecBit::ExtractedBit(std::move(leftShares))));
+        right.push_back(
+            SecBit(typename SecBit::ExtractedBit(std::move(rightShares))));
+      }
+      auto sum = add(left, right);
+      for (size_t k = 0; k < width; k++) {
+        auto sumShares = sum.at(k).extractBit().getValue();
+        for (size_t j = 0; j < targets.size(); j++) {
+          shares[k][targets.at(j)] = sumShares.at(j);
+        }
+      }
+    };
+
+    // the up-sweep leaves the total at the root.
+    for (size_t distance = 1; distance < paddedSize; distance <<= 1) {
+      addToTargets(distance);
+    }
+    std::vector<bool> total(width);
+    for (size_t k = 0; k < width; k++) {
+      total[k] = shares.at(k).at(paddedSize - 1);
+      shares[k][paddedSize - 1] = false;
+    }
+    // the down-sweep passes the sums of the left subtrees to the right ones.
+    for (size_t distance = paddedSize / 2; distance > 0; distance >>= 1) {
+      for (auto& column : shares) {
+        for (auto i = 2 * distance - 1; i < paddedSize; i += 2 * distance) {
+          bool tmp = column[i - distance];
+          column[i - distance] = column[i];
+          column[i] = tmp;
+        }
+      }
+      addToTargets(distance);
+    }
+
+    for (auto& item : shares) {
+      item.resize(size);
+    }
+    return {std::move(shares), std::move(total)};
+  }
+};
+
+} // namespace fbpcf::mpc_std_lib::util
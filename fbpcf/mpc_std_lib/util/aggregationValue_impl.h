@@ -216,6 +216,15 @@ class MpcAdapters<AggregationValue, schedulerId> {
     return rst;
   }
 
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    auto rst = src.conversionCount.extractIntShare().getBooleanShares();
+    auto valueShares =
+        src.conversionValue.extractIntShare().getBooleanShares();
+    rst.insert(rst.end(), valueShares.begin(), valueShares.end());
+    return rst;
+  }
+
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
       const SecBatchType& src2,
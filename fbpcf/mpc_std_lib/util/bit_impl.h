@@ -26,7 +26,20 @@ class MpcAdapters<bool, schedulerId> {
     return SecBatchType(secrets, secretOwnerPartyId);
   }
 
-  static SecBatchType recoverBatchSharedSecrets(const std::vector<bool>& src);
+  static SecBatchType recoverBatchSharedSecrets(const std::vector<bool>& src) {
+    return SecBatchType(typename SecBatchType::ExtractedBit(src));
+  }
+
+  // the same as above, in the one-vector-per-bit form the other types use.
+  static SecBatchType recoverBatchSharedSecrets(
+      const std::vector<std::vector<bool>>& src) {
+    return recoverBatchSharedSecrets(src.at(0));
+  }
+
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    return {src.extractBit().getValue()};
+  }
 
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
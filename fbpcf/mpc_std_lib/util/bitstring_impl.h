@@ -28,7 +28,18 @@ class MpcAdapters<std::vector<bool>, schedulerId> {
   }
 
   static SecBatchType recoverBatchSharedSecrets(
-      const std::vector<std::vector<bool>>& src);
+      const std::vector<std::vector<bool>>& src) {
+    return SecBatchType(typename SecBatchType::ExtractedString(src));
+  }
+
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    std::vector<std::vector<bool>> rst(src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+      rst[i] = src.at(i).extractBit().getValue();
+    }
+    return rst;
+  }
 
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
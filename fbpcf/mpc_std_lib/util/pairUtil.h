@@ -46,6 +46,28 @@ class MpcAdapters<std::pair<T, U>, schedulerId> {
     return {rst1, rst2};
   }
 
+  // the bits of the first values come first. The first type needs a fixed
+  // number of bits, so that its adapters only take the bits they need.
+  static SecBatchType recoverBatchSharedSecrets(
+      const std::vector<std::vector<bool>>& src) {
+    auto rst1 = MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(src);
+    auto width1 =
+        MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(rst1).size();
+    auto rst2 = MpcAdapters<U, schedulerId>::recoverBatchSharedSecrets(
+        std::vector<std::vector<bool>>(src.begin() + width1, src.end()));
+    return {rst1, rst2};
+  }
+
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    auto rst =
+        MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(src.first);
+    auto rst2 =
+        MpcAdapters<U, schedulerId>::extractBatchSharedSecrets(src.second);
+    rst.insert(rst.end(), rst2.begin(), rst2.end());
+    return rst;
+  }
+
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
       const SecBatchType& src2,
@@ -46,6 +46,24 @@ class MpcAdapters<std::pair<T, bool>, schedulerId> {
     return {rst1, rst2};
   }
 
+  // the label is the last bit.
+  static SecBatchType recoverBatchSharedSecrets(
+      const std::vector<std::vector<bool>>& src) {
+    auto rst1 = MpcAdapters<T, schedulerId>::recoverBatchSharedSecrets(
+        std::vector<std::vector<bool>>(src.begin(), src.end() - 1));
+    auto rst2 =
+        MpcAdapters<bool, schedulerId>::recoverBatchSharedSecrets(src.back());
+    return {rst1, rst2};
+  }
+
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    auto rst =
+        MpcAdapters<T, schedulerId>::extractBatchSharedSecrets(src.first);
+    rst.push_back(src.second.extractBit().getValue());
+    return rst;
+  }
+
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
       const SecBatchType& src2,
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <folly/Benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fbpcf::mpc_std_lib::util {
+
+/**
+ * A plaintext stand-in for a batch bit that only tracks the AND gates: how
+ * many gates are issued, how many values they cover and the AND depth.
+ */
+class AndCountingBit {
+ public:
+  AndCountingBit() = default;
+  explicit AndCountingBit(size_t batchSize) : batchSize_(batchSize) {}
+
+  AndCountingBit operator&(const AndCountingBit& other) const {
+    andGates_++;
+    andValues_ += batchSize_;
+    AndCountingBit rst(batchSize_);
+    rst.depth_ = std::max(depth_, other.depth_) + 1;
+    maxDepth_ = std::max(maxDepth_, rst.depth_);
+    return rst;
+  }
+
+  AndCountingBit operator^(const AndCountingBit& other) const {
+    AndCountingBit rst(batchSize_);
+    rst.depth_ = std::max(depth_, other.depth_);
+    return rst;
+  }
+
+  AndCountingBit operator!() const {
+    return *this;
+  }
+
+  AndCountingBit batchingWith(const std::vector<AndCountingBit>& others) const {
+    AndCountingBit rst(*this);
+    for (auto& other : others) {
+      rst.batchSize_ += other.batchSize_;
+      rst.depth_ = std::max(rst.depth_, other.depth_);
+    }
+    return rst;
+  }
+
+  std::vector<AndCountingBit> unbatching(
+      std::shared_ptr<std::vector<uint32_t>> unbatchingStrategy) const {
+    std::vector<AndCountingBit> rst;
+    for (auto size : *unbatchingStrategy) {
+      rst.push_back(AndCountingBit(size));
+      rst.back().depth_ = depth_;
+    }
+    return rst;
+  }
+
+  static void resetCounters() {
+    andGates_ = 0;
+    andValues_ = 0;
+    maxDepth_ = 0;
+  }
+
+  static void reportCounters(folly::UserCounters& counters, size_t blocks) {
+    counters["and_gates"] = andGates_;
+    counters["and_gates_per_block"] = andValues_ / blocks;
+    counters["and_depth"] = maxDepth_;
+  }
+
+ private:
+  size_t batchSize_ = 1;
+  size_t depth_ = 0;
+
+  inline static uint64_t andGates_ = 0;
+  inline static uint64_t andValues_ = 0;
+  inline static size_t maxDepth_ = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::util
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
+#include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+namespace fbpcf::mpc_std_lib::util {
+
+/**
+ * A networked benchmark of a computation between party 0 and party 1 over
+ * sockets, party i running on scheduler i. Subclasses put party 0's part in
+ * initParty0() and runParty0(), and party 1's in initParty1() and
+ * runParty1(). The traffic is party 0's.
+ */
+class TwoPartyMpcBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  /**
+   * @param useEagerScheduler whether to run every gate on its own instead of
+   * merging the gates of a level, e.g. to count the gates issued.
+   */
+  explicit TwoPartyMpcBenchmark(bool useEagerScheduler = false)
+      : useEagerScheduler_(useEagerScheduler) {}
+
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+  }
+
+ protected:
+  template <int schedulerId>
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+  void initSender() override {
+    setScheduler<0>(*agentFactory0_);
+    initParty0();
+  }
+
+  void runSender() override {
+    runParty0();
+  }
+
+  void initReceiver() override {
+    setScheduler<1>(*agentFactory1_);
+    initParty1();
+  }
+
+  void runReceiver() override {
+    runParty1();
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  virtual void initParty0() {}
+  virtual void initParty1() {}
+
+  virtual void runParty0() = 0;
+  virtual void runParty1() = 0;
+
+  // count batches of batchSize random bits each.
+  static std::vector<std::vector<bool>> generateRandomBatches(
+      size_t count,
+      size_t batchSize) {
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint8_t> dist(0, 1);
+    std::vector<std::vector<bool>> rst(count, std::vector<bool>(batchSize));
+    for (auto& bits : rst) {
+      for (size_t i = 0; i < batchSize; i++) {
+        bits[i] = dist(e);
+      }
+    }
+    return rst;
+  }
+
+  // count batches of batchSize copies of one random bit each, e.g. a key
+  // shared by the whole batch.
+  static std::vector<std::vector<bool>> generateRandomConstantBatches(
+      size_t count,
+      size_t batchSize) {
+    auto bits = generateRandomBatches(1, count).at(0);
+    std::vector<std::vector<bool>> rst;
+    rst.reserve(count);
+    for (auto bit : bits) {
+      rst.push_back(std::vector<bool>(batchSize, bit));
+    }
+    return rst;
+  }
+
+  template <int schedulerId>
+  static std::vector<SecBit<schedulerId>> processInputs(
+      const std::vector<std::vector<bool>>& src,
+      int partyId) {
+    std::vector<SecBit<schedulerId>> rst;
+    rst.reserve(src.size());
+    for (auto& bits : src) {
+      rst.push_back(SecBit<schedulerId>(bits, partyId));
+    }
+    return rst;
+  }
+
+  // the lazy scheduler only runs the gates once a value is requested.
+  template <int schedulerId>
+  static void openToParty0(const std::vector<SecBit<schedulerId>>& src) {
+    std::vector<frontend::Bit<false, schedulerId, true>> opened;
+    opened.reserve(src.size());
+    for (auto& bit : src) {
+      opened.push_back(bit.openToParty(0));
+    }
+    for (auto& bit : opened) {
+      bit.getValue();
+    }
+  }
+
+ private:
+  template <int schedulerId>
+  void setScheduler(
+      engine::communication::IPartyCommunicationAgentFactory& agentFactory) {
+    scheduler::SchedulerKeeper<schedulerId>::setScheduler(
+        useEagerScheduler_
+            ? scheduler::createEagerSchedulerWithRealEngine(
+                  schedulerId, agentFactory)
+            : scheduler::createLazySchedulerWithRealEngine(
+                  schedulerId, agentFactory));
+  }
+
+  bool useEagerScheduler_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+};
+
+} // namespace fbpcf::mpc_std_lib::util
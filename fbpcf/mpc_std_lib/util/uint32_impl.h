@@ -67,6 +67,11 @@ class MpcAdapters<uint32_t, schedulerId> {
   static SecBatchType recoverBatchSharedSecrets(
       const std::vector<std::vector<bool>>& src);
 
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src) {
+    return src.extractIntShare().getBooleanShares();
+  }
+
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
       const SecBatchType& src2,
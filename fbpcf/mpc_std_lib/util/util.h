@@ -49,6 +49,11 @@ class MpcAdapters {
   static SecBatchType recoverBatchSharedSecrets(
       const std::vector<std::vector<bool>>& src);
 
+  // the inverse of recoverBatchSharedSecrets: this party's shares, one vector
+  // per bit, each of which holds that bit of all the values in the batch.
+  static std::vector<std::vector<bool>> extractBatchSharedSecrets(
+      const SecBatchType& src);
+
   static std::pair<SecBatchType, SecBatchType> obliviousSwap(
       const SecBatchType& src1,
       const SecBatchType& src2,
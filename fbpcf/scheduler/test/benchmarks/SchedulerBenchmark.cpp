@@ -97,8 +97,7 @@ BENCHMARK(WireKeeperBenchmark_decreaseReferenceCount, n) {
 class SchedulerBenchmark : public engine::util::NetworkedBenchmark {
  public:
   void setup() override {
-    auto [agentFactory0, agentFactory1] =
-        engine::util::getSocketAgentFactories();
+    auto [agentFactory0, agentFactory1] = getAgentFactories();
     agentFactory0_ = std::move(agentFactory0);
     agentFactory1_ = std::move(agentFactory1);
 
@@ -133,6 +132,13 @@ class SchedulerBenchmark : public engine::util::NetworkedBenchmark {
     return sender_->getTrafficStatistics();
   }
 
+  virtual std::pair<
+      std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>,
+      std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>>
+  getAgentFactories() {
+    return engine::util::getSocketAgentFactories();
+  }
+
   virtual std::unique_ptr<IScheduler> getScheduler(
       int myId,
       engine::communication::IPartyCommunicationAgentFactory&
@@ -181,6 +187,25 @@ class EagerSchedulerBenchmark : virtual public SchedulerBenchmark {
   }
 };
 
+// Runs the parties over an emulated link instead of a local socket.
+template <engine::communication::NetworkProfile (*getProfile)()>
+class EmulatedNetworkSchedulerBenchmark : virtual public SchedulerBenchmark {
+ protected:
+  std::pair<
+      std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>,
+      std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>>
+  getAgentFactories() override {
+    return engine::util::getEmulatedNetworkAgentFactories(getProfile());
+  }
+};
+
+using LanBenchmark = EmulatedNetworkSchedulerBenchmark<
+    engine::communication::NetworkProfile::lan>;
+using SameRegionBenchmark = EmulatedNetworkSchedulerBenchmark<
+    engine::communication::NetworkProfile::sameRegion>;
+using CrossRegionBenchmark = EmulatedNetworkSchedulerBenchmark<
+    engine::communication::NetworkProfile::crossRegion>;
+
 class NonFreeGatesBenchmark : virtual public SchedulerBenchmark {
  protected:
   void runMethod(std::unique_ptr<IScheduler>& scheduler) override {
@@ -339,6 +364,59 @@ BENCHMARK_COUNTERS(EagerScheduler_NonFreeGatesCompositeBatch, counters) {
   EagerScheduler_NonFreeGatesCompositeBatch_Benchmark benchmark;
   benchmark.runBenchmark(counters);
 }
+
+// The same workloads over emulated links. The eager scheduler pays one round
+// trip per gate, so it is left out of the cross-region runs.
+
+class LazyScheduler_NonFreeGatesBatch_Lan_Benchmark
+    : public LazySchedulerBenchmark,
+      public NonFreeGatesBatchBenchmark,
+      public LanBenchmark {};
+
+BENCHMARK_COUNTERS(LazyScheduler_NonFreeGatesBatch_Lan, counters) {
+  LazyScheduler_NonFreeGatesBatch_Lan_Benchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class EagerScheduler_NonFreeGatesBatch_Lan_Benchmark
+    : public EagerSchedulerBenchmark,
+      public NonFreeGatesBatchBenchmark,
+      public LanBenchmark {};
+
+BENCHMARK_COUNTERS(EagerScheduler_NonFreeGatesBatch_Lan, counters) {
+  EagerScheduler_NonFreeGatesBatch_Lan_Benchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class LazyScheduler_NonFreeGatesBatch_SameRegion_Benchmark
+    : public LazySchedulerBenchmark,
+      public NonFreeGatesBatchBenchmark,
+      public SameRegionBenchmark {};
+
+BENCHMARK_COUNTERS(LazyScheduler_NonFreeGatesBatch_SameRegion, counters) {
+  LazyScheduler_NonFreeGatesBatch_SameRegion_Benchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class EagerScheduler_NonFreeGatesBatch_SameRegion_Benchmark
+    : public EagerSchedulerBenchmark,
+      public NonFreeGatesBatchBenchmark,
+      public SameRegionBenchmark {};
+
+BENCHMARK_COUNTERS(EagerScheduler_NonFreeGatesBatch_SameRegion, counters) {
+  EagerScheduler_NonFreeGatesBatch_SameRegion_Benchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class LazyScheduler_NonFreeGatesBatch_CrossRegion_Benchmark
+    : public LazySchedulerBenchmark,
+      public NonFreeGatesBatchBenchmark,
+      public CrossRegionBenchmark {};
+
+BENCHMARK_COUNTERS(LazyScheduler_NonFreeGatesBatch_CrossRegion, counters) {
+  LazyScheduler_NonFreeGatesBatch_CrossRegion_Benchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
 } // namespace fbpcf::scheduler
 
 int main(int argc, char* argv[]) {
@@ -46,4 +46,51 @@ bool isDrngSupported() {
 
   return rdrandSupported && rdseedSupported;
 }
+
+namespace {
+// the register states the OS saves on context switches
+uint64_t getXcr0() {
+  uint32_t eax;
+  uint32_t edx;
+  asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+
+bool isOsXsaveSupported() {
+  auto info = getCpuId(1);
+  return (info.ecx & 0x8000000) == 0x8000000;
+}
+} // namespace
+
+bool isAvx2Supported() {
+  if (getCpuId(0).eax < 7 || !isOsXsaveSupported()) {
+    return false;
+  }
+  // the XMM and YMM states
+  if ((getXcr0() & 0x6) != 0x6) {
+    return false;
+  }
+  auto info = getCpuId(7);
+  return (info.ebx & 0x20) == 0x20;
+}
+
+bool isAvx512Supported() {
+  if (!isAvx2Supported()) {
+    return false;
+  }
+  // the opmask and ZMM states
+  if ((getXcr0() & 0xE0) != 0xE0) {
+    return false;
+  }
+  auto info = getCpuId(7);
+  // AVX512F and AVX512BW
+  return (info.ebx & 0x40010000) == 0x40010000;
+}
+
+bool isVaesSupported() {
+  if (!isAvx512Supported()) {
+    return false;
+  }
+  return (getCpuId(7).ecx & 0x200) == 0x200;
+}
 } // namespace fbpcf::system
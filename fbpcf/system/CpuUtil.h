@@ -20,4 +20,11 @@ struct CpuId {
 CpuId getCpuId(const uint64_t& eax);
 bool isIntelCpu();
 bool isDrngSupported();
+
+// whether both the CPU and the OS support these instruction sets.
+bool isAvx2Supported();
+// AVX-512 Foundation and Byte/Word instructions.
+bool isAvx512Supported();
+// AES instructions on 512-bit registers, on top of AVX-512 Foundation.
+bool isVaesSupported();
 } // namespace fbpcf::system